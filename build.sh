@@ -1032,12 +1032,16 @@ if [ $WITH_DEPS -gt 0 ]; then
 
     cd - >/dev/null # return back from llvm 3rd party subdir
 
-    if ! is_dependency_installed "llvm_v${llvmCommit}" || [ "$(cat "${llvmCommitFilePath}")" != "$llvmCommit" ]; then
+    # v2: additionally builds LLVM's OpenMP runtime (for --mlir-codegen-parallel).
+    dep_llvm=("llvm_v${llvmCommit}" "v2")
+
+    if ! is_dependency_installed "${dep_llvm[@]}" || [ "$(cat "${llvmCommitFilePath}")" != "$llvmCommit" ]; then
         daphne_msg "Building LLVM/MLIR from ${llvmCommit}"
         cd "${thirdpartyPath}/${llvmName}"
         echo "Need to build MLIR/LLVM."
         cmake -G Ninja -S llvm -B "$buildPrefix/$llvmName" \
             -DLLVM_ENABLE_PROJECTS=mlir \
+            -DLLVM_ENABLE_RUNTIMES=openmp \
             -DLLVM_BUILD_EXAMPLES=OFF \
             -DLLVM_TARGETS_TO_BUILD="$LLVM_ARCH" \
             -DCMAKE_BUILD_TYPE=Release \
@@ -1049,7 +1053,7 @@ if [ $WITH_DEPS -gt 0 ]; then
         cmake --build "$buildPrefix/$llvmName" --target install/strip
         echo "$llvmCommit" >"$llvmCommitFilePath"
         cd - >/dev/null
-        dependency_install_success "llvm_v${llvmCommit}"
+        dependency_install_success "${dep_llvm[@]}"
     else
         daphne_msg "No need to build MLIR/LLVM again."
     fi
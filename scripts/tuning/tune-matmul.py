@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The DAPHNE Consortium
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Offline auto-tuner for the code generated for matrix multiplications.
+
+For each value type and shape, this script benchmarks a number of candidate
+configurations of the MatMul lowering (tile sizes, unroll factors, and vector
+size) by running DAPHNE with `--mlir-codegen` on the current machine, and
+stores the fastest configuration per value type and shape class in a profile
+file. DAPHNE uses the profile via `--matmul-tuning-profile=<file>` (or the
+`matmul_tuning_profile` key of the user configuration).
+
+Example:
+    scripts/tuning/tune-matmul.py --shapes 64 256 1024 512x64x512 -o matmul-profile.json
+"""
+
+import argparse
+import itertools
+import json
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+BENCHMARK_SCRIPT = """
+A = rand($m, $k, as.{vt}(-1.0), as.{vt}(1.0), 1.0, 42);
+B = rand($k, $n, as.{vt}(-1.0), as.{vt}(1.0), 1.0, 43);
+for (i in 1:$reps) {{
+    start = now();
+    C = A @ B;
+    end = now();
+    print(end - start);
+}}
+"""
+
+
+def detect_vec_size_bits():
+    try:
+        with open("/proc/cpuinfo") as f:
+            flags = f.read()
+    except OSError:
+        return 128
+    if re.search(r"\bavx512f\b", flags):
+        return 512
+    if re.search(r"\bavx2?\b", flags):
+        return 256
+    return 128
+
+
+def parse_shape(s):
+    dims = [int(d) for d in s.split("x")]
+    if len(dims) == 1:
+        return dims * 3
+    if len(dims) != 3:
+        raise argparse.ArgumentTypeError(f"invalid shape '{s}', expected N or MxKxN")
+    return dims
+
+
+def shape_class(dim):
+    """Returns the exponent of the power of two the dimension is rounded up to.
+
+    The entries of a profile are identified by their value type and the shape classes of their dimensions. This must
+    match `MatMulTuningProfile::shapeClass()` in `src/compiler/lowering/MatMulTuningProfile.h`.
+    """
+    return max(dim - 1, 0).bit_length()
+
+
+def profile_key(entry):
+    return (entry["value_type"], shape_class(entry["m"]), shape_class(entry["k"]), shape_class(entry["n"]))
+
+
+def candidates(args, shape):
+    """Returns the untiled baseline and a random sample of tiled configurations."""
+    m, k, n = shape
+    vec_sizes = sorted({0, args.vec_size_bits})
+    space = [
+        [mr, nr, kc, mc, nc, vec, uf, ujf]
+        for mr, nr, kc, mc, nc, vec, uf, ujf in itertools.product(
+            [2, 4, 8], [2, 4, 8], [32, 64, 128, 256], [16, 32, 64, 128], [64, 256, 1024], vec_sizes, [1, 4], [2, 4]
+        )
+        # Tiles larger than the loops are pointless.
+        if max(mr, mc) <= m and max(nr, nc) <= n and kc <= k and mc % mr == 0 and nc % nr == 0
+    ]
+    rng = random.Random(args.seed)
+    sample = rng.sample(space, min(args.max_candidates, len(space)))
+    yield {"tile_sizes": [], "vec_size_bits": 0, "unroll_factor": 1, "unroll_jam_factor": 4}
+    for mr, nr, kc, mc, nc, vec, uf, ujf in sample:
+        yield {"tile_sizes": [mr, nr, kc, mc, nc], "vec_size_bits": vec, "unroll_factor": uf, "unroll_jam_factor": ujf}
+
+
+def benchmark(args, script, vt, shape, config):
+    """Returns the minimum runtime in nanoseconds, or None if DAPHNE failed."""
+    m, k, n = shape
+    cmd = [args.daphne, "--mlir-codegen", f"--matmul-vec-size-bits={config['vec_size_bits']}"]
+    if config["tile_sizes"]:
+        cmd += [
+            "--matmul-fixed-tile-sizes=" + ",".join(str(s) for s in config["tile_sizes"]),
+            f"--matmul-unroll-factor={config['unroll_factor']}",
+            f"--matmul-unroll-jam-factor={config['unroll_jam_factor']}",
+        ]
+    cmd += [script, f"m={m}", f"k={k}", f"n={n}", f"reps={args.repetitions}"]
+    try:
+        res = subprocess.run(cmd, capture_output=True, text=True, timeout=args.timeout)
+    except subprocess.TimeoutExpired:
+        return None
+    if res.returncode != 0:
+        return None
+    times = [int(line) for line in res.stdout.split() if line.strip().lstrip("-").isdigit()]
+    # The first repetition includes warming up the caches.
+    return min(times[1:] or times) if times else None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--daphne", default=os.path.join("bin", "daphne"), help="path to the DAPHNE executable")
+    parser.add_argument("-o", "--output", required=True, help="profile file to create or extend")
+    parser.add_argument("--value-types", nargs="+", default=["f64", "f32"], choices=["f64", "f32"])
+    parser.add_argument(
+        "--shapes", nargs="+", type=parse_shape, default=[[64] * 3, [256] * 3, [1024] * 3],
+        help="shapes to tune for, either N for square matrices or MxKxN",
+    )
+    parser.add_argument("--vec-size-bits", type=int, default=detect_vec_size_bits())
+    parser.add_argument("--max-candidates", type=int, default=40, help="tiled configurations per shape")
+    parser.add_argument("--repetitions", type=int, default=5)
+    parser.add_argument("--timeout", type=int, default=300, help="per run, in seconds")
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    entries = []
+    if os.path.exists(args.output):
+        with open(args.output) as f:
+            entries = json.load(f)["entries"]
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for vt in args.value_types:
+            script = os.path.join(tmp, f"matmul_{vt}.daphne")
+            with open(script, "w") as f:
+                f.write(BENCHMARK_SCRIPT.format(vt=vt))
+            for shape in args.shapes:
+                best, best_time = None, None
+                for config in candidates(args, shape):
+                    t = benchmark(args, script, vt, shape, config)
+                    print(f"{vt} {'x'.join(map(str, shape))} {config}: {t if t is not None else 'failed'}",
+                          file=sys.stderr)
+                    if t is not None and (best_time is None or t < best_time):
+                        best, best_time = config, t
+                if best is None:
+                    print(f"no working configuration for {vt} {shape}", file=sys.stderr)
+                    continue
+                m, k, n = shape
+                entry = {"value_type": vt, "m": m, "k": k, "n": n, **best, "time_ns": best_time}
+                # Replace the entry of the same shape class, if any.
+                entries = [e for e in entries if profile_key(e) != profile_key(entry)]
+                entries.append(entry)
+
+    with open(args.output, "w") as f:
+        json.dump({"entries": entries}, f, indent=4)
+        f.write("\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -19,10 +19,13 @@
 #include <api/daphnelib/DaphneLibResult.h>
 #include <compiler/catalog/KernelCatalog.h>
 #include <runtime/local/datastructures/IAllocationDescriptor.h>
+#include <runtime/local/io/CompressionCodec.h>
 #include <runtime/local/vectorized/LoadPartitioningDefs.h>
 #include <util/DaphneLogger.h>
 #include <util/LogConfig.h>
 class DaphneLogger;
+struct DaphneContext;
+class ResidentObjectStore;
 
 #include <filesystem>
 #include <limits>
@@ -42,6 +45,8 @@ struct DaphneUserConfig {
     bool use_obj_ref_mgnt = true;
     bool use_ipa_const_propa = true;
     bool use_phy_op_selection = true;
+    bool use_async_read = false;
+    bool use_adaptive_matrix_repr = true;
     bool use_mlir_codegen = false;
     int matmul_vec_size_bits = 0;
     bool matmul_tile = false;
@@ -51,7 +56,9 @@ struct DaphneUserConfig {
     bool matmul_use_fixed_tile_sizes = false;
     std::vector<unsigned> matmul_fixed_tile_sizes = {4, 4};
     bool matmul_invert_loops = false;
+    std::string matmul_tuning_profile;
     bool use_mlir_hybrid_codegen = false;
+    bool use_mlir_codegen_parallel = false;
     bool cuda_fuse_any = false;
     bool vectorized_single_queue = false;
     bool prePartitionRows = false;
@@ -89,9 +96,16 @@ struct DaphneUserConfig {
         std::numeric_limits<int>::max() - 1024; // 2GB (-1KB to make up for gRPC headers etc.) - which is the
                                                 // maximum size allowed by gRPC / MPI. TODO: Investigate what
                                                 // might be the optimal.
+    CompressionCodec distributed_compression = CompressionCodec::NONE;
     int numberOfThreads = -1;
     int minimumTaskSize = 1;
 
+    // DAPHNE binary data format (.dbdf)
+    // The format version to write dense matrices and frames in, 2 is the
+    // columnar format (see DaphneColumnarFile.h).
+    int dbdf_version = 2;
+    CompressionCodec dbdf_compression = CompressionCodec::NONE;
+
     // hdfs
     bool use_hdfs = false;
     std::string hdfs_Address = "";
@@ -125,6 +139,12 @@ struct DaphneUserConfig {
     // DaphneContext, but having it here is simpler for now.
     DaphneLibResult *result_struct = nullptr;
 
+    // For DaphneLib sessions (see DaphneSession): the DaphneContext shared by
+    // all scripts of the session and the data objects kept between them. Both
+    // are nullptr outside of a session.
+    DaphneContext *session_context = nullptr;
+    ResidentObjectStore *resident_objects = nullptr;
+
     KernelCatalog kernelCatalog;
 
     /**
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <runtime/local/io/ArrowCDataInterface.h>
+
 #include <cinttypes>
 #include <string>
 
@@ -25,10 +27,9 @@ struct DaphneLibResult {
     int64_t rows;
     int64_t cols;
     int64_t vtc;
-    // For frames.
-    int64_t *vtcs;
-    char **labels;
-    void **columns;
+    // For frames, exported through the Arrow C data interface.
+    ArrowArray frameArray;
+    ArrowSchema frameSchema;
     // To pass error messages to Python code.
     std::string error_message;
 };
\ No newline at end of file
@@ -27,6 +27,20 @@ DaphneLibResult daphneLibRes;
  */
 extern "C" DaphneLibResult getResult() { return daphneLibRes; }
 
+/**
+ * @brief Moves the frame result of a DaphneLib invocation into the given
+ * structs of the Arrow C data interface.
+ *
+ * The caller becomes responsible for releasing them.
+ */
+extern "C" void getFrameResult(ArrowArray *array, ArrowSchema *schema) {
+    *array = daphneLibRes.frameArray;
+    *schema = daphneLibRes.frameSchema;
+    // The caller owns the children now, so no pointers to them must remain.
+    daphneLibRes.frameArray = {};
+    daphneLibRes.frameSchema = {};
+}
+
 /**
  * @brief Invokes DAPHNE with the specified DaphneDSL script and path to lib
  * dir.
@@ -36,4 +50,40 @@ extern "C" int daphne(const char *libDirPath, const char *scriptPath) {
     int argc = 4;
 
     return mainInternal(argc, argv, &daphneLibRes);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Creates a session, in which DAPHNE keeps compiled scripts and
+ * resident data objects between invocations.
+ */
+extern "C" DaphneSession *createSession() { return createDaphneSession(); }
+
+/**
+ * @brief Invokes DAPHNE with the specified DaphneDSL script and path to lib
+ * dir in the given session.
+ */
+extern "C" int runInSession(DaphneSession *session, const char *libDirPath, const char *scriptPath) {
+    const char *argv[] = {"daphne", "--libdir", libDirPath, scriptPath};
+    int argc = 4;
+
+    return runInDaphneSession(session, argc, argv, &daphneLibRes);
+}
+
+/**
+ * @brief Releases the resident data object of the given name in the given
+ * session, returns `false` if there is none.
+ */
+extern "C" bool dropResident(DaphneSession *session, const char *name) {
+    return dropDaphneSessionResident(session, name);
+}
+
+/**
+ * @brief Returns the number of scripts run in the given session that reused
+ * previously compiled code.
+ */
+extern "C" size_t getSessionCacheHits(DaphneSession *session) { return getDaphneSessionNumCacheHits(session); }
+
+/**
+ * @brief Destroys the given session and all resident data objects in it.
+ */
+extern "C" void destroySession(DaphneSession *session) { destroyDaphneSession(session); }
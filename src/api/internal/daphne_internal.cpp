@@ -25,13 +25,17 @@
 #include <api/cli/StatusCode.h>
 #include <api/daphnelib/DaphneLibResult.h>
 #include <api/internal/daphne_internal.h>
+#include <ir/daphneir/Daphne.h>
 #include <parser/catalog/KernelCatalogParser.h>
 #include <parser/config/ConfigParser.h>
 #include <parser/daphnedsl/DaphneDSLParser.h>
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/context/ResidentObjectStore.h>
 #include <runtime/local/vectorized/LoadPartitioningDefs.h>
 #include <util/DaphneLogger.h>
 #include <util/KernelDispatchMapping.h>
 #include <util/Statistics.h>
+#include <util/StringRefCount.h>
 
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
 #include "mlir/IR/Builders.h"
@@ -43,8 +47,13 @@
 #endif
 
 #include <chrono>
+#include <deque>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 
@@ -56,6 +65,72 @@
 // global logger handle for this executable
 static std::unique_ptr<DaphneLogger> logger;
 
+/**
+ * @brief The state DaphneLib keeps between the scripts run in a session.
+ *
+ * The executor (and with it the MLIR context, the kernel catalog, and the
+ * user config the compiled code refers to) and the `DaphneContext` are created
+ * for the first script and reused by all later ones. Named data objects stored
+ * by `storeResident()` stay alive until the session is destroyed. Compiled
+ * scripts are cached by their text, such that running the same script again
+ * only executes it. Scripts that read files or import other scripts are not
+ * cached.
+ */
+struct DaphneSession {
+    // Note that the members are destroyed in reverse order.
+    std::unique_ptr<DaphneIrExecutor> executor;
+    ResidentObjectStore residentObjects;
+    std::unique_ptr<DaphneContext> context;
+
+    /**
+     * @brief The maximum number of compiled scripts kept, the oldest one is
+     * evicted first.
+     */
+    static constexpr size_t maxNumCompiledScripts = 64;
+    std::unordered_map<std::string, std::unique_ptr<mlir::ExecutionEngine>> compiledScripts;
+    std::deque<std::string> compiledScriptsOrder;
+    /**
+     * @brief The number of scripts that were run without compiling them again.
+     */
+    size_t numCacheHits = 0;
+
+    /**
+     * @brief Returns the key under which the compiled code of the given script
+     * is cached, or an empty string if the script cannot be read.
+     *
+     * Besides the script itself, the compiled code depends on the script
+     * arguments and on the types of the resident objects the script loads.
+     * The key does not cover the scripts imported by this one, so the caller
+     * must not cache such scripts.
+     */
+    std::string getCacheKey(const std::string &scriptPath,
+                            const std::unordered_map<std::string, std::string> &scriptArgs) const {
+        std::ifstream ifs(scriptPath);
+        if (!ifs)
+            return "";
+        std::stringstream key;
+        key << scriptPath << '\0' << ifs.rdbuf() << '\0';
+        for (auto &[name, value] : std::map<std::string, std::string>(scriptArgs.begin(), scriptArgs.end()))
+            key << name << '=' << value << '\0';
+        key << residentObjects.signature();
+        return key.str();
+    }
+
+    mlir::ExecutionEngine *getCompiledScript(const std::string &key) const {
+        auto it = compiledScripts.find(key);
+        return it == compiledScripts.end() ? nullptr : it->second.get();
+    }
+
+    void addCompiledScript(const std::string &key, std::unique_ptr<mlir::ExecutionEngine> engine) {
+        if (compiledScripts.size() == maxNumCompiledScripts) {
+            compiledScripts.erase(compiledScriptsOrder.front());
+            compiledScriptsOrder.pop_front();
+        }
+        compiledScripts.emplace(key, std::move(engine));
+        compiledScriptsOrder.push_back(key);
+    }
+};
+
 using namespace std;
 using namespace mlir;
 using namespace llvm::cl;
@@ -103,7 +178,8 @@ void logErrorDaphneLibAware(DaphneLibResult *daphneLibRes, std::string msg) {
         spdlog::error(msg);
 }
 
-int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int *id, DaphneUserConfig &user_config) {
+int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int *id, DaphneUserConfig &user_config,
+                DaphneSession *session) {
     using clock = std::chrono::high_resolution_clock;
     clock::time_point tpBeg = clock::now();
 
@@ -155,6 +231,26 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
                                               "runtime (in bytes)"
                                               "(default is close to maximum allowed ~2GB)"),
                                          init(std::numeric_limits<int>::max() - 1024));
+    static opt<CompressionCodec> distrCompression(
+        "distr-compression", cat(distributedBackEndSetupOptions),
+        desc("Choose the compression of the data sent to the distributed workers:"),
+        values(clEnumValN(CompressionCodec::NONE, "none", "Send the serialized data as is (default)"),
+               clEnumValN(CompressionCodec::LZ4, "lz4", "Compress each chunk with LZ4 (fast)"),
+               clEnumValN(CompressionCodec::ZSTD, "zstd", "Compress each chunk with Zstd (higher ratio)")),
+        init(CompressionCodec::NONE));
+
+    // DAPHNE binary data format knobs
+    static opt<int> dbdfVersion("dbdf-version", cat(daphneOptions),
+                                desc("The version of the DAPHNE binary data format (.dbdf) to write dense matrices "
+                                     "and frames in: 1 (one block per object) or 2 (columnar, default)"),
+                                init(2));
+    static opt<CompressionCodec> dbdfCompression(
+        "dbdf-compression", cat(daphneOptions),
+        desc("Choose the compression of the column chunks of written .dbdf files (version 2):"),
+        values(clEnumValN(CompressionCodec::NONE, "none", "Only use lightweight encodings (default)"),
+               clEnumValN(CompressionCodec::LZ4, "lz4", "Additionally compress each chunk with LZ4 (fast)"),
+               clEnumValN(CompressionCodec::ZSTD, "zstd", "Additionally compress each chunk with Zstd (higher ratio)")),
+        init(CompressionCodec::NONE));
 
     // HDFS knobs
     static opt<bool> use_hdfs("enable-hdfs", cat(HDFSOptions), desc("Enable HDFS filesystem"));
@@ -225,11 +321,17 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
     static opt<bool> noPhyOpSelection("no-phy-op-selection", cat(daphneOptions),
                                       desc("Switch off physical operator selection, use default kernels for "
                                            "all operations"));
+    static opt<bool> asyncRead("async-read", cat(daphneOptions),
+                               desc("Start reading files as early as possible on separate I/O threads, "
+                                    "overlapped with the computation"));
     static opt<bool> selectMatrixRepr("select-matrix-repr", cat(daphneOptions),
                                       desc("Automatically choose physical matrix representations "
                                            "(e.g., dense/sparse)"));
     static alias selectMatrixReprAlias( // to still support the longer old form
         "select-matrix-representations", aliasopt(selectMatrixRepr), desc("Alias for --select-matrix-repr"));
+    static opt<bool> noAdaptiveMatrixRepr("no-adaptive-matrix-repr", cat(daphneOptions),
+                                          desc("Switch off the choice of matrix representations at run-time for "
+                                               "matrices whose sparsity is unknown at compile-time"));
     static opt<bool> cuda("cuda", cat(daphneOptions), desc("Use CUDA"));
     static opt<bool> fpgaopencl("fpgaopencl", cat(daphneOptions), desc("Use FPGAOPENCL"));
     static opt<string> libDir("libdir", cat(daphneOptions),
@@ -267,10 +369,18 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
                                          desc("Enable inverting of the inner two loops in the matrix "
                                               "multiplication as a fallback option, if tiling is not possible "
                                               "or deactivated."));
+    static opt<string> matmul_tuning_profile(
+        "matmul-tuning-profile", cat(daphneOptions),
+        desc("Path to a profile of MatMul lowering parameters created by the auto-tuner "
+             "(scripts/tuning/tune-matmul.py). For value types and shape classes found in the profile, the tuned "
+             "parameters take precedence over the other MatMul options."));
 
     static opt<bool> performHybridCodegen("mlir-hybrid-codegen", cat(daphneOptions),
                                           desc("Enables prototypical hybrid code generation combining "
                                                "pre-compiled kernels and MLIR code generation."));
+    static opt<bool> mlirCodegenParallel("mlir-codegen-parallel", cat(daphneOptions),
+                                         desc("Executes the outermost parallel loops of the code generated by "
+                                              "--mlir-codegen on multiple threads using OpenMP."));
     static opt<string> kernelExt("kernel-ext", cat(daphneOptions),
                                  desc("Additional kernel extension to register "
                                       "(path to a kernel catalog JSON file)."));
@@ -384,6 +494,8 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
     user_config.use_obj_ref_mgnt = !noObjRefMgnt;
     user_config.use_ipa_const_propa = !noIPAConstPropa;
     user_config.use_phy_op_selection = !noPhyOpSelection;
+    user_config.use_async_read = asyncRead;
+    user_config.use_adaptive_matrix_repr = !noAdaptiveMatrixRepr;
     user_config.use_mlir_codegen = mlirCodegen;
     user_config.matmul_vec_size_bits = matmul_vec_size_bits;
     user_config.matmul_tile = matmul_tile;
@@ -391,6 +503,8 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
     user_config.matmul_unroll_jam_factor = matmul_unroll_jam_factor;
     user_config.matmul_num_vec_registers = matmul_num_vec_registers;
     user_config.matmul_invert_loops = matmul_invert_loops;
+    if (!matmul_tuning_profile.getValue().empty())
+        user_config.matmul_tuning_profile = matmul_tuning_profile.getValue();
     if (matmul_fixed_tile_sizes.size() > 0) {
         user_config.matmul_use_fixed_tile_sizes = true;
         user_config.matmul_fixed_tile_sizes = matmul_fixed_tile_sizes;
@@ -398,6 +512,7 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
         user_config.matmul_tile = true;
     }
     user_config.use_mlir_hybrid_codegen = performHybridCodegen;
+    user_config.use_mlir_codegen_parallel = mlirCodegenParallel;
 
     if (!libDir.getValue().empty())
         user_config.libdir = libDir.getValue();
@@ -427,6 +542,11 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
             spdlog::warn("No backend has been selected. Wiil use the default 'MPI'");
     }
     user_config.max_distributed_serialization_chunk_size = maxDistrChunkSize;
+    user_config.distributed_compression = distrCompression;
+    if (dbdfVersion != 1 && dbdfVersion != 2)
+        throw std::runtime_error("unsupported --dbdf-version: " + std::to_string(dbdfVersion));
+    user_config.dbdf_version = dbdfVersion;
+    user_config.dbdf_compression = dbdfCompression;
 
     // only overwrite with non-defaults
     if (use_hdfs) {
@@ -448,6 +568,12 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
                                  "not build with --hdfs option\n");
     }
 #endif
+#ifndef USE_CODEGEN_OPENMP
+    if (user_config.use_mlir_codegen_parallel) {
+        throw std::runtime_error("you are trying to use --mlir-codegen-parallel, but Daphne was "
+                                 "built without LLVM's OpenMP runtime (libomp)\n");
+    }
+#endif
 
     for (auto explain : explainArgList) {
         switch (explain) {
@@ -562,71 +688,120 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
     // Create DaphneIrExecutor and get MLIR context
     // ************************************************************************
 
-    // Creates an MLIR context and loads the required MLIR dialects.
-    DaphneIrExecutor executor(selectMatrixRepr, user_config);
+    // In a DaphneLib session, the executor is created for the first script
+    // and reused for all later ones.
+    std::unique_ptr<DaphneIrExecutor> ownExecutor;
+    if (session)
+        user_config.resident_objects = &session->residentObjects;
+    if (!session || !session->executor) {
+        // Creates an MLIR context and loads the required MLIR dialects.
+        ownExecutor = std::make_unique<DaphneIrExecutor>(selectMatrixRepr, user_config);
+
+        // Populate kernel extension catalog.
+        KernelCatalog &kc = ownExecutor->getUserConfig().kernelCatalog;
+        // kc.dump();
+        KernelCatalogParser kcp(ownExecutor->getContext());
+        kcp.parseKernelCatalog(user_config.libdir + "/catalog.json", kc);
+        if (user_config.use_cuda)
+            kcp.parseKernelCatalog(user_config.libdir + "/CUDAcatalog.json", kc);
+        // kc.dump();
+        if (!kernelExt.empty())
+            kcp.parseKernelCatalog(kernelExt, kc);
+
+        if (session) {
+            // The compiled code refers to the executor's copy of the user
+            // config, so this is where the session's context must be found.
+            DaphneUserConfig &sessionConfig = ownExecutor->getUserConfig();
+            session->context = std::make_unique<DaphneContext>(sessionConfig, KernelDispatchMapping::instance(),
+                                                               Statistics::instance(), StringRefCounter::instance());
+            sessionConfig.session_context = session->context.get();
+            session->executor = std::move(ownExecutor);
+        }
+    }
+    DaphneIrExecutor &executor = session ? *session->executor : *ownExecutor;
     mlir::MLIRContext *mctx = executor.getContext();
 
-    // ************************************************************************
-    // Populate kernel extension catalog
-    // ************************************************************************
-
-    KernelCatalog &kc = executor.getUserConfig().kernelCatalog;
-    // kc.dump();
-    KernelCatalogParser kcp(mctx);
-    kcp.parseKernelCatalog(user_config.libdir + "/catalog.json", kc);
-    if (user_config.use_cuda)
-        kcp.parseKernelCatalog(user_config.libdir + "/CUDAcatalog.json", kc);
-    // kc.dump();
-    if (!kernelExt.empty())
-        kcp.parseKernelCatalog(kernelExt, kc);
-
     // ************************************************************************
     // Parse, compile and execute DaphneDSL script
     // ************************************************************************
 
     clock::time_point tpBegPars = clock::now();
 
-    // Create an OpBuilder and an MLIR module and set the builder's insertion
-    // point to the module's body, such that subsequently created DaphneIR
-    // operations are inserted into the module.
-    OpBuilder builder(mctx);
-    auto loc = mlir::FileLineColLoc::get(builder.getStringAttr(inputFile), 0, 0);
-    auto moduleOp = ModuleOp::create(loc);
-    auto *body = moduleOp.getBody();
-    builder.setInsertionPoint(body, body->begin());
-
-    // Parse the input file and generate the corresponding DaphneIR operations
-    // inside the module, assuming DaphneDSL as the input format.
-    DaphneDSLParser parser(scriptArgsFinal, user_config);
-    try {
-        parser.parseFile(builder, inputFile);
-    } catch (std::exception &e) {
-        logErrorDaphneLibAware(daphneLibRes, "While parsing: " + std::string(e.what()));
-        return StatusCode::PARSER_ERROR;
+    // In a DaphneLib session, a script that was compiled before is only
+    // executed again.
+    std::string cacheKey;
+    mlir::ExecutionEngine *engine = nullptr;
+    if (session) {
+        cacheKey = session->getCacheKey(inputFile, scriptArgsFinal);
+        engine = session->getCompiledScript(cacheKey);
+        if (engine)
+            session->numCacheHits++;
     }
 
-    clock::time_point tpBegComp = clock::now();
-
-    // Further, process the module, including optimization and lowering passes.
-    try {
-        if (!executor.runPasses(moduleOp)) {
+    clock::time_point tpBegComp = tpBegPars;
+    ModuleOp moduleOp;
+    bool cacheable = !cacheKey.empty();
+    if (!engine) {
+        // Create an OpBuilder and an MLIR module and set the builder's
+        // insertion point to the module's body, such that subsequently created
+        // DaphneIR operations are inserted into the module.
+        OpBuilder builder(mctx);
+        auto loc = mlir::FileLineColLoc::get(builder.getStringAttr(inputFile), 0, 0);
+        moduleOp = ModuleOp::create(loc);
+        auto *body = moduleOp.getBody();
+        builder.setInsertionPoint(body, body->begin());
+
+        // Parse the input file and generate the corresponding DaphneIR
+        // operations inside the module, assuming DaphneDSL as the input format.
+        DaphneDSLParser parser(scriptArgsFinal, user_config);
+        try {
+            parser.parseFile(builder, inputFile);
+        } catch (std::exception &e) {
+            logErrorDaphneLibAware(daphneLibRes, "While parsing: " + std::string(e.what()));
+            return StatusCode::PARSER_ERROR;
+        }
+        // Scripts reading files are not cached, since the compiled code
+        // depends on the files' meta data. Neither are scripts importing
+        // other scripts, which can change without changing the cache key.
+        // Imported operations are located in the imported file.
+        moduleOp.walk([&](Operation *op) {
+            if (llvm::isa<daphne::ReadOp>(op))
+                cacheable = false;
+            else if (auto fileLoc = op->getLoc().dyn_cast<FileLineColLoc>())
+                if (fileLoc.getFilename() != inputFile)
+                    cacheable = false;
+        });
+
+        tpBegComp = clock::now();
+
+        // Further, process the module, including optimization and lowering
+        // passes.
+        try {
+            if (!executor.runPasses(moduleOp)) {
+                return StatusCode::PASS_ERROR;
+            }
+        } catch (std::exception &e) {
+            logErrorDaphneLibAware(daphneLibRes, "Lowering pipeline error.{}\nPassManager failed module lowering, "
+                                                 "responsible IR written to module_fail.log.\n" +
+                                                     std::string(e.what()));
+            return StatusCode::PASS_ERROR;
+        } catch (...) {
+            logErrorDaphneLibAware(daphneLibRes, "Lowering pipeline error: Unknown exception");
             return StatusCode::PASS_ERROR;
         }
-    } catch (std::exception &e) {
-        logErrorDaphneLibAware(daphneLibRes, "Lowering pipeline error.{}\nPassManager failed module lowering, "
-                                             "responsible IR written to module_fail.log.\n" +
-                                                 std::string(e.what()));
-        return StatusCode::PASS_ERROR;
-    } catch (...) {
-        logErrorDaphneLibAware(daphneLibRes, "Lowering pipeline error: Unknown exception");
-        return StatusCode::PASS_ERROR;
     }
 
     // JIT-compile the module and execute it.
     // module->dump(); // print the LLVM IR representation
     clock::time_point tpBegExec;
+    std::unique_ptr<mlir::ExecutionEngine> ownEngine;
     try {
-        auto engine = executor.createExecutionEngine(moduleOp);
+        if (!engine) {
+            ownEngine = executor.createExecutionEngine(moduleOp);
+            engine = ownEngine.get();
+            if (session && cacheable)
+                session->addCompiledScript(cacheKey, std::move(ownEngine));
+        }
         tpBegExec = clock::now();
 
         // set jump address for catching exceptions in kernel libraries via
@@ -676,7 +851,8 @@ int startDAPHNE(int argc, const char **argv, DaphneLibResult *daphneLibRes, int
 
     // explicitly destroying the moduleOp here due to valgrind complaining about
     // a memory leak otherwise.
-    moduleOp->destroy();
+    if (moduleOp)
+        moduleOp->destroy();
     return StatusCode::SUCCESS;
 }
 
@@ -687,7 +863,7 @@ int mainInternal(int argc, const char **argv, DaphneLibResult *daphneLibRes) {
     // Initialize user configuration.
     DaphneUserConfig user_config{};
 
-    int res = startDAPHNE(argc, argv, daphneLibRes, &id, user_config);
+    int res = startDAPHNE(argc, argv, daphneLibRes, &id, user_config, nullptr);
 
 #ifdef USE_MPI
     if (id == COORDINATOR) {
@@ -708,3 +884,21 @@ int mainInternal(int argc, const char **argv, DaphneLibResult *daphneLibRes) {
 
     return res;
 }
+
+DaphneSession *createDaphneSession() { return new DaphneSession(); }
+
+int runInDaphneSession(DaphneSession *session, int argc, const char **argv, DaphneLibResult *daphneLibRes) {
+    // The distributed runtime is not supported in sessions, so the MPI rank is
+    // not needed.
+    int id = -1;
+    DaphneUserConfig user_config{};
+    return startDAPHNE(argc, argv, daphneLibRes, &id, user_config, session);
+}
+
+bool dropDaphneSessionResident(DaphneSession *session, const char *name) {
+    return session->residentObjects.drop(name);
+}
+
+size_t getDaphneSessionNumCacheHits(const DaphneSession *session) { return session->numCacheHits; }
+
+void destroyDaphneSession(DaphneSession *session) { delete session; }
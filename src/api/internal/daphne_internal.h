@@ -18,4 +18,34 @@
 
 #include <api/daphnelib/DaphneLibResult.h>
 
-int mainInternal(int argc, const char **argv, DaphneLibResult *daphneLibRes);
\ No newline at end of file
+#include <cstddef>
+
+int mainInternal(int argc, const char **argv, DaphneLibResult *daphneLibRes);
+
+/**
+ * @brief The state kept between the scripts DaphneLib runs in one session
+ * (see daphne_internal.cpp).
+ */
+struct DaphneSession;
+
+DaphneSession *createDaphneSession();
+
+/**
+ * @brief Like `mainInternal()`, but reuses the compiler, the `DaphneContext`,
+ * compiled scripts, and resident data objects of the given session.
+ */
+int runInDaphneSession(DaphneSession *session, int argc, const char **argv, DaphneLibResult *daphneLibRes);
+
+/**
+ * @brief Releases the resident data object of the given name, returns `false`
+ * if there is none.
+ */
+bool dropDaphneSessionResident(DaphneSession *session, const char *name);
+
+/**
+ * @brief Returns the number of scripts run in the given session that reused
+ * previously compiled code.
+ */
+size_t getDaphneSessionNumCacheHits(const DaphneSession *session);
+
+void destroyDaphneSession(DaphneSession *session);
\ No newline at end of file
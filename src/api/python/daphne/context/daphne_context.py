@@ -33,6 +33,8 @@ from daphne.operator.nodes.do_while_loop import DoWhileLoop
 from daphne.operator.nodes.multi_return import MultiReturn
 from daphne.operator.operation_node import OperationNode
 from daphne.utils.consts import VALID_INPUT_TYPES, VALID_COMPUTED_TYPES, TMP_PATH, F64, F32, SI64, SI32, SI8, UI64, UI32, UI8
+from daphne.utils.arrow import to_record_batch, record_batch_vtcs
+from daphne.utils.daphnelib import DaphneLib
 
 import numpy as np
 import pandas as pd
@@ -44,15 +46,78 @@ try:
     import tensorflow as tf
 except ImportError as e:
     tf = e
+try:
+    import pyarrow as pa
+except ImportError as e:
+    pa = e
 
+import ctypes
 import time
 from typing import Sequence, Dict, Union, List, Callable, Tuple, Optional, Iterable
 
+def _categorical_values(col: pd.Series) -> pd.Series:
+    """Replaces the codes of a categorical column by its values.
+    Missing values become NaN, like for integer columns with missing values transferred via Arrow.
+    """
+    if col.isna().any():
+        return col.astype("float64")
+    return col.astype(col.cat.categories.dtype)
+
 class DaphneContext(object):
     _functions: dict
+    _session: Optional[int]
     
-    def __init__(self):
+    def __init__(self, session: bool = False):
+        """
+        :param session: If `True`, all scripts run by this context share one
+            DAPHNE session, which keeps the compiled scripts and the resident
+            data objects (see `storeResident()`) between calls to `compute()`.
+            The session is released by `close()`.
+        """
         self._functions = dict()
+        self._session = DaphneLib.createSession() if session else None
+
+    def close(self) -> None:
+        """Releases the DAPHNE session of this context (if any), including all resident data objects."""
+        if self._session is not None:
+            DaphneLib.destroySession(self._session)
+            self._session = None
+
+    def __del__(self):
+        # The module globals might already be gone at interpreter shutdown.
+        if DaphneLib is not None and getattr(self, "_session", None) is not None:
+            self.close()
+
+    def loadResidentMatrix(self, name: str) -> Matrix:
+        """Refers to a matrix kept in the session by `storeResident()` in an earlier call to `compute()`.
+        :param name: The name of the resident matrix.
+        :return: The resident matrix.
+        """
+        return Matrix(self, 'loadResident', ['\"'+name+'\"'])
+
+    def loadResidentFrame(self, name: str) -> Frame:
+        """Refers to a frame kept in the session by `storeResident()` in an earlier call to `compute()`.
+        :param name: The name of the resident frame.
+        :return: The resident frame.
+        """
+        return Frame(self, 'loadResident', ['\"'+name+'\"'])
+
+    def dropResident(self, name: str) -> bool:
+        """Releases the resident data object of the given name.
+        :param name: The name of the resident data object.
+        :return: `False` if there was no resident data object of that name.
+        """
+        if self._session is None:
+            raise RuntimeError("resident data objects are only available in a DaphneContext with a session")
+        return DaphneLib.dropResident(self._session, ctypes.c_char_p(str.encode(name)))
+
+    def sessionCacheHits(self) -> int:
+        """Returns how many calls to `compute()` in the session of this context reused a compiled script.
+        :return: The number of reused compiled scripts.
+        """
+        if self._session is None:
+            raise RuntimeError("compiled scripts are only reused in a DaphneContext with a session")
+        return DaphneLib.getSessionCacheHits(self._session)
 
     def readMatrix(self, file: str) -> Matrix:
         """Reads a matrix from a file.
@@ -139,12 +204,15 @@ class DaphneContext(object):
 
         return (res, original_shape) if return_shape else res
 
-    def from_pandas(self, df: pd.DataFrame, shared_memory=True, verbose=False, keepIndex=False) -> Frame:
+    def from_pandas(self, df: pd.DataFrame, shared_memory=True, verbose=False, keepIndex=False,
+                    categorical_codes=False) -> Frame:
         """Generates a `DAGNode` representing a frame with data given by a pandas `DataFrame`.
         :param df: The pandas DataFrame.
         :param shared_memory: Whether to use shared memory data transfer (True) or not (False).
         :param verbose: Whether the execution time and further information should be output to the console.
         :param keepIndex: Whether the frame should keep its index from pandas within DAPHNE
+        :param categorical_codes: Whether categorical columns are transferred as their codes (True) or as their
+            values (False).
         :return: A Frame
         """
 
@@ -167,14 +235,33 @@ class DaphneContext(object):
         elif isinstance(df.dtypes, pd.SparseDtype) or any(isinstance(item, pd.SparseDtype) for item in df.dtypes):
             # Convert sparse DataFrame to standard DataFrame.
             df = df.sparse.to_dense()
-        elif df.select_dtypes(include=["category"]).shape[1] > 0:
-            # Convert categorical DataFrame to standard DataFrame.
-            df = df.apply(lambda x: x.cat.codes if x.dtype.name == "category" else x)
+
+        if df.select_dtypes(include=["category"]).shape[1] > 0:
+            if categorical_codes:
+                df = df.apply(lambda x: x.cat.codes if x.dtype.name == "category" else x)
+            elif shared_memory and isinstance(pa, ImportError):
+                # Convert categorical DataFrame to standard DataFrame.
+                # With pyarrow, categorical columns are transferred as dictionary-encoded columns instead,
+                # and files contain the values anyway.
+                df = df.apply(lambda x: _categorical_values(x) if x.dtype.name == "category" else x)
 
         if verbose:
             print(f"from_pandas(): Python-side type-check execution time: {(time.time() - start_time):.10f} seconds")
            
-        if shared_memory: # data transfer via shared memory
+        if shared_memory and not isinstance(pa, ImportError): # data transfer via the Arrow C data interface
+            # Numeric columns without missing values are shared with DAPHNE, string columns are copied.
+            batch = to_record_batch(df)
+            vtcs = record_batch_vtcs(batch)
+            labels = [f'"{label}"' for label in batch.schema.names]
+
+            if verbose:
+                print(f"from_pandas(): total Python-side execution time: {(time.time() - start_time):.10f} seconds")
+
+            # The batch is exported anew (to the addresses given as 0 here) whenever a script using the frame is built.
+            return Frame(self, 'receiveFromArrow', unnamed_input_nodes=[0, 0, *vtcs, *labels], local_data=df,
+                         record_batch=batch)
+
+        elif shared_memory: # data transfer via shared memory
             # Convert DataFrame and labels to column arrays and label arrays.
             args = []
 
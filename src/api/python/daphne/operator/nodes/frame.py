@@ -28,6 +28,7 @@ from daphne.operator.nodes.scalar import Scalar
 from daphne.operator.nodes.matrix import Matrix
 from daphne.script_building.dag import OutputType
 from daphne.utils.consts import VALID_INPUT_TYPES, VALID_ARITHMETIC_TYPES, BINARY_OPERATIONS, TMP_PATH
+from daphne.utils.arrow import ArrowExport
 
 import pandas as pd
 
@@ -42,12 +43,13 @@ if TYPE_CHECKING:
 class Frame(OperationNode):
     _pd_dataframe: pd.DataFrame
     _column_names: Optional[List[str]] = None
+    _arrow_export: Optional[ArrowExport] = None
 
     def __init__(self, daphne_context: "DaphneContext", operation: str,
                  unnamed_input_nodes: Union[str, Iterable[VALID_INPUT_TYPES]] = None,
                  named_input_nodes: Dict[str, VALID_INPUT_TYPES] = None,
                  local_data: pd.DataFrame = None, brackets: bool = False, 
-                 column_names: Optional[List[str]] = None) -> "Frame":
+                 column_names: Optional[List[str]] = None, record_batch=None) -> "Frame":
         is_python_local_data = False
         if local_data is not None:
             self._pd_dataframe = local_data
@@ -56,11 +58,18 @@ class Frame(OperationNode):
             self._pd_dataframe = None
 
         self._column_names = column_names
+        self._record_batch = record_batch
 
         super().__init__(daphne_context, operation, unnamed_input_nodes,
                          named_input_nodes, OutputType.FRAME, is_python_local_data, brackets)
 
     def code_line(self, var_name: str, unnamed_input_vars: Sequence[str], named_input_vars: Dict[str, str]) -> str:
+        # DAPHNE takes over the exported record batch, so it is exported for each script.
+        if self.operation == "receiveFromArrow":
+            self._arrow_export = ArrowExport(self._record_batch)
+            unnamed_input_vars = [str(self._arrow_export.array_address), str(self._arrow_export.schema_address),
+                                  *unnamed_input_vars[2:]]
+
         code_line = super().code_line(var_name, unnamed_input_vars, named_input_vars).format(file_name=var_name, TMP_PATH = TMP_PATH) 
         
         # Save temporary CSV file, if the operation is "readFrame".
@@ -202,3 +211,9 @@ class Frame(OperationNode):
 
     def write(self, file: str) -> 'OperationNode':
         return OperationNode(self.daphne_context, 'writeFrame', [self,'\"'+file+'\"'], output_type=OutputType.NONE)
+
+    def storeResident(self, name: str) -> 'OperationNode':
+        """Keeps this frame under the given name in the session of the DaphneContext, such that later calls to
+        `compute()` can refer to it by `DaphneContext.loadResidentFrame()` without transferring it to Python.
+        """
+        return OperationNode(self.daphne_context, 'storeResident', [self,'\"'+name+'\"'], output_type=OutputType.NONE)
@@ -474,6 +474,12 @@ class Matrix(OperationNode):
     
     def print(self):
         return OperationNode(self.daphne_context,'print',[self], output_type=OutputType.NONE)
+
+    def storeResident(self, name: str) -> 'OperationNode':
+        """Keeps this matrix under the given name in the session of the DaphneContext, such that later calls to
+        `compute()` can refer to it by `DaphneContext.loadResidentMatrix()` without transferring it to Python.
+        """
+        return OperationNode(self.daphne_context, 'storeResident', [self,'\"'+name+'\"'], output_type=OutputType.NONE)
     
     def asType(self, dtype=None, vtype=None):
         # TODO We import Frame here (not at the top of the file) to avoid a circular import.
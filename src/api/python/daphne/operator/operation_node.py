@@ -25,6 +25,7 @@ from daphne.script_building.dag import DAGNode, OutputType
 from daphne.script_building.script import DaphneDSLScript
 from daphne.utils.consts import BINARY_OPERATIONS, TMP_PATH, VALID_INPUT_TYPES, F64, F32, SI64, SI32, SI8, UI64, UI32, UI8
 from daphne.utils.daphnelib import DaphneLib, DaphneLibResult
+from daphne.utils.arrow import receive_frame
 from daphne.utils.helpers import create_params_string
 
 import numpy as np
@@ -133,47 +134,14 @@ class OperationNode(DAGNode):
                 if verbose:
                     dt_start_time = time.time()
 
-                daphneLibResult = DaphneLib.getResult()
-                
-                # Read the frame's address into a numpy array.
-                if daphneLibResult.columns is not None:
-                    # Read the column labels and dtypes from the Frame's labels and dtypes directly.
-                    labels = [ctypes.cast(daphneLibResult.labels[i], ctypes.c_char_p).value.decode() for i in range(daphneLibResult.cols)]
-                    
-                    # Create a new type representing an array of value type codes.
-                    VTArray = ctypes.c_int64 * daphneLibResult.cols
-                    # Cast the pointer to this type and access its contents.
-                    vtcs_array = ctypes.cast(daphneLibResult.vtcs, ctypes.POINTER(VTArray)).contents
-                    # Convert the value types into numpy dtypes.
-                    dtypes = [self.getNumpyType(vtc) for vtc in vtcs_array]
-
-                    data = {label: None for label in labels}
+                # Take over the frame exported through the Arrow C data interface.
+                df = receive_frame()
 
-                    # Using ctypes cast and numpy array view to create dictionary directly.
-                    for idx in range(daphneLibResult.cols):
-                        c_data_type = self.getType(daphneLibResult.vtcs[idx])
-                        array_view = np.ctypeslib.as_array(
-                            ctypes.cast(daphneLibResult.columns[idx], ctypes.POINTER(c_data_type)),
-                            shape=[daphneLibResult.rows]
-                        )
-                        label = labels[idx]
-                        data[label] = array_view
+                # If useIndexColumn is True, set "index" column as the DataFrame's index
+                # TODO What if there is no column named "index"?
+                if useIndexColumn and "index" in df.columns:
+                    df.set_index("index", inplace=True, drop=True)
 
-                    # Create DataFrame from dictionary.
-                    df = pd.DataFrame(data, copy=False)
-
-                    # If useIndexColumn is True, set "index" column as the DataFrame's index
-                    # TODO What if there is no column named "index"?
-                    if useIndexColumn and "index" in df.columns:
-                        df.set_index("index", inplace=True, drop=True)
-                else:
-                    # TODO Raise an error.
-                    # TODO When does this happen?
-                    print("Error: NULL pointer access")
-                    labels = []
-                    dtypes = []
-                    df = pd.DataFrame()
-                
                 result = df
                 self.clear_tmp()
 
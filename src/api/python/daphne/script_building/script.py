@@ -95,7 +95,12 @@ class DaphneDSLScript:
         temp_out_file.close()
         
         #os.environ['OPENBLAS_NUM_THREADS'] = '1'
-        res = DaphneLib.daphne(ctypes.c_char_p(str.encode(PROTOTYPE_PATH)), ctypes.c_char_p(str.encode(temp_out_path)))
+        session = self.daphne_context._session
+        if session is not None:
+            res = DaphneLib.runInSession(session, ctypes.c_char_p(str.encode(PROTOTYPE_PATH)),
+                                         ctypes.c_char_p(str.encode(temp_out_path)))
+        else:
+            res = DaphneLib.daphne(ctypes.c_char_p(str.encode(PROTOTYPE_PATH)), ctypes.c_char_p(str.encode(temp_out_path)))
         if res != 0:
             # Error message with DSL code line.
             error_message = DaphneLib.getResult().error_message.decode("utf-8")
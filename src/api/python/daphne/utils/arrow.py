@@ -0,0 +1,155 @@
+# Copyright 2024 The DAPHNE Consortium
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Exchange of frames with DAPHNE through the Arrow C data interface.
+
+Sending a pandas DataFrame to DAPHNE requires pyarrow, receiving a frame from
+DAPHNE does not.
+"""
+
+from daphne.utils.consts import F64, F32, SI64, SI32, SI8, UI64, UI32, UI8, STR
+from daphne.utils.daphnelib import DaphneLib, ArrowArray, ArrowSchema
+
+import numpy as np
+import pandas as pd
+try:
+    import pyarrow as pa
+except ImportError as e:
+    pa = e
+
+import ctypes
+
+# The numeric Arrow formats DAPHNE exports, see ArrowCData::formatFor().
+_FORMAT_CTYPES = {
+    "g": ctypes.c_double,
+    "f": ctypes.c_float,
+    "l": ctypes.c_int64,
+    "i": ctypes.c_int32,
+    "c": ctypes.c_int8,
+    "L": ctypes.c_uint64,
+    "I": ctypes.c_uint32,
+    "C": ctypes.c_uint8,
+}
+
+class _Released:
+    """Owns a struct of the Arrow C data interface and releases it when garbage collected."""
+
+    def __init__(self, struct):
+        self.struct = struct
+
+    def __del__(self):
+        if self.struct.release:
+            self.struct.release(ctypes.byref(self.struct))
+
+class ArrowExport:
+    """A pyarrow record batch exported through the Arrow C data interface.
+
+    DAPHNE takes over the array and the schema when it imports them. If that
+    does not happen (e.g., because the script failed), they are released when
+    this object is garbage collected.
+    """
+
+    def __init__(self, batch: "pa.RecordBatch"):
+        self._array = _Released(ArrowArray())
+        self._schema = _Released(ArrowSchema())
+        batch._export_to_c(self.array_address, self.schema_address)
+
+    @property
+    def array_address(self) -> int:
+        return ctypes.addressof(self._array.struct)
+
+    @property
+    def schema_address(self) -> int:
+        return ctypes.addressof(self._schema.struct)
+
+def _arrow_vtc(arrow_type, has_nulls: bool) -> int:
+    # Mirrors ArrowCData::valueTypeCodeFor(), which determines the types of
+    # the columns DAPHNE imports.
+    if pa.types.is_float64(arrow_type):
+        return F64
+    if pa.types.is_float32(arrow_type):
+        return F32
+    if pa.types.is_string(arrow_type) or pa.types.is_large_string(arrow_type):
+        return STR
+    if pa.types.is_int8(arrow_type):
+        vtc = SI8
+    elif pa.types.is_int16(arrow_type) or pa.types.is_int32(arrow_type):
+        vtc = SI32
+    elif pa.types.is_int64(arrow_type):
+        vtc = SI64
+    elif pa.types.is_uint8(arrow_type) or pa.types.is_boolean(arrow_type):
+        vtc = UI8
+    elif pa.types.is_uint16(arrow_type) or pa.types.is_uint32(arrow_type):
+        vtc = UI32
+    elif pa.types.is_uint64(arrow_type):
+        vtc = UI64
+    else:
+        raise TypeError(f"unsupported Arrow type: {arrow_type}")
+    # DAPHNE has no nulls, integers with nulls become floating-point numbers with NaN.
+    return F64 if has_nulls else vtc
+
+def record_batch_vtcs(batch: "pa.RecordBatch") -> list:
+    """Returns the DAPHNE value type codes of the columns DAPHNE imports the given record batch as."""
+    vtcs = []
+    for field, column in zip(batch.schema, batch.columns):
+        if pa.types.is_dictionary(field.type):
+            has_nulls = column.null_count > 0 or column.dictionary.null_count > 0
+            vtc = _arrow_vtc(field.type.value_type, has_nulls)
+        else:
+            vtc = _arrow_vtc(field.type, column.null_count > 0)
+        vtcs.append(vtc)
+    return vtcs
+
+def to_record_batch(df: pd.DataFrame) -> "pa.RecordBatch":
+    """Converts a pandas DataFrame into a pyarrow record batch, without copying numeric columns."""
+    if isinstance(pa, ImportError):
+        raise pa
+    return pa.RecordBatch.from_pandas(df, preserve_index=False)
+
+def receive_frame() -> pd.DataFrame:
+    """Takes over the frame result of the last DaphneLib invocation as a pandas DataFrame.
+
+    Numeric columns are numpy views on the memory of the DAPHNE frame, which
+    is released once all of them have been garbage collected.
+    """
+    array = ArrowArray()
+    schema = ArrowSchema()
+    DaphneLib.getFrameResult(ctypes.byref(array), ctypes.byref(schema))
+    owner = _Released(array)
+    # The schema is released when this function returns.
+    schema_owner = _Released(schema)
+    if not array.release or not schema.release:
+        # The children of a released array must not be accessed anymore.
+        raise RuntimeError("there is no frame result to receive, it was not produced or was already received")
+
+    data = {}
+    for i in range(schema.n_children):
+        child_schema = schema.children[i].contents
+        child = array.children[i].contents
+        label = child_schema.name.decode()
+        fmt = child_schema.format.decode()
+        length = child.length
+        if fmt == "U":
+            offsets = np.ctypeslib.as_array(ctypes.cast(child.buffers[1], ctypes.POINTER(ctypes.c_int64)),
+                                            shape=[length + 1])
+            chars = ctypes.string_at(child.buffers[2], int(offsets[-1]))
+            data[label] = np.array([chars[offsets[r]:offsets[r + 1]].decode() for r in range(length)], dtype=object)
+        elif length == 0:
+            data[label] = np.empty(0, dtype=_FORMAT_CTYPES[fmt])
+        else:
+            buffer = (_FORMAT_CTYPES[fmt] * length).from_address(child.buffers[1])
+            # Keep the DAPHNE frame alive as long as the numpy view exists.
+            buffer._owner = owner
+            data[label] = np.ctypeslib.as_array(buffer)
+    return pd.DataFrame(data, copy=False)
@@ -55,3 +55,4 @@ UI32 = 4
 UI64 = 5
 F32 = 6
 F64 = 7
+STR = 8
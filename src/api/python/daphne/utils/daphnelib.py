@@ -17,6 +17,38 @@ import os
 
 from daphne.utils.consts import PROTOTYPE_PATH, DAPHNELIB_FILENAME
 
+# Python representations of the structs of the Arrow C data interface.
+class ArrowSchema(ctypes.Structure):
+    pass
+
+ArrowSchema._fields_ = [
+    ("format", ctypes.c_char_p),
+    ("name", ctypes.c_char_p),
+    ("metadata", ctypes.c_char_p),
+    ("flags", ctypes.c_int64),
+    ("n_children", ctypes.c_int64),
+    ("children", ctypes.POINTER(ctypes.POINTER(ArrowSchema))),
+    ("dictionary", ctypes.POINTER(ArrowSchema)),
+    ("release", ctypes.CFUNCTYPE(None, ctypes.POINTER(ArrowSchema))),
+    ("private_data", ctypes.c_void_p)
+]
+
+class ArrowArray(ctypes.Structure):
+    pass
+
+ArrowArray._fields_ = [
+    ("length", ctypes.c_int64),
+    ("null_count", ctypes.c_int64),
+    ("offset", ctypes.c_int64),
+    ("n_buffers", ctypes.c_int64),
+    ("n_children", ctypes.c_int64),
+    ("buffers", ctypes.POINTER(ctypes.c_void_p)),
+    ("children", ctypes.POINTER(ctypes.POINTER(ArrowArray))),
+    ("dictionary", ctypes.POINTER(ArrowArray)),
+    ("release", ctypes.CFUNCTYPE(None, ctypes.POINTER(ArrowArray))),
+    ("private_data", ctypes.c_void_p)
+]
+
 # Python representation of the struct DaphneLibResult.
 class DaphneLibResult(ctypes.Structure):
     _fields_ = [
@@ -25,13 +57,25 @@ class DaphneLibResult(ctypes.Structure):
         ("rows", ctypes.c_int64),
         ("cols", ctypes.c_int64),
         ("vtc", ctypes.c_int64),
-        # For frames.
-        ("vtcs", ctypes.POINTER(ctypes.c_int64)),
-        ("labels", ctypes.POINTER(ctypes.c_char_p)),
-        ("columns", ctypes.POINTER(ctypes.c_void_p)),
+        # For frames, exported through the Arrow C data interface.
+        ("frameArray", ArrowArray),
+        ("frameSchema", ArrowSchema),
         # To pass error messages to Python code.
         ("error_message", ctypes.c_char_p)
     ]
 
 DaphneLib = ctypes.CDLL(os.path.join(PROTOTYPE_PATH, DAPHNELIB_FILENAME))
 DaphneLib.getResult.restype = DaphneLibResult
+DaphneLib.getFrameResult.argtypes = [ctypes.POINTER(ArrowArray), ctypes.POINTER(ArrowSchema)]
+DaphneLib.getFrameResult.restype = None
+# Sessions are opaque handles.
+DaphneLib.createSession.argtypes = []
+DaphneLib.createSession.restype = ctypes.c_void_p
+DaphneLib.runInSession.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
+DaphneLib.runInSession.restype = ctypes.c_int
+DaphneLib.dropResident.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+DaphneLib.dropResident.restype = ctypes.c_bool
+DaphneLib.getSessionCacheHits.argtypes = [ctypes.c_void_p]
+DaphneLib.getSessionCacheHits.restype = ctypes.c_size_t
+DaphneLib.destroySession.argtypes = [ctypes.c_void_p]
+DaphneLib.destroySession.restype = None
@@ -31,6 +31,7 @@
 #include "mlir/Conversion/MathToLLVM/MathToLLVM.h"
 #include "mlir/Conversion/ReconcileUnrealizedCasts/ReconcileUnrealizedCasts.h"
 #include "mlir/Conversion/SCFToControlFlow/SCFToControlFlow.h"
+#include "mlir/Conversion/SCFToOpenMP/SCFToOpenMP.h"
 #include "mlir/Conversion/VectorToLLVM/ConvertVectorToLLVM.h"
 #include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Affine/Passes.h"
@@ -47,6 +48,7 @@
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
+#include "mlir/Target/LLVMIR/Dialect/OpenMP/OpenMPToLLVMIRTranslation.h"
 #include "mlir/Transforms/Passes.h"
 #include "llvm/Support/TargetSelect.h"
 
@@ -117,6 +119,18 @@ bool DaphneIrExecutor::runPasses(mlir::ModuleOp module) {
     pm.addNestedPass<mlir::func::FuncOp>(mlir::daphne::createInferencePass());
     pm.addPass(mlir::createCanonicalizerPass());
 
+    // The logical optimization of SQL queries needs the inferred frame labels
+    // and shapes. It re-infers the properties of the functions it rewrites.
+    pm.addNestedPass<mlir::func::FuncOp>(mlir::daphne::createSqlOptPass());
+    if (userConfig_.explain_sql)
+        pm.addPass(mlir::daphne::createPrintIRPass("IR after SQL optimization:"));
+
+    // Reordering chains of matrix multiplications needs the inferred shapes
+    // and sparsities. Without the selection of matrix representations, all
+    // matrices are dense.
+    pm.addNestedPass<mlir::func::FuncOp>(mlir::daphne::createMatMulChainPass(
+        selectMatrixRepresentations_ ? userConfig_.sparsity_threshold : 0.0));
+
     if (selectMatrixRepresentations_) {
         pm.addNestedPass<mlir::func::FuncOp>(mlir::daphne::createSelectMatrixRepresentationsPass(userConfig_));
         pm.addNestedPass<mlir::func::FuncOp>(mlir::createCanonicalizerPass());
@@ -151,6 +165,9 @@ bool DaphneIrExecutor::runPasses(mlir::ModuleOp module) {
     if (userConfig_.use_distributed)
         pm.addPass(mlir::daphne::createDistributePipelinesPass());
 
+    if (userConfig_.use_async_read)
+        pm.addNestedPass<mlir::func::FuncOp>(mlir::daphne::createPrefetchReadsPass());
+
     if (userConfig_.use_mlir_codegen || userConfig_.use_mlir_hybrid_codegen)
         buildCodegenPipeline(pm);
 
@@ -219,6 +236,11 @@ std::unique_ptr<mlir::ExecutionEngine> DaphneIrExecutor::createExecutionEngine(m
     llvm::TargetMachine *targetMachine = nullptr;
     auto optPipeline = mlir::makeOptimizingTransformer(optLevel, sizeLevel, targetMachine);
 
+    // The parallel loops of the code-generated kernels call into the OpenMP
+    // runtime.
+    if (userConfig_.use_mlir_codegen_parallel)
+        usedLibPaths[userConfig_.libdir + "/libomp.so"] = true;
+
     // Determine the actually used kernels libraries.
     std::vector<llvm::StringRef> sharedLibRefs;
     for (auto it = usedLibPaths.begin(); it != usedLibPaths.end(); it++)
@@ -235,6 +257,7 @@ std::unique_ptr<mlir::ExecutionEngine> DaphneIrExecutor::createExecutionEngine(m
         }
 
     registerLLVMDialectTranslation(context_);
+    registerOpenMPDialectTranslation(context_);
     // module.dump();
     mlir::ExecutionEngineOptions options;
     options.llvmModuleBuilder = nullptr;
@@ -273,14 +296,27 @@ void DaphneIrExecutor::buildCodegenPipeline(mlir::PassManager &pm) {
     pm.addPass(mlir::daphne::createTransposeOpLoweringPass());
     pm.addPass(mlir::createInlinerPass());
 
+    // Fuse chains of element-wise operations and trailing aggregations into
+    // single loop nests. To this end, the canonicalizer removes the
+    // conversions of intermediate results to DenseMatrix and back, such
+    // that producers and consumers access the same MemRef, and the loops
+    // must be affine. After fusion, the intermediate results are forwarded
+    // to their uses, which eliminates their MemRefs.
+    pm.addPass(mlir::createCanonicalizerPass());
+    pm.addNestedPass<mlir::func::FuncOp>(mlir::createLinalgGeneralizationPass());
+    pm.addNestedPass<mlir::func::FuncOp>(mlir::createConvertLinalgToAffineLoopsPass());
+    pm.addNestedPass<mlir::func::FuncOp>(mlir::memref::createFoldMemRefAliasOpsPass());
     pm.addNestedPass<mlir::func::FuncOp>(mlir::createLoopFusionPass());
+    pm.addNestedPass<mlir::func::FuncOp>(mlir::createAffineScalarReplacementPass());
+    if (userConfig_.explain_mlir_codegen)
+        pm.addPass(mlir::daphne::createPrintIRPass("IR after loop fusion:"));
 
     if (!userConfig_.use_mlir_hybrid_codegen) {
         pm.addPass(mlir::daphne::createMatMulOpLoweringPass(
             userConfig_.matmul_tile, userConfig_.matmul_vec_size_bits, userConfig_.matmul_fixed_tile_sizes,
             userConfig_.matmul_use_fixed_tile_sizes, userConfig_.matmul_unroll_factor,
             userConfig_.matmul_unroll_jam_factor, userConfig_.matmul_num_vec_registers,
-            userConfig_.matmul_invert_loops));
+            userConfig_.matmul_invert_loops, userConfig_.matmul_tuning_profile));
         if (userConfig_.explain_mlir_codegen)
             pm.addPass(mlir::daphne::createPrintIRPass("IR directly after lowering MatMulOp."));
     }
@@ -300,7 +336,20 @@ void DaphneIrExecutor::buildCodegenPipeline(mlir::PassManager &pm) {
     pm.addPass(mlir::memref::createNormalizeMemRefsPass());
 
     pm.addNestedPass<mlir::func::FuncOp>(mlir::createAffineScalarReplacementPass());
+    if (userConfig_.use_mlir_codegen_parallel) {
+        // Only the outermost parallel loop of a loop nest is executed in
+        // parallel, since nested parallel regions would oversubscribe the
+        // cores. Loops computing a reduction (e.g., AllAgg*Op) qualify, too.
+        auto parallelizePass = mlir::createAffineParallelizePass();
+        if (failed(parallelizePass->initializeOptions("max-nested=1 parallel-reductions=true")))
+            throw std::runtime_error("invalid options for the affine parallelization pass");
+        pm.addNestedPass<mlir::func::FuncOp>(std::move(parallelizePass));
+    }
     pm.addPass(mlir::createLowerAffinePass());
+    if (userConfig_.use_mlir_codegen_parallel)
+        // Parallel loops that cannot be mapped to OpenMP (e.g., due to an
+        // unsupported reduction) are lowered to sequential loops later on.
+        pm.addPass(mlir::createConvertSCFToOpenMPPass());
     mlir::LowerVectorToLLVMOptions lowerVectorToLLVMOptions;
     pm.addPass(mlir::createConvertVectorToLLVMPass(lowerVectorToLLVMOptions));
 
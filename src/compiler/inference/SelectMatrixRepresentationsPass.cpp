@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <compiler/utils/CompilerUtils.h>
 #include <ir/daphneir/Daphne.h>
 #include <ir/daphneir/Passes.h>
 #include <util/ErrorHandler.h>
@@ -23,6 +24,7 @@
 #include <mlir/Pass/Pass.h>
 
 #include <memory>
+#include <vector>
 
 using namespace mlir;
 
@@ -147,12 +149,92 @@ class SelectMatrixRepresentationsPass
         return WalkResult::advance();
     };
 
+    /**
+     * @brief Returns if the left-hand-side argument of the given matrix
+     * multiplication should be converted to a sparse representation at
+     * run-time, if it turns out to be sparse enough.
+     *
+     * This is the case if the sparsity of the argument is unknown at
+     * compile-time (e.g., after reading it from a file), and a sparse kernel
+     * exists for the multiplication (currently only for f64). Matrix-vector
+     * products are excluded, since determining the sparsity and converting
+     * the argument would cost about as much as the product itself.
+     */
+    static bool isAdaptiveMatMulCandidate(daphne::MatMulOp op) {
+        auto lhsTy = op.getLhs().getType().dyn_cast<daphne::MatrixType>();
+        auto rhsTy = op.getRhs().getType().dyn_cast<daphne::MatrixType>();
+        auto resTy = op.getType().dyn_cast<daphne::MatrixType>();
+        if (!lhsTy || !rhsTy || !resTy)
+            return false;
+        if (lhsTy.getSparsity() != -1.0 || lhsTy.getRepresentation() != daphne::MatrixRepresentation::Dense ||
+            rhsTy.getRepresentation() != daphne::MatrixRepresentation::Dense ||
+            resTy.getRepresentation() != daphne::MatrixRepresentation::Dense)
+            return false;
+        if (!lhsTy.getElementType().isF64() || !rhsTy.getElementType().isF64() || !resTy.getElementType().isF64())
+            return false;
+        if (rhsTy.getNumCols() == 1)
+            return false;
+        // The sparse kernel does not support transposed arguments, and a
+        // transposed lhs is handled by the physical operator selection.
+        if (CompilerUtils::constantOrDefault<bool>(op.getTransa(), true) ||
+            CompilerUtils::constantOrDefault<bool>(op.getTransb(), true) ||
+            op.getLhs().getDefiningOp<daphne::TransposeOp>())
+            return false;
+        return true;
+    }
+
+    /**
+     * @brief Replaces the given matrix multiplication by two code paths, one
+     * with a dense and one with a sparse left-hand-side argument, which are
+     * chosen at run-time based on the actual sparsity of the argument.
+     */
+    void insertAdaptiveMatMul(daphne::MatMulOp op) {
+        OpBuilder builder(op);
+        Location loc = op.getLoc();
+        Value lhs = op.getLhs();
+        auto lhsTy = lhs.getType().cast<daphne::MatrixType>();
+
+        Type f64 = builder.getF64Type();
+        Value sparsity = builder.create<daphne::SparsityOp>(loc, f64, lhs);
+        Value threshold = builder.create<daphne::ConstantOp>(loc, static_cast<double>(cfg.sparsity_threshold));
+        Value isSparse = builder.create<daphne::EwLtOp>(loc, f64, sparsity, threshold);
+        Value cond = builder.create<daphne::CastOp>(loc, builder.getI1Type(), isSparse);
+
+        auto ifOp = builder.create<scf::IfOp>(
+            loc, cond,
+            [&](OpBuilder &nested, Location loc) {
+                Type sparseLhsTy = lhsTy.withRepresentation(daphne::MatrixRepresentation::Sparse);
+                Value sparseLhs = nested.create<daphne::CastOp>(loc, sparseLhsTy, lhs);
+                Value res = nested.create<daphne::MatMulOp>(loc, op.getType(), sparseLhs, op.getRhs(), op.getTransa(),
+                                                            op.getTransb());
+                nested.create<scf::YieldOp>(loc, res);
+            },
+            [&](OpBuilder &nested, Location loc) {
+                Operation *denseOp = nested.clone(*op);
+                nested.create<scf::YieldOp>(loc, denseOp->getResult(0));
+            });
+        op.getResult().replaceAllUsesWith(ifOp.getResult(0));
+        op->erase();
+    }
+
   public:
     explicit SelectMatrixRepresentationsPass(const DaphneUserConfig &cfg) : cfg(cfg) {}
 
     void runOnOperation() override {
         func::FuncOp f = getOperation();
         f.walk<WalkOrder::PreOrder>(walkOp);
+
+        // Defer the choice of the representation to run-time where the
+        // sparsity is not known at compile-time.
+        if (cfg.use_adaptive_matrix_repr) {
+            std::vector<daphne::MatMulOp> candidates;
+            f.walk([&](daphne::MatMulOp op) {
+                if (isAdaptiveMatMulCandidate(op))
+                    candidates.push_back(op);
+            });
+            for (daphne::MatMulOp op : candidates)
+                insertAdaptiveMatMul(op);
+        }
         // infer function return types
         // TODO: cast for UDFs?
         f.setType(FunctionType::get(&getContext(), f.getFunctionType().getInputs(),
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief A compact synopsis of the non-zero structure of a matrix for
+ * estimating the sparsity of matrix products.
+ *
+ * This follows the ideas of the MNC (Matrix Non-zero Count) sketch, but
+ * summarizes the row and column histograms of non-zeros by the number of
+ * non-empty rows/columns and the maximum number of non-zeros per row/column,
+ * since the compiler only knows the shape and sparsity of most matrices (and
+ * the exact structure of some, e.g., diagonal matrices). Compared to the
+ * independence assumption, this captures empty rows/columns and the exact
+ * case of at most one non-zero per row of the left-hand-side (or per column
+ * of the right-hand-side) argument, in which no two scalar products collide
+ * in the same output cell. Such structure is also propagated through chains
+ * of matrix multiplications.
+ */
+struct SparsitySketch {
+    double numRows = 0;
+    double numCols = 0;
+    double nnz = 0;
+    double nonEmptyRows = 0;
+    double nonEmptyCols = 0;
+    double maxNnzPerRow = 0;
+    double maxNnzPerCol = 0;
+
+    /**
+     * @brief Creates a sketch for a matrix whose non-zeros are uniformly
+     * distributed.
+     */
+    static SparsitySketch uniform(double numRows, double numCols, double sparsity) {
+        SparsitySketch s;
+        s.numRows = numRows;
+        s.numCols = numCols;
+        s.nnz = sparsity * numRows * numCols;
+        s.nonEmptyRows = numRows * (1.0 - std::pow(1.0 - sparsity, numCols));
+        s.nonEmptyCols = numCols * (1.0 - std::pow(1.0 - sparsity, numRows));
+        // Without information on skew, the maximum is the mean over the
+        // non-empty rows/columns.
+        s.maxNnzPerRow = s.nonEmptyRows > 0 ? s.nnz / s.nonEmptyRows : 0;
+        s.maxNnzPerCol = s.nonEmptyCols > 0 ? s.nnz / s.nonEmptyCols : 0;
+        return s;
+    }
+
+    /**
+     * @brief Creates a sketch for a square diagonal matrix with the given
+     * number of non-zeros.
+     */
+    static SparsitySketch diagonal(double n, double nnz) {
+        SparsitySketch s;
+        s.numRows = n;
+        s.numCols = n;
+        s.nnz = nnz;
+        s.nonEmptyRows = nnz;
+        s.nonEmptyCols = nnz;
+        s.maxNnzPerRow = nnz > 0 ? 1 : 0;
+        s.maxNnzPerCol = nnz > 0 ? 1 : 0;
+        return s;
+    }
+
+    SparsitySketch transposed() const {
+        SparsitySketch s = *this;
+        std::swap(s.numRows, s.numCols);
+        std::swap(s.nonEmptyRows, s.nonEmptyCols);
+        std::swap(s.maxNnzPerRow, s.maxNnzPerCol);
+        return s;
+    }
+
+    double sparsity() const { return numRows > 0 && numCols > 0 ? nnz / (numRows * numCols) : 0; }
+
+    /**
+     * @brief Estimates the sketch of the product `lhs @ rhs`.
+     */
+    static SparsitySketch matMul(const SparsitySketch &lhs, const SparsitySketch &rhs) {
+        const double k = lhs.numCols;
+        SparsitySketch res;
+        res.numRows = lhs.numRows;
+        res.numCols = rhs.numCols;
+        if (k <= 0 || lhs.nnz <= 0 || rhs.nnz <= 0)
+            return res;
+
+        // The number of scalar products, assuming that the non-zeros of the
+        // lhs columns and the rhs rows are spread evenly over the common
+        // dimension.
+        const double products = lhs.nnz * rhs.nnz / k;
+
+        // A row of the result is non-empty if the corresponding lhs row hits
+        // at least one non-empty rhs row (and vice versa for the columns).
+        const double avgNnzPerLhsRow = lhs.nnz / lhs.nonEmptyRows;
+        const double avgNnzPerRhsCol = rhs.nnz / rhs.nonEmptyCols;
+        res.nonEmptyRows =
+            lhs.nonEmptyRows * (1.0 - std::pow(1.0 - std::min(1.0, rhs.nonEmptyRows / k), avgNnzPerLhsRow));
+        res.nonEmptyCols =
+            rhs.nonEmptyCols * (1.0 - std::pow(1.0 - std::min(1.0, lhs.nonEmptyCols / k), avgNnzPerRhsCol));
+        const double cells = res.nonEmptyRows * res.nonEmptyCols;
+
+        if (lhs.maxNnzPerRow <= 1 || rhs.maxNnzPerCol <= 1)
+            // Each output cell receives at most one scalar product.
+            res.nnz = products;
+        else if (cells > 1)
+            // The products fall into the output cells spanned by the non-empty
+            // rows and columns like balls into bins.
+            res.nnz = -cells * std::expm1(products * std::log1p(-1.0 / cells));
+        else
+            res.nnz = products;
+        res.nnz = std::min(res.nnz, cells);
+
+        res.maxNnzPerRow = lhs.maxNnzPerRow <= 1
+                               ? rhs.maxNnzPerRow
+                               : (res.nonEmptyRows > 0 ? std::min(res.numCols, res.nnz / res.nonEmptyRows) : 0);
+        res.maxNnzPerCol = rhs.maxNnzPerCol <= 1
+                               ? lhs.maxNnzPerCol
+                               : (res.nonEmptyCols > 0 ? std::min(res.numRows, res.nnz / res.nonEmptyCols) : 0);
+        return res;
+    }
+};
@@ -15,6 +15,7 @@
  */
 
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "compiler/utils/LoweringUtils.h"
@@ -59,11 +60,14 @@ using namespace mlir;
 
 /**
  * @brief template for lowering fully aggregating functions.
- * Aggregation is initialized with the first value of the input MemRef.
- * A Linalg GenericOp then iterates over the remainder of the first row
- * and the remaining (n-1) x m matrix. The next element as well as the
- * running aggregation result are mapped using the corresponding SI/UI/FOp
- * to update the result.
+ * A nest of affine loops iterates over the rows and columns of the input
+ * MemRef. Each row is aggregated by the inner loop, and the row results are
+ * combined by the outer loop. The running aggregation results start at the
+ * neutral element of the aggregation, are carried by the loops (`iter_args`),
+ * and are updated using the corresponding SI/UI/FOp. Thus, the outer loop can
+ * be recognized as a parallel reduction (see the option
+ * `--mlir-codegen-parallel`), and the producers of the input can be fused
+ * into the loop nest.
  *
  * @param AggOp The target operation this pass aims to rewrite.
  * @param SIOp The binary operation applied along the axis for signed integers.
@@ -72,6 +76,34 @@ using namespace mlir;
  */
 template <typename AggOp, typename SIOp, typename UIOp, typename FOp>
 class AggAllOpLowering : public OpConversionPattern<AggOp> {
+    Value combine(OpBuilder &builder, Location loc, Type matrixElementType, Value lhs, Value rhs) const {
+        if (matrixElementType.isSignedInteger())
+            return builder.create<SIOp>(loc, lhs, rhs).getResult();
+        if (matrixElementType.isUnsignedInteger())
+            return builder.create<UIOp>(loc, lhs, rhs).getResult();
+        return builder.create<FOp>(loc, lhs, rhs).getResult();
+    }
+
+    /**
+     * @brief Creates the neutral element of the aggregation as a signless
+     * value, which the `arith` operations and the reduction analysis work on.
+     */
+    Value identity(OpBuilder &builder, Location loc, Type matrixElementType) const {
+        const bool isFloat = llvm::isa<FloatType>(matrixElementType);
+        const bool isSigned = matrixElementType.isSignedInteger();
+        arith::AtomicRMWKind kind;
+        if constexpr (std::is_same_v<FOp, arith::AddFOp>)
+            kind = isFloat ? arith::AtomicRMWKind::addf : arith::AtomicRMWKind::addi;
+        else if constexpr (std::is_same_v<FOp, arith::MinFOp>)
+            kind = isFloat ? arith::AtomicRMWKind::minf
+                           : (isSigned ? arith::AtomicRMWKind::mins : arith::AtomicRMWKind::minu);
+        else
+            kind = isFloat ? arith::AtomicRMWKind::maxf
+                           : (isSigned ? arith::AtomicRMWKind::maxs : arith::AtomicRMWKind::maxu);
+        Type type = isFloat ? matrixElementType : builder.getIntegerType(matrixElementType.getIntOrFloatBitWidth());
+        return arith::getIdentityValue(kind, type, builder, loc);
+    }
+
   public:
     using OpAdaptor = typename OpConversionPattern<AggOp>::OpAdaptor;
 
@@ -100,100 +132,31 @@ class AggAllOpLowering : public OpConversionPattern<AggOp> {
         MemRefType memRefType = MemRefType::get({numRows, numCols}, matrixElementType);
         auto argMemRef = rewriter.create<daphne::ConvertDenseMatrixToMemRef>(loc, memRefType, adaptor.getArg());
 
-        // Create a singleton Memref to store the running aggregation result in.
-        // This is necessary because Linalg only accepts shaped variadics.
-        // Store first elem of argMemRef into accumulator and then iterate over remainder.
-        Value accumulator = rewriter.create<memref::AllocaOp>(loc, MemRefType::get({1}, matrixElementType));
-        Value initValue = rewriter.create<memref::LoadOp>(loc, argMemRef,
-                                                          ValueRange{rewriter.create<arith::ConstantIndexOp>(loc, 0),
-                                                                     rewriter.create<arith::ConstantIndexOp>(loc, 0)});
-        rewriter.create<memref::StoreOp>(loc, initValue, accumulator,
-                                         ValueRange{rewriter.create<arith::ConstantIndexOp>(loc, 0)});
-
-        SmallVector<AffineMap, 2> indexMap{
-            AffineMap::getMultiDimIdentityMap(2, rewriter.getContext()),
-            AffineMap::get(2, 0, {rewriter.getAffineConstantExpr(0)}, rewriter.getContext())};
-        SmallVector<utils::IteratorType, 2> iterTypes{utils::IteratorType::reduction, utils::IteratorType::reduction};
-
-        // Aggregate over the remainder of the first row of argMemRef before aggregating over the remaining values.
-        SmallVector<OpFoldResult, 2> firstRowOffsets{rewriter.getIndexAttr(0), rewriter.getIndexAttr(1)};
-        SmallVector<OpFoldResult, 2> firstRowSizes{rewriter.getIndexAttr(1), rewriter.getIndexAttr(numCols - 1)};
-        SmallVector<OpFoldResult, 2> firstRowStrides{rewriter.getIndexAttr(1), rewriter.getIndexAttr(1)};
-
-        Value firstRow =
-            rewriter.create<memref::SubViewOp>(loc, argMemRef, firstRowOffsets, firstRowSizes, firstRowStrides);
-
-        rewriter.create<linalg::GenericOp>(
-            loc, TypeRange{}, ValueRange{firstRow}, ValueRange{accumulator}, indexMap, iterTypes,
-            [&](OpBuilder &OpBuilderNested, Location locNested, ValueRange arg) {
-                Value currentElem = OpBuilderNested.create<memref::LoadOp>(
-                    locNested, accumulator, ValueRange{OpBuilderNested.create<arith::ConstantIndexOp>(locNested, 0)});
-                Value nextElem = arg[0];
-                Value runningAgg;
-
-                if (llvm::isa<IntegerType>(matrixElementType)) {
-                    currentElem = convertToSignlessInt(OpBuilderNested, locNested, this->typeConverter, currentElem,
-                                                       matrixElementType);
-                    nextElem = convertToSignlessInt(OpBuilderNested, locNested, this->typeConverter, nextElem,
-                                                    matrixElementType);
-                }
-
-                if (matrixElementType.isSignedInteger()) {
-                    runningAgg = OpBuilderNested.create<SIOp>(locNested, currentElem, nextElem).getResult();
-                } else if (matrixElementType.isUnsignedInteger()) {
-                    runningAgg = OpBuilderNested.create<UIOp>(locNested, currentElem, nextElem).getResult();
-                } else {
-                    runningAgg = OpBuilderNested.create<FOp>(locNested, currentElem, nextElem).getResult();
-                }
-
-                if (llvm::isa<IntegerType>(matrixElementType)) {
-                    runningAgg = this->typeConverter->materializeTargetConversion(OpBuilderNested, locNested,
-                                                                                  matrixElementType, runningAgg);
-                }
-
-                OpBuilderNested.create<linalg::YieldOp>(locNested, runningAgg);
-            });
-
-        SmallVector<OpFoldResult, 2> remainderOffsets{rewriter.getIndexAttr(1), rewriter.getIndexAttr(0)};
-        SmallVector<OpFoldResult, 2> remainderSizes{rewriter.getIndexAttr(numRows - 1), rewriter.getIndexAttr(numCols)};
-        SmallVector<OpFoldResult, 2> remainderStrides{rewriter.getIndexAttr(1), rewriter.getIndexAttr(1)};
-
-        Value remainder =
-            rewriter.create<memref::SubViewOp>(loc, argMemRef, remainderOffsets, remainderSizes, remainderStrides);
-
-        rewriter.create<linalg::GenericOp>(
-            loc, TypeRange{}, ValueRange{remainder}, ValueRange{accumulator}, indexMap, iterTypes,
-            [&](OpBuilder &OpBuilderNested, Location locNested, ValueRange arg) {
-                Value currentElem = OpBuilderNested.create<memref::LoadOp>(
-                    locNested, accumulator, ValueRange{OpBuilderNested.create<arith::ConstantIndexOp>(locNested, 0)});
-                Value nextElem = arg[0];
-                Value runningAgg;
-
-                if (llvm::isa<IntegerType>(matrixElementType)) {
-                    currentElem = convertToSignlessInt(OpBuilderNested, locNested, this->typeConverter, currentElem,
-                                                       matrixElementType);
-                    nextElem = convertToSignlessInt(OpBuilderNested, locNested, this->typeConverter, nextElem,
-                                                    matrixElementType);
-                }
-
-                if (matrixElementType.isSignedInteger()) {
-                    runningAgg = OpBuilderNested.create<SIOp>(locNested, currentElem, nextElem).getResult();
-                } else if (matrixElementType.isUnsignedInteger()) {
-                    runningAgg = OpBuilderNested.create<UIOp>(locNested, currentElem, nextElem).getResult();
-                } else {
-                    runningAgg = OpBuilderNested.create<FOp>(locNested, currentElem, nextElem).getResult();
-                }
-
-                if (llvm::isa<IntegerType>(matrixElementType)) {
-                    runningAgg = this->typeConverter->materializeTargetConversion(OpBuilderNested, locNested,
-                                                                                  matrixElementType, runningAgg);
-                }
-
-                OpBuilderNested.create<linalg::YieldOp>(locNested, runningAgg);
-            });
+        auto rowLoop = rewriter.create<AffineForOp>(loc, 0, numRows, 1,
+                                                    ValueRange{identity(rewriter, loc, matrixElementType)});
+        {
+            OpBuilder::InsertionGuard guard(rewriter);
+            rewriter.setInsertionPointToStart(rowLoop.getBody());
+
+            auto colLoop = rewriter.create<AffineForOp>(loc, 0, numCols, 1,
+                                                        ValueRange{identity(rewriter, loc, matrixElementType)});
+            rewriter.setInsertionPointToStart(colLoop.getBody());
+            Value next = rewriter.create<AffineLoadOp>(
+                loc, argMemRef, ValueRange{rowLoop.getInductionVar(), colLoop.getInductionVar()});
+            if (llvm::isa<IntegerType>(matrixElementType))
+                next = convertToSignlessInt(rewriter, loc, this->typeConverter, next, matrixElementType);
+            rewriter.create<AffineYieldOp>(
+                loc, combine(rewriter, loc, matrixElementType, colLoop.getRegionIterArgs()[0], next));
+
+            rewriter.setInsertionPointAfter(colLoop);
+            rewriter.create<AffineYieldOp>(loc, combine(rewriter, loc, matrixElementType,
+                                                        rowLoop.getRegionIterArgs()[0], colLoop.getResult(0)));
+        }
 
-        rewriter.replaceOp(op, ValueRange{rewriter.create<memref::LoadOp>(
-                                   loc, accumulator, ValueRange{rewriter.create<arith::ConstantIndexOp>(loc, 0)})});
+        Value res = rowLoop.getResult(0);
+        if (llvm::isa<IntegerType>(matrixElementType))
+            res = this->typeConverter->materializeTargetConversion(rewriter, loc, matrixElementType, res);
+        rewriter.replaceOp(op, ValueRange{res});
 
         return success();
     }
@@ -209,19 +172,19 @@ using MaxAllOpLowering = AggAllOpLowering<daphne::AllAggMaxOp, arith::MaxSIOp, a
 
 namespace {
 /**
- * @brief Lowers the daphne::AllAgg operator to a Linalg GenericOp
- * which iterates over a MemRef that is created from the input DenseMatrix
- * and uses a singleton MemRef to store the aggregation result.
+ * @brief Lowers the daphne::AllAgg operator to Affine loops which iterate
+ * over a MemRef that is created from the input DenseMatrix and carry the
+ * aggregation result.
  *
- * This rewrite may enable loop fusion of the GenericOp or lowered Affine
- * loops using the loop fusion pass.
+ * This rewrite may enable loop fusion of the Affine loops using the loop
+ * fusion pass.
  */
 struct AggAllLoweringPass : public PassWrapper<AggAllLoweringPass, OperationPass<ModuleOp>> {
     explicit AggAllLoweringPass() = default;
 
     [[nodiscard]] StringRef getArgument() const final { return "lower-agg"; }
     [[nodiscard]] StringRef getDescription() const final {
-        return "Lowers AllAgg* operators to a Linalg GenericOp and performs "
+        return "Lowers AllAgg* operators to Affine loops and performs "
                "the aggregation on a MemRef which is created from the input "
                "DenseMatrix.";
     }
@@ -85,6 +85,42 @@ struct DistributePipelines : public OpConversionPattern<daphne::VectorizedPipeli
     }
 };
 
+/**
+ * @brief Checks if the outputs of a vectorized pipeline can be collected from
+ * the distributed workers.
+ *
+ * The distributed runtime handles all outputs of a pipeline with one data
+ * type, which must be a DenseMatrix or CSRMatrix of a numeric value type or a
+ * Frame. Sparse matrices and frames can only be combined row-wise.
+ */
+static bool hasDistributableOutputs(daphne::VectorizedPipelineOp op) {
+    auto outputTypes = op.getOutputs().getTypes();
+    if (outputTypes.empty())
+        return false;
+    for (size_t i = 0; i < outputTypes.size(); i++) {
+        Type t = outputTypes[i];
+        if (t != outputTypes[0])
+            return false;
+        const bool rowsCombine =
+            op.getCombines()[i].cast<daphne::VectorCombineAttr>().getValue() == daphne::VectorCombine::ROWS;
+        if (auto matTy = t.dyn_cast<daphne::MatrixType>()) {
+            Type vt = matTy.getElementType();
+            const bool numeric = vt.isF64() || vt.isF32() || vt.isSignedInteger(8) || vt.isSignedInteger(32) ||
+                                 vt.isSignedInteger(64) || vt.isUnsignedInteger(8) || vt.isUnsignedInteger(32) ||
+                                 vt.isUnsignedInteger(64);
+            if (!numeric)
+                return false;
+            if (matTy.getRepresentation() == daphne::MatrixRepresentation::Sparse && !rowsCombine)
+                return false;
+        } else if (t.isa<daphne::FrameType>()) {
+            if (!rowsCombine)
+                return false;
+        } else
+            return false;
+    }
+    return true;
+}
+
 struct DistributePipelinesPass : public PassWrapper<DistributePipelinesPass, OperationPass<ModuleOp>> {
     void runOnOperation() final;
 
@@ -104,10 +140,10 @@ void DistributePipelinesPass::runOnOperation() {
     target.addLegalOp<ModuleOp, func::FuncOp>();
     target.addDynamicallyLegalOp<daphne::VectorizedPipelineOp>([](daphne::VectorizedPipelineOp op) {
         // TODO Carefully decide if this pipeline shall be distributed,
-        // e.g., based on physical input size. For now, all pipelines are
-        // distributed (false means this pipeline is illegal and must be
-        // rewritten).
-        return false;
+        // e.g., based on physical input size. For now, all pipelines whose
+        // outputs the distributed runtime can collect are distributed (false
+        // means this pipeline is illegal and must be rewritten).
+        return !hasDistributableOutputs(op);
     });
 
     patterns.add<DistributePipelines>(&getContext());
@@ -72,6 +72,13 @@ void InsertDaphneContextPass::runOnOperation() {
         builder.create<daphne::CreateFPGAContextOp>(loc);
     }
 #endif
+    if (user_config.use_async_read) {
+        // Only functions starting asynchronous reads need the I/O threads.
+        bool hasReadAsyncOps = false;
+        f.walk([&](daphne::ReadAsyncOp) { hasReadAsyncOps = true; });
+        if (hasReadAsyncOps)
+            builder.create<daphne::CreateIOContextOp>(loc);
+    }
 
     // Insert a DestroyDaphneContextOp as the last operation in the block, but
     // before the block's terminator.
@@ -30,12 +30,14 @@
 #include "mlir/Conversion/LLVMCommon/TypeConverter.h"
 #include "mlir/Conversion/LinalgToStandard/LinalgToStandard.h"
 #include "mlir/Conversion/MemRefToLLVM/MemRefToLLVM.h"
+#include "mlir/Conversion/OpenMPToLLVM/ConvertOpenMPToLLVM.h"
 #include "mlir/Conversion/SCFToControlFlow/SCFToControlFlow.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Func/Transforms/FuncConversions.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/OpenMP/OpenMPDialect.h"
 #include "mlir/Transforms/DialectConversion.h"
 
 #include <iostream>
@@ -706,7 +708,14 @@ class VectorizedPipelineOpLowering : public OpConversionPattern<daphne::Vectoriz
         Operation::result_type_range resultTypes = op->getResultTypes();
         const size_t numRes = op->getNumResults();
 
-        if (numRes > 0) {
+        const bool frameRes =
+            numRes > 0 && llvm::all_of(resultTypes, [](Type t) { return llvm::isa<daphne::FrameType>(t); });
+
+        if (frameRes)
+            // Frames carry their schema at run-time, so all frame results
+            // share the same kernel.
+            callee << "__" << CompilerUtils::mlirTypeToCppTypeName(resultTypes[0], false) << "_variadic__size_t";
+        else if (numRes > 0) {
             // TODO Support individual types for all outputs (see #397).
             // Check if all results have the same type.
             Type mt0 = resultTypes[0].dyn_cast<daphne::MatrixType>().withSameElementTypeAndRepr();
@@ -725,7 +734,10 @@ class VectorizedPipelineOpLowering : public OpConversionPattern<daphne::Vectoriz
 
         mlir::Type operandType;
         std::vector<Value> newOperands;
-        if (numRes > 0) {
+        if (frameRes)
+            // The inputs are passed as `Structure`s anyway.
+            operandType = resultTypes[0];
+        else if (numRes > 0) {
             auto m32type = rewriter.getF32Type();
             auto m64type = rewriter.getF64Type();
             auto msi64type = rewriter.getIntegerType(64, true);
@@ -893,7 +905,7 @@ struct DaphneLowerToLLVMPass : public PassWrapper<DaphneLowerToLLVMPass, Operati
     const DaphneUserConfig &cfg;
 
     void getDependentDialects(DialectRegistry &registry) const override {
-        registry.insert<LLVM::LLVMDialect /*, scf::SCFDialect*/>();
+        registry.insert<LLVM::LLVMDialect, omp::OpenMPDialect /*, scf::SCFDialect*/>();
     }
     void runOnOperation() final;
 };
@@ -924,6 +936,8 @@ void DaphneLowerToLLVMPass::runOnOperation() {
         [&](daphne::HandleType t) { return LLVM::LLVMPointerType::get(IntegerType::get(t.getContext(), 1)); });
     typeConverter.addConversion(
         [&](daphne::FileType t) { return LLVM::LLVMPointerType::get(IntegerType::get(t.getContext(), 1)); });
+    typeConverter.addConversion(
+        [&](daphne::FutureType t) { return LLVM::LLVMPointerType::get(IntegerType::get(t.getContext(), 1)); });
     typeConverter.addConversion(
         [&](daphne::DescriptorType t) { return LLVM::LLVMPointerType::get(IntegerType::get(t.getContext(), 1)); });
     typeConverter.addConversion(
@@ -940,8 +954,12 @@ void DaphneLowerToLLVMPass::runOnOperation() {
     cf::populateControlFlowToLLVMConversionPatterns(typeConverter, patterns);
     populateFuncToLLVMConversionPatterns(typeConverter, patterns);
     populateReturnOpTypeConversionPattern(patterns, typeConverter);
+    // OpenMP operations stem from the parallel loops of code-generated
+    // kernels (see `--mlir-codegen-parallel`).
+    populateOpenMPToLLVMConversionPatterns(typeConverter, patterns);
 
     target.addLegalOp<ModuleOp>();
+    configureOpenMPToLLVMConversionLegality(target, typeConverter);
 
     // for trivial casts no lowering to kernels -> higher benefit
     patterns.insert<CastOpLowering>(&getContext(), 2);
@@ -45,6 +45,16 @@ using namespace mlir;
  *   that decreasing the reference on the new value does not destroy a data
  *   object that is still needed in a surrounding scope, i.e., to prevent
  *   double frees.
+ * - As an exception, a matrix whose last use is initializing a loop-carried
+ *   variable is moved into the loop instead, i.e., the loop takes over the
+ *   reference.
+ *
+ * Finally, the pass marks each `InsertRowOp`, `InsertColOp`, and `TransposeOp`
+ * whose argument is not used afterwards with the attribute `may_reuse_arg`.
+ * The kernel updates such an argument in place if it finds at run-time that
+ * nothing else refers to it. Together with moving matrices into loops, this
+ * allows left-indexing in a loop (e.g., `X[i, ] = ...;`) to update the same
+ * buffer in all iterations instead of copying the matrix each time.
  */
 struct ManageObjRefsPass : public PassWrapper<ManageObjRefsPass, OperationPass<func::FuncOp>> {
     explicit ManageObjRefsPass() {}
@@ -202,6 +212,83 @@ void incRefArgs(Operation &op, OpBuilder &b) {
         incRefIfObj(arg, b);
 }
 
+/**
+ * @brief Returns the `DecRefOp` of the given value directly following the
+ * given operation, or `nullptr` if there is none.
+ *
+ * `processValue()` inserts the `DecRefOp`s of all values whose last use is
+ * the same operation directly after that operation.
+ *
+ * @param op
+ * @param v
+ */
+daphne::DecRefOp findDecRefAfter(Operation *op, Value v) {
+    for (Operation *next = op->getNextNode(); next; next = next->getNextNode()) {
+        auto decRefOp = dyn_cast<daphne::DecRefOp>(next);
+        if (!decRefOp)
+            break;
+        if (decRefOp.getArg() == v)
+            return decRefOp;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Increases the reference counters of the operands of the given loop,
+ * except for matrices whose last use is the loop.
+ *
+ * Such a matrix is moved into the loop instead: we omit its `IncRefOp` and its
+ * `DecRefOp` after the loop, such that the loop-carried variable holds the
+ * only reference to it, already in the first iteration. If the loop is not
+ * entered, the reference is passed on to the loop result.
+ *
+ * @param op
+ * @param b
+ */
+void incRefLoopArgs(Operation &op, OpBuilder &b) {
+    b.setInsertionPoint(&op);
+    for (Value arg : op.getOperands()) {
+        if (llvm::isa<daphne::MatrixType>(arg.getType())) {
+            // The loop must refer to the matrix only once and only through
+            // the loop-carried variable.
+            bool onlyLoopCarried = true;
+            size_t numUsesByLoop = 0;
+            for (OpOperand &use : arg.getUses()) {
+                if (use.getOwner() == &op)
+                    numUsesByLoop++;
+                else if (op.isAncestor(use.getOwner()))
+                    onlyLoopCarried = false;
+            }
+            if (onlyLoopCarried && numUsesByLoop == 1) {
+                if (daphne::DecRefOp decRefOp = findDecRefAfter(&op, arg)) {
+                    decRefOp->erase();
+                    continue;
+                }
+            }
+        }
+        incRefIfObj(arg, b);
+    }
+}
+
+/**
+ * @brief Marks the given `InsertRowOp`, `InsertColOp`, or `TransposeOp` with
+ * the attribute `may_reuse_arg` if its argument is not used afterwards.
+ *
+ * @param op
+ */
+void markReusableArg(Operation *op) {
+    // The workers of a vectorized pipeline may share its inputs.
+    if (op->getParentOfType<daphne::VectorizedPipelineOp>())
+        return;
+    Value arg = op->getOperand(0);
+    // Reading from the argument while updating it is not safe.
+    for (size_t i = 1; i < op->getNumOperands(); i++)
+        if (op->getOperand(i) == arg)
+            return;
+    if (findDecRefAfter(op, arg))
+        op->setAttr("may_reuse_arg", UnitAttr::get(op->getContext()));
+}
+
 /**
  * @brief Manages the reference counters of all values defined in the given
  * block by inserting `IncRefOp` and `DecRefOp` in the right places.
@@ -226,8 +313,11 @@ void processBlock(OpBuilder builder, Block *b) {
             if (co.isTrivialCast() || co.isRemovePropertyCast())
                 incRefArgs(op, builder);
         }
-        // Loops and function calls.
-        else if (llvm::isa<scf::WhileOp, scf::ForOp, func::CallOp, daphne::GenericCallOp>(op))
+        // Loops.
+        else if (llvm::isa<scf::WhileOp, scf::ForOp>(op))
+            incRefLoopArgs(op, builder);
+        // Function calls.
+        else if (llvm::isa<func::CallOp, daphne::GenericCallOp>(op))
             incRefArgs(op, builder);
         // YieldOp of IfOp.
         else if (llvm::isa<scf::YieldOp>(op) && llvm::isa<scf::IfOp>(op.getParentOp())) {
@@ -272,6 +362,10 @@ void ManageObjRefsPass::runOnOperation() {
     func::FuncOp f = getOperation();
     OpBuilder builder(f.getContext());
     processBlock(builder, &(f.getBody().front()));
+    f.walk([](Operation *op) {
+        if (llvm::isa<daphne::InsertRowOp, daphne::InsertColOp, daphne::TransposeOp>(op))
+            markReusableArg(op);
+    });
 }
 
 std::unique_ptr<Pass> daphne::createManageObjRefsPass() { return std::make_unique<ManageObjRefsPass>(); }
@@ -0,0 +1,269 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <compiler/inference/SparsitySketch.h>
+#include <compiler/utils/CompilerUtils.h>
+#include <ir/daphneir/Daphne.h>
+#include <ir/daphneir/Passes.h>
+
+#include <mlir/Pass/Pass.h>
+
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace mlir;
+
+/**
+ * @brief Reorders chains of matrix multiplications by their estimated cost.
+ *
+ * Matrix multiplication is associative, but the DaphneDSL parser always
+ * creates a left-deep tree of `MatMulOp`s for an expression like `A @ B @ v`,
+ * which can be orders of magnitude more expensive than the best
+ * parenthesization (e.g., `A @ (B @ v)` for a tall-skinny `A`, a short-wide
+ * `B`, and a vector `v`). This pass finds maximal chains of matrix
+ * multiplications whose intermediate results are not used elsewhere, and
+ * finds the cheapest parenthesization of each chain using the classic dynamic
+ * programming algorithm for the matrix chain problem.
+ *
+ * The cost model takes the sparsity of the arguments into account: arguments
+ * whose estimated sparsity is below the given threshold are assumed to be
+ * stored in a sparse representation, such that the cost of a multiplication
+ * is proportional to the number of scalar products computed on the non-zeros
+ * plus the size of the result. The sparsity of the intermediate results is
+ * estimated by means of a `SparsitySketch`, which keeps track of structure
+ * like empty rows/columns across the chain.
+ *
+ * The pass relies on the shapes and sparsities from property inference, so it
+ * must run after the `InferencePass`. The rewritten chain is annotated with
+ * the estimated properties of the intermediate results.
+ */
+struct MatMulChainPass : public PassWrapper<MatMulChainPass, OperationPass<func::FuncOp>> {
+    double sparsityThreshold;
+
+    explicit MatMulChainPass(double sparsityThreshold) : sparsityThreshold(sparsityThreshold) {}
+    void runOnOperation() final;
+
+    StringRef getArgument() const final { return "opt-matmul-chain"; }
+    StringRef getDescription() const final {
+        return "Reorders chains of matrix multiplications based on their estimated cost.";
+    }
+};
+
+namespace {
+
+/**
+ * @brief An argument of a matrix multiplication chain, which is used either as
+ * is or transposed.
+ */
+struct Leaf {
+    Value value;
+    bool transposed;
+    SparsitySketch sketch;
+};
+
+class ChainRewriter {
+    const double sparsityThreshold;
+
+    daphne::MatMulOp root;
+    std::vector<Leaf> leaves;
+    std::vector<Operation *> innerOps;
+    bool valid = true;
+
+    std::vector<std::vector<double>> cost;
+    std::vector<std::vector<SparsitySketch>> sketch;
+    std::vector<std::vector<size_t>> split;
+
+    static bool hasConstantFlags(daphne::MatMulOp op) {
+        return CompilerUtils::isConstant<bool>(op.getTransa()).first &&
+               CompilerUtils::isConstant<bool>(op.getTransb()).first;
+    }
+
+    bool isSparse(const SparsitySketch &s) const { return s.sparsity() < sparsityThreshold; }
+
+    /**
+     * @brief The estimated cost of computing `res = a @ b`.
+     */
+    double multiplyCost(const SparsitySketch &a, const SparsitySketch &b, const SparsitySketch &res) const {
+        double c;
+        if (isSparse(a) && isSparse(b))
+            c = a.numCols > 0 ? a.nnz * b.nnz / a.numCols : 0;
+        else if (isSparse(a))
+            c = a.nnz * b.numCols;
+        else if (isSparse(b))
+            c = a.numRows * b.nnz;
+        else
+            c = a.numRows * a.numCols * b.numCols;
+        return c + (isSparse(res) ? res.nnz : res.numRows * res.numCols);
+    }
+
+    SparsitySketch leafSketch(Value v, bool transposed) {
+        auto mt = v.getType().dyn_cast<daphne::MatrixType>();
+        if (!mt || mt.getNumRows() == -1 || mt.getNumCols() == -1 ||
+            mt.getElementType() != root.getType().cast<daphne::MatrixType>().getElementType()) {
+            valid = false;
+            return {};
+        }
+        // Unknown sparsity is treated as dense.
+        const double sp = mt.getSparsity() == -1.0 ? 1.0 : mt.getSparsity();
+        SparsitySketch s = v.getDefiningOp<daphne::DiagMatrixOp>()
+                               ? SparsitySketch::diagonal(mt.getNumRows(), sp * mt.getNumRows() * mt.getNumCols())
+                               : SparsitySketch::uniform(mt.getNumRows(), mt.getNumCols(), sp);
+        return transposed ? s.transposed() : s;
+    }
+
+    /**
+     * @brief Flattens the tree of matrix multiplications producing `v` into
+     * the list of leaves, and returns the sketch of `v` while accumulating the
+     * cost of the original tree.
+     */
+    SparsitySketch flatten(Value v, bool transposed, double &origCost) {
+        auto op = v.getDefiningOp<daphne::MatMulOp>();
+        if (op && (op == root || isInner(op))) {
+            if (op != root)
+                innerOps.push_back(op);
+            const bool ta = CompilerUtils::constantOrThrow<bool>(op.getTransa());
+            const bool tb = CompilerUtils::constantOrThrow<bool>(op.getTransb());
+            // (A @ B)^T = B^T @ A^T
+            SparsitySketch lhs = transposed ? flatten(op.getRhs(), !tb, origCost) : flatten(op.getLhs(), ta, origCost);
+            SparsitySketch rhs = transposed ? flatten(op.getLhs(), !ta, origCost) : flatten(op.getRhs(), tb, origCost);
+            SparsitySketch res = SparsitySketch::matMul(lhs, rhs);
+            origCost += multiplyCost(lhs, rhs, res);
+            return res;
+        }
+        SparsitySketch s = leafSketch(v, transposed);
+        leaves.push_back({v, transposed, s});
+        return s;
+    }
+
+    Value materializeLeaf(OpBuilder &builder, Location loc, const Leaf &leaf) {
+        if (!leaf.transposed)
+            return leaf.value;
+        // The canonicalizer folds the transposition into the multiplication
+        // where the kernels support it.
+        auto mt = leaf.value.getType().cast<daphne::MatrixType>();
+        return builder.create<daphne::TransposeOp>(loc, mt.withShape(mt.getNumCols(), mt.getNumRows()), leaf.value);
+    }
+
+    Value build(OpBuilder &builder, Location loc, Value falseFlag, size_t i, size_t j) {
+        if (i == j)
+            return materializeLeaf(builder, loc, leaves[i]);
+        const size_t s = split[i][j];
+        Value lhs = build(builder, loc, falseFlag, i, s);
+        Value rhs = build(builder, loc, falseFlag, s + 1, j);
+        Type resTy;
+        if (i == 0 && j == leaves.size() - 1)
+            resTy = root.getType();
+        else {
+            const SparsitySketch &r = sketch[i][j];
+            resTy = daphne::MatrixType::get(builder.getContext(),
+                                            root.getType().cast<daphne::MatrixType>().getElementType(),
+                                            static_cast<ssize_t>(r.numRows), static_cast<ssize_t>(r.numCols),
+                                            r.sparsity(), daphne::MatrixRepresentation::Default);
+        }
+        return builder.create<daphne::MatMulOp>(loc, resTy, lhs, rhs, falseFlag, falseFlag);
+    }
+
+  public:
+    explicit ChainRewriter(double sparsityThreshold) : sparsityThreshold(sparsityThreshold) {}
+
+    /**
+     * @brief Returns if the result of the given multiplication is only
+     * consumed by another multiplication of the same chain.
+     */
+    static bool isInner(daphne::MatMulOp op) {
+        if (!hasConstantFlags(op) || !op->hasOneUse())
+            return false;
+        auto user = dyn_cast<daphne::MatMulOp>(*op->getUsers().begin());
+        return user && user->getBlock() == op->getBlock() && hasConstantFlags(user) &&
+               user.getType().cast<daphne::MatrixType>().getElementType() ==
+                   op.getType().cast<daphne::MatrixType>().getElementType();
+    }
+
+    /**
+     * @brief Rewrites the chain rooted at the given multiplication if a
+     * cheaper parenthesization exists.
+     */
+    bool rewrite(daphne::MatMulOp rootOp) {
+        root = rootOp;
+        if (!hasConstantFlags(root))
+            return false;
+
+        double origCost = 0;
+        flatten(root.getResult(), false, origCost);
+        const size_t n = leaves.size();
+        if (!valid || n < 3)
+            return false;
+
+        // Dynamic programming over all sub-chains by increasing length.
+        cost.assign(n, std::vector<double>(n, 0));
+        sketch.assign(n, std::vector<SparsitySketch>(n));
+        split.assign(n, std::vector<size_t>(n, 0));
+        for (size_t i = 0; i < n; i++)
+            sketch[i][i] = leaves[i].sketch;
+        for (size_t len = 2; len <= n; len++)
+            for (size_t i = 0; i + len - 1 < n; i++) {
+                const size_t j = i + len - 1;
+                cost[i][j] = std::numeric_limits<double>::infinity();
+                for (size_t s = i; s < j; s++) {
+                    SparsitySketch res = SparsitySketch::matMul(sketch[i][s], sketch[s + 1][j]);
+                    const double c = cost[i][s] + cost[s + 1][j] + multiplyCost(sketch[i][s], sketch[s + 1][j], res);
+                    if (c < cost[i][j]) {
+                        cost[i][j] = c;
+                        sketch[i][j] = res;
+                        split[i][j] = s;
+                    }
+                }
+            }
+
+        // Keep the original order unless the new one is clearly cheaper, since
+        // the estimates are not exact.
+        if (cost[0][n - 1] >= 0.9 * origCost)
+            return false;
+
+        OpBuilder builder(root);
+        Location loc = root.getLoc();
+        Value falseFlag = builder.create<daphne::ConstantOp>(loc, false);
+        Value res = build(builder, loc, falseFlag, 0, n - 1);
+        root.getResult().replaceAllUsesWith(res);
+        root->erase();
+        // The inner operations were collected from the root towards the
+        // leaves, so each one is unused by the time it is erased.
+        for (Operation *op : innerOps)
+            op->erase();
+        return true;
+    }
+};
+
+} // namespace
+
+void MatMulChainPass::runOnOperation() {
+    func::FuncOp f = getOperation();
+
+    std::vector<daphne::MatMulOp> roots;
+    f.walk([&](daphne::MatMulOp op) {
+        if (!ChainRewriter::isInner(op))
+            roots.push_back(op);
+    });
+
+    for (daphne::MatMulOp op : roots)
+        ChainRewriter(sparsityThreshold).rewrite(op);
+}
+
+std::unique_ptr<Pass> daphne::createMatMulChainPass(double sparsityThreshold) {
+    return std::make_unique<MatMulChainPass>(sparsityThreshold);
+}
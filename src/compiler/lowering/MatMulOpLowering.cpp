@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "compiler/lowering/MatMulTuningProfile.h"
 #include "compiler/utils/LoweringUtils.h"
 #include "hwloc.h"
 #include "ir/daphneir/Daphne.h"
@@ -65,6 +66,7 @@
 #include "spdlog/spdlog.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
 #include <util/ErrorHandler.h>
 
 namespace mlir {
@@ -133,6 +135,16 @@ struct LowerMatMulOpOptions {
         invert_loops = b;
         return *this;
     }
+    LowerMatMulOpOptions &applyTuningConfig(MatMulTuningConfig const &config) {
+        enableTiling(!config.tileSizes.empty());
+        useFixedTileSizes = true;
+        setTileSizes(config.tileSizes);
+        setUnrollFactor(config.unrollFactor);
+        setUnrollJamFactor(config.unrollJamFactor);
+        enableVectorization(config.vecSizeBits > 0);
+        setVectorSizeBits(config.vecSizeBits);
+        return *this;
+    }
     int getVecSize(int bitwidth) const {
         if (vec_size_bits > 0) {
             return std::max(1, vec_size_bits / bitwidth);
@@ -171,13 +183,31 @@ bool is_valid_options(LowerMatMulOpOptions const options) {
 
 class MatMulLowering : public OpConversionPattern<daphne::MatMulOp> {
     const LowerMatMulOpOptions options;
+    std::shared_ptr<const MatMulTuningProfile> profile;
+    /**
+     * @brief The lowerings with the options of the individual entries of the
+     * profile (`nullptr` for entries yielding invalid options).
+     */
+    std::vector<std::unique_ptr<const MatMulLowering>> tunedLowerings;
 
   public:
     using OpConversionPattern::OpConversionPattern;
     explicit MatMulLowering(mlir::TypeConverter &typeConverter, MLIRContext *context,
-                            LowerMatMulOpOptions const &options)
-        : OpConversionPattern<daphne::MatMulOp>(typeConverter, context, PatternBenefit(1)), options(options) {
+                            LowerMatMulOpOptions const &options,
+                            std::shared_ptr<const MatMulTuningProfile> profile = nullptr)
+        : OpConversionPattern<daphne::MatMulOp>(typeConverter, context, PatternBenefit(1)), options(options),
+          profile(std::move(profile)) {
         this->setDebugName("MatMulLowering");
+        if (this->profile)
+            for (size_t i = 0; i < this->profile->size(); i++) {
+                LowerMatMulOpOptions tunedOptions = options;
+                tunedOptions.applyTuningConfig(this->profile->getConfig(i));
+                if (is_valid_options(tunedOptions))
+                    tunedLowerings.push_back(
+                        std::make_unique<const MatMulLowering>(typeConverter, context, tunedOptions));
+                else
+                    tunedLowerings.push_back(nullptr);
+            }
     }
 
     bool is_vectorizable(ArrayRef<int64_t> const rhsShape, Type const matrixElementType) const {
@@ -315,6 +345,17 @@ class MatMulLowering : public OpConversionPattern<daphne::MatMulOp> {
 
         auto matrixElementType = lhsMatrixType.getElementType();
 
+        // Lower with the parameters tuned for the value type and shape class,
+        // if the profile has any.
+        if (profile) {
+            std::string valueType;
+            llvm::raw_string_ostream stream(valueType);
+            matrixElementType.print(stream);
+            const int64_t i = profile->lookupIndex(stream.str(), lhsRows, lhsCols, rhsCols);
+            if (i >= 0 && tunedLowerings[i])
+                return tunedLowerings[i]->matchAndRewrite(op, adaptor, rewriter);
+        }
+
         // TODO(phil): if shape is unknown, e.g., row/col = -1 we currently
         // can't create a MemRefType
         auto lhsMemRefType = mlir::MemRefType::get({lhsRows, lhsCols}, matrixElementType);
@@ -627,7 +668,7 @@ struct MatMulLoweringPass : public impl::MatMulOpLoweringPassBase<MatMulLowering
     explicit MatMulLoweringPass(bool matmul_tile, int matmul_vec_size_bits,
                                 std::vector<unsigned> matmul_fixed_tile_sizes, bool matmul_use_fixed_tile_sizes,
                                 int matmul_unroll_factor, int matmul_unroll_jam_factor, int matmul_num_vec_registers,
-                                bool matmul_invert_loops)
+                                bool matmul_invert_loops, std::string matmul_tuning_profile)
         : impl::MatMulOpLoweringPassBase<MatMulLoweringPass>() {
         this->matmul_tile = matmul_tile;
         this->matmul_vec_size_bits = matmul_vec_size_bits;
@@ -637,6 +678,7 @@ struct MatMulLoweringPass : public impl::MatMulOpLoweringPassBase<MatMulLowering
         this->matmul_unroll_jam_factor = matmul_unroll_jam_factor;
         this->matmul_num_vec_registers = matmul_num_vec_registers;
         this->matmul_invert_loops = matmul_invert_loops;
+        this->matmul_tuning_profile = matmul_tuning_profile;
     }
 
     void runOnOperation() override;
@@ -714,7 +756,16 @@ void MatMulLoweringPass::runOnOperation() {
     target.addDynamicallyLegalOp<mlir::daphne::MatMulOp>(
         [options](Operation *op) { return !is_valid_options(options); });
 
-    patterns.insert<MatMulLowering>(typeConverter, &getContext(), options);
+    std::shared_ptr<const MatMulTuningProfile> profile;
+    if (!matmul_tuning_profile.empty()) {
+        try {
+            profile = std::make_shared<const MatMulTuningProfile>(MatMulTuningProfile::load(matmul_tuning_profile));
+        } catch (const std::runtime_error &e) {
+            throw ErrorHandler::compilerError(module.getLoc(), "MatMulOpLowering", e.what());
+        }
+    }
+
+    patterns.insert<MatMulLowering>(typeConverter, &getContext(), options, profile);
 
     if (failed(applyPartialConversion(module, target, std::move(patterns)))) {
         signalPassFailure();
@@ -724,10 +775,10 @@ void MatMulLoweringPass::runOnOperation() {
 std::unique_ptr<OperationPass<ModuleOp>> mlir::daphne::createMatMulOpLoweringPass(
     bool matmul_tile, int matmul_vec_size_bits, std::vector<unsigned> matmul_fixed_tile_sizes,
     bool matmul_use_fixed_tile_sizes, int matmul_unroll_factor, int matmul_unroll_jam_factor,
-    int matmul_num_vec_registers, bool matmul_invert_loops) {
+    int matmul_num_vec_registers, bool matmul_invert_loops, std::string matmul_tuning_profile) {
     return std::make_unique<MatMulLoweringPass>(
         matmul_tile, matmul_vec_size_bits, matmul_fixed_tile_sizes, matmul_use_fixed_tile_sizes, matmul_unroll_factor,
-        matmul_unroll_jam_factor, matmul_num_vec_registers, matmul_invert_loops);
+        matmul_unroll_jam_factor, matmul_num_vec_registers, matmul_invert_loops, matmul_tuning_profile);
 }
 
 // This is used by daphne-opt and automatically inserts the options provided on
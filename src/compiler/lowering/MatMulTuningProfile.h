@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <nlohmannjson/json.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The parameters of the lowering of a `MatMulOp` found by the
+ * auto-tuner.
+ */
+struct MatMulTuningConfig {
+    /**
+     * @brief The tile sizes (MR, NR, KC, MC, NC); empty to disable tiling.
+     */
+    std::vector<unsigned> tileSizes;
+    int vecSizeBits = 0;
+    int unrollFactor = 1;
+    int unrollJamFactor = 4;
+};
+
+/**
+ * @brief A profile of the best lowering parameters of `MatMulOp`s per value
+ * type and shape class, as measured by the auto-tuner on a particular machine.
+ *
+ * The shape class of a multiplication of an `(m x k)` by a `(k x n)` matrix
+ * consists of the powers of two the three dimensions are rounded up to. When
+ * no configuration was tuned for the exact shape class, the one of the closest
+ * shape class of the same value type is used, as long as it is not too far
+ * away.
+ *
+ * The profile is stored as a JSON file of the following form:
+ * ```
+ * {"entries": [{"value_type": "f64", "m": 512, "k": 512, "n": 512,
+ *               "tile_sizes": [4, 4, 256, 64, 512], "vec_size_bits": 256,
+ *               "unroll_factor": 1, "unroll_jam_factor": 4}]}
+ * ```
+ */
+class MatMulTuningProfile {
+  public:
+    /**
+     * @brief The maximum sum of the differences of the exponents of the shape
+     * classes for a configuration to be used for another shape class.
+     */
+    static constexpr int maxClassDistance = 2;
+
+  private:
+    struct Entry {
+        std::string valueType;
+        int64_t m, k, n;
+        MatMulTuningConfig config;
+    };
+
+    std::vector<Entry> entries;
+
+    /**
+     * @brief Returns the exponent of the power of two the given dimension is
+     * rounded up to.
+     *
+     * Entries are identified by their value type and the shape classes of
+     * their dimensions. `scripts/tuning/tune-matmul.py` uses the same key when
+     * extending a profile, see `shape_class()` there.
+     */
+    static int shapeClass(int64_t dim) {
+        int c = 0;
+        while (c < 62 && (int64_t(1) << c) < dim)
+            c++;
+        return c;
+    }
+
+    static int classDistance(const Entry &e, int64_t m, int64_t k, int64_t n) {
+        return std::abs(shapeClass(e.m) - shapeClass(m)) + std::abs(shapeClass(e.k) - shapeClass(k)) +
+               std::abs(shapeClass(e.n) - shapeClass(n));
+    }
+
+  public:
+    /**
+     * @brief Adds the configuration for the given value type and shape,
+     * replacing the one of the same shape class, if any.
+     */
+    void add(const std::string &valueType, int64_t m, int64_t k, int64_t n, const MatMulTuningConfig &config) {
+        for (auto &e : entries)
+            if (e.valueType == valueType && classDistance(e, m, k, n) == 0) {
+                e = {valueType, m, k, n, config};
+                return;
+            }
+        entries.push_back({valueType, m, k, n, config});
+    }
+
+    /**
+     * @brief Returns the index of the entry of the closest shape class for the
+     * given value type and shape, or `-1` if there is none.
+     */
+    int64_t lookupIndex(const std::string &valueType, int64_t m, int64_t k, int64_t n) const {
+        int64_t best = -1;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].valueType != valueType)
+                continue;
+            const int d = classDistance(entries[i], m, k, n);
+            if (d <= maxClassDistance && d < bestDistance) {
+                best = i;
+                bestDistance = d;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Returns the configuration of the closest shape class for the
+     * given value type and shape, or `nullptr` if there is none.
+     */
+    const MatMulTuningConfig *lookup(const std::string &valueType, int64_t m, int64_t k, int64_t n) const {
+        const int64_t i = lookupIndex(valueType, m, k, n);
+        return i < 0 ? nullptr : &entries[i].config;
+    }
+
+    const MatMulTuningConfig &getConfig(size_t i) const { return entries[i].config; }
+
+    size_t size() const { return entries.size(); }
+
+    static MatMulTuningProfile load(const std::string &path) {
+        std::ifstream ifs(path);
+        if (!ifs.good())
+            throw std::runtime_error("could not open MatMul tuning profile '" + path + "'");
+        MatMulTuningProfile profile;
+        try {
+            const nlohmann::json j = nlohmann::json::parse(ifs);
+            for (const auto &je : j.at("entries")) {
+                MatMulTuningConfig c;
+                c.tileSizes = je.value("tile_sizes", std::vector<unsigned>{});
+                c.vecSizeBits = je.value("vec_size_bits", 0);
+                c.unrollFactor = je.value("unroll_factor", 1);
+                c.unrollJamFactor = je.value("unroll_jam_factor", 4);
+                for (unsigned s : c.tileSizes)
+                    if (s <= 1)
+                        throw std::runtime_error("tile sizes must be larger than 1");
+                if (c.tileSizes.size() > 5 || c.vecSizeBits < 0 || c.unrollFactor < 0 || c.unrollJamFactor < 0)
+                    throw std::runtime_error("invalid configuration");
+                profile.add(je.at("value_type").get<std::string>(), je.at("m").get<int64_t>(),
+                            je.at("k").get<int64_t>(), je.at("n").get<int64_t>(), c);
+            }
+        } catch (const std::exception &e) {
+            throw std::runtime_error("invalid MatMul tuning profile '" + path + "': " + e.what());
+        }
+        return profile;
+    }
+
+    void save(const std::string &path) const {
+        nlohmann::json jes = nlohmann::json::array();
+        for (const auto &e : entries)
+            jes.push_back({{"value_type", e.valueType},
+                           {"m", e.m},
+                           {"k", e.k},
+                           {"n", e.n},
+                           {"tile_sizes", e.config.tileSizes},
+                           {"vec_size_bits", e.config.vecSizeBits},
+                           {"unroll_factor", e.config.unrollFactor},
+                           {"unroll_jam_factor", e.config.unrollJamFactor}});
+        std::ofstream ofs(path);
+        if (!ofs.good())
+            throw std::runtime_error("could not write MatMul tuning profile '" + path + "'");
+        ofs << nlohmann::json{{"entries", jes}}.dump(4) << std::endl;
+    }
+};
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ir/daphneir/Daphne.h>
+#include <ir/daphneir/Passes.h>
+
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Pass/Pass.h>
+
+#include <memory>
+#include <vector>
+
+using namespace mlir;
+
+/**
+ * @brief Overlaps the reading of files with computation.
+ *
+ * Each `ReadOp` is split into a `ReadAsyncOp`, which starts reading the file
+ * on a pool of I/O threads, and an `AwaitOp`, which blocks until the data
+ * object is available. The `ReadAsyncOp` is hoisted as early as possible in
+ * its block, i.e., up to the definition of the file name or up to the last
+ * operation that might write files (writes and function calls, also nested
+ * inside control flow). The `AwaitOp` is placed right before the first
+ * operation in the block that uses the data object. Thus, several reads can be
+ * in flight at the same time and the computation in between runs while the
+ * files are being read.
+ *
+ * Reads whose result is not used, or used right away without any chance of
+ * hoisting, are left unchanged.
+ */
+struct PrefetchReadsPass : public PassWrapper<PrefetchReadsPass, OperationPass<func::FuncOp>> {
+    void runOnOperation() final;
+};
+
+/**
+ * @brief Returns if a read must not be moved above the given operation,
+ * because the operation might create or modify files.
+ */
+static bool isReadBarrier(Operation *op) {
+    bool barrier = false;
+    op->walk([&](Operation *nestedOp) {
+        if (llvm::isa<daphne::WriteOp, daphne::GenericCallOp, func::CallOp>(nestedOp)) {
+            barrier = true;
+            return WalkResult::interrupt();
+        }
+        return WalkResult::advance();
+    });
+    return barrier;
+}
+
+void PrefetchReadsPass::runOnOperation() {
+    func::FuncOp f = getOperation();
+
+    std::vector<daphne::ReadOp> readOps;
+    f.walk([&](daphne::ReadOp op) { readOps.push_back(op); });
+
+    for (daphne::ReadOp readOp : readOps) {
+        Block *block = readOp->getBlock();
+        Value res = readOp.getRes();
+
+        // Find the first operation in the block that uses the result.
+        Operation *firstUser = nullptr;
+        for (Operation *user : res.getUsers()) {
+            Operation *ancestor = block->findAncestorOpInBlock(*user);
+            if (!firstUser || ancestor->isBeforeInBlock(firstUser))
+                firstUser = ancestor;
+        }
+        if (!firstUser)
+            continue;
+
+        // Find the earliest position the read can be started at.
+        Operation *fileNameDef = readOp.getFileName().getDefiningOp();
+        Operation *start = readOp;
+        for (Operation *prev = readOp->getPrevNode(); prev; prev = prev->getPrevNode()) {
+            if (prev == fileNameDef || isReadBarrier(prev))
+                break;
+            start = prev;
+        }
+        if (start == readOp.getOperation() && firstUser == readOp->getNextNode())
+            continue;
+
+        OpBuilder builder(start);
+        Location loc = readOp.getLoc();
+        Type futureType = daphne::FutureType::get(&getContext(), res.getType());
+        auto readAsyncOp = builder.create<daphne::ReadAsyncOp>(loc, futureType, readOp.getFileName());
+        builder.setInsertionPoint(firstUser);
+        auto awaitOp = builder.create<daphne::AwaitOp>(loc, res.getType(), readAsyncOp.getRes());
+        res.replaceAllUsesWith(awaitOp.getRes());
+        readOp.erase();
+    }
+}
+
+std::unique_ptr<Pass> daphne::createPrefetchReadsPass() { return std::make_unique<PrefetchReadsPass>(); }
@@ -55,7 +55,9 @@ class KernelReplacement : public RewritePattern {
             return 4;
         if (llvm::isa<daphne::OrderOp>(op))
             return 4;
-        if (llvm::isa<daphne::GroupOp>(op))
+        if (llvm::isa<daphne::TopKOp>(op))
+            return 5;
+        if (llvm::isa<daphne::GroupOp, daphne::ReceiveFromArrowOp>(op))
             return 3;
         if (llvm::isa<daphne::CreateFrameOp, daphne::SetColLabelsOp>(op))
             return 2;
@@ -109,6 +111,16 @@ class KernelReplacement : public RewritePattern {
             static bool isVariadic[] = {false, true, true, false};
             return std::make_tuple(idxAndLen.first, idxAndLen.second, isVariadic[index]);
         }
+        if (auto concreteOp = llvm::dyn_cast<daphne::TopKOp>(op)) {
+            auto idxAndLen = concreteOp.getODSOperandIndexAndLength(index);
+            static bool isVariadic[] = {false, false, true, true, false};
+            return std::make_tuple(idxAndLen.first, idxAndLen.second, isVariadic[index]);
+        }
+        if (auto concreteOp = llvm::dyn_cast<daphne::ReceiveFromArrowOp>(op)) {
+            auto idxAndLen = concreteOp.getODSOperandIndexAndLength(index);
+            static bool isVariadic[] = {false, false, true};
+            return std::make_tuple(idxAndLen.first, idxAndLen.second, isVariadic[index]);
+        }
         throw ErrorHandler::compilerError(op, "RewriteToCallKernelOpPass",
                                           "lowering to kernel call not yet supported for this variadic "
                                           "operation: " +
@@ -134,6 +146,8 @@ class KernelReplacement : public RewritePattern {
             return mlir::daphne::FrameType::get(mctx, {mlir::daphne::UnknownType::get(mctx)});
         if (auto lt = t.dyn_cast<mlir::daphne::ListType>())
             return mlir::daphne::ListType::get(mctx, adaptType(lt.getElementType(), generalizeToStructure));
+        if (auto ft = t.dyn_cast<mlir::daphne::FutureType>())
+            return mlir::daphne::FutureType::get(mctx, adaptType(ft.getDataType(), false));
         if (auto mrt = t.dyn_cast<mlir::MemRefType>()) {
             // Remove any specific dimension information ({0}), but retain the rank and element type.
             int64_t mrtRank = mrt.getRank();
@@ -230,7 +244,7 @@ class KernelReplacement : public RewritePattern {
             // AtLeastNOperands... There seems to be no simple way to
             // detect if an operation has variadic ODS operands with any N.
             op->hasTrait<OpTrait::VariadicOperands>() || op->hasTrait<OpTrait::AtLeastNOperands<1>::Impl>() ||
-            op->hasTrait<OpTrait::AtLeastNOperands<2>::Impl>()) {
+            op->hasTrait<OpTrait::AtLeastNOperands<2>::Impl>() || op->hasTrait<OpTrait::AtLeastNOperands<3>::Impl>()) {
             // For operations with variadic ODS operands, we replace all
             // occurrences of a variadic ODS operand by a single operand of
             // type VariadicPack as well as an operand for the number of
@@ -358,6 +372,55 @@ class KernelReplacement : public RewritePattern {
                                                                      rewriter.getIndexAttr(numCompareOperations)));
         }
 
+        if (llvm::isa<daphne::ReceiveFromArrowOp, daphne::LoadResidentOp>(op)) {
+            // The kernel checks the received frame against the column types
+            // the compiled code relies on. Like the aggregation functions of
+            // GroupOp, they are not part of the kernel look-up. The value
+            // type of a matrix is already part of the kernel's result type.
+            auto ft = opResTys[0].dyn_cast<daphne::FrameType>();
+            std::vector<Type> colTypes = ft ? ft.getColumnTypes() : std::vector<Type>();
+            const Type t = rewriter.getIntegerType(8, false);
+            auto cvpOp = rewriter.create<daphne::CreateVariadicPackOp>(
+                loc, daphne::VariadicPackType::get(rewriter.getContext(), t),
+                rewriter.getI64IntegerAttr(colTypes.size()));
+            for (size_t k = 0; k < colTypes.size(); k++)
+                rewriter.create<daphne::StoreVariadicPackOp>(
+                    loc, cvpOp,
+                    rewriter.create<daphne::ConstantOp>(
+                        loc, t,
+                        rewriter.getIntegerAttr(
+                            t, static_cast<uint8_t>(CompilerUtils::mlirTypeToValueTypeCode(colTypes[k])))),
+                    rewriter.getI64IntegerAttr(k));
+            kernelArgs.push_back(cvpOp);
+            kernelArgs.push_back(rewriter.create<daphne::ConstantOp>(loc, rewriter.getIndexType(),
+                                                                     rewriter.getIndexAttr(colTypes.size())));
+        }
+
+        if (llvm::isa<daphne::LoadResidentOp>(op)) {
+            // The labels of a resident frame are known at compile-time, too.
+            auto ft = opResTys[0].dyn_cast<daphne::FrameType>();
+            std::vector<std::string> *labels = ft ? ft.getLabels() : nullptr;
+            const size_t numLabels = labels ? labels->size() : 0;
+            auto strTy = daphne::StringType::get(rewriter.getContext());
+            auto cvpOp = rewriter.create<daphne::CreateVariadicPackOp>(
+                loc, daphne::VariadicPackType::get(rewriter.getContext(), strTy),
+                rewriter.getI64IntegerAttr(numLabels));
+            for (size_t k = 0; k < numLabels; k++)
+                rewriter.create<daphne::StoreVariadicPackOp>(
+                    loc, cvpOp, rewriter.create<daphne::ConstantOp>(loc, strTy, rewriter.getStringAttr((*labels)[k])),
+                    rewriter.getI64IntegerAttr(k));
+            kernelArgs.push_back(cvpOp);
+            kernelArgs.push_back(
+                rewriter.create<daphne::ConstantOp>(loc, rewriter.getIndexType(), rewriter.getIndexAttr(numLabels)));
+        }
+
+        if (llvm::isa<daphne::InsertRowOp, daphne::InsertColOp, daphne::TransposeOp>(op)) {
+            // ManageObjRefsPass marks the operations whose argument is not
+            // used afterwards, such that the kernel may update it in place.
+            lookupArgTys.push_back(rewriter.getI1Type());
+            kernelArgs.push_back(rewriter.create<daphne::ConstantOp>(loc, op->hasAttr("may_reuse_arg")));
+        }
+
         if (auto distCompOp = llvm::dyn_cast<daphne::DistributedComputeOp>(op)) {
             MLIRContext newContext; // TODO Reuse the existing context.
             OpBuilder tempBuilder(&newContext);
@@ -523,17 +586,21 @@ class DistributedPipelineKernelReplacement : public OpConversionPattern<daphne::
         size_t numOutputs = op.getOutputs().size();
         size_t numInputs = op.getInputs().size();
 
+        // All outputs of a distributed pipeline share the same data type (see
+        // DistributePipelinesPass).
+        const std::string outputTypeName = CompilerUtils::mlirTypeToCppTypeName(op.getOutputs().getTypes()[0], false);
+
         std::stringstream callee;
-        callee << "_distributedPipeline";         // kernel name
-        callee << "__DenseMatrix_double_variadic" // outputs
-               << "__size_t"                      // numOutputs
-               << "__Structure_variadic"          // inputs
-               << "__size_t"                      // numInputs
-               << "__int64_t"                     // outRows
-               << "__int64_t"                     // outCols
-               << "__int64_t"                     // splits
-               << "__int64_t"                     // combines
-               << "__char";                       // irCode
+        callee << "_distributedPipeline";               // kernel name
+        callee << "__" << outputTypeName << "_variadic" // outputs
+               << "__size_t"                            // numOutputs
+               << "__Structure_variadic"                // inputs
+               << "__size_t"                            // numInputs
+               << "__int64_t"                           // outRows
+               << "__int64_t"                           // outCols
+               << "__int64_t"                           // splits
+               << "__int64_t"                           // combines
+               << "__char";                             // irCode
 
         MLIRContext *mctx = rewriter.getContext();
 
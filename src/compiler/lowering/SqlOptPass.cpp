@@ -0,0 +1,712 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <compiler/utils/CompilerUtils.h>
+#include <ir/daphneir/Daphne.h>
+#include <ir/daphneir/Passes.h>
+
+#include <mlir/IR/IRMapping.h>
+#include <mlir/Pass/Pass.h>
+#include <mlir/Pass/PassManager.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace mlir;
+
+/**
+ * @brief A logical optimizer for the relational operations generated by the
+ * SQL parser.
+ *
+ * The `SQLVisitor` translates `FROM a, b, ... WHERE p` into a tree of
+ * `CartesianOp`s (and `InnerJoinOp`s for explicit `JOIN`s) with a single
+ * `FilterRowOp` on top, i.e., it materializes the full cross product before
+ * filtering. This pass rewrites such a *join region* as follows:
+ *
+ * - The WHERE predicate is split into its conjuncts. Conjuncts referencing
+ *   the columns of a single input are pushed below the joins and evaluated on
+ *   that input (predicate pushdown).
+ * - Equality conjuncts between two key columns of different inputs turn the
+ *   cross product into an `InnerJoinOp`.
+ * - If the result of the region is only accessed by label (e.g., by the
+ *   projections of a SELECT), the inputs are reduced to the columns actually
+ *   needed (projection pruning), and the join order is chosen greedily based
+ *   on the estimated number of rows of the inputs. Otherwise, the column
+ *   order of the result is observable, and the inputs are joined in their
+ *   original order.
+ * - All remaining conjuncts are applied on top of the rewritten region.
+ *
+ * Finally, a `FilterRowOp` on a frame whose result is only accessed column by
+ * column (e.g., by the projections of a SELECT) is materialized late: the bit
+ * vector is converted into a list of positions once, and only the columns
+ * actually extracted are gathered by these positions.
+ *
+ * The pass relies on the frame labels and shapes from property inference,
+ * so it must run after the `InferencePass`. If it rewrites anything, it runs
+ * the `InferencePass` on the function once more to infer the properties of
+ * the operations it created.
+ */
+struct SqlOptPass : public PassWrapper<SqlOptPass, OperationPass<func::FuncOp>> {
+    explicit SqlOptPass() {}
+    void runOnOperation() final;
+
+    StringRef getArgument() const final { return "opt-sql"; }
+    StringRef getDescription() const final {
+        return "Pushes down predicates, introduces inner joins, prunes columns, reorders joins, and materializes "
+               "filters late in the relational operations generated from SQL queries.";
+    }
+};
+
+namespace {
+
+/**
+ * @brief The estimated fraction of rows retained by a predicate pushed to an
+ * input, in the absence of any statistics.
+ */
+constexpr double FILTER_SELECTIVITY = 1.0 / 3;
+
+/**
+ * @brief An input frame of a join region, i.e., a leaf of the tree of
+ * `CartesianOp`s and `InnerJoinOp`s.
+ */
+struct JoinInput {
+    Value frame;
+    std::vector<std::string> labels;
+    std::vector<Type> colTypes;
+    /**
+     * @brief The conjuncts of the WHERE predicate which only reference the
+     * columns of this input.
+     */
+    std::vector<size_t> filters;
+    double estNumRows;
+};
+
+/**
+ * @brief An equi-join condition between two inputs of a join region.
+ */
+struct JoinEdge {
+    size_t lhsInput;
+    size_t rhsInput;
+    std::string lhsLabel;
+    std::string rhsLabel;
+    /**
+     * @brief The index of the WHERE conjunct this condition stems from, or
+     * `-1` for the condition of an `InnerJoinOp` in the original region.
+     */
+    int64_t conjunct;
+};
+
+/**
+ * @brief A conjunct of the WHERE predicate of a join region.
+ */
+struct Conjunct {
+    Value pred;
+    /**
+     * @brief The operations computing `pred` from the columns of the region's
+     * result in topological order.
+     */
+    std::vector<Operation *> slice;
+    std::set<std::string> labels;
+    bool supported = true;
+};
+
+/**
+ * @brief The state of the rewrite of a single join region.
+ */
+class JoinRegionRewriter {
+    daphne::FilterRowOp filterOp;
+    Value root;
+    std::vector<Operation *> nodes;
+    std::vector<JoinInput> inputs;
+    std::vector<JoinEdge> edges;
+    std::vector<Conjunct> conjuncts;
+    std::map<std::string, size_t> inputOfLabel;
+
+    // ------------------------------------------------------------------------
+    // Analysis
+    // ------------------------------------------------------------------------
+
+    static bool isJoinNode(Operation *op) { return op && llvm::isa<daphne::CartesianOp, daphne::InnerJoinOp>(op); }
+
+    static std::vector<Type> concatColTypes(Value lhs, Value rhs) {
+        std::vector<Type> colTypes = lhs.getType().dyn_cast<daphne::FrameType>().getColumnTypes();
+        for (Type t : rhs.getType().dyn_cast<daphne::FrameType>().getColumnTypes())
+            colTypes.push_back(t);
+        return colTypes;
+    }
+
+    /**
+     * @brief Collects the inputs, the join conditions, and the join
+     * operations of the tree rooted at `v`.
+     */
+    bool collectTree(Value v) {
+        Operation *op = v.getDefiningOp();
+        if (!isJoinNode(op)) {
+            auto ft = v.getType().dyn_cast<daphne::FrameType>();
+            if (!ft || !ft.getLabels())
+                return false;
+            JoinInput in;
+            in.frame = v;
+            in.labels = *ft.getLabels();
+            in.colTypes = ft.getColumnTypes();
+            in.estNumRows = ft.getNumRows() == -1 ? std::numeric_limits<double>::max() : ft.getNumRows();
+            inputs.push_back(in);
+            return true;
+        }
+        // Intermediate results must not be used outside the region.
+        if (v != root && !v.hasOneUse())
+            return false;
+        if (op->getBlock() != filterOp->getBlock())
+            return false;
+        nodes.push_back(op);
+        if (auto ijo = llvm::dyn_cast<daphne::InnerJoinOp>(op)) {
+            auto lhsOn = CompilerUtils::isConstant<std::string>(ijo.getLhsOn());
+            auto rhsOn = CompilerUtils::isConstant<std::string>(ijo.getRhsOn());
+            if (!lhsOn.first || !rhsOn.first)
+                return false;
+            edges.push_back({0, 0, lhsOn.second, rhsOn.second, -1});
+        }
+        return collectTree(op->getOperand(0)) && collectTree(op->getOperand(1));
+    }
+
+    enum class Dep { INDEPENDENT, DEPENDENT, UNSUPPORTED };
+
+    /**
+     * @brief Determines whether `v` is computed row-wise from the columns of
+     * the region's result, and records the operations and labels involved.
+     */
+    Dep analyze(Value v, Conjunct &c, llvm::DenseMap<Operation *, Dep> &visited) {
+        if (v == root)
+            return Dep::UNSUPPORTED;
+        Operation *op = v.getDefiningOp();
+        if (!op)
+            return Dep::INDEPENDENT;
+        if (auto it = visited.find(op); it != visited.end())
+            return it->second;
+
+        Dep res = Dep::INDEPENDENT;
+        if (auto eco = llvm::dyn_cast<daphne::ExtractColOp>(op); eco && eco.getSource() == root) {
+            auto label = CompilerUtils::isConstant<std::string>(eco.getSelectedCols());
+            if (label.first && !label.second.empty() && label.second.back() != '*') {
+                c.labels.insert(label.second);
+                res = Dep::DEPENDENT;
+            } else
+                res = Dep::UNSUPPORTED;
+        } else {
+            const bool rowWise = op->hasTrait<OpTrait::ShapeEwBinary>() ||
+                                 llvm::isa<daphne::CastOp, daphne::CreateFrameOp, daphne::ConstantOp>(op);
+            for (Value operand : op->getOperands()) {
+                const Dep d = analyze(operand, c, visited);
+                if (d == Dep::UNSUPPORTED || (d == Dep::DEPENDENT && !rowWise)) {
+                    res = Dep::UNSUPPORTED;
+                    break;
+                }
+                if (d == Dep::DEPENDENT)
+                    res = Dep::DEPENDENT;
+            }
+        }
+        if (res == Dep::DEPENDENT) {
+            if (op->getBlock() != filterOp->getBlock())
+                res = Dep::UNSUPPORTED;
+            else
+                c.slice.push_back(op);
+        }
+        visited[op] = res;
+        return res;
+    }
+
+    /**
+     * @brief Splits the predicate `v` along logical ANDs.
+     *
+     * The SQL parser casts the operands of AND to integer matrices via a
+     * single-column frame; these casts are looked through for comparisons,
+     * whose results are zero or one anyway.
+     */
+    void splitConjuncts(Value v, std::vector<Value> &res) {
+        if (auto andOp = v.getDefiningOp<daphne::EwAndOp>()) {
+            splitConjuncts(andOp.getLhs(), res);
+            splitConjuncts(andOp.getRhs(), res);
+            return;
+        }
+        if (auto co = v.getDefiningOp<daphne::CastOp>())
+            if (auto cfo = co.getArg().getDefiningOp<daphne::CreateFrameOp>())
+                if (cfo.getCols().size() == 1 && isBoolean(cfo.getCols()[0])) {
+                    splitConjuncts(cfo.getCols()[0], res);
+                    return;
+                }
+        res.push_back(v);
+    }
+
+    /**
+     * @brief Whether `v` only contains zeros and ones, as required for
+     * applying it via `FilterRowOp` on its own.
+     */
+    static bool isBoolean(Value v) {
+        Operation *op = v.getDefiningOp();
+        return op && llvm::isa<daphne::EwEqOp, daphne::EwNeqOp, daphne::EwLtOp, daphne::EwLeOp, daphne::EwGtOp,
+                               daphne::EwGeOp, daphne::EwAndOp, daphne::EwOrOp>(op);
+    }
+
+    /**
+     * @brief Returns the label of the column `v` is directly extracted from,
+     * or an empty string.
+     */
+    std::string columnRef(Value v) {
+        if (auto co = v.getDefiningOp<daphne::CastOp>())
+            v = co.getArg();
+        if (auto eco = v.getDefiningOp<daphne::ExtractColOp>())
+            if (eco.getSource() == root) {
+                auto label = CompilerUtils::isConstant<std::string>(eco.getSelectedCols());
+                if (label.first)
+                    return label.second;
+            }
+        return "";
+    }
+
+    Type colTypeOf(const std::string &label) {
+        const JoinInput &in = inputs[inputOfLabel.at(label)];
+        const size_t pos = std::find(in.labels.begin(), in.labels.end(), label) - in.labels.begin();
+        return in.colTypes[pos];
+    }
+
+    /**
+     * @brief Whether the `InnerJoinOp` kernel can join on the given columns.
+     */
+    bool isJoinable(const std::string &lhsLabel, const std::string &rhsLabel) {
+        Type lt = colTypeOf(lhsLabel);
+        Type rt = colTypeOf(rhsLabel);
+        if (lt != rt)
+            return false;
+        return llvm::isa<daphne::StringType>(lt) || lt.isSignedInteger(64);
+    }
+
+    /**
+     * @brief Determines the labels of the region's result needed by its
+     * users, or returns `false` if the result is not only accessed by label.
+     */
+    bool collectUsedLabels(std::set<std::string> &used) {
+        for (Operation *user : filterOp->getUsers()) {
+            auto eco = llvm::dyn_cast<daphne::ExtractColOp>(user);
+            if (!eco)
+                return false;
+            auto label = CompilerUtils::isConstant<std::string>(eco.getSelectedCols());
+            if (!label.first)
+                return false;
+            const std::string &l = label.second;
+            if (l == "*")
+                return false;
+            if (l.size() >= 2 && l.compare(l.size() - 2, 2, ".*") == 0) {
+                // All columns of the referenced frame, cf.
+                // ExtractColOp::inferFrameLabels().
+                const std::string frameName = l.substr(0, l.find('.'));
+                for (auto &in : inputs)
+                    for (auto &il : in.labels)
+                        if (il.substr(0, il.find('.')) == frameName)
+                            used.insert(il);
+            } else
+                used.insert(l);
+        }
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // Code generation
+    // ------------------------------------------------------------------------
+
+    static Type unknownFrameType(Value frame) {
+        return frame.getType().dyn_cast<daphne::FrameType>().withSameColumnTypes();
+    }
+
+    /**
+     * @brief Resets all properties of the results of `op` except for the
+     * data/value types, such that they get re-inferred.
+     */
+    static void resetProperties(Operation *op) {
+        for (Value r : op->getResults()) {
+            if (auto mt = r.getType().dyn_cast<daphne::MatrixType>())
+                r.setType(mt.withSameElementType());
+            else if (auto ft = r.getType().dyn_cast<daphne::FrameType>())
+                r.setType(ft.withSameColumnTypes());
+        }
+    }
+
+    /**
+     * @brief Re-creates the predicate of the given conjunct on `frame`.
+     */
+    Value clonePredicate(OpBuilder &builder, const Conjunct &c, Value frame) {
+        IRMapping mapping;
+        mapping.map(root, frame);
+        for (Operation *op : c.slice)
+            resetProperties(builder.clone(*op, mapping));
+        return mapping.lookup(c.pred);
+    }
+
+    Value filter(OpBuilder &builder, Value frame, Value pred) {
+        return builder.create<daphne::FilterRowOp>(filterOp.getLoc(), unknownFrameType(frame), frame, pred);
+    }
+
+    Value extractCol(OpBuilder &builder, Value frame, const std::string &label, Type colType) {
+        Location loc = filterOp.getLoc();
+        Value labelVal = builder.create<daphne::ConstantOp>(loc, label);
+        return builder.create<daphne::ExtractColOp>(loc, daphne::FrameType::get(builder.getContext(), {colType}),
+                                                    frame, labelVal);
+    }
+
+    /**
+     * @brief Restricts the given input to the given labels (in their
+     * original order).
+     */
+    Value project(OpBuilder &builder, const JoinInput &in, const std::set<std::string> &needed) {
+        Location loc = filterOp.getLoc();
+        Value res;
+        size_t numCols = 0;
+        for (size_t i = 0; i < in.labels.size(); i++) {
+            if (!needed.count(in.labels[i]))
+                continue;
+            Value col = extractCol(builder, in.frame, in.labels[i], in.colTypes[i]);
+            if (res)
+                res = builder.create<daphne::ColBindOp>(
+                    loc, daphne::FrameType::get(builder.getContext(), concatColTypes(res, col)), res, col);
+            else
+                res = col;
+            numCols++;
+        }
+        return numCols == in.labels.size() ? in.frame : res;
+    }
+
+    Value equiJoin(OpBuilder &builder, Value lhs, Value rhs, const std::string &lhsOn, const std::string &rhsOn) {
+        Location loc = filterOp.getLoc();
+        Value lhsOnVal = builder.create<daphne::ConstantOp>(loc, lhsOn);
+        Value rhsOnVal = builder.create<daphne::ConstantOp>(loc, rhsOn);
+        // An unknown result size makes the kernel count the matches, a wrong
+        // estimate would either waste memory or be too small.
+        Value numRowRes = builder.create<daphne::ConstantOp>(loc, static_cast<int64_t>(-1));
+        return builder.create<daphne::InnerJoinOp>(
+            loc, daphne::FrameType::get(builder.getContext(), concatColTypes(lhs, rhs)), lhs, rhs, lhsOnVal, rhsOnVal,
+            numRowRes);
+    }
+
+    Value cartesian(OpBuilder &builder, Value lhs, Value rhs) {
+        return builder.create<daphne::CartesianOp>(
+            filterOp.getLoc(), daphne::FrameType::get(builder.getContext(), concatColTypes(lhs, rhs)), lhs, rhs);
+    }
+
+    /**
+     * @brief Creates an equality predicate on two columns of `frame`, for an
+     * `InnerJoinOp` condition which cannot become a join any more.
+     */
+    Value equalityPredicate(OpBuilder &builder, Value frame, const JoinEdge &e) {
+        Location loc = filterOp.getLoc();
+        Type u = builder.getType<daphne::UnknownType>();
+        Value lhs = builder.create<daphne::CastOp>(loc, daphne::MatrixType::get(builder.getContext(), u),
+                                                   extractCol(builder, frame, e.lhsLabel, colTypeOf(e.lhsLabel)));
+        Value rhs = builder.create<daphne::CastOp>(loc, daphne::MatrixType::get(builder.getContext(), u),
+                                                   extractCol(builder, frame, e.rhsLabel, colTypeOf(e.rhsLabel)));
+        return builder.create<daphne::EwEqOp>(loc, lhs, rhs);
+    }
+
+  public:
+    explicit JoinRegionRewriter(daphne::FilterRowOp filterOp) : filterOp(filterOp), root(filterOp.getSource()) {}
+
+    /**
+     * @brief Rewrites the join region below `filterOp`, if possible.
+     *
+     * @return `true` if the region was rewritten, `false` if the IR was left
+     * unchanged.
+     */
+    bool rewrite() {
+        if (!isJoinNode(root.getDefiningOp()) || !collectTree(root))
+            return false;
+
+        // Map each label to the input it stems from; labels must be unique.
+        for (size_t i = 0; i < inputs.size(); i++)
+            for (const std::string &l : inputs[i].labels)
+                if (!inputOfLabel.emplace(l, i).second)
+                    return false;
+        for (JoinEdge &e : edges) {
+            if (!inputOfLabel.count(e.lhsLabel) || !inputOfLabel.count(e.rhsLabel))
+                return false;
+            e.lhsInput = inputOfLabel[e.lhsLabel];
+            e.rhsInput = inputOfLabel[e.rhsLabel];
+            if (e.lhsInput == e.rhsInput)
+                return false;
+        }
+
+        // Classify the conjuncts of the WHERE predicate.
+        std::vector<Value> preds;
+        splitConjuncts(filterOp.getSelectedRows(), preds);
+        if (preds.size() > 1 && !std::all_of(preds.begin(), preds.end(), isBoolean))
+            preds = {filterOp.getSelectedRows()};
+        llvm::SmallPtrSet<Operation *, 32> sliceOps;
+        for (Value pred : preds) {
+            Conjunct c;
+            c.pred = pred;
+            llvm::DenseMap<Operation *, Dep> visited;
+            c.supported = analyze(pred, c, visited) == Dep::DEPENDENT;
+            for (const std::string &l : c.labels)
+                c.supported = c.supported && inputOfLabel.count(l);
+            sliceOps.insert(c.slice.begin(), c.slice.end());
+            conjuncts.push_back(c);
+        }
+        // The region's result must not be used by anything but the filter and
+        // the predicates we can re-create.
+        for (Operation *user : root.getUsers()) {
+            if (user == filterOp.getOperation())
+                continue;
+            if (!sliceOps.count(user))
+                return false;
+        }
+        // The predicate as a whole must be re-creatable, since the conjuncts
+        // are re-created separately.
+        if (!std::all_of(conjuncts.begin(), conjuncts.end(), [](const Conjunct &c) { return c.supported; }))
+            return false;
+
+        std::vector<size_t> residual;
+        for (size_t ci = 0; ci < conjuncts.size(); ci++) {
+            const Conjunct &c = conjuncts[ci];
+            std::set<size_t> refInputs;
+            for (const std::string &l : c.labels)
+                refInputs.insert(inputOfLabel[l]);
+            if (refInputs.size() == 1) {
+                inputs[*refInputs.begin()].filters.push_back(ci);
+                continue;
+            }
+            if (refInputs.size() == 2)
+                if (auto eqOp = c.pred.getDefiningOp<daphne::EwEqOp>()) {
+                    const std::string l = columnRef(eqOp.getLhs());
+                    const std::string r = columnRef(eqOp.getRhs());
+                    if (!l.empty() && !r.empty() && isJoinable(l, r)) {
+                        edges.push_back({inputOfLabel[l], inputOfLabel[r], l, r, static_cast<int64_t>(ci)});
+                        continue;
+                    }
+                }
+            residual.push_back(ci);
+        }
+
+        // Projection pruning and join reordering are only possible if the
+        // layout of the result is not observable.
+        std::set<std::string> needed;
+        const bool accessedByLabel = collectUsedLabels(needed);
+        if (accessedByLabel) {
+            for (const Conjunct &c : conjuncts)
+                needed.insert(c.labels.begin(), c.labels.end());
+            for (const JoinEdge &e : edges) {
+                needed.insert(e.lhsLabel);
+                needed.insert(e.rhsLabel);
+            }
+        }
+
+        OpBuilder builder(filterOp);
+
+        // Prune and filter the inputs.
+        std::vector<Value> frames;
+        for (JoinInput &in : inputs) {
+            Value frame = accessedByLabel ? project(builder, in, needed) : in.frame;
+            for (size_t ci : in.filters) {
+                frame = filter(builder, frame, clonePredicate(builder, conjuncts[ci], frame));
+                in.estNumRows *= FILTER_SELECTIVITY;
+            }
+            frames.push_back(frame);
+        }
+
+        // Join the inputs left-deep. If the layout of the result is not
+        // observable, we greedily pick the input with the fewest estimated
+        // rows among those connected to the inputs joined so far, and build
+        // the hash table of the join on the smaller side.
+        std::vector<bool> joined(inputs.size(), false);
+        std::vector<bool> edgeUsed(edges.size(), false);
+        auto connects = [&](const JoinEdge &e, size_t next) {
+            return (e.lhsInput == next && joined[e.rhsInput]) || (e.rhsInput == next && joined[e.lhsInput]);
+        };
+        size_t first = 0;
+        if (accessedByLabel)
+            for (size_t i = 1; i < inputs.size(); i++)
+                if (inputs[i].estNumRows < inputs[first].estNumRows)
+                    first = i;
+        Value cur = frames[first];
+        double curEstNumRows = inputs[first].estNumRows;
+        joined[first] = true;
+        for (size_t step = 1; step < inputs.size(); step++) {
+            size_t next = inputs.size();
+            if (accessedByLabel) {
+                bool nextConnected = false;
+                for (size_t i = 0; i < inputs.size(); i++) {
+                    if (joined[i])
+                        continue;
+                    const bool connected = std::any_of(edges.begin(), edges.end(),
+                                                       [&](const JoinEdge &e) { return connects(e, i); });
+                    if (next == inputs.size() || (connected && !nextConnected) ||
+                        (connected == nextConnected && inputs[i].estNumRows < inputs[next].estNumRows)) {
+                        next = i;
+                        nextConnected = connected;
+                    }
+                }
+            } else
+                next = std::find(joined.begin(), joined.end(), false) - joined.begin();
+
+            auto edgeIt =
+                std::find_if(edges.begin(), edges.end(), [&](const JoinEdge &e) { return connects(e, next); });
+            if (edgeIt != edges.end()) {
+                edgeUsed[edgeIt - edges.begin()] = true;
+                std::string curOn = edgeIt->lhsInput == next ? edgeIt->rhsLabel : edgeIt->lhsLabel;
+                std::string nextOn = edgeIt->lhsInput == next ? edgeIt->lhsLabel : edgeIt->rhsLabel;
+                // Assuming a key/foreign-key join, the result is about as large
+                // as the larger side.
+                if (accessedByLabel && inputs[next].estNumRows > curEstNumRows)
+                    cur = equiJoin(builder, frames[next], cur, nextOn, curOn);
+                else
+                    cur = equiJoin(builder, cur, frames[next], curOn, nextOn);
+                curEstNumRows = std::max(curEstNumRows, inputs[next].estNumRows);
+            } else {
+                cur = cartesian(builder, cur, frames[next]);
+                curEstNumRows *= inputs[next].estNumRows;
+            }
+            joined[next] = true;
+        }
+
+        // Apply what could not be pushed down or turned into a join.
+        for (size_t ei = 0; ei < edges.size(); ei++)
+            if (!edgeUsed[ei]) {
+                if (edges[ei].conjunct == -1)
+                    cur = filter(builder, cur, equalityPredicate(builder, cur, edges[ei]));
+                else
+                    residual.push_back(edges[ei].conjunct);
+            }
+        std::sort(residual.begin(), residual.end());
+        for (size_t ci : residual)
+            cur = filter(builder, cur, clonePredicate(builder, conjuncts[ci], cur));
+
+        // Replace the region and remove the now dead operations.
+        std::vector<Operation *> dead(nodes);
+        for (const Conjunct &c : conjuncts)
+            dead.insert(dead.end(), c.slice.begin(), c.slice.end());
+        if (Operation *predOp = filterOp.getSelectedRows().getDefiningOp())
+            if (predOp->getBlock() == filterOp->getBlock())
+                dead.push_back(predOp);
+        filterOp.getResult().replaceAllUsesWith(cur);
+        filterOp->erase();
+        eraseIfDead(dead);
+        return true;
+    }
+
+  private:
+    /**
+     * @brief Erases the given operations and the operations computing the
+     * original predicate as far as they have become unused.
+     */
+    static void eraseIfDead(std::vector<Operation *> candidates) {
+        llvm::SmallPtrSet<Operation *, 32> erased;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t i = 0; i < candidates.size(); i++) {
+                Operation *op = candidates[i];
+                if (erased.count(op) || !op->use_empty() || llvm::isa<daphne::ConstantOp>(op))
+                    continue;
+                for (Value operand : op->getOperands())
+                    if (Operation *def = operand.getDefiningOp())
+                        if (!erased.count(def) && def->getBlock() == op->getBlock() &&
+                            (isJoinNode(def) || def->hasTrait<OpTrait::ShapeEwBinary>() ||
+                             llvm::isa<daphne::CastOp, daphne::CreateFrameOp, daphne::ExtractColOp>(def)))
+                            candidates.push_back(def);
+                op->erase();
+                erased.insert(op);
+                changed = true;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Rewrites `ExtractColOp(FilterRowOp(f, sel), c)` into
+ * `ExtractRowOp(ExtractColOp(f, c), PositionListOp(sel))` if all users of the
+ * `FilterRowOp` are `ExtractColOp`s, such that the columns of `f` which are
+ * not needed are never copied, and the bit vector is evaluated only once for
+ * all columns which are.
+ *
+ * @return `true` if the `FilterRowOp` was rewritten, `false` otherwise.
+ */
+bool materializeLate(daphne::FilterRowOp filterOp) {
+    Value source = filterOp.getSource();
+    if (!source.getType().isa<daphne::FrameType>() || filterOp->use_empty())
+        return false;
+    for (Operation *user : filterOp->getUsers())
+        if (!llvm::isa<daphne::ExtractColOp>(user))
+            return false;
+
+    OpBuilder builder(filterOp);
+    MLIRContext *ctx = builder.getContext();
+    Value pos = builder.create<daphne::PositionListOp>(
+        filterOp.getLoc(), daphne::MatrixType::get(ctx, builder.getIndexType()), filterOp.getSelectedRows());
+    for (Operation *user : llvm::make_early_inc_range(filterOp->getUsers())) {
+        auto eco = llvm::cast<daphne::ExtractColOp>(user);
+        builder.setInsertionPoint(eco);
+        Type resTy = eco.getType();
+        if (auto ft = resTy.dyn_cast<daphne::FrameType>())
+            resTy = ft.withSameColumnTypes();
+        Value cols = builder.create<daphne::ExtractColOp>(eco.getLoc(), resTy, source, eco.getSelectedCols());
+        Value res = builder.create<daphne::ExtractRowOp>(eco.getLoc(), resTy, cols, pos);
+        eco.getResult().replaceAllUsesWith(res);
+        eco->erase();
+    }
+    filterOp->erase();
+    return true;
+}
+
+} // namespace
+
+void SqlOptPass::runOnOperation() {
+    func::FuncOp f = getOperation();
+    std::vector<daphne::FilterRowOp> filterOps;
+    f.walk([&](daphne::FilterRowOp op) {
+        if (op.getSource().getType().isa<daphne::FrameType>())
+            filterOps.push_back(op);
+    });
+    // Most functions do not filter any frames, leave them alone.
+    if (filterOps.empty()) {
+        markAllAnalysesPreserved();
+        return;
+    }
+
+    bool changed = false;
+    for (daphne::FilterRowOp op : filterOps)
+        changed |= JoinRegionRewriter(op).rewrite();
+
+    // The join regions may have introduced new filters, so collect them again.
+    filterOps.clear();
+    f.walk([&](daphne::FilterRowOp op) { filterOps.push_back(op); });
+    for (daphne::FilterRowOp op : filterOps)
+        changed |= materializeLate(op);
+
+    if (!changed) {
+        markAllAnalysesPreserved();
+        return;
+    }
+
+    // Infer the properties of the operations created above.
+    OpPassManager inferencePM(func::FuncOp::getOperationName());
+    inferencePM.addPass(daphne::createInferencePass());
+    if (failed(runPipeline(inferencePM, f)))
+        signalPassFailure();
+}
+
+std::unique_ptr<Pass> daphne::createSqlOptPass() { return std::make_unique<SqlOptPass>(); }
@@ -179,6 +179,47 @@ void movePipelineInterleavedOperations(Block::iterator pipelinePosition,
     }
 }
 
+/**
+ * @brief Returns if all results of the given operation are frames.
+ *
+ * A pipeline has a single kind of outputs, since the run-time combines the
+ * results of all operations of a pipeline alike. Pipelines on frames
+ * concatenate the results of the individual row ranges (morsels), such that
+ * the number of rows of the results need not be known in advance.
+ */
+bool producesFrames(Operation *op) {
+    return op->getNumResults() > 0 &&
+           llvm::all_of(op->getResultTypes(), [](Type t) { return llvm::isa<daphne::FrameType>(t); });
+}
+
+/**
+ * @brief Returns if the given value is a constant string (e.g., a column
+ * label).
+ *
+ * String arguments cannot be passed to a pipeline, so constant strings are
+ * copied into the pipeline body instead.
+ */
+bool isConstantString(Value v) {
+    return llvm::isa<daphne::StringType>(v.getType()) && v.getDefiningOp<daphne::ConstantOp>();
+}
+
+/**
+ * @brief Checks if the given vectorizable operation can become part of a
+ * pipeline.
+ */
+bool isVectorizationCandidate(Operation *op) {
+    if (producesFrames(op))
+        return llvm::all_of(op->getOperands(), [](Value v) {
+            return !llvm::isa<daphne::StringType>(v.getType()) || isConstantString(v);
+        });
+    // The results of matrix pipelines are allocated with their final size
+    // upfront, which is unknown for filtered rows.
+    if (llvm::isa<daphne::FilterRowOp>(op))
+        return false;
+    return CompilerUtils::isMatrixComputation(op) &&
+           llvm::none_of(op->getResultTypes(), [](Type t) { return llvm::isa<daphne::FrameType>(t); });
+}
+
 struct VectorizeComputationsPass : public PassWrapper<VectorizeComputationsPass, OperationPass<func::FuncOp>> {
     void runOnOperation() final;
 };
@@ -194,7 +235,7 @@ void VectorizeComputationsPass::runOnOperation() {
     // Find vectorizable operations and their inputs of vectorizable operations
     std::vector<daphne::Vectorizable> vectOps;
     func->walk([&](daphne::Vectorizable op) {
-        if (CompilerUtils::isMatrixComputation(op))
+        if (isVectorizationCandidate(op))
             vectOps.emplace_back(op);
     });
     std::vector<daphne::Vectorizable> vectorizables(vectOps.begin(), vectOps.end());
@@ -203,7 +244,8 @@ void VectorizeComputationsPass::runOnOperation() {
         for (auto e : llvm::zip(v->getOperands(), v.getVectorSplits())) {
             auto operand = std::get<0>(e);
             auto defOp = operand.getDefiningOp<daphne::Vectorizable>();
-            if (defOp && v->getBlock() == defOp->getBlock() && CompilerUtils::isMatrixComputation(defOp)) {
+            if (defOp && v->getBlock() == defOp->getBlock() && isVectorizationCandidate(defOp) &&
+                producesFrames(defOp) == producesFrames(v)) {
                 // defOp is not a candidate for fusion with v, if the
                 // result/operand along which we would fuse is used within a
                 // nested block (e.g., control structure) between defOp and v.
@@ -307,7 +349,7 @@ void VectorizeComputationsPass::runOnOperation() {
             //  just directly use an I64ArrayAttribute
             for (auto i = 0u; i < v->getNumOperands(); ++i) {
                 auto operand = v->getOperand(i);
-                if (!valueIsPartOfPipeline(operand)) {
+                if (!valueIsPartOfPipeline(operand) && !isConstantString(operand)) {
                     vSplitAttrs.push_back(daphne::VectorSplitAttr::get(&getContext(), vSplits[i]));
                     operands.push_back(operand);
                 }
@@ -339,9 +381,13 @@ void VectorizeComputationsPass::runOnOperation() {
             auto argTy = operands[i].getType();
             switch (vSplitAttrs[i].cast<daphne::VectorSplitAttr>().getValue()) {
             case daphne::VectorSplit::ROWS: {
-                auto matTy = argTy.cast<daphne::MatrixType>();
                 // only remove row information
-                argTy = matTy.withShape(-1, matTy.getNumCols());
+                if (auto frmTy = argTy.dyn_cast<daphne::FrameType>())
+                    argTy = frmTy.withShape(-1, frmTy.getNumCols());
+                else {
+                    auto matTy = argTy.cast<daphne::MatrixType>();
+                    argTy = matTy.withShape(-1, matTy.getNumCols());
+                }
                 break;
             }
             case daphne::VectorSplit::NONE:
@@ -361,9 +407,14 @@ void VectorizeComputationsPass::runOnOperation() {
             v->moveBefore(bodyBlock, bodyBlock->end());
 
             for (auto i = 0u; i < numOperands; ++i) {
-                if (!valueIsPartOfPipeline(v->getOperand(i))) {
+                Value operand = v->getOperand(i);
+                if (valueIsPartOfPipeline(operand))
+                    continue;
+                if (isConstantString(operand)) {
+                    OpBuilder bodyBuilder(v);
+                    v->setOperand(i, bodyBuilder.clone(*operand.getDefiningOp())->getResult(0));
+                } else
                     v->setOperand(i, bodyBlock->getArgument(argsIx++));
-                }
             }
 
             auto pipelineReplaceResults = pipelineOp->getResults().drop_front(resultsIx).take_front(numResults);
@@ -383,6 +434,12 @@ void VectorizeComputationsPass::runOnOperation() {
                         continue;
 
                     if (auto nrowOp = llvm::dyn_cast<daphne::NumRowsOp>(op)) {
+                        // The number of rows of a frame result is only known
+                        // after the pipeline, so only the size computations of
+                        // the pipeline itself can be replaced.
+                        if (llvm::isa<daphne::FrameType>(old.getType()) &&
+                            !(op->getBlock() == pipelineOp->getBlock() && op->isBeforeInBlock(pipelineOp)))
+                            continue;
                         nrowOp.replaceAllUsesWith(pipelineOp.getOutRows()[replacement.getResultNumber()]);
                         nrowOp.erase();
                     }
@@ -401,6 +458,8 @@ void VectorizeComputationsPass::runOnOperation() {
             for (auto resVal : op->getResults()) {
                 if (auto ty = resVal.getType().dyn_cast<daphne::MatrixType>()) {
                     resVal.setType(ty.withShape(-1, -1));
+                } else if (auto ty = resVal.getType().dyn_cast<daphne::FrameType>()) {
+                    resVal.setType(ty.withShape(-1, ty.getNumCols()));
                 }
             }
         });
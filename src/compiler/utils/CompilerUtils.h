@@ -204,6 +204,10 @@ struct CompilerUtils {
             const std::string tName =
                 mlirTypeToCppTypeName(handleTy.getDataType(), angleBrackets, generalizeToStructure);
             return angleBrackets ? ("Handle<" + tName + ">") : ("Handle_" + tName);
+        } else if (auto futureTy = t.dyn_cast<mlir::daphne::FutureType>()) {
+            const std::string tName =
+                mlirTypeToCppTypeName(futureTy.getDataType(), angleBrackets, generalizeToStructure);
+            return angleBrackets ? ("Future<" + tName + ">") : ("Future_" + tName);
         } else if (llvm::isa<mlir::daphne::FileType>(t))
             return "File";
         else if (llvm::isa<mlir::daphne::DescriptorType>(t))
@@ -223,6 +227,36 @@ struct CompilerUtils {
         throw std::runtime_error("no C++ type name known for the given MLIR type: " + typeName);
     }
 
+    /**
+     * @brief Returns the `ValueTypeCode` the runtime uses for the given MLIR
+     * value type, e.g., in the schema of a frame.
+     */
+    static ValueTypeCode mlirTypeToValueTypeCode(mlir::Type t) {
+        if (t.isF64())
+            return ValueTypeCode::F64;
+        else if (t.isF32())
+            return ValueTypeCode::F32;
+        else if (t.isSignedInteger(8))
+            return ValueTypeCode::SI8;
+        else if (t.isSignedInteger(32))
+            return ValueTypeCode::SI32;
+        else if (t.isSignedInteger(64))
+            return ValueTypeCode::SI64;
+        else if (t.isUnsignedInteger(8))
+            return ValueTypeCode::UI8;
+        else if (t.isUnsignedInteger(32))
+            return ValueTypeCode::UI32;
+        else if (t.isUnsignedInteger(64))
+            return ValueTypeCode::UI64;
+        else if (llvm::isa<mlir::daphne::StringType>(t))
+            return ValueTypeCode::STR;
+
+        std::string typeName;
+        llvm::raw_string_ostream rsos(typeName);
+        t.print(rsos);
+        throw std::runtime_error("no value type code known for the given MLIR type: " + typeName);
+    }
+
     static bool isMatrixComputation(mlir::Operation *v);
 
     /**
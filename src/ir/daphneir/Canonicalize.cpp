@@ -593,3 +593,49 @@ mlir::LogicalResult mlir::daphne::EwMinusOp::canonicalize(mlir::daphne::EwMinusO
     }
     return mlir::failure();
 }
+
+/**
+ * @brief Replaces `sliceRow(order(X, ...), lo, hi)` by `topK(X, hi, ...)`, or
+ * by `sliceRow(topK(X, hi, ...), lo, hi)` if `lo > 0`, such that only the
+ * first `hi` rows need to be ordered instead of all rows.
+ *
+ * The rewrite only happens if the bounds are constants and the result of the
+ * `OrderOp` has no other uses.
+ *
+ * @param op
+ * @param rewriter
+ * @return
+ */
+mlir::LogicalResult mlir::daphne::SliceRowOp::canonicalize(mlir::daphne::SliceRowOp op, PatternRewriter &rewriter) {
+    auto orderOp = op.getSource().getDefiningOp<mlir::daphne::OrderOp>();
+    if (!orderOp || !orderOp->hasOneUse())
+        return mlir::failure();
+    auto lowerIncl = CompilerUtils::isConstant<int64_t>(op.getLowerIncl());
+    auto upperExcl = CompilerUtils::isConstant<int64_t>(op.getUpperExcl());
+    if (!lowerIncl.first || !upperExcl.first || lowerIncl.second < 0 || upperExcl.second < lowerIncl.second)
+        return mlir::failure();
+
+    mlir::Location loc = op.getLoc();
+    mlir::Value k = rewriter.create<mlir::daphne::ConstantOp>(loc, rewriter.getIndexType(),
+                                                              rewriter.getIndexAttr(upperExcl.second));
+    if (lowerIncl.second == 0) {
+        rewriter.replaceOpWithNewOp<mlir::daphne::TopKOp>(op, op.getRes().getType(), orderOp.getArg(), k,
+                                                          orderOp.getColIdxs(), orderOp.getAscs(),
+                                                          orderOp.getReturnIdxs());
+    } else {
+        // The number of rows of the top-k result differs from that of both
+        // the order and the slice.
+        mlir::Type topKTy = orderOp.getRes().getType();
+        if (auto mt = topKTy.dyn_cast<mlir::daphne::MatrixType>())
+            topKTy = mt.withShape(-1, mt.getNumCols());
+        else if (auto ft = topKTy.dyn_cast<mlir::daphne::FrameType>())
+            topKTy = ft.withShape(-1, ft.getNumCols());
+        mlir::Value topK =
+            rewriter.create<mlir::daphne::TopKOp>(loc, topKTy, orderOp.getArg(), k, orderOp.getColIdxs(),
+                                                  orderOp.getAscs(), orderOp.getReturnIdxs());
+        rewriter.replaceOpWithNewOp<mlir::daphne::SliceRowOp>(op, op.getRes().getType(), topK, op.getLowerIncl(),
+                                                              op.getUpperExcl());
+    }
+    rewriter.eraseOp(orderOp);
+    return mlir::success();
+}
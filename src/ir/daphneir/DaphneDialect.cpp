@@ -204,6 +204,12 @@ mlir::Type mlir::daphne::DaphneDialect::parseType(mlir::DialectAsmParser &parser
             return nullptr;
         }
         return mlir::daphne::HandleType::get(parser.getBuilder().getContext(), dataType);
+    } else if (keyword == "Future") {
+        mlir::Type dataType;
+        if (parser.parseLess() || parser.parseType(dataType) || parser.parseGreater()) {
+            return nullptr;
+        }
+        return mlir::daphne::FutureType::get(parser.getBuilder().getContext(), dataType);
     } else if (keyword == "String") {
         return StringType::get(parser.getBuilder().getContext());
     } else if (keyword == "DaphneContext") {
@@ -261,6 +267,8 @@ void mlir::daphne::DaphneDialect::printType(mlir::Type type, mlir::DialectAsmPri
         os << "List<" << t.getElementType() << '>';
     } else if (auto handle = type.dyn_cast<mlir::daphne::HandleType>()) {
         os << "Handle<" << handle.getDataType() << ">";
+    } else if (auto future = type.dyn_cast<mlir::daphne::FutureType>()) {
+        os << "Future<" << future.getDataType() << ">";
     } else if (isa<mlir::daphne::StringType>(type))
         os << "String";
     else if (auto t = type.dyn_cast<mlir::daphne::VariadicPackType>())
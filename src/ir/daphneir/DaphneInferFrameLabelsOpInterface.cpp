@@ -97,6 +97,14 @@ void daphne::CreateFrameOp::inferFrameLabels() {
     res.setType(res.getType().dyn_cast<daphne::FrameType>().withLabels(resLabels));
 }
 
+void daphne::ReceiveFromArrowOp::inferFrameLabels() {
+    auto resLabels = new std::vector<std::string>();
+    for (Value label : getLabels())
+        resLabels->push_back(CompilerUtils::constantOrThrow<std::string>(label));
+    Value res = getResult();
+    res.setType(res.getType().dyn_cast<daphne::FrameType>().withLabels(resLabels));
+}
+
 void daphne::ExtractColOp::inferFrameLabels() {
     auto ft = getSource().getType().dyn_cast<daphne::FrameType>();
     auto st = getSelectedCols().getType().dyn_cast<daphne::StringType>();
@@ -171,6 +179,14 @@ void daphne::OrderOp::inferFrameLabels() {
     }
 }
 
+void daphne::TopKOp::inferFrameLabels() {
+    Type t = getArg().getType();
+    if (auto ft = t.dyn_cast<daphne::FrameType>()) {
+        Value res = getResult();
+        res.setType(res.getType().dyn_cast<daphne::FrameType>().withLabels(ft.getLabels()));
+    }
+}
+
 void daphne::InnerJoinOp::inferFrameLabels() {
     auto newLabels = new std::vector<std::string>();
     auto ft1 = getLhs().getType().dyn_cast<daphne::FrameType>();
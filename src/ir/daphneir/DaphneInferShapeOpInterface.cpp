@@ -262,6 +262,25 @@ std::vector<std::pair<ssize_t, ssize_t>> daphne::OrderOp::inferShape() {
     return {{numRows, numCols}};
 }
 
+std::vector<std::pair<ssize_t, ssize_t>> daphne::TopKOp::inferShape() {
+    ssize_t numCols = -1;
+
+    Type t = getArg().getType();
+    if (auto mt = t.dyn_cast<daphne::MatrixType>())
+        numCols = mt.getNumCols();
+    if (auto ft = t.dyn_cast<daphne::FrameType>())
+        numCols = ft.getNumCols();
+    std::pair<bool, bool> p = CompilerUtils::isConstant<bool>(getReturnIdxs());
+    if (p.first) {
+        if (p.second)
+            numCols = 1;
+    } else
+        numCols = -1;
+
+    auto k = CompilerUtils::isConstant<uint64_t>(getK());
+    return {{k.first ? static_cast<ssize_t>(k.second) : -1, numCols}};
+}
+
 std::vector<std::pair<ssize_t, ssize_t>> daphne::CondOp::inferShape() {
     Type condTy = getCond().getType();
     if (llvm::isa<daphne::UnknownType>(condTy))
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <compiler/inference/SparsitySketch.h>
 #include <compiler/utils/CompilerUtils.h>
 #include <ir/daphneir/Daphne.h>
 
@@ -67,9 +68,23 @@ std::vector<double> daphne::MatMulOp::inferSparsity() {
     if (lhsTy.getSparsity() == -1.0 || rhsTy.getSparsity() == -1.0) {
         return {-1.0};
     }
-    auto k = lhsTy.getNumCols();
+    const bool ta = CompilerUtils::constantOrDefault<bool>(getTransa(), false);
+    const bool tb = CompilerUtils::constantOrDefault<bool>(getTransb(), false);
+    if (lhsTy.getNumRows() != -1 && lhsTy.getNumCols() != -1 && rhsTy.getNumRows() != -1 &&
+        rhsTy.getNumCols() != -1) {
+        // Sketch-based estimate, which accounts for diagonal arguments.
+        auto sketch = [](Value v, daphne::MatrixType mt, bool trans) {
+            SparsitySketch s =
+                v.getDefiningOp<daphne::DiagMatrixOp>()
+                    ? SparsitySketch::diagonal(mt.getNumRows(), mt.getSparsity() * mt.getNumRows() * mt.getNumCols())
+                    : SparsitySketch::uniform(mt.getNumRows(), mt.getNumCols(), mt.getSparsity());
+            return trans ? s.transposed() : s;
+        };
+        return {SparsitySketch::matMul(sketch(getLhs(), lhsTy, ta), sketch(getRhs(), rhsTy, tb)).sparsity()};
+    }
+    auto k = ta ? lhsTy.getNumRows() : lhsTy.getNumCols();
     if (k == -1) {
-        k = rhsTy.getNumRows();
+        k = tb ? rhsTy.getNumCols() : rhsTy.getNumRows();
     }
     if (k == -1)
         return {-1.0};
@@ -322,6 +322,23 @@ std::vector<Type> daphne::OrderOp::inferTypes() {
     return {t};
 }
 
+std::vector<Type> daphne::TopKOp::inferTypes() {
+    std::pair<bool, bool> returnIdxs = CompilerUtils::isConstant<bool>(getReturnIdxs());
+    if (!returnIdxs.first)
+        return {daphne::UnknownType::get(getContext())};
+    if (returnIdxs.second)
+        // The positions of the top-k rows in the argument.
+        return {daphne::MatrixType::get(getContext(), Builder(getContext()).getIndexType())};
+
+    Type srcType = getArg().getType();
+    Type t;
+    if (auto mt = srcType.dyn_cast<daphne::MatrixType>())
+        t = mt.withSameElementType();
+    else if (auto ft = srcType.dyn_cast<daphne::FrameType>())
+        t = ft.withSameColumnTypes();
+    return {t};
+}
+
 mlir::Type mlirTypeForCode(ValueTypeCode type, Builder builder) {
     switch (type) {
     case ValueTypeCode::SI8:
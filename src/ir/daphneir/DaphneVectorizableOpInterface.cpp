@@ -225,9 +225,26 @@ std::vector<std::pair<Value, Value>> daphne::ExtractColOp::createOpsOutputSizes(
     auto loc = getLoc();
     auto sizeTy = builder.getIndexType();
     auto rows = builder.create<daphne::NumRowsOp>(loc, sizeTy, getSource());
-    // TODO: support scalar and maybe (based on definition of `ExtractColOp`)
-    // apply some kind of `unique()` op
-    auto cols = builder.create<daphne::NumRowsOp>(loc, sizeTy, getSelectedCols());
+    Value cols;
+    if (llvm::isa<daphne::StringType>(getSelectedCols().getType()))
+        // A single column of a frame, selected by its label.
+        cols = builder.create<daphne::ConstantOp>(loc, sizeTy, builder.getIndexAttr(1));
+    else
+        // TODO: support scalar and maybe (based on definition of `ExtractColOp`)
+        // apply some kind of `unique()` op
+        cols = builder.create<daphne::NumRowsOp>(loc, sizeTy, getSelectedCols());
+    return {{rows, cols}};
+}
+std::vector<daphne::VectorSplit> daphne::FilterRowOp::getVectorSplits() {
+    return {daphne::VectorSplit::ROWS, daphne::VectorSplit::ROWS};
+}
+std::vector<daphne::VectorCombine> daphne::FilterRowOp::getVectorCombines() { return {daphne::VectorCombine::ROWS}; }
+std::vector<std::pair<Value, Value>> daphne::FilterRowOp::createOpsOutputSizes(OpBuilder &builder) {
+    auto loc = getLoc();
+    auto sizeTy = builder.getIndexType();
+    // Only an upper bound, the combine of frames does not rely on it.
+    auto rows = builder.create<daphne::NumRowsOp>(loc, sizeTy, getSource());
+    auto cols = builder.create<daphne::NumColsOp>(loc, sizeTy, getSource());
     return {{rows, cols}};
 }
 // ----------------------------------------------------------------------------
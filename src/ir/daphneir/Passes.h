@@ -53,15 +53,18 @@ std::unique_ptr<Pass> createInsertDaphneContextPass(const DaphneUserConfig &cfg)
 std::unique_ptr<Pass> createLowerToLLVMPass(const DaphneUserConfig &cfg);
 std::unique_ptr<Pass> createManageObjRefsPass();
 std::unique_ptr<Pass> createMapOpLoweringPass();
+std::unique_ptr<Pass> createMatMulChainPass(double sparsityThreshold = 0.25);
 std::unique_ptr<OperationPass<ModuleOp>>
 createMatMulOpLoweringPass(bool matmul_tile, int matmul_vec_size_bits = 0,
                            std::vector<unsigned> matmul_fixed_tile_sizes = {}, bool matmul_use_fixed_tile_sizes = false,
                            int matmul_unroll_factor = 1, int matmul_unroll_jam_factor = 4,
-                           int matmul_num_vec_registers = 16, bool matmul_invert_loops = false);
+                           int matmul_num_vec_registers = 16, bool matmul_invert_loops = false,
+                           std::string matmul_tuning_profile = "");
 std::unique_ptr<OperationPass<ModuleOp>> createMatMulOpLoweringPass();
 std::unique_ptr<Pass> createMemRefTestPass();
 std::unique_ptr<Pass> createModOpLoweringPass();
 std::unique_ptr<Pass> createPhyOperatorSelectionPass();
+std::unique_ptr<Pass> createPrefetchReadsPass();
 std::unique_ptr<Pass> createPrintIRPass(std::string message = "");
 std::unique_ptr<Pass> createProfilingPass();
 std::unique_ptr<Pass> createRewriteSqlOpPass();
@@ -69,6 +72,7 @@ std::unique_ptr<Pass> createRewriteToCallKernelOpPass(const DaphneUserConfig &cf
                                                       std::unordered_map<std::string, bool> &usedLibPaths);
 std::unique_ptr<Pass> createSelectMatrixRepresentationsPass(const DaphneUserConfig &cfg);
 std::unique_ptr<Pass> createSpecializeGenericFunctionsPass(const DaphneUserConfig &cfg);
+std::unique_ptr<Pass> createSqlOptPass();
 std::unique_ptr<Pass> createTransposeOpLoweringPass();
 std::unique_ptr<Pass> createVectorizeComputationsPass();
 #ifdef USE_CUDA
@@ -69,6 +69,12 @@ KernelCatalogParser::KernelCatalogParser(mlir::MLIRContext *mctx) {
         mlir::Type ltCSR = mlir::daphne::ListType::get(mctx, mtCSR);
         typeMap.emplace(CompilerUtils::mlirTypeToCppTypeName(ltCSR), ltCSR);
 
+        // Future types for the asynchronous reading of matrices.
+        for (mlir::Type mt : {mtDense, mtCSR}) {
+            mlir::Type ft = mlir::daphne::FutureType::get(mctx, mt);
+            typeMap.emplace(CompilerUtils::mlirTypeToCppTypeName(ft), ft);
+        }
+
         // MemRef type.
         if (!st.isa<mlir::daphne::StringType>()) {
             // DAPHNE's StringType is not supported as the element type of a
@@ -80,11 +86,13 @@ KernelCatalogParser::KernelCatalogParser(mlir::MLIRContext *mctx) {
         }
     }
 
-    // Structure, Frame, DaphneContext, MemRef.
+    // Structure, Frame, DaphneContext, MemRef, Future.
+    mlir::Type ft = mlir::daphne::FrameType::get(mctx, {mlir::daphne::UnknownType::get(mctx)});
     std::vector<mlir::Type> otherTypes = {
         mlir::daphne::StructureType::get(mctx),
-        mlir::daphne::FrameType::get(mctx, {mlir::daphne::UnknownType::get(mctx)}),
+        ft,
         mlir::daphne::DaphneContextType::get(mctx),
+        mlir::daphne::FutureType::get(mctx, ft),
     };
     for (mlir::Type t : otherTypes) {
         typeMap.emplace(CompilerUtils::mlirTypeToCppTypeName(t), t);
@@ -55,8 +55,14 @@ void ConfigParser::readUserConfig(const std::string &filename, DaphneUserConfig
         config.use_ipa_const_propa = jf.at(DaphneConfigJsonParams::USE_IPA_CONST_PROPA).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::USE_PHY_OP_SELECTION))
         config.use_phy_op_selection = jf.at(DaphneConfigJsonParams::USE_PHY_OP_SELECTION).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::USE_ASYNC_READ))
+        config.use_async_read = jf.at(DaphneConfigJsonParams::USE_ASYNC_READ).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::USE_ADAPTIVE_MATRIX_REPR))
+        config.use_adaptive_matrix_repr = jf.at(DaphneConfigJsonParams::USE_ADAPTIVE_MATRIX_REPR).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::USE_MLIR_CODEGEN))
         config.use_mlir_codegen = jf.at(DaphneConfigJsonParams::USE_MLIR_CODEGEN).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::USE_MLIR_CODEGEN_PARALLEL))
+        config.use_mlir_codegen_parallel = jf.at(DaphneConfigJsonParams::USE_MLIR_CODEGEN_PARALLEL).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::MATMUL_VEC_SIZE_BITS))
         config.matmul_vec_size_bits = jf.at(DaphneConfigJsonParams::MATMUL_VEC_SIZE_BITS).get<int>();
     if (keyExists(jf, DaphneConfigJsonParams::MATMUL_TILE))
@@ -74,6 +80,8 @@ void ConfigParser::readUserConfig(const std::string &filename, DaphneUserConfig
         config.matmul_num_vec_registers = jf.at(DaphneConfigJsonParams::MATMUL_NUM_VEC_REGISTERS).get<int>();
     if (keyExists(jf, DaphneConfigJsonParams::MATMUL_INVERT_LOOPS))
         config.matmul_invert_loops = jf.at(DaphneConfigJsonParams::MATMUL_INVERT_LOOPS).get<bool>();
+    if (keyExists(jf, DaphneConfigJsonParams::MATMUL_TUNING_PROFILE))
+        config.matmul_tuning_profile = jf.at(DaphneConfigJsonParams::MATMUL_TUNING_PROFILE).get<std::string>();
     if (keyExists(jf, DaphneConfigJsonParams::CUDA_FUSE_ANY))
         config.cuda_fuse_any = jf.at(DaphneConfigJsonParams::CUDA_FUSE_ANY).get<bool>();
     if (keyExists(jf, DaphneConfigJsonParams::VECTORIZED_SINGLE_QUEUE))
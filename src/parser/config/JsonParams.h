@@ -29,7 +29,10 @@ struct DaphneConfigJsonParams {
     inline static const std::string USE_OBJ_REF_MGNT = "use_obj_ref_mgnt";
     inline static const std::string USE_IPA_CONST_PROPA = "use_ipa_const_propa";
     inline static const std::string USE_PHY_OP_SELECTION = "use_phy_op_selection";
+    inline static const std::string USE_ASYNC_READ = "use_async_read";
+    inline static const std::string USE_ADAPTIVE_MATRIX_REPR = "use_adaptive_matrix_repr";
     inline static const std::string USE_MLIR_CODEGEN = "use_mlir_codegen";
+    inline static const std::string USE_MLIR_CODEGEN_PARALLEL = "use_mlir_codegen_parallel";
     inline static const std::string MATMUL_VEC_SIZE_BITS = "matmul_vec_size_bits";
     inline static const std::string MATMUL_TILE = "matmul_tile";
     inline static const std::string MATMUL_FIXED_TILE_SIZES = "matmul_fixed_tile_sizes";
@@ -38,6 +41,7 @@ struct DaphneConfigJsonParams {
     inline static const std::string MATMUL_UNROLL_JAM_FACTOR = "matmul_unroll_jam_factor";
     inline static const std::string MATMUL_NUM_VEC_REGISTERS = "matmul_num_vec_registers";
     inline static const std::string MATMUL_INVERT_LOOPS = "matmul_invert_loops";
+    inline static const std::string MATMUL_TUNING_PROFILE = "matmul_tuning_profile";
     inline static const std::string CUDA_FUSE_ANY = "cuda_fuse_any";
     inline static const std::string VECTORIZED_SINGLE_QUEUE = "vectorized_single_queue";
 
@@ -79,12 +83,16 @@ struct DaphneConfigJsonParams {
                                                      MATMUL_UNROLL_JAM_FACTOR,
                                                      MATMUL_NUM_VEC_REGISTERS,
                                                      MATMUL_INVERT_LOOPS,
+                                                     MATMUL_TUNING_PROFILE,
                                                      USE_CUDA_,
                                                      USE_VECTORIZED_EXEC,
                                                      USE_OBJ_REF_MGNT,
                                                      USE_IPA_CONST_PROPA,
                                                      USE_PHY_OP_SELECTION,
+                                                     USE_ASYNC_READ,
+                                                     USE_ADAPTIVE_MATRIX_REPR,
                                                      USE_MLIR_CODEGEN,
+                                                     USE_MLIR_CODEGEN_PARALLEL,
                                                      CUDA_FUSE_ANY,
                                                      VECTORIZED_SINGLE_QUEUE,
                                                      DEBUG_LLVM,
@@ -302,6 +302,70 @@ mlir::ResultRange DaphneDSLBuiltins::createPoolFwdOp(mlir::Location loc, const s
 // Other utilities
 // ****************************************************************************
 
+mlir::Type DaphneDSLBuiltins::getValueTypeFromCode(mlir::Location loc, int64_t valueTypeCode) {
+    switch (static_cast<ValueTypeCode>(valueTypeCode)) {
+    case ValueTypeCode::F32:
+        return builder.getF32Type();
+    case ValueTypeCode::F64:
+        return builder.getF64Type();
+    case ValueTypeCode::SI8:
+        return builder.getIntegerType(8, true);
+    case ValueTypeCode::SI32:
+        return builder.getIntegerType(32, true);
+    case ValueTypeCode::SI64:
+        return builder.getIntegerType(64, true);
+    case ValueTypeCode::UI8:
+        return builder.getIntegerType(8, false);
+    case ValueTypeCode::UI32:
+        return builder.getIntegerType(32, false);
+    case ValueTypeCode::UI64:
+        return builder.getIntegerType(64, false);
+    case ValueTypeCode::STR:
+        return mlir::daphne::StringType::get(builder.getContext());
+    default:
+        throw ErrorHandler::compilerError(loc, "DSLBuiltins", "invalid value type code");
+    }
+}
+
+mlir::Type DaphneDSLBuiltins::getValueTypeFromCode(mlir::Location loc, const std::string &func,
+                                                    mlir::Value valueTypeCode) {
+    const int64_t vtc = CompilerUtils::constantOrThrow<int64_t>(
+        valueTypeCode, "the value type codes passed to " + func + "() must be constants");
+    return getValueTypeFromCode(loc, vtc);
+}
+
+mlir::Type DaphneDSLBuiltins::getResidentObjectType(mlir::Location loc, const std::string &func, mlir::Value name) {
+    if (!residentObjects)
+        throw ErrorHandler::compilerError(loc, "DSLBuiltins", func + "() can only be used in a DaphneLib session");
+    const std::string nameStr =
+        CompilerUtils::constantOrThrow<std::string>(name, "the name passed to " + func + "() must be a constant");
+
+    // The type is determined by the object stored at the time the script is
+    // compiled. Thus, objects stored by this script itself are not visible.
+    ResidentObject res;
+    try {
+        res = residentObjects->get(nameStr);
+    } catch (std::runtime_error &e) {
+        throw ErrorHandler::compilerError(loc, "DSLBuiltins", e.what());
+    }
+    switch (res.kind) {
+    case ResidentObject::Kind::DENSE_MATRIX:
+        return utils.matrixOf(getValueTypeFromCode(loc, static_cast<int64_t>(res.valueType)));
+    case ResidentObject::Kind::CSR_MATRIX:
+        return utils.matrixOf(getValueTypeFromCode(loc, static_cast<int64_t>(res.valueType)))
+            .withRepresentation(mlir::daphne::MatrixRepresentation::Sparse);
+    case ResidentObject::Kind::FRAME: {
+        std::vector<mlir::Type> colTypes;
+        for (ValueTypeCode vtc : res.schema)
+            colTypes.push_back(getValueTypeFromCode(loc, static_cast<int64_t>(vtc)));
+        return mlir::daphne::FrameType::get(builder.getContext(), colTypes)
+            .withLabels(new std::vector<std::string>(res.labels));
+    }
+    default:
+        throw ErrorHandler::compilerError(loc, "DSLBuiltins", "unsupported kind of resident object");
+    }
+}
+
 antlrcpp::Any DaphneDSLBuiltins::build(mlir::Location loc, const std::string &func,
                                        const std::vector<mlir::Value> &args) {
     using namespace mlir::daphne;
@@ -1156,41 +1220,53 @@ antlrcpp::Any DaphneDSLBuiltins::build(mlir::Location loc, const std::string &fu
         mlir::Value address = utils.castUI64If(args[0]);
         mlir::Value rows = args[1];
         mlir::Value cols = args[2];
-        mlir::Value valueType = args[3];
-
-        int64_t valueTypeCode = CompilerUtils::constantOrThrow<int64_t>(
-            valueType, "the value type code in ReceiveFromNumpyOp must be a constant");
-
-        // TODO Is there a utility for this mapping from value type code to MLIR
-        // type?
-        mlir::Type vt;
-        if (valueTypeCode == (int64_t)ValueTypeCode::F32)
-            vt = builder.getF32Type();
-        else if (valueTypeCode == (int64_t)ValueTypeCode::F64)
-            vt = builder.getF64Type();
-        else if (valueTypeCode == (int64_t)ValueTypeCode::SI8)
-            vt = builder.getIntegerType(8, true);
-        else if (valueTypeCode == (int64_t)ValueTypeCode::SI32)
-            vt = builder.getIntegerType(32, true);
-        else if (valueTypeCode == (int64_t)ValueTypeCode::SI64)
-            vt = builder.getIntegerType(64, true);
-        else if (valueTypeCode == (int64_t)ValueTypeCode::UI8)
-            vt = builder.getIntegerType(8, false);
-        else if (valueTypeCode == (int64_t)ValueTypeCode::UI32)
-            vt = builder.getIntegerType(32, false);
-        else if (valueTypeCode == (int64_t)ValueTypeCode::UI64)
-            vt = builder.getIntegerType(64, false);
-        else
+        mlir::Type vt = getValueTypeFromCode(loc, func, args[3]);
+        if (llvm::isa<StringType>(vt))
             throw ErrorHandler::compilerError(loc, "DSLBuiltins", "invalid value type code");
 
         return static_cast<mlir::Value>(
             builder.create<ReceiveFromNumpyOp>(loc, utils.matrixOf(vt), address, rows, cols));
     }
+    if (func == "receiveFromArrow") {
+        // receiveFromArrow(arrayAddress, schemaAddress, vtc_0, ..., vtc_n-1, label_0, ..., label_n-1)
+        checkNumArgsMin(loc, func, numArgs, 4);
+        checkNumArgsEven(loc, func, numArgs);
+
+        mlir::Value arrayAddress = utils.castUI64If(args[0]);
+        mlir::Value schemaAddress = utils.castUI64If(args[1]);
+        const size_t numCols = (numArgs - 2) / 2;
+        std::vector<mlir::Type> colTypes;
+        std::vector<mlir::Value> labels;
+        for (size_t i = 0; i < numCols; i++) {
+            colTypes.push_back(getValueTypeFromCode(loc, func, args[2 + i]));
+            mlir::Value label = args[2 + numCols + i];
+            if (!llvm::isa<StringType>(label.getType()))
+                throw ErrorHandler::compilerError(loc, "DSLBuiltins",
+                                                  "the column labels of receiveFromArrow() must be strings");
+            labels.push_back(label);
+        }
+
+        mlir::Type t = FrameType::get(builder.getContext(), colTypes);
+        return static_cast<mlir::Value>(
+            builder.create<ReceiveFromArrowOp>(loc, t, arrayAddress, schemaAddress, labels));
+    }
     if (func == "saveDaphneLibResult") {
         checkNumArgsExact(loc, func, numArgs, 1);
         mlir::Value arg = args[0];
         return builder.create<SaveDaphneLibResultOp>(loc, arg).getOperation();
     }
+    if (func == "storeResident") {
+        checkNumArgsExact(loc, func, numArgs, 2);
+        mlir::Value arg = args[0];
+        mlir::Value name = args[1];
+        return builder.create<StoreResidentOp>(loc, arg, name).getOperation();
+    }
+    if (func == "loadResident") {
+        checkNumArgsExact(loc, func, numArgs, 1);
+        mlir::Value name = args[0];
+        return static_cast<mlir::Value>(
+            builder.create<LoadResidentOp>(loc, getResidentObjectType(loc, func, name), name));
+    }
     if (func == "stop") {
         checkNumArgsBetween(loc, func, numArgs, 0, 1);
         mlir::Value message;
@@ -18,6 +18,7 @@
 #define SRC_PARSER_DAPHNEDSL_DAPHNEDSLBUILTINS_H
 
 #include <parser/ParserUtils.h>
+#include <runtime/local/context/ResidentObjectStore.h>
 #include <runtime/local/io/FileMetaData.h>
 
 #include "antlr4-runtime.h"
@@ -47,6 +48,12 @@ class DaphneDSLBuiltins {
      */
     ParserUtils utils;
 
+    /**
+     * @brief The data objects kept by the current DaphneLib session, or
+     * `nullptr` outside of a session.
+     */
+    const ResidentObjectStore *residentObjects;
+
     // ************************************************************************
     // Checking number of arguments
     // ************************************************************************
@@ -124,13 +131,17 @@ class DaphneDSLBuiltins {
 
     FileMetaData getFileMetaData(const std::string &func, mlir::Value filename);
 
+    mlir::Type getValueTypeFromCode(mlir::Location loc, int64_t valueTypeCode);
+
+    mlir::Type getValueTypeFromCode(mlir::Location loc, const std::string &func, mlir::Value valueTypeCode);
+
+    mlir::Type getResidentObjectType(mlir::Location loc, const std::string &func, mlir::Value name);
+
     // ************************************************************************
 
   public:
-    explicit DaphneDSLBuiltins(mlir::OpBuilder &builder)
-        : builder(builder), utils(builder){
-                                //
-                            };
+    explicit DaphneDSLBuiltins(mlir::OpBuilder &builder, const ResidentObjectStore *residentObjects = nullptr)
+        : builder(builder), utils(builder), residentObjects(residentObjects) {}
 
     antlrcpp::Any build(mlir::Location loc, const std::string &func, const std::vector<mlir::Value> &args);
 };
@@ -179,7 +179,8 @@ class DaphneDSLVisitor : public DaphneDSLGrammarVisitor {
     DaphneDSLVisitor(mlir::ModuleOp &module, mlir::OpBuilder &builder,
                      std::unordered_map<std::string, std::string> args, const std::string &rootScriptPath,
                      DaphneUserConfig userConf_)
-        : module(module), builder(builder), utils(builder), builtins(builder), args(std::move(args)) {
+        : module(module), builder(builder), utils(builder), builtins(builder, userConf_.resident_objects),
+          args(std::move(args)) {
         scriptPaths.push(rootScriptPath);
         userConf = std::move(userConf_);
         logger = spdlog::get("parser");
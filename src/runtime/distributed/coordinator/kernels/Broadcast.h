@@ -19,6 +19,7 @@
 #include <runtime/local/context/DistributedContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/ChunkCompression.h>
 #include <runtime/local/io/DaphneSerializer.h>
 
 #include <runtime/distributed/coordinator/scheduling/LoadPartitioningDistributed.h>
@@ -35,6 +36,8 @@
 #endif
 
 #include <cstddef>
+#include <future>
+#include <memory>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -62,8 +65,6 @@ template <ALLOCATION_TYPE AT, class DT> void broadcast(DT *&mat, bool isScalar,
 #ifdef USE_MPI
 template <class DT> struct Broadcast<ALLOCATION_TYPE::DIST_MPI, DT> {
     static void apply(DT *&mat, bool isScalar, DCTX(dctx)) {
-        size_t messageLength = 0;
-        std::vector<char> dataToSend;
         double val = 1;
         if (isScalar) {
             auto ptr = (double *)(&mat);
@@ -81,30 +82,82 @@ template <class DT> struct Broadcast<ALLOCATION_TYPE::DIST_MPI, DT> {
             if (dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).getDistributedData().isPlacedAtWorker)
                 continue;
 
-            // Minimum chunk size
-            auto min_chunk_size =
-                dctx->config.max_distributed_serialization_chunk_size < DaphneSerializer<DT>::length(mat)
-                    ? dctx->config.max_distributed_serialization_chunk_size
-                    : DaphneSerializer<DT>::length(mat);
-
-            MPIHelper::initiateStreaming(rank, min_chunk_size);
             targetGroup.push_back(rank);
         }
 
+        // Minimum chunk size (for scalars, this is based on the empty
+        // placeholder matrix, so that the worker's buffer fits the header)
+        const size_t length = DaphneSerializer<DT>::length(mat);
+        auto min_chunk_size = dctx->config.max_distributed_serialization_chunk_size < length
+                                  ? dctx->config.max_distributed_serialization_chunk_size
+                                  : length;
+        // Scalars are too small to be worth compressing.
+        const CompressionCodec codec = isScalar ? CompressionCodec::NONE : dctx->config.distributed_compression;
+        ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(mat));
+
         if ((int)targetGroup.size() == MPIHelper::getCommSize() - 1) { // exclude coordinator
+            for (int rank : targetGroup)
+                MPIHelper::initiateStreaming(rank, min_chunk_size, 0, codec != CompressionCodec::NONE);
             if (isScalar) {
                 std::vector<char> buffer;
                 auto length = DaphneSerializer<double>::serialize(val, buffer);
                 MPIHelper::broadcastData(length, buffer.data());
+            } else if (codec != CompressionCodec::NONE) {
+                // The next chunk is compressed while the current one is
+                // broadcast.
+                std::vector<char> frames[2];
+                auto serializer = DaphneSerializerChunks<DT>(mat, min_chunk_size);
+                auto it = serializer.begin();
+                size_t frameLength = compressor.compress(it->second->data(), it->first, 0, frames[0]);
+                size_t offset = it->first;
+                for (size_t i = 0;; i++) {
+                    std::future<size_t> next;
+                    if (++it != serializer.end()) {
+                        next = std::async(std::launch::async, [&compressor, &it, &frames, i, offset]() {
+                            return compressor.compress(it->second->data(), it->first, offset, frames[(i + 1) % 2]);
+                        });
+                        offset += it->first;
+                    }
+                    MPIHelper::broadcastData(frameLength, frames[i % 2].data());
+                    if (!next.valid())
+                        break;
+                    frameLength = next.get();
+                }
             } else {
-                auto serializer =
-                    DaphneSerializerChunks<DT>(mat, dctx->config.max_distributed_serialization_chunk_size);
+                auto serializer = DaphneSerializerChunks<DT>(mat, min_chunk_size);
                 for (auto it = serializer.begin(); it != serializer.end(); ++it)
                     MPIHelper::broadcastData(it->first, it->second->data());
             }
         } else {
-            for (int i = 0; i < (int)targetGroup.size(); i++)
-                MPIHelper::sendData(messageLength, dataToSend.data(), targetGroup.at(i));
+            // Only some workers need the data, so we serialize it once and
+            // stream the chunks to each of them via non-blocking sends.
+            std::vector<std::shared_ptr<std::vector<char>>> chunks;
+            if (isScalar) {
+                chunks.push_back(std::make_shared<std::vector<char>>());
+                DaphneSerializer<double>::serialize(val, *chunks.back());
+            } else {
+                size_t offset = 0;
+                auto serializer = DaphneSerializerChunks<DT>(mat, min_chunk_size);
+                for (auto it = serializer.begin(); it != serializer.end(); ++it) {
+                    if (codec != CompressionCodec::NONE) {
+                        auto frame = std::make_shared<std::vector<char>>();
+                        frame->resize(compressor.compress(it->second->data(), it->first, offset, *frame));
+                        chunks.push_back(frame);
+                    } else
+                        chunks.push_back(
+                            std::make_shared<std::vector<char>>(it->second->begin(), it->second->begin() + it->first));
+                    offset += it->first;
+                }
+            }
+            MPIHelper::AsyncSender sender;
+            for (int rank : targetGroup) {
+                if (rank == COORDINATOR)
+                    continue;
+                MPIHelper::initiateStreaming(rank, min_chunk_size, chunks.size(), codec != CompressionCodec::NONE);
+                for (auto &chunk : chunks)
+                    sender.send(DATA, chunk, chunk->size(), rank);
+            }
+            sender.waitAll();
         }
         for (int i = 0; i < (int)targetGroup.size(); i++) {
             int rank = targetGroup.at(i);
@@ -173,9 +226,19 @@ template <class DT> struct Broadcast<ALLOCATION_TYPE::DIST_GRPC_ASYNC, DT> {
 
                 caller.sendDataStream(address, protoMsg);
             } else {
+                const CompressionCodec codec = dctx->config.distributed_compression;
+                ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(mat));
+                std::vector<char> frame;
+                size_t offset = 0;
                 auto serializer = DaphneSerializerChunks<DT>(mat, min_chunk_size);
                 for (auto it = serializer.begin(); it != serializer.end(); ++it) {
-                    protoMsg.set_bytes(it->second->data(), it->first);
+                    if (codec != CompressionCodec::NONE) {
+                        const size_t len = compressor.compress(it->second->data(), it->first, offset, frame);
+                        protoMsg.set_bytes(frame.data(), len);
+                    } else
+                        protoMsg.set_bytes(it->second->data(), it->first);
+                    protoMsg.set_compressed(codec != CompressionCodec::NONE);
+                    offset += it->first;
                     caller.sendDataStream(address, protoMsg);
                 }
             }
@@ -245,10 +308,20 @@ template <class DT> struct Broadcast<ALLOCATION_TYPE::DIST_GRPC_SYNC, DT> {
 
                     writer->Write(protoMsg);
                 } else {
+                    const CompressionCodec codec = dctx->config.distributed_compression;
+                    ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(mat));
+                    std::vector<char> frame;
+                    size_t offset = 0;
                     auto serializer =
                         DaphneSerializerChunks<DT>(mat, dctx->config.max_distributed_serialization_chunk_size);
                     for (auto it = serializer.begin(); it != serializer.end(); ++it) {
-                        protoMsg.set_bytes(it->second->data(), it->first);
+                        if (codec != CompressionCodec::NONE) {
+                            const size_t len = compressor.compress(it->second->data(), it->first, offset, frame);
+                            protoMsg.set_bytes(frame.data(), len);
+                        } else
+                            protoMsg.set_bytes(it->second->data(), it->first);
+                        protoMsg.set_compressed(codec != CompressionCodec::NONE);
+                        offset += it->first;
                         writer->Write(protoMsg);
                     }
                 }
@@ -20,6 +20,8 @@
 #include <runtime/local/context/DistributedContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/ChunkCompression.h>
+#include <runtime/local/io/DaphneSerializer.h>
 
 #include <runtime/distributed/proto/DistributedGRPCCaller.h>
 #include <runtime/distributed/worker/WorkerImpl.h>
@@ -30,6 +32,8 @@
 #endif
 
 #include <cstddef>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 
 // ****************************************************************************
@@ -55,9 +59,13 @@ template <ALLOCATION_TYPE AT, class DT> void distribute(DT *mat, DCTX(dctx)) { D
 // MPI
 // ----------------------------------------------------------------------------
 template <class DT> struct Distribute<ALLOCATION_TYPE::DIST_MPI, DT> {
+    // Maximum number of chunks in flight per worker when streaming
+    // point-to-point.
+    static constexpr size_t MAX_PENDING_CHUNKS = 4;
+
     static void apply(DT *mat, DCTX(dctx)) {
-        std::vector<char> dataToSend;
         std::vector<int> targetGroup;
+        std::vector<DataPlacement *> targetPlacements;
 
         LoadPartitioningDistributed<DT, AllocationDescriptorMPI> partioner(DistributionSchema::DISTRIBUTE, mat, dctx);
 
@@ -67,26 +75,21 @@ template <class DT> struct Distribute<ALLOCATION_TYPE::DIST_MPI, DT> {
 
             if (dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).getDistributedData().isPlacedAtWorker)
                 continue;
+            if (rank == COORDINATOR)
+                continue;
 
-            auto slicedMat = mat->sliceRow(dp->range->r_start, dp->range->r_start + dp->range->r_len);
-
-            // Minimum chunk size
-            auto min_chunk_size =
-                dctx->config.max_distributed_serialization_chunk_size < DaphneSerializer<DT>::length(slicedMat)
-                    ? dctx->config.max_distributed_serialization_chunk_size
-                    : DaphneSerializer<DT>::length(slicedMat);
-            MPIHelper::initiateStreaming(rank, min_chunk_size);
-            auto serializer = DaphneSerializerChunks<DT>(slicedMat, min_chunk_size);
-            for (auto it = serializer.begin(); it != serializer.end(); ++it) {
-                MPIHelper::sendData(it->first, it->second->data(), rank);
-            }
             targetGroup.push_back(rank);
-            DataObjectFactory::destroy(slicedMat);
+            targetPlacements.push_back(dp);
         }
+
+        // If every worker receives a part, a single MPI_Scatterv moves all
+        // parts at once. Otherwise, we stream the parts point-to-point.
+        if (!(static_cast<int>(targetGroup.size()) == MPIHelper::getCommSize() - 1 &&
+              scatter(mat, targetGroup, targetPlacements, dctx)))
+            stream(mat, targetGroup, targetPlacements, dctx);
+
         for (size_t i = 0; i < targetGroup.size(); i++) {
             int rank = targetGroup.at(i);
-            if (rank == COORDINATOR)
-                continue;
 
             WorkerImpl::StoredInfo dataAcknowledgement = MPIHelper::getDataAcknowledgement(&rank);
             std::string address = std::to_string(rank);
@@ -99,6 +102,113 @@ template <class DT> struct Distribute<ALLOCATION_TYPE::DIST_MPI, DT> {
             dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).updateDistributedData(data);
         }
     }
+
+  private:
+    /**
+     * @brief Serializes the parts of all workers into one buffer and
+     * distributes them with `MPI_Scatterv`.
+     *
+     * If compression is enabled, each part is sent as a single compressed
+     * frame.
+     *
+     * @return `false` if the parts exceed the MPI count limit, in which case
+     * nothing was sent.
+     */
+    static bool scatter(DT *mat, const std::vector<int> &targetGroup,
+                        const std::vector<DataPlacement *> &targetPlacements, DCTX(dctx)) {
+        const int worldSize = MPIHelper::getCommSize();
+        const CompressionCodec codec = dctx->config.distributed_compression;
+        std::vector<int> counts(worldSize, 0);
+        std::vector<int> displs(worldSize, 0);
+        std::vector<DT *> slices(worldSize, nullptr);
+        std::vector<std::vector<char>> frames(worldSize);
+
+        size_t total = 0;
+        for (size_t i = 0; i < targetGroup.size(); i++) {
+            DataPlacement *dp = targetPlacements[i];
+            auto slicedMat = mat->sliceRow(dp->range->r_start, dp->range->r_start + dp->range->r_len);
+            size_t len = DaphneSerializer<DT>::length(slicedMat);
+            if (codec != CompressionCodec::NONE) {
+                std::vector<char> serialized;
+                DaphneSerializer<DT>::serialize(slicedMat, serialized);
+                ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(slicedMat));
+                len = compressor.compress(serialized.data(), len, 0, frames[targetGroup[i]]);
+            }
+            slices[targetGroup[i]] = slicedMat;
+            counts[targetGroup[i]] = static_cast<int>(len);
+            total += len;
+            if (len > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+                total > static_cast<size_t>(std::numeric_limits<int>::max())) {
+                for (auto slice : slices)
+                    if (slice)
+                        DataObjectFactory::destroy(slice);
+                return false;
+            }
+        }
+
+        std::vector<char> sendBuffer(total);
+        size_t offset = 0;
+        for (int rank = 0; rank < worldSize; rank++) {
+            displs[rank] = static_cast<int>(offset);
+            if (slices[rank]) {
+                if (codec != CompressionCodec::NONE)
+                    std::copy(frames[rank].begin(), frames[rank].begin() + counts[rank], sendBuffer.begin() + offset);
+                else
+                    DaphneSerializer<DT>::serialize(slices[rank], sendBuffer.data() + offset, counts[rank], 0);
+                DataObjectFactory::destroy(slices[rank]);
+            }
+            offset += counts[rank];
+        }
+
+        MPIHelper::scatterData(sendBuffer, counts, displs, codec != CompressionCodec::NONE);
+        return true;
+    }
+
+    /**
+     * @brief Streams the parts to the workers in chunks via non-blocking
+     * point-to-point sends.
+     *
+     * The stream header announces the number of chunks, so that the workers
+     * can post their receives ahead of time. Serializing and compressing the
+     * next chunk overlaps with sending the previous ones.
+     */
+    static void stream(DT *mat, const std::vector<int> &targetGroup,
+                       const std::vector<DataPlacement *> &targetPlacements, DCTX(dctx)) {
+        const CompressionCodec codec = dctx->config.distributed_compression;
+        MPIHelper::AsyncSender sender;
+        for (size_t i = 0; i < targetGroup.size(); i++) {
+            const int rank = targetGroup[i];
+            DataPlacement *dp = targetPlacements[i];
+            auto slicedMat = mat->sliceRow(dp->range->r_start, dp->range->r_start + dp->range->r_len);
+
+            // Minimum chunk size
+            const size_t length = DaphneSerializer<DT>::length(slicedMat);
+            auto min_chunk_size = dctx->config.max_distributed_serialization_chunk_size < length
+                                      ? dctx->config.max_distributed_serialization_chunk_size
+                                      : length;
+            const size_t numChunks = (length + min_chunk_size - 1) / min_chunk_size;
+            MPIHelper::initiateStreaming(rank, min_chunk_size, numChunks, codec != CompressionCodec::NONE);
+            ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(slicedMat));
+            size_t offset = 0;
+            auto serializer = DaphneSerializerChunks<DT>(slicedMat, min_chunk_size);
+            for (auto it = serializer.begin(); it != serializer.end(); ++it) {
+                // The serializer reuses its buffer, so hand a copy (or a
+                // compressed frame) to MPI.
+                std::shared_ptr<std::vector<char>> chunk;
+                size_t len = it->first;
+                if (codec != CompressionCodec::NONE) {
+                    chunk = std::make_shared<std::vector<char>>();
+                    len = compressor.compress(it->second->data(), it->first, offset, *chunk);
+                } else
+                    chunk = std::make_shared<std::vector<char>>(it->second->begin(), it->second->begin() + it->first);
+                offset += it->first;
+                sender.send(DATA, chunk, len, rank);
+                sender.waitUntilAtMost(MAX_PENDING_CHUNKS);
+            }
+            DataObjectFactory::destroy(slicedMat);
+        }
+        sender.waitAll();
+    }
 };
 #endif
 
@@ -143,9 +253,18 @@ template <class DT> struct Distribute<ALLOCATION_TYPE::DIST_GRPC_ASYNC, DT> {
             protoMsg.set_bytes(&min_chunk_size, sizeof(size_t));
             caller.sendDataStream(address, protoMsg);
 
+            const CompressionCodec codec = dctx->config.distributed_compression;
+            ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(slicedMat));
+            size_t offset = 0;
             auto serializer = DaphneSerializerChunks<DT>(slicedMat, min_chunk_size);
             for (auto it = serializer.begin(); it != serializer.end(); ++it) {
-                protoMsg.set_bytes(it->second->data(), it->first);
+                if (codec != CompressionCodec::NONE) {
+                    const size_t len = compressor.compress(it->second->data(), it->first, offset, buffer);
+                    protoMsg.set_bytes(buffer.data(), len);
+                } else
+                    protoMsg.set_bytes(it->second->data(), it->first);
+                protoMsg.set_compressed(codec != CompressionCodec::NONE);
+                offset += it->first;
                 caller.sendDataStream(address, protoMsg);
             }
             DataObjectFactory::destroy(slicedMat);
@@ -205,11 +324,21 @@ template <class DT> struct Distribute<ALLOCATION_TYPE::DIST_GRPC_SYNC, DT> {
                     DaphneSerializerChunks<DT>(slicedMat, dctx->config.max_distributed_serialization_chunk_size);
 
                 distributed::Data protoMsg;
+                const CompressionCodec codec = dctx->config.distributed_compression;
+                ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(slicedMat));
+                std::vector<char> frame;
+                size_t offset = 0;
 
                 // Send chunks
                 auto writer = stub->Store(&grpc_ctx, &storedData);
                 for (auto it = serializer.begin(); it != serializer.end(); ++it) {
-                    protoMsg.set_bytes(it->second->data(), it->first);
+                    if (codec != CompressionCodec::NONE) {
+                        const size_t len = compressor.compress(it->second->data(), it->first, offset, frame);
+                        protoMsg.set_bytes(frame.data(), len);
+                    } else
+                        protoMsg.set_bytes(it->second->data(), it->first);
+                    protoMsg.set_compressed(codec != CompressionCodec::NONE);
+                    offset += it->first;
                     writer->Write(protoMsg);
                 }
                 writer->WritesDone();
@@ -18,12 +18,15 @@
 
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/context/DistributedContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/kernels/BinaryOpCode.h>
 #include <runtime/local/kernels/EwBinaryMat.h>
 
 #include <runtime/distributed/proto/DistributedGRPCCaller.h>
+#include <runtime/distributed/proto/ReduceTree.h>
 #include <runtime/distributed/proto/worker.grpc.pb.h>
 #include <runtime/distributed/proto/worker.pb.h>
 #include <runtime/local/datastructures/AllocationDescriptorGRPC.h>
@@ -33,8 +36,15 @@
 #include <runtime/distributed/worker/MPIHelper.h>
 #endif
 
+#include <algorithm>
 #include <cstddef>
+#include <map>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -52,6 +62,284 @@ template <ALLOCATION_TYPE AT, class DT> void distributedCollect(DT *&mat, const
     DistributedCollect<AT, DT>::apply(mat, combine, dctx);
 }
 
+// ****************************************************************************
+// Functions called by multiple template specializations
+// ****************************************************************************
+
+/**
+ * @brief Keeps the row-wise partial results of the workers until all of them
+ * have arrived, such that they can be concatenated in the order of the
+ * workers.
+ */
+template <class DT> class RowSliceBuffer {
+  protected:
+    std::map<size_t, DT *> slices;
+    size_t numRows = 0;
+    std::mutex mtx;
+
+    void addSlice(Structure *slice, size_t workerIdx) {
+        auto typedSlice = dynamic_cast<DT *>(slice);
+        if (!typedSlice)
+            throw std::runtime_error("DistributedCollect: a partial result has an unexpected data type");
+        std::lock_guard g(mtx);
+        slices.emplace(workerIdx, typedSlice);
+        numRows += typedSlice->getNumRows();
+    }
+
+    /**
+     * @brief Returns the partial result determining the columns of the
+     * concatenation (workers without any rows may return empty results).
+     */
+    const DT *firstSlice() const {
+        if (slices.empty())
+            throw std::runtime_error("DistributedCollect: no partial results to combine");
+        for (auto &[workerIdx, slice] : slices)
+            if (slice->getNumRows())
+                return slice;
+        return slices.begin()->second;
+    }
+
+  public:
+    ~RowSliceBuffer() {
+        for (auto &[workerIdx, slice] : slices)
+            DataObjectFactory::destroy(slice);
+    }
+};
+
+/**
+ * @brief Combines the partial results the workers send back to the
+ * coordinator into the result of a distributed pipeline.
+ *
+ * A DenseMatrix result of known shape is allocated upfront (see `allocate`)
+ * and each partial result is written to (or added to) it as soon as it
+ * arrives. Results whose shape or schema is only known once the partial
+ * results have arrived (Frames, CSRMatrix, and DenseMatrix results with a
+ * data-dependent number of rows) are represented by an empty placeholder until
+ * then; their partial results are concatenated row-wise by `finish`.
+ */
+template <class DT> class DistributedResultSink;
+
+template <typename VT> class DistributedResultSink<DenseMatrix<VT>> : public RowSliceBuffer<DenseMatrix<VT>> {
+    DenseMatrix<VT> *&res;
+    const VectorCombine combine;
+    const bool preallocated;
+
+  public:
+    static DenseMatrix<VT> *allocate(int64_t numRows, int64_t numCols, VectorCombine combine) {
+        if (numRows == -1 || numCols == -1)
+            return DataObjectFactory::create<DenseMatrix<VT>>(0, 0, false);
+        return DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, combine == VectorCombine::ADD);
+    }
+
+    DistributedResultSink(DenseMatrix<VT> *&res, VectorCombine combine)
+        : res(res), combine(combine), preallocated(res->getNumRows() || res->getNumCols()) {
+        if (!preallocated && combine != VectorCombine::ROWS)
+            throw std::runtime_error("DistributedCollect: results of unknown shape can only be combined row-wise");
+    }
+
+    /**
+     * @brief Combines the partial result of the given worker, whose place in
+     * the result is given by `range`, and takes its ownership.
+     */
+    void add(Structure *slice, size_t workerIdx, const Range &range) {
+        if (!preallocated) {
+            this->addSlice(slice, workerIdx);
+            return;
+        }
+        auto slicedMat = dynamic_cast<DenseMatrix<VT> *>(slice);
+        if (!slicedMat)
+            throw std::runtime_error("DistributedCollect: a partial result has an unexpected data type");
+        if (combine == VectorCombine::ADD) {
+            std::lock_guard g(this->mtx);
+            ewBinaryMat(BinaryOpCode::ADD, res, slicedMat, res, nullptr);
+        } else {
+            // The partial results of the workers are disjoint.
+            VT *resValues = res->getValues() + range.r_start * res->getRowSkip() + range.c_start;
+            const VT *slicedMatValues = slicedMat->getValues();
+            for (size_t r = 0; r < range.r_len; r++) {
+                std::copy(slicedMatValues, slicedMatValues + range.c_len, resValues);
+                resValues += res->getRowSkip();
+                slicedMatValues += slicedMat->getRowSkip();
+            }
+        }
+        DataObjectFactory::destroy(slicedMat);
+    }
+
+    void finish() {
+        if (preallocated)
+            return;
+        const size_t numCols = this->firstSlice()->getNumCols();
+        auto concat = DataObjectFactory::create<DenseMatrix<VT>>(this->numRows, numCols, false);
+        VT *resValues = concat->getValues();
+        for (auto &[workerIdx, slice] : this->slices) {
+            if (!slice->getNumRows())
+                continue;
+            if (slice->getNumCols() != numCols)
+                throw std::runtime_error("DistributedCollect: partial results differ in their number of columns");
+            const VT *sliceValues = slice->getValues();
+            for (size_t r = 0; r < slice->getNumRows(); r++) {
+                std::copy(sliceValues, sliceValues + numCols, resValues);
+                resValues += concat->getRowSkip();
+                sliceValues += slice->getRowSkip();
+            }
+        }
+        DataObjectFactory::destroy(res);
+        res = concat;
+    }
+};
+
+template <typename VT> class DistributedResultSink<CSRMatrix<VT>> : public RowSliceBuffer<CSRMatrix<VT>> {
+    CSRMatrix<VT> *&res;
+
+  public:
+    static CSRMatrix<VT> *allocate(int64_t numRows, int64_t numCols, VectorCombine combine) {
+        return DataObjectFactory::create<CSRMatrix<VT>>(0, 0, 0, false);
+    }
+
+    DistributedResultSink(CSRMatrix<VT> *&res, VectorCombine combine) : res(res) {
+        if (combine != VectorCombine::ROWS)
+            throw std::runtime_error("DistributedCollect: CSRMatrix results can only be combined row-wise");
+    }
+
+    void add(Structure *slice, size_t workerIdx, const Range &range) { this->addSlice(slice, workerIdx); }
+
+    void finish() {
+        const size_t numCols = this->firstSlice()->getNumCols();
+        size_t numNonZeros = 0;
+        for (auto &[workerIdx, slice] : this->slices)
+            numNonZeros += slice->getNumNonZeros();
+
+        auto concat = DataObjectFactory::create<CSRMatrix<VT>>(this->numRows, numCols, numNonZeros, false);
+        size_t *resRowOffsets = concat->getRowOffsets();
+        resRowOffsets[0] = 0;
+        size_t row = 0;
+        for (auto &[workerIdx, slice] : this->slices) {
+            if (!slice->getNumRows())
+                continue;
+            if (slice->getNumCols() != numCols)
+                throw std::runtime_error("DistributedCollect: partial results differ in their number of columns");
+            const size_t *sliceRowOffsets = slice->getRowOffsets();
+            const size_t startOffset = sliceRowOffsets[0];
+            const size_t resOffset = resRowOffsets[row];
+            for (size_t r = 0; r < slice->getNumRows(); r++)
+                resRowOffsets[row + r + 1] = resOffset + sliceRowOffsets[r + 1] - startOffset;
+            std::copy(slice->getValues() + startOffset, slice->getValues() + startOffset + slice->getNumNonZeros(),
+                      concat->getValues() + resOffset);
+            std::copy(slice->getColIdxs() + startOffset, slice->getColIdxs() + startOffset + slice->getNumNonZeros(),
+                      concat->getColIdxs() + resOffset);
+            row += slice->getNumRows();
+        }
+        DataObjectFactory::destroy(res);
+        res = concat;
+    }
+};
+
+template <> class DistributedResultSink<Frame> : public RowSliceBuffer<Frame> {
+    Frame *&res;
+
+  public:
+    static Frame *allocate(int64_t numRows, int64_t numCols, VectorCombine combine) {
+        return DataObjectFactory::create<Frame>(0, 0, nullptr, nullptr, false);
+    }
+
+    DistributedResultSink(Frame *&res, VectorCombine combine) : res(res) {
+        if (combine != VectorCombine::ROWS)
+            throw std::runtime_error("DistributedCollect: Frame results can only be combined row-wise");
+    }
+
+    void add(Structure *slice, size_t workerIdx, const Range &range) { this->addSlice(slice, workerIdx); }
+
+    void finish() {
+        const Frame *first = this->firstSlice();
+        const size_t numCols = first->getNumCols();
+        const ValueTypeCode *schema = first->getSchema();
+
+        auto concat = DataObjectFactory::create<Frame>(this->numRows, numCols, schema, first->getLabels(), false);
+        size_t row = 0;
+        for (auto &[workerIdx, slice] : this->slices) {
+            if (!slice->getNumRows())
+                continue;
+            if (slice->getNumCols() != numCols ||
+                !std::equal(schema, schema + numCols, slice->getSchema()))
+                throw std::runtime_error("DistributedCollect: partial results differ in their schema");
+            for (size_t c = 0; c < numCols; c++) {
+                if (schema[c] == ValueTypeCode::STR) {
+                    auto sliceCol = static_cast<const std::string *>(slice->getColumnRaw(c));
+                    std::copy(sliceCol, sliceCol + slice->getNumRows(),
+                              static_cast<std::string *>(concat->getColumnRaw(c)) + row);
+                } else {
+                    const size_t elemSize = ValueTypeUtils::sizeOf(schema[c]);
+                    auto sliceCol = static_cast<const char *>(slice->getColumnRaw(c));
+                    std::copy(sliceCol, sliceCol + slice->getNumRows() * elemSize,
+                              static_cast<char *>(concat->getColumnRaw(c)) + row * elemSize);
+                }
+            }
+            row += slice->getNumRows();
+        }
+        DataObjectFactory::destroy(res);
+        res = concat;
+    }
+};
+
+/**
+ * @brief Adds up the partial results of an ADD-combined output among the gRPC
+ * workers along a reduction tree (see `ReduceTree`), such that only the final
+ * sum is sent to the coordinator.
+ *
+ * @return `false` if there is nothing to gain from a reduction tree (a single
+ * worker), the partial results are not all placed at the workers, or the
+ * workers cannot add up results of this type; in this case, nothing is done.
+ */
+template <class DT> bool reduceAtWorkersGRPC(DT *mat, DCTX(dctx)) {
+    // The workers add up dense matrices only (see the overload below), other
+    // results are gathered at the coordinator.
+    return false;
+}
+
+template <typename VT> bool reduceAtWorkersGRPC(DenseMatrix<VT> *mat, DCTX(dctx)) {
+    auto dpVector = mat->getMetaDataObject()->getDataPlacementByType(ALLOCATION_TYPE::DIST_GRPC);
+    if (dpVector->size() < 2)
+        return false;
+
+    std::vector<std::pair<std::string, distributed::StoredData>> parts;
+    for (auto &dp : *dpVector) {
+        auto distributedData = dynamic_cast<AllocationDescriptorGRPC &>(*(dp->allocation)).getDistributedData();
+        if (!distributedData.isPlacedAtWorker)
+            return false;
+        distributed::StoredData protoData;
+        protoData.set_identifier(distributedData.identifier);
+        protoData.set_num_rows(distributedData.numRows);
+        protoData.set_num_cols(distributedData.numCols);
+        parts.emplace_back(dp->allocation->getLocation(), protoData);
+    }
+
+    distributed::ReduceTask task;
+    ReduceTree::build(parts, 0, parts.size(), &task);
+
+    auto ctx = DistributedContext::get(dctx);
+    distributed::Data matProto;
+    grpc::ClientContext grpc_ctx;
+    auto status = ctx->stubs[parts.front().first]->Reduce(&grpc_ctx, task, &matProto);
+    if (!status.ok())
+        throw std::runtime_error("DistributedCollect gRPC: reduction at workers failed: " + status.error_message());
+
+    Structure *received = DF_deserialize(matProto.bytes().data(), matProto.bytes().size());
+    auto sum = dynamic_cast<DenseMatrix<VT> *>(received);
+    if (!sum) {
+        DataObjectFactory::destroy(received);
+        throw std::runtime_error("DistributedCollect gRPC: the workers' sum differs in its value type");
+    }
+    ewBinaryMat(BinaryOpCode::ADD, mat, sum, mat, nullptr);
+    DataObjectFactory::destroy(sum);
+
+    for (auto &dp : *dpVector) {
+        auto data = dynamic_cast<AllocationDescriptorGRPC &>(*(dp->allocation)).getDistributedData();
+        data.isPlacedAtWorker = false;
+        dynamic_cast<AllocationDescriptorGRPC &>(*(dp->allocation)).updateDistributedData(data);
+    }
+    return true;
+}
+
 // ****************************************************************************
 // (Partial) template specializations for different distributed backends
 // ****************************************************************************
@@ -60,66 +348,129 @@ template <ALLOCATION_TYPE AT, class DT> void distributedCollect(DT *&mat, const
 // MPI
 // ----------------------------------------------------------------------------
 #ifdef USE_MPI
+/**
+ * @brief Whether ADD-combined results of the given data type can be added up
+ * among the MPI workers, see `MPIHelper::reduceData`.
+ */
+template <class DT> struct ReducibleAtWorkers : std::false_type {};
+template <typename VT> struct ReducibleAtWorkers<DenseMatrix<VT>> : std::bool_constant<MPIHelper::hasMPIType<VT>> {};
+
 template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_MPI, DT> {
     static void apply(DT *&mat, const VectorCombine &combine, DCTX(dctx)) {
         if (mat == nullptr)
-            throw std::runtime_error("DistributedCollect gRPC: result matrix must be already "
+            throw std::runtime_error("DistributedCollect MPI: result must be already "
                                      "allocated by wrapper since information regarding size only "
                                      "exists there");
-        size_t worldSize = MPIHelper::getCommSize();
+        DistributedResultSink<DT> sink(mat, combine);
+
+        const size_t worldSize = MPIHelper::getCommSize();
+        std::vector<WorkerImpl::StoredInfo> infos(worldSize);
+        bool allWorkersParticipate = true;
         for (size_t rank = 0; rank < worldSize; rank++) {
             if (rank == COORDINATOR) // we currently exclude the coordinator
                 continue;
 
             std::string address = std::to_string(rank);
             auto dp = mat->getMetaDataObject()->getDataPlacementByLocation(address);
+            if (!dp ||
+                !dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).getDistributedData().isPlacedAtWorker) {
+                allWorkersParticipate = false;
+                continue;
+            }
             auto distributedData = dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).getDistributedData();
-            WorkerImpl::StoredInfo info = {distributedData.identifier, distributedData.numRows,
-                                           distributedData.numCols};
-            MPIHelper::requestData(rank, info);
+            infos[rank] = {distributedData.identifier, distributedData.numRows, distributedData.numCols};
+        }
+
+        // The workers add up dense matrices of the value types MPI supports.
+        if constexpr (ReducibleAtWorkers<DT>::value) {
+            if (allWorkersParticipate && combine == VectorCombine::ADD) {
+                reduceAtWorkers(mat, infos);
+                return;
+            }
+        }
+        if (allWorkersParticipate) {
+            // A single MPI_Gatherv collects the results of all workers.
+            std::vector<char> buffer;
+            std::vector<int> displs, counts;
+            std::vector<std::vector<char>> oversized;
+            MPIHelper::gatherData(infos, buffer, displs, counts, oversized);
+            for (size_t rank = 1; rank < worldSize; rank++) {
+                if (!oversized[rank].empty())
+                    combineSlice(mat, sink, oversized[rank].data(), oversized[rank].size(), rank);
+                else
+                    combineSlice(mat, sink, buffer.data() + displs[rank], counts[rank], rank);
+            }
+            sink.finish();
+            return;
         }
-        auto collectedDataItems = 0u;
-        for (size_t i = 1; i < worldSize; i++) {
+
+        // Otherwise, we request the results point-to-point and combine them in
+        // the order in which they arrive.
+        size_t numRequests = 0;
+        for (size_t rank = 1; rank < worldSize; rank++) {
+            if (infos[rank].identifier.empty())
+                continue;
+            MPIHelper::requestData(rank, infos[rank]);
+            numRequests++;
+        }
+        for (size_t i = 0; i < numRequests; i++) {
             size_t len;
             int rank;
             std::vector<char> buffer;
             MPIHelper::getMessage(&rank, TypesOfMessages::OUTPUT, MPI_UNSIGNED_CHAR, buffer, &len);
+            combineSlice(mat, sink, buffer.data(), len, rank);
+        }
+        sink.finish();
+    };
 
-            std::string address = std::to_string(rank);
-            auto dp = mat->getMetaDataObject()->getDataPlacementByLocation(address);
-
-            auto denseMat = dynamic_cast<DenseMatrix<double> *>(mat);
-            if (!denseMat) {
-                throw std::runtime_error("Distribute grpc only supports "
-                                         "DenseMatrix<double> for now");
-            }
-
-            auto slicedMat = dynamic_cast<DenseMatrix<double> *>(DF_deserialize(buffer));
-            if (combine == VectorCombine::ADD) {
-                ewBinaryMat(BinaryOpCode::ADD, denseMat, slicedMat, denseMat, nullptr);
-            } else {
-                auto resValues = denseMat->getValues() + (dp->range->r_start * denseMat->getRowSkip());
-                auto slicedMatValues = slicedMat->getValues();
-                for (size_t r = 0; r < dp->range->r_len; r++) {
-                    memcpy(resValues + dp->range->c_start, slicedMatValues, dp->range->c_len * sizeof(double));
-                    resValues += denseMat->getRowSkip();
-                    slicedMatValues += slicedMat->getRowSkip();
-                }
-            }
-            DataObjectFactory::destroy(slicedMat);
-
-            collectedDataItems += dp->range->r_len * dp->range->c_len;
+  private:
+    /**
+     * @brief Adds up the partial results among the workers, such that the
+     * coordinator receives the sum only once (see `MPIHelper::reduceData`).
+     *
+     * Afterwards, each worker still holds its share of the rows of the sum,
+     * which is recorded as the object's data placement. Thus, if the result
+     * is distributed row-wise again, it is not sent to the workers again.
+     */
+    template <typename VT>
+    static void reduceAtWorkers(DenseMatrix<VT> *denseMat, const std::vector<WorkerImpl::StoredInfo> &infos) {
+        const size_t numRows = denseMat->getNumRows();
+        const size_t numCols = denseMat->getNumCols();
+        auto sum = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+        MPIHelper::reduceData(infos, sum->getValues(), numRows, numCols);
+        ewBinaryMat(BinaryOpCode::ADD, denseMat, sum, denseMat, nullptr);
+        DataObjectFactory::destroy(sum);
+
+        const size_t numWorkers = MPIHelper::getCommSize() - 1;
+        for (size_t i = 0; i < numWorkers; i++) {
+            int rank;
+            auto info = MPIHelper::getDataAcknowledgement(&rank);
+            auto [start, len] = MPIHelper::partitionRows(numRows, numWorkers, rank - 1);
+            Range range(start, 0, len, numCols);
 
+            auto dp = denseMat->getMetaDataObject()->getDataPlacementByLocation(std::to_string(rank));
+            denseMat->getMetaDataObject()->updateRangeDataPlacementByID(dp->dp_id, &range);
             auto distributedData = dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).getDistributedData();
-            distributedData.isPlacedAtWorker = false;
+            distributedData.identifier = info.identifier;
+            distributedData.numRows = info.numRows;
+            distributedData.numCols = info.numCols;
+            distributedData.vectorCombine = VectorCombine::ROWS;
+            distributedData.ix = DistributedIndex(rank - 1, 0);
+            distributedData.isPlacedAtWorker = true;
             dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).updateDistributedData(distributedData);
-            // this is to handle the case when not all workers participate in
-            // the computation, i.e., number of workers is larger than of the
-            // work items
-            if (collectedDataItems == denseMat->getNumRows() * denseMat->getNumCols())
-                break;
         }
-    };
+    }
+
+    static void combineSlice(DT *mat, DistributedResultSink<DT> &sink, const char *buffer, size_t len, size_t rank) {
+        std::string address = std::to_string(rank);
+        auto dp = mat->getMetaDataObject()->getDataPlacementByLocation(address);
+        auto distributedData = dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).getDistributedData();
+
+        sink.add(DF_deserialize(buffer, len), distributedData.ix.getRow(), *(dp->range));
+
+        distributedData.isPlacedAtWorker = false;
+        dynamic_cast<AllocationDescriptorMPI &>(*(dp->allocation)).updateDistributedData(distributedData);
+    }
 };
 #endif
 
@@ -130,9 +481,14 @@ template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_MPI, DT> {
 template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_ASYNC, DT> {
     static void apply(DT *&mat, const VectorCombine &combine, DCTX(dctx)) {
         if (mat == nullptr)
-            throw std::runtime_error("DistributedCollect gRPC: result matrix must be already "
+            throw std::runtime_error("DistributedCollect gRPC: result must be already "
                                      "allocated by wrapper since information regarding size only "
                                      "exists there");
+        DistributedResultSink<DT> sink(mat, combine);
+
+        // Partial results to be added up are reduced among the workers.
+        if (combine == VectorCombine::ADD && reduceAtWorkersGRPC(mat, dctx))
+            return;
 
         struct StoredInfo {
             size_t dp_id;
@@ -160,33 +516,13 @@ template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_ASYNC,
             auto data = dynamic_cast<AllocationDescriptorGRPC &>(*(dp->allocation)).getDistributedData();
 
             auto matProto = response.result;
-
-            // TODO: We need to handle different data types
-            auto denseMat = dynamic_cast<DenseMatrix<double> *>(mat);
-            if (!denseMat) {
-                throw std::runtime_error("Distribute grpc only supports "
-                                         "DenseMatrix<double> for now");
-            }
-            // Zero copy buffer
-            std::vector<char> buf(static_cast<const char *>(matProto.bytes().data()),
-                                  static_cast<const char *>(matProto.bytes().data()) + matProto.bytes().size());
-            auto slicedMat = dynamic_cast<DenseMatrix<double> *>(DF_deserialize(buf));
-            if (combine == VectorCombine::ADD) {
-                ewBinaryMat(BinaryOpCode::ADD, denseMat, slicedMat, denseMat, nullptr);
-            } else {
-                auto resValues = denseMat->getValues() + (dp->range->r_start * denseMat->getRowSkip());
-                auto slicedMatValues = slicedMat->getValues();
-                for (size_t r = 0; r < dp->range->r_len; r++) {
-                    memcpy(resValues + dp->range->c_start, slicedMatValues, dp->range->c_len * sizeof(double));
-                    resValues += denseMat->getRowSkip();
-                    slicedMatValues += slicedMat->getRowSkip();
-                }
-            }
-            DataObjectFactory::destroy(slicedMat);
+            sink.add(DF_deserialize(matProto.bytes().data(), matProto.bytes().size()), data.ix.getRow(),
+                     *(dp->range));
 
             data.isPlacedAtWorker = false;
             dynamic_cast<AllocationDescriptorGRPC &>(*(dp->allocation)).updateDistributedData(data);
         }
+        sink.finish();
     };
 };
 
@@ -197,13 +533,17 @@ template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_ASYNC,
 template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_SYNC, DT> {
     static void apply(DT *&mat, const VectorCombine &combine, DCTX(dctx)) {
         if (mat == nullptr)
-            throw std::runtime_error("DistributedCollect gRPC: result matrix must be already "
+            throw std::runtime_error("DistributedCollect gRPC: result must be already "
                                      "allocated by wrapper since information regarding size only "
                                      "exists there");
+        DistributedResultSink<DT> sink(mat, combine);
+
+        // Partial results to be added up are reduced among the workers.
+        if (combine == VectorCombine::ADD && reduceAtWorkersGRPC(mat, dctx))
+            return;
 
         auto ctx = DistributedContext::get(dctx);
         std::vector<std::thread> threads_vector;
-        std::mutex lock;
 
         auto dpVector = mat->getMetaDataObject()->getDataPlacementByType(ALLOCATION_TYPE::DIST_GRPC);
         for (auto &dp : *dpVector) {
@@ -215,36 +555,16 @@ template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_SYNC, D
             protoData.set_num_rows(distributedData.numRows);
             protoData.set_num_cols(distributedData.numCols);
 
-            std::thread t([address, dp = dp.get(), protoData, distributedData, &combine, &lock, &mat, &ctx]() mutable {
+            std::thread t([address, dp = dp.get(), protoData, distributedData, &sink, &ctx]() mutable {
                 auto stub = ctx->stubs[address].get();
 
                 distributed::Data matProto;
                 grpc::ClientContext grpc_ctx;
                 stub->Transfer(&grpc_ctx, protoData, &matProto);
 
-                // TODO: We need to handle different data types
-                auto denseMat = dynamic_cast<DenseMatrix<double> *>(mat);
-                if (!denseMat) {
-                    throw std::runtime_error("Distribute grpc only supports "
-                                             "DenseMatrix<double> for now");
-                }
-                // Zero copy buffer
-                std::vector<char> buf(static_cast<const char *>(matProto.bytes().data()),
-                                      static_cast<const char *>(matProto.bytes().data()) + matProto.bytes().size());
-                auto slicedMat = dynamic_cast<DenseMatrix<double> *>(DF_deserialize(buf));
-                if (combine == VectorCombine::ADD) {
-                    std::lock_guard g(lock);
-                    ewBinaryMat(BinaryOpCode::ADD, denseMat, slicedMat, denseMat, nullptr);
-                } else {
-                    auto resValues = denseMat->getValues() + (dp->range->r_start * denseMat->getRowSkip());
-                    auto slicedMatValues = slicedMat->getValues();
-                    for (size_t r = 0; r < dp->range->r_len; r++) {
-                        memcpy(resValues + dp->range->c_start, slicedMatValues, dp->range->c_len * sizeof(double));
-                        resValues += denseMat->getRowSkip();
-                        slicedMatValues += slicedMat->getRowSkip();
-                    }
-                }
-                DataObjectFactory::destroy(slicedMat);
+                sink.add(DF_deserialize(matProto.bytes().data(), matProto.bytes().size()),
+                         distributedData.ix.getRow(), *(dp->range));
+
                 distributedData.isPlacedAtWorker = false;
                 dynamic_cast<AllocationDescriptorGRPC &>(*(dp->allocation)).updateDistributedData(distributedData);
             });
@@ -252,5 +572,6 @@ template <class DT> struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_SYNC, D
         }
         for (auto &thread : threads_vector)
             thread.join();
+        sink.finish();
     };
 };
@@ -20,6 +20,8 @@
 #include <runtime/local/context/DistributedContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/io/DaphneColumnarFile.h>
 #include <runtime/local/io/File.h>
 #include <runtime/local/io/ReadCsv.h>
 
@@ -33,6 +35,9 @@
 #endif
 
 #include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -86,6 +91,82 @@ template <class DTRes> struct DistributedRead<ALLOCATION_TYPE::DIST_GRPC_ASYNC,
 
 template <class DTRes> struct DistributedRead<ALLOCATION_TYPE::DIST_GRPC_SYNC, DTRes> {
     static void apply(DTRes *&res, const char *filename, DCTX(dctx)) {
+        if (DaphneColumnar::isColumnarFile(filename))
+            readColumnar(res, filename, dctx);
+        else
+            readHDFS(res, filename, dctx);
+    }
+
+    /**
+     * @brief Lets each worker read the chunks of its row partition from a file
+     * in the columnar DAPHNE binary format on a shared file system, such that
+     * the data does not pass through the coordinator.
+     */
+    static void readColumnar(DTRes *&res, const char *filename, DCTX(dctx)) {
+        auto ctx = DistributedContext::get(dctx);
+        if (res == nullptr) {
+            const int fd = open(filename, O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("DistributedRead: could not open file " + std::string(filename));
+            DaphneColumnarFooter footer;
+            try {
+                footer = DaphneColumnar::readFooter(fd, filename);
+            } catch (...) {
+                close(fd);
+                throw;
+            }
+            close(fd);
+            res = DataObjectFactory::create<DTRes>(footer.numRows, footer.numCols, false);
+        }
+
+        std::vector<std::thread> threads_vector;
+        std::vector<std::string> errors(ctx->getWorkers().size());
+        LoadPartitioningDistributed<DTRes, AllocationDescriptorGRPC> partioner(DistributionSchema::DISTRIBUTE, res,
+                                                                               dctx);
+        for (size_t i = 0; partioner.HasNextChunk(); i++) {
+            auto dp = partioner.GetNextChunk();
+            auto workerAddr = dynamic_cast<AllocationDescriptorGRPC *>(dp->allocation.get())->getLocation();
+            std::thread t([=, &errors]() {
+                auto stub = ctx->stubs[workerAddr].get();
+
+                distributed::ColumnarFileRange fileRange;
+                fileRange.set_filename(filename);
+                fileRange.set_start_row(dp->range->r_start);
+                fileRange.set_num_rows(dp->range->r_len);
+                fileRange.set_value_type(static_cast<uint32_t>(ValueTypeUtils::codeFor<typename DTRes::VT>));
+
+                grpc::ClientContext grpc_ctx;
+                distributed::StoredData response;
+                auto status = stub->ReadColumnar(&grpc_ctx, fileRange, &response);
+                if (!status.ok()) {
+                    errors[i] = status.error_message();
+                    return;
+                }
+
+                if (response.num_cols() != res->getNumCols()) {
+                    errors[i] = "the file has " + std::to_string(response.num_cols()) + " columns, but " +
+                                std::to_string(res->getNumCols()) + " were expected";
+                    return;
+                }
+
+                DistributedData newData;
+                newData.identifier = response.identifier();
+                newData.numRows = response.num_rows();
+                newData.numCols = response.num_cols();
+                newData.isPlacedAtWorker = true;
+                dynamic_cast<AllocationDescriptorGRPC &>(*(dp->allocation)).updateDistributedData(newData);
+            });
+            threads_vector.push_back(move(t));
+        }
+
+        for (auto &thread : threads_vector)
+            thread.join();
+        for (auto &error : errors)
+            if (!error.empty())
+                throw std::runtime_error("DistributedRead: " + error);
+    }
+
+    static void readHDFS(DTRes *&res, const char *filename, DCTX(dctx)) {
 #if USE_HDFS
         auto ctx = DistributedContext::get(dctx);
         auto workers = ctx->getWorkers();
@@ -66,14 +66,12 @@ template <class DT> class DistributedWrapper {
         // gRPC hard-coded selection
         const auto allocation_type = _dctx->getUserConfig().distributedBackEndSetup;
         // std::cout<<"Distributed wrapper " <<std::endl;
-        //  output allocation for row-wise combine
+        // Output allocation; results whose shape or schema is only known once
+        // they are collected are represented by an empty placeholder (see
+        // DistributedResultSink).
         for (size_t i = 0; i < numOutputs; ++i) {
-            if (*(res[i]) == nullptr && outRows[i] != -1 && outCols[i] != -1) {
-                auto zeroOut = combines[i] == mlir::daphne::VectorCombine::ADD;
-                // TODO we know result is only DenseMatrix<double> for now,
-                // but in the future this will change to support other DataTypes
-                *(res[i]) = DataObjectFactory::create<DT>(outRows[i], outCols[i], zeroOut);
-            }
+            if (*(res[i]) == nullptr)
+                *(res[i]) = DistributedResultSink<DT>::allocate(outRows[i], outCols[i], combines[i]);
         }
 
         // Currently an input might appear twice in the inputs array of a
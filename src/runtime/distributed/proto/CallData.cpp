@@ -85,6 +85,28 @@ void TransferCallData::Proceed(bool ok) {
     }
 }
 
+void ReduceCallData::Proceed(bool ok) {
+    if (status_ == CREATE) {
+        // Make this instance progress to the PROCESS state.
+        status_ = PROCESS;
+
+        service_->RequestReduce(&ctx_, &task, &responder_, cq_, cq_, this);
+    } else if (status_ == PROCESS) {
+        if (!ok)
+            delete this;
+        status_ = FINISH;
+
+        new ReduceCallData(worker, cq_);
+
+        grpc::Status status = worker->ReduceGRPC(&ctx_, &task, &data);
+
+        responder_.Finish(data, status, this);
+    } else {
+        GPR_ASSERT(status_ == FINISH);
+        delete this;
+    }
+}
+
 // void FreeMemCallData::Proceed() {
 //     if (status_ == CREATE)
 //     {
@@ -111,6 +111,33 @@ class TransferCallData final : public CallData {
     CallStatus status_; // The current serving state.
 };
 
+class ReduceCallData final : public CallData {
+  public:
+    ReduceCallData(WorkerImplGRPCAsync *worker_, grpc::ServerCompletionQueue *cq)
+        : worker(worker_), service_(&worker_->service_), cq_(cq), responder_(&ctx_), status_(CREATE) {
+        // Invoke the serving logic right away.
+        Proceed(true);
+    }
+    void Proceed(bool ok) override;
+
+  private:
+    WorkerImplGRPCAsync *worker;
+    distributed::Worker::AsyncService *service_;
+    // The producer-consumer queue where for asynchronous server notifications.
+    grpc::ServerCompletionQueue *cq_;
+    grpc::ServerContext ctx_;
+    // What we get from the client.
+    distributed::ReduceTask task;
+    // What we send back to the client.
+    distributed::Data data;
+    // The means to get back to the client.
+    grpc::ServerAsyncResponseWriter<distributed::Data> responder_;
+
+    // Let's implement a tiny state machine with the following states.
+    enum CallStatus { CREATE, PROCESS, FINISH };
+    CallStatus status_; // The current serving state.
+};
+
 // class FreeMemCallData final : public CallData
 // {
 //     public:
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2021 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_RUNTIME_DISTRIBUTED_PROTO_REDUCETREE_H
+#define SRC_RUNTIME_DISTRIBUTED_PROTO_REDUCETREE_H
+
+#include <runtime/distributed/proto/worker.grpc.pb.h>
+#include <runtime/distributed/proto/worker.pb.h>
+#include <runtime/distributed/worker/WorkerImpl.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/io/DaphneSerializer.h>
+
+#include <grpcpp/grpcpp.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Reduction trees for adding up ADD-combined partial results among the
+ * gRPC workers.
+ *
+ * The coordinator describes the whole tree in a single `ReduceTask` and sends
+ * it to the root worker. Every worker forwards the subtasks of its children to
+ * them in parallel, adds their sums to its own partial result and returns the
+ * total to its parent. Thus, the coordinator receives only the final result,
+ * and each worker receives at most two partial results.
+ */
+namespace ReduceTree {
+
+/**
+ * @brief Builds the reduction tree over the given partial results.
+ *
+ * The first partial result of the range is the root, the remaining ones are
+ * split into two halves which form the subtrees of its (at most) two children.
+ * The depth of the tree is logarithmic in the number of workers.
+ *
+ * @param parts The address of each worker and the partial result stored there.
+ * @param begin The first partial result of the (sub)tree.
+ * @param end One past the last partial result of the (sub)tree.
+ * @param task The task of the root of the (sub)tree, to be populated.
+ */
+inline void build(const std::vector<std::pair<std::string, distributed::StoredData>> &parts, size_t begin, size_t end,
+                  distributed::ReduceTask *task) {
+    *task->mutable_data() = parts[begin].second;
+    const size_t mid = begin + 1 + (end - begin) / 2;
+    for (auto [childBegin, childEnd] : {std::make_pair(begin + 1, mid), std::make_pair(mid, end)}) {
+        if (childBegin >= childEnd)
+            continue;
+        auto child = task->add_children();
+        child->set_address(parts[childBegin].first);
+        build(parts, childBegin, childEnd, child->mutable_task());
+    }
+}
+
+/**
+ * @brief Returns a stub for calling another worker.
+ *
+ * Channels are created on first use and kept for subsequent reductions.
+ */
+inline std::unique_ptr<distributed::Worker::Stub> getStub(const std::string &addr) {
+    static std::map<std::string, std::shared_ptr<grpc::Channel>> channels;
+    static std::mutex channelsLock;
+
+    std::lock_guard<std::mutex> g(channelsLock);
+    auto it = channels.find(addr);
+    if (it == channels.end()) {
+        grpc::ChannelArguments ch_args;
+        ch_args.SetMaxSendMessageSize(-1);
+        ch_args.SetMaxReceiveMessageSize(-1);
+        it = channels.emplace(addr, grpc::CreateCustomChannel(addr, grpc::InsecureChannelCredentials(), ch_args)).first;
+    }
+    return distributed::Worker::NewStub(it->second);
+}
+
+/**
+ * @brief Evaluates the given node of a reduction tree at this worker.
+ *
+ * @param worker The worker holding the partial result of this node.
+ * @param task The node of the reduction tree.
+ * @param response Populated with the serialized sum of the subtree.
+ */
+inline grpc::Status evaluate(WorkerImpl &worker, const distributed::ReduceTask &task, distributed::Data *response) {
+    const size_t numChildren = task.children_size();
+    std::vector<distributed::Data> childResults(numChildren);
+    std::vector<grpc::Status> childStatus(numChildren);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numChildren; i++) {
+        threads.emplace_back([&task, &childResults, &childStatus, i]() {
+            const auto &child = task.children(i);
+            auto stub = getStub(child.address());
+            grpc::ClientContext grpc_ctx;
+            childStatus[i] = stub->Reduce(&grpc_ctx, child.task(), &childResults[i]);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < numChildren; i++)
+        if (!childStatus[i].ok())
+            return childStatus[i];
+
+    std::vector<Structure *> partials;
+    for (size_t i = 0; i < numChildren; i++) {
+        partials.push_back(DF_deserialize(childResults[i].bytes().data(), childResults[i].bytes().size()));
+        // Release the serialized copy as early as possible.
+        childResults[i].Clear();
+    }
+
+    const auto &data = task.data();
+    std::vector<char> buffer;
+    size_t bufferLength = 0;
+    grpc::Status status = grpc::Status::OK;
+    try {
+        WorkerImpl::StoredInfo info({data.identifier(), data.num_rows(), data.num_cols()});
+        bufferLength = worker.Reduce(info, partials, buffer);
+    } catch (const std::exception &e) {
+        status = grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+    for (auto partial : partials)
+        DataObjectFactory::destroy(partial);
+    if (status.ok())
+        response->set_bytes(buffer.data(), bufferLength);
+    return status;
+}
+
+} // namespace ReduceTree
+
+#endif // SRC_RUNTIME_DISTRIBUTED_PROTO_REDUCETREE_H
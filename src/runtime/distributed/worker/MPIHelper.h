@@ -7,35 +7,189 @@
 #include <runtime/local/datastructures/AllocationDescriptorMPI.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/IAllocationDescriptor.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
 #include <sstream>
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #define COORDINATOR 0
 
+// Payload messages (DATA, MLIR, TRANSFER, ...) are not preceded by a separate
+// size message anymore, the receiver obtains the length by probing.
 enum TypesOfMessages {
     BROADCAST,
     STREAM_INIT,
     STREAM_COMPLETE,
-    DATASIZE,
     DATA,
     DATAACK,
-    MLIRSIZE,
     TRANSFER,
-    TRANSFERSIZE,
     MLIR,
     INPUTKEYS,
     COMPUTERESULT,
     OUTPUT,
     OUTPUTKEY,
-    DETACH
+    DETACH,
+    SCATTER,
+    GATHER,
+    REDUCE
 };
 enum WorkerStatus { LISTENING = 0, DETACHED, TERMINATED };
 
 class MPIHelper {
   public:
     using StoredInfo = WorkerImpl::StoredInfo;
+
+    /**
+     * @brief Whether values of the given type can be reduced by MPI, see
+     * `mpiTypeFor()`.
+     */
+    template <typename VT>
+    static constexpr bool hasMPIType =
+        std::is_same_v<VT, double> || std::is_same_v<VT, float> || std::is_same_v<VT, int64_t> ||
+        std::is_same_v<VT, int32_t> || std::is_same_v<VT, int8_t> || std::is_same_v<VT, uint64_t> ||
+        std::is_same_v<VT, uint32_t> || std::is_same_v<VT, uint8_t>;
+
+    /**
+     * @brief Returns the MPI datatype corresponding to the given value type.
+     */
+    template <typename VT> static MPI_Datatype mpiTypeFor() {
+        static_assert(hasMPIType<VT>, "MPIHelper: unsupported value type");
+        if constexpr (std::is_same_v<VT, double>)
+            return MPI_DOUBLE;
+        else if constexpr (std::is_same_v<VT, float>)
+            return MPI_FLOAT;
+        else if constexpr (std::is_same_v<VT, int64_t>)
+            return MPI_INT64_T;
+        else if constexpr (std::is_same_v<VT, int32_t>)
+            return MPI_INT32_T;
+        else if constexpr (std::is_same_v<VT, int8_t>)
+            return MPI_INT8_T;
+        else if constexpr (std::is_same_v<VT, uint64_t>)
+            return MPI_UINT64_T;
+        else if constexpr (std::is_same_v<VT, uint32_t>)
+            return MPI_UINT32_T;
+        else
+            return MPI_UINT8_T;
+    }
+
+    /**
+     * @brief The payload of a `STREAM_INIT` message.
+     *
+     * If `numChunks` is zero, the chunks are sent via `MPI_Bcast` (one
+     * `BROADCAST` message per chunk). Otherwise, exactly `numChunks` point-to-
+     * point `DATA` messages of at most `chunkSize` bytes follow, which allows
+     * the receiver to post all receives ahead of time. If `framed` is set,
+     * each chunk is a compressed frame (see `ChunkCompression.h`) of a
+     * serialized chunk of at most `chunkSize` bytes.
+     */
+    struct StreamInfo {
+        size_t chunkSize;
+        size_t numChunks;
+        bool framed;
+    } __attribute__((__packed__));
+
+    /**
+     * @brief Keeps track of non-blocking sends and the buffers they read from.
+     *
+     * The buffers must stay alive until MPI completed the corresponding send,
+     * so they are owned by this class until then. Destroying an instance
+     * waits for all outstanding sends.
+     */
+    class AsyncSender {
+        std::vector<MPI_Request> requests;
+        std::vector<std::shared_ptr<std::vector<char>>> buffers;
+
+      public:
+        AsyncSender() = default;
+        AsyncSender(const AsyncSender &) = delete;
+        AsyncSender &operator=(const AsyncSender &) = delete;
+        ~AsyncSender() { waitAll(); }
+
+        void send(int tag, std::shared_ptr<std::vector<char>> buffer, size_t messageLength, int rank) {
+            if (messageLength > static_cast<size_t>(std::numeric_limits<int>::max()))
+                throw std::runtime_error("MPIHelper: message of " + std::to_string(messageLength) +
+                                         " bytes exceeds the MPI count limit");
+            MPI_Request request;
+            MPI_Isend(buffer->data(), static_cast<int>(messageLength), MPI_UNSIGNED_CHAR, rank, tag, MPI_COMM_WORLD,
+                      &request);
+            requests.push_back(request);
+            buffers.push_back(std::move(buffer));
+        }
+
+        /**
+         * @brief Drives MPI progress and releases the buffers of all completed
+         * sends without blocking.
+         */
+        void progress() {
+            size_t numPending = 0;
+            for (size_t i = 0; i < requests.size(); i++) {
+                int done = 0;
+                MPI_Test(&requests[i], &done, MPI_STATUS_IGNORE);
+                if (!done) {
+                    requests[numPending] = requests[i];
+                    buffers[numPending] = std::move(buffers[i]);
+                    numPending++;
+                }
+            }
+            requests.resize(numPending);
+            buffers.resize(numPending);
+        }
+
+        /**
+         * @brief Blocks until at most `maxPending` sends are outstanding.
+         */
+        void waitUntilAtMost(size_t maxPending) {
+            progress();
+            while (requests.size() > maxPending) {
+                int idx;
+                MPI_Waitany(static_cast<int>(requests.size()), requests.data(), &idx, MPI_STATUS_IGNORE);
+                progress();
+            }
+        }
+
+        void waitAll() {
+            if (!requests.empty())
+                MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+            requests.clear();
+            buffers.clear();
+        }
+
+        [[nodiscard]] size_t numPending() const { return requests.size(); }
+    };
+
+    /**
+     * @brief Sleeps increasingly long while there is nothing to do, so that
+     * idle processes do not burn a full core, while staying responsive after
+     * a burst of messages.
+     */
+    class IdleBackoff {
+        static constexpr size_t SPIN_ROUNDS = 64;
+        static constexpr std::chrono::microseconds MAX_SLEEP{1000};
+        size_t idleRounds = 0;
+
+      public:
+        void reset() { idleRounds = 0; }
+        void idle() {
+            if (idleRounds < SPIN_ROUNDS)
+                std::this_thread::yield();
+            else {
+                const auto shift = std::min<size_t>(idleRounds - SPIN_ROUNDS, 10);
+                std::this_thread::sleep_for(std::min(MAX_SLEEP, std::chrono::microseconds(1) * (1 << shift)));
+            }
+            idleRounds++;
+        }
+    };
     struct Task {
       private:
         struct Header {
@@ -166,16 +320,267 @@ class MPIHelper {
     static void broadcastData(size_t messageLength, void *data) {
         int worldSize = getCommSize();
         int message = messageLength;
+        std::vector<MPI_Request> requests;
         for (int rank = 0; rank < worldSize; rank++) {
             if (rank == COORDINATOR)
                 continue;
-            MPI_Send(&message, 1, MPI_INT, rank, BROADCAST, MPI_COMM_WORLD);
+            requests.emplace_back();
+            MPI_Isend(&message, 1, MPI_INT, rank, BROADCAST, MPI_COMM_WORLD, &requests.back());
         }
         MPI_Bcast(data, message, MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD);
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    /**
+     * @brief Distributes one serialized object per worker with a single
+     * `MPI_Scatterv`.
+     *
+     * All workers must take part, since the scatter is a collective operation
+     * on `MPI_COMM_WORLD`. Each worker is first told the length of its part
+     * and whether it is compressed by a `SCATTER` message.
+     *
+     * @param sendBuffer The serialized objects of all ranks, back to back.
+     * @param counts The number of bytes for each rank (0 for the coordinator).
+     * @param displs The offset of each rank's part in `sendBuffer`.
+     * @param framed Whether each part is a single compressed frame (see
+     * `ChunkCompression.h`).
+     */
+    static void scatterData(const std::vector<char> &sendBuffer, const std::vector<int> &counts,
+                            const std::vector<int> &displs, bool framed = false) {
+        const int worldSize = getCommSize();
+        std::vector<MPI_Request> requests(worldSize - 1);
+        std::vector<int> messages(2 * worldSize);
+        for (int rank = 1; rank < worldSize; rank++) {
+            messages[2 * rank] = counts[rank];
+            messages[2 * rank + 1] = framed;
+            MPI_Isend(&messages[2 * rank], 2, MPI_INT, rank, SCATTER, MPI_COMM_WORLD, &requests[rank - 1]);
+        }
+        MPI_Scatterv(sendBuffer.data(), counts.data(), displs.data(), MPI_UNSIGNED_CHAR, nullptr, 0,
+                     MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD);
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    /**
+     * @brief Collects one serialized object from every worker with a single
+     * `MPI_Gatherv`.
+     *
+     * Each worker is sent a `GATHER` message with the information on the
+     * object it shall contribute. The workers then take part in an
+     * `MPI_Gather` of the lengths and an `MPI_Gatherv` of the data. Objects
+     * which do not fit into the `int` counts and displacements of the
+     * `MPI_Gatherv` are sent point-to-point in chunks instead (see
+     * `sendInChunks`); the coordinator tells the workers which objects these
+     * are by an `MPI_Scatter`.
+     *
+     * @param infos The stored object to collect from each rank (index 0, the
+     * coordinator, is ignored).
+     * @param recvBuffer The serialized objects gathered by the `MPI_Gatherv`,
+     * back to back.
+     * @param displs The offset of each rank's part in `recvBuffer`.
+     * @param counts The number of bytes in `recvBuffer` from each rank.
+     * @param oversized The serialized object of each rank that was sent
+     * point-to-point, empty for all other ranks.
+     */
+    static void gatherData(const std::vector<StoredInfo> &infos, std::vector<char> &recvBuffer,
+                           std::vector<int> &displs, std::vector<int> &counts,
+                           std::vector<std::vector<char>> &oversized) {
+        const int worldSize = getCommSize();
+        std::vector<std::string> messages(worldSize);
+        std::vector<MPI_Request> requests(worldSize - 1);
+        for (int rank = 1; rank < worldSize; rank++) {
+            messages[rank] = infos[rank].toString();
+            MPI_Isend(messages[rank].c_str(), static_cast<int>(messages[rank].size() + 1), MPI_CHAR, rank, GATHER,
+                      MPI_COMM_WORLD, &requests[rank - 1]);
+        }
+        // A worker reports a length of -1 if its object alone exceeds the
+        // MPI count limit.
+        int ownCount = 0;
+        counts.resize(worldSize);
+        MPI_Gather(&ownCount, 1, MPI_INT, counts.data(), 1, MPI_INT, COORDINATOR, MPI_COMM_WORLD);
+        std::vector<int> pointToPoint(worldSize, 0);
+        displs.resize(worldSize);
+        size_t total = 0;
+        for (int rank = 0; rank < worldSize; rank++) {
+            if (counts[rank] < 0 || total + counts[rank] > static_cast<size_t>(std::numeric_limits<int>::max())) {
+                pointToPoint[rank] = 1;
+                counts[rank] = 0;
+            }
+            displs[rank] = static_cast<int>(total);
+            total += counts[rank];
+        }
+        int ownPointToPoint;
+        MPI_Scatter(pointToPoint.data(), 1, MPI_INT, &ownPointToPoint, 1, MPI_INT, COORDINATOR, MPI_COMM_WORLD);
+        recvBuffer.resize(total);
+        MPI_Gatherv(nullptr, 0, MPI_UNSIGNED_CHAR, recvBuffer.data(), counts.data(), displs.data(), MPI_UNSIGNED_CHAR,
+                    COORDINATOR, MPI_COMM_WORLD);
+        oversized.assign(worldSize, {});
+        for (int rank = 1; rank < worldSize; rank++)
+            if (pointToPoint[rank])
+                receiveInChunks(rank, GATHER, oversized[rank]);
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    /**
+     * @brief The worker's part of `gatherData`.
+     *
+     * @param data The serialized object to contribute.
+     * @param len The number of bytes of `data`.
+     */
+    static void contributeToGather(const char *data, size_t len) {
+        const bool fits = len <= static_cast<size_t>(std::numeric_limits<int>::max());
+        int count = fits ? static_cast<int>(len) : -1;
+        MPI_Gather(&count, 1, MPI_INT, nullptr, 0, MPI_INT, COORDINATOR, MPI_COMM_WORLD);
+        int pointToPoint;
+        MPI_Scatter(nullptr, 1, MPI_INT, &pointToPoint, 1, MPI_INT, COORDINATOR, MPI_COMM_WORLD);
+        MPI_Gatherv(data, pointToPoint ? 0 : count, MPI_UNSIGNED_CHAR, nullptr, nullptr, nullptr, MPI_UNSIGNED_CHAR,
+                    COORDINATOR, MPI_COMM_WORLD);
+        if (pointToPoint)
+            sendInChunks(data, len, COORDINATOR, GATHER);
+    }
+
+    /**
+     * @brief Sends a message of arbitrary length as its length followed by
+     * chunks within the MPI count limit (see `receiveInChunks`).
+     */
+    static void sendInChunks(const char *data, size_t len, int rank, int tag) {
+        uint64_t len64 = len;
+        MPI_Send(&len64, 1, MPI_UINT64_T, rank, tag, MPI_COMM_WORLD);
+        const size_t maxChunk = std::numeric_limits<int>::max();
+        for (size_t offset = 0; offset < len; offset += maxChunk)
+            MPI_Send(data + offset, static_cast<int>(std::min(maxChunk, len - offset)), MPI_UNSIGNED_CHAR, rank, tag,
+                     MPI_COMM_WORLD);
+    }
+
+    /**
+     * @brief Receives a message sent by `sendInChunks`.
+     *
+     * MPI does not let messages with the same source and tag overtake each
+     * other, so the chunks arrive in order.
+     */
+    static void receiveInChunks(int rank, int tag, std::vector<char> &data) {
+        uint64_t len64;
+        MPI_Recv(&len64, 1, MPI_UINT64_T, rank, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        const size_t len = len64;
+        data.resize(len);
+        const size_t maxChunk = std::numeric_limits<int>::max();
+        for (size_t offset = 0; offset < len; offset += maxChunk)
+            MPI_Recv(data.data() + offset, static_cast<int>(std::min(maxChunk, len - offset)), MPI_UNSIGNED_CHAR, rank,
+                     tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+
+    /**
+     * @brief Returns the first row and the number of rows of the given part
+     * when splitting the rows evenly into the given number of parts.
+     *
+     * This is the same split as for distributing a matrix row-wise, such that
+     * reduced results can be reused as distributed inputs.
+     */
+    static std::pair<size_t, size_t> partitionRows(size_t numRows, size_t numParts, size_t part) {
+        const size_t k = numRows / numParts;
+        const size_t m = numRows % numParts;
+        const size_t start = part * k + std::min(part, m);
+        return {start, (part + 1) * k + std::min(part + 1, m) - start};
     }
 
-    static void initiateStreaming(int rank, size_t chunksize) {
-        MPI_Send(&chunksize, 1, MPI_INT, rank, STREAM_INIT, MPI_COMM_WORLD);
+    /**
+     * @brief Creates a communicator of all workers (i.e., without the
+     * coordinator).
+     *
+     * This is collective only over the workers, so the workers can create it
+     * lazily, the first time they need it.
+     */
+    static MPI_Comm createWorkerComm() {
+        MPI_Group worldGroup, workerGroup;
+        MPI_Comm_group(MPI_COMM_WORLD, &worldGroup);
+        const int excluded[] = {COORDINATOR};
+        MPI_Group_excl(worldGroup, 1, excluded, &workerGroup);
+        MPI_Comm workerComm;
+        MPI_Comm_create_group(MPI_COMM_WORLD, workerGroup, REDUCE, &workerComm);
+        MPI_Group_free(&workerGroup);
+        MPI_Group_free(&worldGroup);
+        return workerComm;
+    }
+
+    /**
+     * @brief Lets all ranks agree on the value type of the partial results
+     * before they enter the collectives of `reduceData`.
+     *
+     * If any rank disagrees, all ranks skip the reduction, instead of leaving
+     * the others waiting in the collectives forever.
+     *
+     * @param vtc The value type code of this rank's dense matrix, or -1 if it
+     * has none.
+     * @return `true` if all ranks contributed the same value type code.
+     */
+    static bool agreeOnValueType(int vtc) {
+        // The minimum of the codes and of their negations yields the minimum
+        // and the maximum code in a single collective.
+        int local[2] = {vtc, -vtc};
+        int global[2];
+        MPI_Allreduce(local, global, 2, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        return global[0] >= 0 && global[0] == -global[1];
+    }
+
+    /**
+     * @brief Element-wise adds up the partial results of all workers among the
+     * workers and collects only the sum.
+     *
+     * Each worker is sent a `REDUCE` message with the information on its
+     * partial result. After all ranks agreed on the value type (see
+     * `agreeOnValueType`), the workers add up their partial results with an
+     * `MPI_Reduce_scatter` among themselves, which MPI implementations carry
+     * out by recursive halving or in a ring, such that every worker ends up
+     * with an even share of the rows of the sum (see `partitionRows`). These
+     * shares are collected by a single `MPI_Gatherv`. Finally, each worker
+     * keeps its share instead of its partial result and acknowledges it with
+     * a `DATAACK` message, which is left for the caller to receive.
+     *
+     * @param infos The partial result at each rank (index 0, the coordinator,
+     * is ignored).
+     * @param recvBuffer The sum as a contiguous row-major `numRows x numCols`
+     * array.
+     */
+    template <typename VT>
+    static void reduceData(const std::vector<StoredInfo> &infos, VT *recvBuffer, size_t numRows, size_t numCols) {
+        if (numRows * numCols > static_cast<size_t>(std::numeric_limits<int>::max()))
+            throw std::runtime_error("MPIHelper: reduced data exceeds the MPI count limit");
+        const int worldSize = getCommSize();
+        std::vector<std::string> messages(worldSize);
+        std::vector<MPI_Request> requests(worldSize - 1);
+        for (int rank = 1; rank < worldSize; rank++) {
+            messages[rank] = infos[rank].toString();
+            MPI_Isend(messages[rank].c_str(), static_cast<int>(messages[rank].size() + 1), MPI_CHAR, rank, REDUCE,
+                      MPI_COMM_WORLD, &requests[rank - 1]);
+        }
+        if (!agreeOnValueType(static_cast<int>(ValueTypeUtils::codeFor<VT>))) {
+            MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+            throw std::runtime_error("MPIHelper: the partial results to reduce are not all dense matrices of "
+                                     "value type " +
+                                     ValueTypeUtils::cppNameFor<VT>);
+        }
+        std::vector<int> counts(worldSize, 0), displs(worldSize, 0);
+        for (int rank = 1; rank < worldSize; rank++) {
+            auto [start, len] = partitionRows(numRows, worldSize - 1, rank - 1);
+            displs[rank] = static_cast<int>(start * numCols);
+            counts[rank] = static_cast<int>(len * numCols);
+        }
+        MPI_Gatherv(nullptr, 0, mpiTypeFor<VT>(), recvBuffer, counts.data(), displs.data(), mpiTypeFor<VT>(),
+                    COORDINATOR, MPI_COMM_WORLD);
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    /**
+     * @brief Announces a stream of serialized chunks to a worker.
+     *
+     * @param rank The receiving worker.
+     * @param chunksize The maximum size of each chunk.
+     * @param numChunks The number of point-to-point chunks that follow, or 0
+     * if the chunks are broadcast.
+     * @param framed Whether the chunks are compressed frames.
+     */
+    static void initiateStreaming(int rank, size_t chunksize, size_t numChunks = 0, bool framed = false) {
+        StreamInfo info{chunksize, numChunks, framed};
+        MPI_Send(&info, sizeof(info), MPI_UNSIGNED_CHAR, rank, STREAM_INIT, MPI_COMM_WORLD);
     }
     static void sendData(size_t messageLength, void *data, int rank) { sendWithTag(DATA, messageLength, data, rank); }
 
@@ -195,13 +600,8 @@ class MPIHelper {
     }
 
     static void requestData(const int &rank, const StoredInfo &info) {
-        int len = info.toString().length();
-        len++;
-        MPI_Send(&len, 1, MPI_INT, rank, TRANSFERSIZE, MPI_COMM_WORLD);
-        char message[len];
-        std::strcpy(message, info.toString().c_str());
-        message[len - 1] = '\0';
-        MPI_Send(message, len, MPI_CHAR, rank, TRANSFER, MPI_COMM_WORLD);
+        std::string message = info.toString();
+        MPI_Send(message.c_str(), static_cast<int>(message.size() + 1), MPI_CHAR, rank, TRANSFER, MPI_COMM_WORLD);
     }
 
     static void getMessage(int *rank, int tag, MPI_Datatype type, std::vector<char> &data, size_t *len) {
@@ -230,24 +630,7 @@ class MPIHelper {
     static void sendWithTag(TypesOfMessages tag, size_t messageLength, void *data, int rank) {
         if (rank == COORDINATOR)
             return;
-        int message = messageLength;
-        int sizeTag = -1, dataTag = -1;
-        // std::cout<<"message size is "<< message << " tag "<< tag <<std::endl;
-        switch (tag) {
-        case DATA:
-            sizeTag = DATASIZE;
-            dataTag = DATA;
-            break;
-        case MLIR:
-            sizeTag = MLIRSIZE;
-            dataTag = MLIR;
-        default:
-            break;
-        }
-        // std::cout<<"message size is "<< message << " tag "<< sizeTag
-        // <<std::endl;
-        MPI_Send(&message, 1, MPI_INT, rank, sizeTag, MPI_COMM_WORLD);
-        MPI_Send(data, message, MPI_UNSIGNED_CHAR, rank, dataTag, MPI_COMM_WORLD);
+        MPI_Send(data, static_cast<int>(messageLength), MPI_UNSIGNED_CHAR, rank, tag, MPI_COMM_WORLD);
     }
 };
 
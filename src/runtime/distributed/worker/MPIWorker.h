@@ -23,9 +23,16 @@
 #include <runtime/distributed/worker/MPIHelper.h>
 #include <runtime/distributed/worker/WorkerImpl.h>
 #include <runtime/local/datastructures/AllocationDescriptorMPI.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/IAllocationDescriptor.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/io/ChunkCompression.h>
 #include <runtime/local/io/DaphneSerializer.h>
 
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 class MPIWorker : WorkerImpl {
   public:
     MPIWorker(DaphneUserConfig &_cfg) : WorkerImpl(_cfg) { // TODO
@@ -33,19 +40,37 @@ class MPIWorker : WorkerImpl {
     }
 
     ~MPIWorker() { // TODO
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (workerComm != MPI_COMM_NULL && !finalized)
+            MPI_Comm_free(&workerComm);
     }
 
+    /**
+     * @brief The main loop of the worker.
+     *
+     * Incoming messages are handled as they arrive. While there are none, the
+     * worker drives the completion of its outstanding non-blocking sends and
+     * backs off instead of spinning on `MPI_Iprobe`.
+     */
     void joinComputingTeam() {
         int inCommingMessage = 0;
         MPI_Status status;
+        MPIHelper::IdleBackoff backoff;
         while (myState != TERMINATED) { //
             MPI_Iprobe(COORDINATOR, MPI_ANY_TAG, MPI_COMM_WORLD, &inCommingMessage, &status);
             if (inCommingMessage && myState != DETACHED) {
                 handleInCommingMessages(status);
-            } else
+                backoff.reset();
+            } else {
+                sender.progress();
                 continueComputing(); // takes form a queue // hocks for
                                      // scheuling
+                if (myState != TERMINATED)
+                    backoff.idle();
+            }
         }
+        sender.waitAll();
     }
 
   private:
@@ -56,21 +81,35 @@ class MPIWorker : WorkerImpl {
     std::unique_ptr<DaphneDeserializerChunks<Structure>> deserializer;
     std::unique_ptr<DaphneDeserializerChunks<Structure>::Iterator> deserializerIter;
     Structure *deserializedMatrix;
+    // Whether the chunks of the current stream are compressed frames.
+    bool framedStream = false;
+    // Outstanding non-blocking sends (acknowledgements, results).
+    MPIHelper::AsyncSender sender;
+    // Communicator of all workers, created on the first reduction.
+    MPI_Comm workerComm = MPI_COMM_NULL;
 
-    std::tuple<bool, StoredInfo> storeInputs(const std::vector<char> &buffer, size_t messageLength) {
+    /**
+     * @brief Feeds the next chunk of the current stream to the deserializer.
+     *
+     * The buffer is handed over to the deserializer without copying, so the
+     * caller must not write to it until this function returned. Compressed
+     * chunks are decoded into a new buffer first.
+     */
+    std::tuple<bool, StoredInfo> storeInputs(std::shared_ptr<std::vector<char>> buffer, size_t messageLength) {
         StoredInfo info;
-        if (*deserializerIter == deserializer->begin() && DF_Dtype(buffer.data()) == DF_data_t::Value_t) {
-            double val = DaphneSerializer<double>::deserialize(buffer.data());
+        if (framedStream) {
+            auto chunk = std::make_shared<std::vector<char>>();
+            messageLength = ChunkCompression::decompress(buffer->data(), messageLength, *chunk);
+            buffer = std::move(chunk);
+        }
+        if (*deserializerIter == deserializer->begin() && DF_Dtype(buffer->data()) == DF_data_t::Value_t) {
+            double val = DaphneSerializer<double>::deserialize(buffer->data());
             info = this->Store(&val);
             return std::make_tuple(true, info);
         } else {
             // partially deserialize next
             (*deserializerIter)->first = messageLength;
-            if ((*deserializerIter)->second->size() < messageLength)
-                (*deserializerIter)->second->resize(messageLength);
-            (*deserializerIter)
-                ->second->assign(static_cast<const char *>(buffer.data()),
-                                 static_cast<const char *>(buffer.data()) + messageLength);
+            (*deserializerIter)->second = std::move(buffer);
 
             // advance iterator, this also partially deserializes
             ++(*deserializerIter);
@@ -91,34 +130,152 @@ class MPIWorker : WorkerImpl {
             StoredInfo tempInfo = outputs.at(i);
             computeResult += ":" + tempInfo.toString();
         }
-        MPI_Send(computeResult.c_str(), computeResult.size(), MPI_CHAR, COORDINATOR, COMPUTERESULT, MPI_COMM_WORLD);
+        auto buffer = std::make_shared<std::vector<char>>(computeResult.begin(), computeResult.end());
+        sender.send(COMPUTERESULT, buffer, buffer->size(), COORDINATOR);
     }
     void sendMatrix(StoredInfo info) {
         auto mat = this->Transfer(info);
-        std::vector<char> dataToSend;
-        size_t messageLength = DaphneSerializer<Structure>::serialize(mat, dataToSend);
-
-        int len = messageLength;
-        MPI_Send(dataToSend.data(), len, MPI_UNSIGNED_CHAR, COORDINATOR, OUTPUT, MPI_COMM_WORLD);
+        auto dataToSend = std::make_shared<std::vector<char>>();
+        size_t messageLength = DaphneSerializer<Structure>::serialize(mat, *dataToSend);
+        sender.send(OUTPUT, dataToSend, messageLength, COORDINATOR);
     }
 
-    void prepareBufferForMessage(std::vector<char> &buffer, int *messageLength, MPI_Datatype type, int source,
-                                 int tag) {
-        MPI_Status messageStatus;
-        MPI_Recv(messageLength, 1, type, source, tag, MPI_COMM_WORLD, &messageStatus);
-        // std::cout<< id<<" in distribute size " <<*messageLength << " tag " <<
-        // tag <<std::endl;
-        if (buffer.size() < size_t(*messageLength))
-            buffer.resize(size_t(*messageLength));
+    /**
+     * @brief Receives the message the given status was probed for into the
+     * buffer, which is resized as needed.
+     */
+    int receiveProbedMessage(std::vector<char> &buffer, MPI_Datatype type, const MPI_Status &status) {
+        int messageLength;
+        MPI_Get_count(&status, type, &messageLength);
+        if (buffer.size() < size_t(messageLength))
+            buffer.resize(size_t(messageLength));
+        MPI_Recv(buffer.data(), messageLength, type, status.MPI_SOURCE, status.MPI_TAG, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        return messageLength;
     }
 
     void sendDataACK(StoredInfo info) {
-        // std::cout<< "ack from " << id << " will have " << info.identifier <<
-        // " , " << std::to_string(info.numRows) << " , "
-        // <<std::to_string(info.numCols)<<std::endl;
         std::string toSend = info.toString();
-        MPI_Send(toSend.c_str(), sizeof(toSend), MPI_CHAR, COORDINATOR, DATAACK, MPI_COMM_WORLD);
-        // std::cout<<"rank " << id <<" acknowledging" <<std::endl;
+        // Include the terminating '\0', the coordinator parses a C string.
+        auto buffer = std::make_shared<std::vector<char>>(toSend.c_str(), toSend.c_str() + toSend.size() + 1);
+        sender.send(DATAACK, buffer, buffer->size(), COORDINATOR);
+    }
+
+    /**
+     * @brief Receives the announced number of point-to-point chunks of a
+     * stream.
+     *
+     * All receives are double-buffered: the receive of the next chunk is
+     * posted before the current one is decoded and deserialized, so that
+     * both overlap with the network transfer.
+     *
+     * @param bufferSize The maximum size of a message of the stream.
+     */
+    void receiveStream(int source, size_t bufferSize, size_t numChunks) {
+        std::shared_ptr<std::vector<char>> buffers[2];
+        MPI_Request requests[2];
+        auto postReceive = [&](size_t i) {
+            auto &buffer = buffers[i % 2];
+            // The previous buffer may still be owned by the deserializer.
+            if (!buffer || buffer.use_count() > 1)
+                buffer = std::make_shared<std::vector<char>>(bufferSize);
+            MPI_Irecv(buffer->data(), static_cast<int>(bufferSize), MPI_UNSIGNED_CHAR, source, DATA, MPI_COMM_WORLD,
+                      &requests[i % 2]);
+        };
+
+        postReceive(0);
+        for (size_t i = 0; i < numChunks; i++) {
+            if (i + 1 < numChunks)
+                postReceive(i + 1);
+            MPI_Status status;
+            MPI_Wait(&requests[i % 2], &status);
+            int messageLength;
+            MPI_Get_count(&status, MPI_UNSIGNED_CHAR, &messageLength);
+            auto ret = storeInputs(buffers[i % 2], (size_t)messageLength);
+            if (std::get<0>(ret))
+                sendDataACK(std::get<1>(ret));
+            sender.progress();
+        }
+    }
+
+    /**
+     * @brief Takes part in `MPIHelper::reduceData`: adds up the partial
+     * results among all workers, contributes this worker's share of the rows
+     * of the sum to the coordinator and keeps it for later use.
+     */
+    void reduceAndKeepShare(StoredInfo info) {
+        if (workerComm == MPI_COMM_NULL)
+            workerComm = MPIHelper::createWorkerComm();
+
+        // The coordinator only reduces the value types MPI supports, see
+        // `MPIHelper::hasMPIType`. If this worker's partial result is of
+        // another type, all ranks skip the reduction and the coordinator
+        // reports the error.
+        Structure *partial = this->Transfer(info);
+        const int vtc = denseValueTypeCode<double, float, int64_t, int32_t, int8_t, uint64_t, uint32_t, uint8_t>(partial);
+        if (!MPIHelper::agreeOnValueType(vtc))
+            return;
+        tryReduceAndKeepShare<double>(partial) || tryReduceAndKeepShare<float>(partial) ||
+            tryReduceAndKeepShare<int64_t>(partial) || tryReduceAndKeepShare<int32_t>(partial) ||
+            tryReduceAndKeepShare<int8_t>(partial) || tryReduceAndKeepShare<uint64_t>(partial) ||
+            tryReduceAndKeepShare<uint32_t>(partial) || tryReduceAndKeepShare<uint8_t>(partial);
+        // The coordinator refers to the share from now on.
+        this->Free(info);
+    }
+
+    /**
+     * @brief Returns the value type code of the given object if it is a
+     * `DenseMatrix` of one of the given value types, or -1 otherwise.
+     */
+    template <typename... VTs> static int denseValueTypeCode(const Structure *obj) {
+        int vtc = -1;
+        ((dynamic_cast<const DenseMatrix<VTs> *>(obj) ? (vtc = static_cast<int>(ValueTypeUtils::codeFor<VTs>)) : 0),
+         ...);
+        return vtc;
+    }
+
+    /**
+     * @brief Reduces the given partial result (see `reduceAndKeepShare`) if it
+     * is a `DenseMatrix<VT>`, returns `false` otherwise.
+     */
+    template <typename VT> bool tryReduceAndKeepShare(Structure *obj) {
+        auto partial = dynamic_cast<DenseMatrix<VT> *>(obj);
+        if (!partial)
+            return false;
+        int numWorkers, workerRank;
+        MPI_Comm_size(workerComm, &numWorkers);
+        MPI_Comm_rank(workerComm, &workerRank);
+        const size_t numRows = partial->getNumRows();
+        const size_t numCols = partial->getNumCols();
+
+        // MPI needs the partial result as a contiguous array.
+        std::vector<VT> contiguous;
+        const VT *sendBuffer = partial->getValues();
+        if (partial->getRowSkip() != numCols) {
+            contiguous.resize(numRows * numCols);
+            for (size_t r = 0; r < numRows; r++)
+                std::copy(sendBuffer + r * partial->getRowSkip(), sendBuffer + r * partial->getRowSkip() + numCols,
+                          contiguous.data() + r * numCols);
+            sendBuffer = contiguous.data();
+        }
+
+        std::vector<int> counts(numWorkers);
+        for (int i = 0; i < numWorkers; i++)
+            counts[i] = static_cast<int>(MPIHelper::partitionRows(numRows, numWorkers, i).second * numCols);
+        auto shareRows = MPIHelper::partitionRows(numRows, numWorkers, workerRank).second;
+        auto share = DataObjectFactory::create<DenseMatrix<VT>>(shareRows, numCols, false);
+        const MPI_Datatype type = MPIHelper::mpiTypeFor<VT>();
+        MPI_Reduce_scatter(sendBuffer, share->getValues(), counts.data(), type, MPI_SUM, workerComm);
+        MPI_Gatherv(share->getValues(), counts[workerRank], type, nullptr, nullptr, nullptr, type, COORDINATOR,
+                    MPI_COMM_WORLD);
+        sendDataACK(this->Store<Structure>(share));
+        return true;
+    }
+
+    void startStream(size_t chunkSize, bool framed) {
+        framedStream = framed;
+        deserializer.reset(new DaphneDeserializerChunks<Structure>(&deserializedMatrix, chunkSize));
+        deserializerIter.reset(new DaphneDeserializerChunks<Structure>::Iterator(deserializer->begin()));
     }
 
     void detachFromComputingTeam() {
@@ -149,42 +306,67 @@ class MPIWorker : WorkerImpl {
         std::string identifier;
         WorkerImpl::Status exStatus(true);
         switch (tag) {
-        case STREAM_INIT:
-            int chunkSize;
-            MPI_Recv(&chunkSize, 1, MPI_INT, COORDINATOR, STREAM_INIT, MPI_COMM_WORLD, &messageStatus);
-            deserializer.reset(new DaphneDeserializerChunks<Structure>(&deserializedMatrix, chunkSize));
-            deserializerIter.reset(new DaphneDeserializerChunks<Structure>::Iterator(deserializer->begin()));
-            (*deserializerIter)->second->resize(chunkSize);
-            break;
-        case DATASIZE: {
-            prepareBufferForMessage(buffer, &messageLength, MPI_INT, source, DATASIZE);
-            MPI_Recv(buffer.data(), messageLength, MPI_UNSIGNED_CHAR, COORDINATOR, DATA, MPI_COMM_WORLD,
+        case STREAM_INIT: {
+            MPIHelper::StreamInfo streamInfo;
+            MPI_Recv(&streamInfo, sizeof(streamInfo), MPI_UNSIGNED_CHAR, COORDINATOR, STREAM_INIT, MPI_COMM_WORLD,
                      &messageStatus);
-            auto ret = storeInputs(buffer, (size_t)messageLength);
-            if (std::get<0>(ret))
-                sendDataACK(std::get<1>(ret));
+            startStream(streamInfo.chunkSize, streamInfo.framed);
+            // Point-to-point chunks are announced, so we can receive them
+            // right away; broadcast chunks arrive as BROADCAST messages.
+            if (streamInfo.numChunks > 0)
+                receiveStream(source,
+                              streamInfo.framed ? ChunkCompression::maxFrameLength(streamInfo.chunkSize)
+                                                : streamInfo.chunkSize,
+                              streamInfo.numChunks);
         } break;
         case BROADCAST: {
-            prepareBufferForMessage(buffer, &messageLength, MPI_INT, source, BROADCAST);
-            MPI_Bcast(buffer.data(), messageLength, MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD);
-            auto ret = storeInputs(buffer, (size_t)messageLength);
+            MPI_Recv(&messageLength, 1, MPI_INT, source, BROADCAST, MPI_COMM_WORLD, &messageStatus);
+            auto chunk = std::make_shared<std::vector<char>>(messageLength);
+            MPI_Bcast(chunk->data(), messageLength, MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD);
+            auto ret = storeInputs(chunk, (size_t)messageLength);
             if (std::get<0>(ret))
                 sendDataACK(std::get<1>(ret));
         } break;
+        case SCATTER: {
+            // The length of this worker's part and whether it is compressed.
+            int scatterInfo[2];
+            MPI_Recv(scatterInfo, 2, MPI_INT, source, SCATTER, MPI_COMM_WORLD, &messageStatus);
+            messageLength = scatterInfo[0];
+            buffer.resize(messageLength);
+            MPI_Scatterv(nullptr, nullptr, nullptr, MPI_UNSIGNED_CHAR, buffer.data(), messageLength,
+                         MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD);
+            if (scatterInfo[1]) {
+                std::vector<char> frame;
+                frame.swap(buffer);
+                ChunkCompression::decompress(frame.data(), frame.size(), buffer);
+            }
+            Structure *mat = DF_deserialize(buffer);
+            sendDataACK(this->Store(mat));
+        } break;
+        case GATHER: {
+            receiveProbedMessage(buffer, MPI_CHAR, status);
+            auto info = MPIHelper::constructStoredInfo(std::string(buffer.data()));
+            std::vector<char> dataToSend;
+            auto mat = this->Transfer(info);
+            size_t len = DaphneSerializer<Structure>::serialize(mat, dataToSend);
+            MPIHelper::contributeToGather(dataToSend.data(), len);
+        } break;
 
-        case MLIRSIZE:
-            prepareBufferForMessage(buffer, &messageLength, MPI_INT, source, MLIRSIZE);
-            MPI_Recv(buffer.data(), messageLength, MPI_UNSIGNED_CHAR, COORDINATOR, MLIR, MPI_COMM_WORLD,
-                     &messageStatus);
+        case REDUCE: {
+            receiveProbedMessage(buffer, MPI_CHAR, status);
+            reduceAndKeepShare(MPIHelper::constructStoredInfo(std::string(buffer.data())));
+        } break;
+
+        case MLIR:
+            receiveProbedMessage(buffer, MPI_UNSIGNED_CHAR, status);
             MsgTask.deserialize(buffer);
 
             exStatus = this->Compute(&outputs, MsgTask.inputs, MsgTask.mlir_code);
             sendComputeResult(outputs);
             break;
 
-        case TRANSFERSIZE: {
-            prepareBufferForMessage(buffer, &messageLength, MPI_INT, source, TRANSFERSIZE);
-            MPI_Recv(buffer.data(), messageLength, MPI_CHAR, COORDINATOR, TRANSFER, MPI_COMM_WORLD, &messageStatus);
+        case TRANSFER: {
+            receiveProbedMessage(buffer, MPI_CHAR, status);
             auto info = MPIHelper::constructStoredInfo(std::string(buffer.data()));
             sendMatrix(info);
         } break;
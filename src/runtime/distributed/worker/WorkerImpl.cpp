@@ -32,7 +32,10 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/io/File.h>
+#include <runtime/local/io/DaphneSerializer.h>
 #include <runtime/local/io/ReadCsv.h>
+#include <runtime/local/kernels/BinaryOpCode.h>
+#include <runtime/local/kernels/EwBinaryMat.h>
 #include <runtime/local/kernels/Read.h>
 
 #include <stdexcept>
@@ -174,6 +177,59 @@ Structure *WorkerImpl::Transfer(StoredInfo info) {
     return mat;
 }
 
+void WorkerImpl::Free(StoredInfo info) {
+    auto it = localData_.find(info.identifier);
+    if (it == localData_.end())
+        return;
+    DataObjectFactory::destroy(static_cast<Structure *>(it->second));
+    localData_.erase(it);
+}
+
+size_t WorkerImpl::Reduce(StoredInfo info, const std::vector<Structure *> &partials, std::vector<char> &buffer) {
+    Structure *own = Transfer(info);
+    size_t bufferLength;
+    if (!(tryReduce<double>(own, partials, buffer, bufferLength) ||
+          tryReduce<float>(own, partials, buffer, bufferLength) ||
+          tryReduce<int64_t>(own, partials, buffer, bufferLength) ||
+          tryReduce<int32_t>(own, partials, buffer, bufferLength) ||
+          tryReduce<int8_t>(own, partials, buffer, bufferLength) ||
+          tryReduce<uint64_t>(own, partials, buffer, bufferLength) ||
+          tryReduce<uint32_t>(own, partials, buffer, bufferLength) ||
+          tryReduce<uint8_t>(own, partials, buffer, bufferLength)))
+        throw std::runtime_error("WorkerImpl: Reduce only supports dense matrices of numeric value types");
+    return bufferLength;
+}
+
+template <typename VT>
+bool WorkerImpl::tryReduce(Structure *obj, const std::vector<Structure *> &partials, std::vector<char> &buffer,
+                           size_t &bufferLength) {
+    auto own = dynamic_cast<DenseMatrix<VT> *>(obj);
+    if (!own)
+        return false;
+    if (partials.empty()) {
+        bufferLength = DaphneSerializer<Structure>::serialize(own, buffer);
+        return true;
+    }
+
+    // The first addition allocates the sum, the stored partial result stays
+    // untouched. All further additions happen in-place.
+    DenseMatrix<VT> *sum = nullptr;
+    const DenseMatrix<VT> *lhs = own;
+    for (auto partial : partials) {
+        auto rhs = dynamic_cast<const DenseMatrix<VT> *>(partial);
+        if (!rhs) {
+            if (sum)
+                DataObjectFactory::destroy(sum);
+            throw std::runtime_error("WorkerImpl: Reduce received partial results of different value types");
+        }
+        ewBinaryMat(BinaryOpCode::ADD, sum, lhs, rhs, nullptr);
+        lhs = sum;
+    }
+    bufferLength = DaphneSerializer<Structure>::serialize(sum, buffer);
+    DataObjectFactory::destroy(sum);
+    return true;
+}
+
 std::vector<void *> WorkerImpl::createPackedCInterfaceInputsOutputs(mlir::FunctionType functionType,
                                                                     std::vector<WorkerImpl::StoredInfo> workInputs,
                                                                     std::vector<void *> &outputs,
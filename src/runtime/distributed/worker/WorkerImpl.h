@@ -86,7 +86,34 @@ class WorkerImpl {
      */
     Structure *Transfer(StoredInfo storedInfo);
 
+    /**
+     * @brief Removes a data object from worker's memory and destroys it
+     *
+     * @param storedInfo Information regarding stored object (identifier,
+     * numRows, numCols)
+     */
+    void Free(StoredInfo storedInfo);
+
+    /**
+     * @brief Adds partial results of an ADD-combined output received from
+     * other workers to the partial result stored in worker's memory
+     *
+     * @param storedInfo Information regarding the stored partial result
+     * @param partials Partial results of other workers (left untouched)
+     * @param buffer Populated with the serialized sum
+     * @return size_t The length of the serialized sum
+     */
+    size_t Reduce(StoredInfo storedInfo, const std::vector<Structure *> &partials, std::vector<char> &buffer);
+
   private:
+    /**
+     * @brief Reduces the given partial result (see `Reduce`) if it is a
+     * `DenseMatrix<VT>`, returns `false` otherwise.
+     */
+    template <typename VT>
+    bool tryReduce(Structure *own, const std::vector<Structure *> &partials, std::vector<char> &buffer,
+                   size_t &bufferLength);
+
     uint64_t tmp_file_counter_ = 0;
     std::unordered_map<std::string, void *> localData_;
     /**
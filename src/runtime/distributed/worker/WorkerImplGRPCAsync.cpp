@@ -17,7 +17,9 @@
 #include "WorkerImplGRPCAsync.h"
 
 #include <runtime/distributed/proto/CallData.h>
+#include <runtime/distributed/proto/ReduceTree.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/io/ChunkCompression.h>
 #include <runtime/local/io/DaphneSerializer.h>
 
 #include <grpcpp/grpcpp.h>
@@ -38,6 +40,7 @@ void WorkerImplGRPCAsync::Wait() {
     new StoreCallData(this, cq_.get(), cq_.get());
     new ComputeCallData(this, cq_.get());
     new TransferCallData(this, cq_.get());
+    new ReduceCallData(this, cq_.get());
     // new FreeMemCallData(this, cq_.get());
     void *tag; // uniquely identifies a request.
     bool ok;
@@ -68,9 +71,16 @@ grpc::Status WorkerImplGRPCAsync::StoreGRPC(::grpc::ServerContext *context, cons
         return grpc::Status::OK;
     }
 
+    const char *buffer = request->bytes().data();
+    std::vector<char> decoded;
+    if (request->compressed()) {
+        bufferLength = ChunkCompression::decompress(buffer, bufferLength, decoded);
+        buffer = decoded.data();
+    }
+
     // Handle value case
-    if (*deserializerIter == deserializer->begin() && DF_Dtype(request->bytes().data()) == DF_data_t::Value_t) {
-        double val = DaphneSerializer<double>::deserialize(request->bytes().data());
+    if (*deserializerIter == deserializer->begin() && DF_Dtype(buffer) == DF_data_t::Value_t) {
+        double val = DaphneSerializer<double>::deserialize(buffer);
         storedInfo = WorkerImpl::Store(&val);
         response->set_identifier(storedInfo.identifier);
         response->set_num_rows(storedInfo.numRows);
@@ -81,9 +91,7 @@ grpc::Status WorkerImplGRPCAsync::StoreGRPC(::grpc::ServerContext *context, cons
         (*deserializerIter)->first = bufferLength;
         if ((*deserializerIter)->second->size() < bufferLength)
             (*deserializerIter)->second->resize(bufferLength);
-        (*deserializerIter)
-            ->second->assign(static_cast<const char *>(request->bytes().data()),
-                             static_cast<const char *>(request->bytes().data()) + bufferLength);
+        (*deserializerIter)->second->assign(buffer, buffer + bufferLength);
 
         // advance iterator, this also partially deserializes
         ++(*deserializerIter);
@@ -144,3 +152,10 @@ grpc::Status WorkerImplGRPCAsync::TransferGRPC(::grpc::ServerContext *context, c
     response->set_bytes(buffer.data(), bufferLength);
     return ::grpc::Status::OK;
 }
+
+grpc::Status WorkerImplGRPCAsync::ReduceGRPC(::grpc::ServerContext *context, const ::distributed::ReduceTask *request,
+                                             ::distributed::Data *response) {
+    // This blocks the completion queue until the children answered. That is
+    // fine, since the children are other workers and the tree has no cycles.
+    return ReduceTree::evaluate(*this, *request, response);
+}
@@ -52,6 +52,8 @@ class WorkerImplGRPCAsync : public WorkerImpl {
                              ::distributed::ComputeResult *response);
     grpc::Status TransferGRPC(::grpc::ServerContext *context, const ::distributed::StoredData *request,
                               ::distributed::Data *response);
+    grpc::Status ReduceGRPC(::grpc::ServerContext *context, const ::distributed::ReduceTask *request,
+                            ::distributed::Data *response);
 
     distributed::Worker::AsyncService service_;
 
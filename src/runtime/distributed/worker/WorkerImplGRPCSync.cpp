@@ -16,8 +16,11 @@
 
 #include "WorkerImplGRPCSync.h"
 
+#include <runtime/distributed/proto/ReduceTree.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/io/ChunkCompression.h>
 #include <runtime/local/io/DaphneSerializer.h>
+#include <runtime/local/io/ReadDaphneColumnar.h>
 
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/server_builder.h>
@@ -29,6 +32,7 @@
 #include <runtime/local/io/HDFS/WriteHDFSCsv.h>
 #include <runtime/local/kernels/CreateHDFSContext.h>
 #endif
+#include <util/DeduceType.h>
 #include <util/KernelDispatchMapping.h>
 #include <util/Statistics.h>
 #include <util/StringRefCount.h>
@@ -53,8 +57,14 @@ grpc::Status WorkerImplGRPCSync::Store(::grpc::ServerContext *context,
     distributed::Data data;
     reader->Read(&data);
 
+    // Compressed chunks are decoded into this buffer.
+    std::vector<char> decoded;
     auto buffer = data.bytes().data();
     auto len = data.bytes().size();
+    if (data.compressed()) {
+        len = ChunkCompression::decompress(buffer, len, decoded);
+        buffer = decoded.data();
+    }
     if (DF_Dtype(buffer) == DF_data_t::Value_t) {
         double val = DaphneSerializer<double>::deserialize(buffer);
         storedInfo = WorkerImpl::Store(&val);
@@ -78,6 +88,10 @@ grpc::Status WorkerImplGRPCSync::Store(::grpc::ServerContext *context,
         while (reader->Read(&data)) {
             buffer = data.bytes().data();
             len = data.bytes().size();
+            if (data.compressed()) {
+                len = ChunkCompression::decompress(buffer, len, decoded);
+                buffer = decoded.data();
+            }
             (*deserializerIter)->first = len;
             if ((*deserializerIter)->second->size() < len)
                 (*deserializerIter)->second->resize(len);
@@ -130,6 +144,42 @@ grpc::Status WorkerImplGRPCSync::Transfer(::grpc::ServerContext *context, const
     return ::grpc::Status::OK;
 }
 
+grpc::Status WorkerImplGRPCSync::Reduce(::grpc::ServerContext *context, const ::distributed::ReduceTask *request,
+                                        ::distributed::Data *response) {
+    return ReduceTree::evaluate(*this, *request, response);
+}
+
+template <typename VT> struct ReadColumnarMatrix {
+    static void apply(Structure *&res, const char *filename, const DaphneColumnarReadOptions &opts, DCTX(ctx)) {
+        DenseMatrix<VT> *mat = nullptr;
+        readDaphneColumnar(mat, filename, opts, ctx);
+        res = mat;
+    }
+};
+
+grpc::Status WorkerImplGRPCSync::ReadColumnar(::grpc::ServerContext *context,
+                                              const ::distributed::ColumnarFileRange *request,
+                                              ::distributed::StoredData *response) {
+    DaphneContext ctx(cfg, KernelDispatchMapping::instance(), Statistics::instance(), StringRefCounter::instance());
+    DaphneColumnarReadOptions opts;
+    opts.startRow = request->start_row();
+    opts.numRows = request->num_rows();
+    Structure *res = nullptr;
+    try {
+        // The reader rejects files whose columns do not have this value type.
+        const auto vtc = static_cast<ValueTypeCode>(request->value_type());
+        DeduceValueTypeAndExecute<ReadColumnarMatrix>::apply(vtc, res, request->filename().c_str(), opts, &ctx);
+    } catch (const std::exception &e) {
+        return ::grpc::Status(grpc::StatusCode::ABORTED, e.what());
+    }
+    auto storedInfo = WorkerImpl::Store(res);
+
+    response->set_identifier(storedInfo.identifier);
+    response->set_num_rows(storedInfo.numRows);
+    response->set_num_cols(storedInfo.numCols);
+    return ::grpc::Status::OK;
+}
+
 #if USE_HDFS
 grpc::Status WorkerImplGRPCSync::ReadHDFS(::grpc::ServerContext *context, const ::distributed::HDFSFile *request,
                                           ::distributed::StoredData *response) {
@@ -44,12 +44,16 @@ class WorkerImplGRPCSync : public WorkerImpl, public distributed::Worker::Servic
     grpc::Status ReadHDFS(::grpc::ServerContext *context, const ::distributed::HDFSFile *request,
                           ::distributed::StoredData *response) override;
 #endif
+    grpc::Status ReadColumnar(::grpc::ServerContext *context, const ::distributed::ColumnarFileRange *request,
+                              ::distributed::StoredData *response) override;
     grpc::Status Store(::grpc::ServerContext *context, ::grpc::ServerReader<::distributed::Data> *reader,
                        ::distributed::StoredData *response) override;
     grpc::Status Compute(::grpc::ServerContext *context, const ::distributed::Task *request,
                          ::distributed::ComputeResult *response) override;
     grpc::Status Transfer(::grpc::ServerContext *context, const ::distributed::StoredData *request,
                           ::distributed::Data *response) override;
+    grpc::Status Reduce(::grpc::ServerContext *context, const ::distributed::ReduceTask *request,
+                        ::distributed::Data *response) override;
 
     template <class DT> DT *CreateMatrix(const ::distributed::Data *mat);
 };
@@ -57,6 +57,7 @@ struct DaphneContext {
 
     std::unique_ptr<IContext> distributed_context;
     std::unique_ptr<IContext> hdfs_context;
+    std::unique_ptr<IContext> io_context;
 
     /**
      * @brief The user configuration (including information passed via CLI
@@ -87,6 +88,8 @@ struct DaphneContext {
         }
         cuda_contexts.clear();
         fpga_contexts.clear();
+        if (io_context)
+            io_context->destroy();
     }
 
 #ifdef USE_CUDA
@@ -114,6 +117,7 @@ struct DaphneContext {
 #ifdef USE_HDFS
     [[nodiscard]] IContext *getHDFSContext() const { return hdfs_context.get(); }
 #endif
+    [[nodiscard]] IContext *getIOContext() const { return io_context.get(); }
 
     [[nodiscard]] DaphneUserConfig &getUserConfig() const { return config; }
 };
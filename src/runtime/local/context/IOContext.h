@@ -0,0 +1,142 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/io/Future.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Runs I/O tasks, such as asynchronous reads, on a small pool of
+ * threads separate from the compute workers.
+ *
+ * The threads are started on the first submitted task, such that scripts which
+ * never read asynchronously do not pay for them. The context owns the futures
+ * it hands out until they are released, such that the results of operations
+ * which are never awaited, e.g., because the script failed before, are
+ * destroyed with the context.
+ */
+class IOContext final : public IContext {
+    // I/O tasks mostly wait for the storage, so a few threads suffice to keep
+    // several files loading concurrently.
+    static constexpr size_t NUM_IO_THREADS = 4;
+
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::unordered_map<const IFuture *, std::unique_ptr<IFuture>> pending;
+
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+  public:
+    IOContext() = default;
+    IOContext(const IOContext &) = delete;
+    IOContext &operator=(const IOContext &) = delete;
+
+    ~IOContext() override { destroy(); }
+
+    static std::unique_ptr<IContext> createIOContext(const DaphneUserConfig &cfg) {
+        return std::make_unique<IOContext>();
+    }
+
+    static IOContext *get(DaphneContext *ctx) { return dynamic_cast<IOContext *>(ctx->getIOContext()); }
+
+    /**
+     * @brief Enqueues the given function and returns a future for its result.
+     *
+     * Exceptions thrown by the function are rethrown by the future's `get()`.
+     */
+    template <class F> auto submit(F func) -> std::future<decltype(func())> {
+        auto task = std::make_shared<std::packaged_task<decltype(func())()>>(std::move(func));
+        auto res = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (stopping)
+                throw std::runtime_error("IOContext: cannot submit tasks after the context was destroyed");
+            if (threads.empty())
+                for (size_t i = 0; i < NUM_IO_THREADS; i++)
+                    threads.emplace_back(&IOContext::run, this);
+            tasks.emplace_back([task] { (*task)(); });
+        }
+        cv.notify_one();
+        return res;
+    }
+
+    /**
+     * @brief Takes ownership of the given future until it is released.
+     */
+    template <class DT> Future<DT> *track(std::unique_ptr<Future<DT>> future) {
+        Future<DT> *ptr = future.get();
+        std::lock_guard<std::mutex> lock(mtx);
+        pending.emplace(ptr, std::move(future));
+        return ptr;
+    }
+
+    /**
+     * @brief Hands the ownership of the given future over to the caller.
+     */
+    template <class DT> std::unique_ptr<Future<DT>> release(Future<DT> *future) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = pending.find(future);
+        if (it == pending.end())
+            throw std::runtime_error("IOContext: the future is unknown or was already released");
+        it->second.release();
+        pending.erase(it);
+        return std::unique_ptr<Future<DT>>(future);
+    }
+
+    /**
+     * @brief Finishes all enqueued tasks, stops the threads, and destroys the
+     * results that were never awaited.
+     */
+    void destroy() override {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &t : threads)
+            t.join();
+        threads.clear();
+        pending.clear();
+    }
+};
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/Structure.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A data object kept alive across the scripts run in a DaphneLib
+ * session, together with the information needed to type it at compile-time.
+ */
+struct ResidentObject {
+    enum class Kind { DENSE_MATRIX, CSR_MATRIX, FRAME };
+
+    Structure *obj;
+    Kind kind;
+    /**
+     * @brief The value type of a matrix.
+     */
+    ValueTypeCode valueType;
+    /**
+     * @brief The column types of a frame.
+     */
+    std::vector<ValueTypeCode> schema;
+    /**
+     * @brief The column labels of a frame.
+     */
+    std::vector<std::string> labels;
+};
+
+/**
+ * @brief Named data objects that outlive the script that produced them.
+ *
+ * A script stores an object by `storeResident()`; all scripts compiled later
+ * in the same session can refer to it by `loadResident()`. The store holds one
+ * reference to each object, so the objects stay valid until they are replaced,
+ * dropped, or the store is destroyed.
+ *
+ * The access is protected by a mutex.
+ */
+class ResidentObjectStore {
+    mutable std::mutex mtx;
+    std::map<std::string, ResidentObject> objects;
+
+    std::map<std::string, ResidentObject>::const_iterator find(const std::string &name) const {
+        auto it = objects.find(name);
+        if (it == objects.end())
+            throw std::runtime_error("there is no resident object named '" + name + "'");
+        return it;
+    }
+
+  public:
+    ResidentObjectStore() = default;
+    ResidentObjectStore(const ResidentObjectStore &) = delete;
+    ResidentObjectStore &operator=(const ResidentObjectStore &) = delete;
+
+    ~ResidentObjectStore() { clear(); }
+
+    /**
+     * @brief Stores the given object under the given name, replacing the
+     * object previously stored under that name (if any).
+     *
+     * Increases the reference counter of the object.
+     */
+    void put(const std::string &name, ResidentObject res) {
+        res.obj->increaseRefCounter();
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = objects.find(name);
+        if (it != objects.end()) {
+            DataObjectFactory::destroy(it->second.obj);
+            it->second = std::move(res);
+        } else
+            objects.emplace(name, std::move(res));
+    }
+
+    /**
+     * @brief Returns a copy of the entry stored under the given name.
+     *
+     * The object itself must not be used after the entry was replaced or
+     * dropped, see `acquire()`.
+     */
+    ResidentObject get(const std::string &name) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return find(name)->second;
+    }
+
+    /**
+     * @brief Returns the object stored under the given name after increasing
+     * its reference counter, i.e., the caller must destroy it eventually.
+     */
+    Structure *acquire(const std::string &name) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        Structure *obj = find(name)->second.obj;
+        obj->increaseRefCounter();
+        return obj;
+    }
+
+    bool contains(const std::string &name) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return objects.count(name);
+    }
+
+    /**
+     * @brief Removes the object stored under the given name, returns `false`
+     * if there is none.
+     */
+    bool drop(const std::string &name) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = objects.find(name);
+        if (it == objects.end())
+            return false;
+        DataObjectFactory::destroy(it->second.obj);
+        objects.erase(it);
+        return true;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto &[name, res] : objects)
+            DataObjectFactory::destroy(res.obj);
+        objects.clear();
+    }
+
+    /**
+     * @brief Returns a string identifying the names and compile-time types of
+     * all stored objects.
+     *
+     * Code compiled while two stores have the same signature types all
+     * `loadResident()` calls the same way.
+     */
+    std::string signature() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        // Names and labels are prefixed by their length, such that they may
+        // contain any character.
+        auto str = [](const std::string &s) { return std::to_string(s.size()) + ':' + s; };
+        std::string sig;
+        for (auto &[name, res] : objects) {
+            sig += str(name) + ',' + std::to_string(static_cast<int>(res.kind)) + ',' +
+                   std::to_string(static_cast<int>(res.valueType));
+            for (size_t i = 0; i < res.schema.size(); i++)
+                sig += ',' + std::to_string(static_cast<int>(res.schema[i])) + ',' + str(res.labels[i]);
+            sig += ';';
+        }
+        return sig;
+    }
+};
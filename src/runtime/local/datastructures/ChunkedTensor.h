@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <optional>
 #include <ostream>
 #include <utility>
@@ -40,7 +43,7 @@ template <typename VT> void ReverseArray(VT *data, uint64_t element_count) {
     for (uint64_t i = 0; i < element_count; i++) {
         VT tmp = data[i];
         for (uint32_t j = 0; j < sizeof(VT); j++) {
-            *(reinterpret_cast<uint8_t *>(&(data[i])) + sizeof(VT) - j) = *(reinterpret_cast<uint8_t *>(&tmp) + j);
+            *(reinterpret_cast<uint8_t *>(&(data[i])) + sizeof(VT) - 1 - j) = *(reinterpret_cast<uint8_t *>(&tmp) + j);
         }
     }
 }
@@ -111,6 +114,20 @@ template <typename ValueType> class ChunkedTensor : public Tensor<ValueType> {
     template <class DataType, typename... ArgTypes> friend DataType *DataObjectFactory::create(ArgTypes...);
     template <class DataType> friend void DataObjectFactory::destroy(const DataType *obj);
 
+    // The values are aligned such that chunks whose size is a multiple of the
+    // alignment can be read from files with O_DIRECT.
+    static std::shared_ptr<ValueType[]> allocateData(size_t element_count) {
+        // std::aligned_alloc() requires the size to be a multiple of the alignment.
+        const size_t size_in_bytes = std::max<size_t>(element_count * sizeof(ValueType), 1);
+        const size_t aligned_size =
+            (size_in_bytes + IO_BUFFER_ALIGNMENT - 1) / IO_BUFFER_ALIGNMENT * IO_BUFFER_ALIGNMENT;
+        void *ptr = std::aligned_alloc(IO_BUFFER_ALIGNMENT, aligned_size);
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return std::shared_ptr<ValueType[]>(static_cast<ValueType *>(ptr), [](ValueType *p) { std::free(p); });
+    }
+
     ChunkedTensor(const std::vector<size_t> &tensor_shape, const std::vector<size_t> &chunk_shape, InitCode init_code)
         : Tensor<ValueType>::Tensor(tensor_shape), chunk_shape(chunk_shape) {
 
@@ -148,7 +165,7 @@ template <typename ValueType> class ChunkedTensor : public Tensor<ValueType> {
 
         total_size_in_elements = total_chunk_count * chunk_element_count;
 
-        data = std::shared_ptr<ValueType[]>(new ValueType[total_size_in_elements], std::default_delete<ValueType[]>());
+        data = allocateData(total_size_in_elements);
 
         chunk_materialization_flags = std::make_unique<std::atomic<bool>[]>(total_chunk_count);
         chunk_io_futures = std::make_unique<AsyncIOInfo[]>(total_chunk_count);
@@ -228,7 +245,7 @@ template <typename ValueType> class ChunkedTensor : public Tensor<ValueType> {
           intra_chunk_strides(other->intra_chunk_strides), chunks_per_dim(other->chunks_per_dim),
           total_size_in_elements(other->total_size_in_elements), total_chunk_count(other->total_chunk_count),
           chunk_materialization_flags(std::make_unique<std::atomic<bool>[]>(total_chunk_count)) {
-        data = std::shared_ptr<ValueType[]>(new ValueType[total_size_in_elements], std::default_delete<ValueType[]>());
+        data = allocateData(total_size_in_elements);
         for (size_t i = 0; i < total_chunk_count; i++) {
             chunk_materialization_flags[i] = static_cast<bool>(other->chunk_materialization_flags[i]);
         }
@@ -261,7 +278,7 @@ template <typename ValueType> class ChunkedTensor : public Tensor<ValueType> {
         total_chunk_count = chunks_per_dim[0] * chunks_per_dim[1];
         total_size_in_elements = total_chunk_count * chunk_element_count;
 
-        data = std::shared_ptr<ValueType[]>(new ValueType[total_size_in_elements], std::default_delete<ValueType[]>());
+        data = allocateData(total_size_in_elements);
 
         for (size_t i = 0; i < this->numCols; i++) {
             for (size_t j = 0; j < this->numRows; j++) {
@@ -312,7 +329,7 @@ template <typename ValueType> class ChunkedTensor : public Tensor<ValueType> {
 
         total_size_in_elements = this->total_element_count;
 
-        data = std::shared_ptr<ValueType[]>(new ValueType[total_size_in_elements], std::default_delete<ValueType[]>());
+        data = allocateData(total_size_in_elements);
 
         std::memcpy(data.get(), other->data.get(), total_size_in_elements * sizeof(ValueType));
 
@@ -827,8 +844,7 @@ template <typename ValueType> class ChunkedTensor : public Tensor<ValueType> {
 
         size_t new_total_size_in_elements = new_total_chunk_count * new_chunk_element_count;
 
-        std::shared_ptr<ValueType[]> new_data(new ValueType[new_total_size_in_elements],
-                                              std::default_delete<ValueType[]>());
+        std::shared_ptr<ValueType[]> new_data = allocateData(new_total_size_in_elements);
 
         std::vector<size_t> chunk_count_strides;
         chunk_count_strides.push_back(1);
@@ -88,7 +88,7 @@ DenseMatrix<ValueType>::DenseMatrix(size_t maxNumRows, size_t numCols, bool zero
 
 template <typename ValueType>
 DenseMatrix<ValueType>::DenseMatrix(size_t numRows, size_t numCols, std::shared_ptr<ValueType[]> &values)
-    : Matrix<ValueType>(numRows, numCols), is_view(false), rowSkip(numCols), values(values),
+    : Matrix<ValueType>(numRows, numCols), is_view(false), rowSkip(numCols), values(values), externalValues(true),
       bufferSize(numRows * numCols * sizeof(ValueType)), lastAppendedRowIdx(0), lastAppendedColIdx(0) {
     AllocationDescriptorHost myHostAllocInfo;
     DataPlacement *new_data_placement = this->mdo->addDataPlacement(&myHostAllocInfo);
@@ -117,7 +117,8 @@ DenseMatrix<ValueType>::DenseMatrix(const DenseMatrix<ValueType> *src, int64_t r
 template <typename ValueType>
 DenseMatrix<ValueType>::DenseMatrix(size_t numRows, size_t numCols, const DenseMatrix<ValueType> *src)
     : Matrix<ValueType>(numRows, numCols), is_view(false), rowSkip(numCols),
-      bufferSize(numRows * numCols * sizeof(ValueType)), lastAppendedRowIdx(0), lastAppendedColIdx(0) {
+      externalValues(src->externalValues), bufferSize(numRows * numCols * sizeof(ValueType)), lastAppendedRowIdx(0),
+      lastAppendedColIdx(0) {
     if (src->values)
         values = src->values;
     this->clone_mdo(src);
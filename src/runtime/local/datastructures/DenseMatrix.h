@@ -50,6 +50,9 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
 
     // ToDo: handle this through MDO
     std::shared_ptr<ValueType[]> values{};
+    // Whether the values array was not allocated by this matrix, but handed
+    // to it (e.g., a numpy array), such that it must not be updated in place.
+    bool externalValues = false;
     size_t bufferSize;
 
     size_t lastAppendedRowIdx;
@@ -202,6 +205,15 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
 
     [[nodiscard]] bool isView() const { return is_view; }
 
+    /**
+     * @brief Returns if the only reference to this matrix and its values is
+     * held by the caller, i.e., if the caller may modify the matrix in place
+     * without affecting any other data object.
+     */
+    [[nodiscard]] bool isExclusivelyOwned() const {
+        return !is_view && !externalValues && this->getRefCounter() == 1 && values.use_count() == 1;
+    }
+
     /**
      * @brief Fetch a pointer to the data held by this structure meant for
      * read-only access.
@@ -219,6 +231,10 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
      * @return A pointer to the data in the requested memory space
      */
     const ValueType *getValues(const IAllocationDescriptor *alloc_desc = nullptr, const Range *range = nullptr) const {
+        // Fast path: the only copy of the data is in host memory, so there is
+        // nothing to look up or keep coherent.
+        if (alloc_desc == nullptr && range == nullptr && this->mdo->isHostOnly())
+            return startAddress();
         auto [isLatest, id, ptr] = const_cast<DenseMatrix<ValueType> *>(this)->getValuesInternal(alloc_desc, range);
         if (!isLatest)
             this->mdo->addLatest(id);
@@ -242,6 +258,10 @@ template <typename ValueType> class DenseMatrix : public Matrix<ValueType> {
      * @return A pointer to the data in the requested memory space
      */
     ValueType *getValues(IAllocationDescriptor *alloc_desc = nullptr, const Range *range = nullptr) {
+        // Fast path: the only copy of the data is in host memory, so there are
+        // no other copies to invalidate.
+        if (alloc_desc == nullptr && range == nullptr && this->mdo->isHostOnly())
+            return startAddress();
         auto [isLatest, id, ptr] = const_cast<DenseMatrix<ValueType> *>(this)->getValuesInternal(alloc_desc, range);
         if (!isLatest)
             this->mdo->setLatest(id);
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_RUNTIME_LOCAL_DATASTRUCTURES_DICTIONARYENCODING_H
+#define SRC_RUNTIME_LOCAL_DATASTRUCTURES_DICTIONARYENCODING_H
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A dictionary encoding of one column of a `DenseMatrix`, i.e., an
+ * integer code per row and the dictionary of distinct values.
+ *
+ * Kernels on columns with few distinct values (e.g., categorical string
+ * columns of a `Frame`) can encode the column once, hashing each value only a
+ * single time, and then compare, sort, group, or join on the integer codes
+ * instead of the values. For `std::string` columns, the dictionary refers to
+ * the strings of the encoded column via `std::string_view`s, such that no
+ * string is copied; thus, the encoded column must outlive the encoding.
+ *
+ * @tparam VT The value type of the encoded column.
+ */
+template <typename VT> class DictionaryEncoding {
+  public:
+    using CodeType = uint32_t;
+    using KeyType = std::conditional_t<std::is_same_v<VT, std::string>, std::string_view, VT>;
+
+  private:
+    size_t numRows;
+    std::shared_ptr<CodeType[]> codes;
+    std::vector<KeyType> dict;
+    std::unordered_map<KeyType, CodeType> codesByKey;
+
+  public:
+    /**
+     * @brief Encodes the given column.
+     *
+     * @param col The matrix containing the column to encode.
+     * @param colIdx The index of the column to encode within `col`.
+     * @param orderPreserving If `true`, the codes are assigned in ascending
+     * order of the values, such that comparing codes is equivalent to
+     * comparing values; otherwise, the codes are assigned in the order of the
+     * first occurrence of the values.
+     */
+    DictionaryEncoding(const DenseMatrix<VT> *col, size_t colIdx = 0, bool orderPreserving = false)
+        : numRows(col->getNumRows()), codes(new CodeType[numRows], std::default_delete<CodeType[]>()) {
+        const VT *values = col->getValues() + colIdx;
+        const size_t rowSkip = col->getRowSkip();
+        CodeType *cs = codes.get();
+        for (size_t r = 0; r < numRows; r++) {
+            const auto nextCode = static_cast<CodeType>(dict.size());
+            auto [it, inserted] = codesByKey.try_emplace(KeyType(values[r * rowSkip]), nextCode);
+            if (inserted) {
+                if (dict.size() == std::numeric_limits<CodeType>::max())
+                    throw std::runtime_error("DictionaryEncoding: too many distinct values");
+                dict.push_back(it->first);
+            }
+            cs[r] = it->second;
+        }
+
+        if (orderPreserving) {
+            // Sorting the few distinct values and remapping the codes is much
+            // cheaper than ordering all rows by their values.
+            std::vector<CodeType> sorted(dict.size());
+            std::iota(sorted.begin(), sorted.end(), 0);
+            std::sort(sorted.begin(), sorted.end(), [this](CodeType a, CodeType b) { return dict[a] < dict[b]; });
+            std::vector<CodeType> newCodes(dict.size());
+            std::vector<KeyType> sortedDict(dict.size());
+            for (size_t i = 0; i < sorted.size(); i++) {
+                newCodes[sorted[i]] = static_cast<CodeType>(i);
+                sortedDict[i] = dict[sorted[i]];
+            }
+            dict = std::move(sortedDict);
+            for (auto &entry : codesByKey)
+                entry.second = newCodes[entry.second];
+            for (size_t r = 0; r < numRows; r++)
+                cs[r] = newCodes[cs[r]];
+        }
+    }
+
+    size_t getNumRows() const { return numRows; }
+
+    size_t getNumDistinct() const { return dict.size(); }
+
+    const CodeType *getCodes() const { return codes.get(); }
+
+    /**
+     * @brief Returns the distinct value with the given code.
+     */
+    const KeyType &getValue(CodeType code) const { return dict[code]; }
+
+    /**
+     * @brief Looks up the code of the given value.
+     *
+     * @return `true` and the code if the value occurs in the encoded column,
+     * or `false` and an unspecified code otherwise.
+     */
+    std::pair<bool, CodeType> find(const KeyType &value) const {
+        auto it = codesByKey.find(value);
+        if (it == codesByKey.end())
+            return {false, 0};
+        return {true, it->second};
+    }
+
+    /**
+     * @brief Returns a `(#rows x 1)` matrix of the codes, which shares the
+     * memory of this encoding.
+     */
+    DenseMatrix<CodeType> *createCodesMatrix() const {
+        std::shared_ptr<CodeType[]> values = codes;
+        return DataObjectFactory::create<DenseMatrix<CodeType>>(numRows, 1, values);
+    }
+};
+
+#endif // SRC_RUNTIME_LOCAL_DATASTRUCTURES_DICTIONARYENCODING_H
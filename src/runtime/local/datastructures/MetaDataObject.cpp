@@ -18,6 +18,8 @@
 #include "DataPlacement.h"
 
 DataPlacement *MetaDataObject::addDataPlacement(const IAllocationDescriptor *allocInfo, Range *r) {
+    if (allocInfo->getType() != ALLOCATION_TYPE::HOST || r != nullptr)
+        host_only = false;
     data_placements[static_cast<size_t>(allocInfo->getType())].emplace_back(
         std::make_unique<DataPlacement>(allocInfo->clone(), r == nullptr ? nullptr : r->clone()));
     return data_placements[static_cast<size_t>(allocInfo->getType())].back().get();
@@ -43,6 +45,7 @@ void MetaDataObject::updateRangeDataPlacementByID(size_t id, Range *r) {
         for (auto &_omd : _omdType) {
             if (_omd->dp_id == id) {
                 _omd->range = r->clone();
+                host_only = false;
                 return;
             }
         }
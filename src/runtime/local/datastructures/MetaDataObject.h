@@ -40,6 +40,9 @@ class MetaDataObject {
     std::array<std::vector<std::unique_ptr<DataPlacement>>, static_cast<size_t>(ALLOCATION_TYPE::NUM_ALLOC_TYPES)>
         data_placements;
     std::vector<size_t> latest_version;
+    // Whether all data placements are host allocations of the full data
+    // object; placements are never removed, so this only changes once.
+    bool host_only = true;
 
   public:
     DataPlacement *addDataPlacement(const IAllocationDescriptor *allocInfo, Range *r = nullptr);
@@ -54,4 +57,11 @@ class MetaDataObject {
     void addLatest(size_t id);
     void setLatest(size_t id);
     [[nodiscard]] auto getLatest() const -> std::vector<size_t>;
+
+    /**
+     * @brief Returns if the data object lives exclusively in (full-range) host
+     * allocations, in which case the host allocation is always up-to-date and
+     * the data placement bookkeeping can be bypassed.
+     */
+    [[nodiscard]] bool isHostOnly() const { return host_only; }
 };
@@ -0,0 +1,545 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/Structure.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/io/ArrowCDataInterface.h>
+#include <util/DeduceType.h>
+
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Exchange of frames with other libraries (e.g., pyarrow) through the
+ * Arrow C data interface.
+ *
+ * A frame is represented as an Arrow struct array with one child per column,
+ * which is how Arrow exports record batches. Numeric columns are exchanged
+ * without copying in both directions. DAPHNE stores strings as `std::string`,
+ * so string columns are always copied.
+ */
+namespace ArrowCData {
+
+// ****************************************************************************
+// Mapping of value types
+// ****************************************************************************
+
+/**
+ * @brief Returns the Arrow format string a DAPHNE value type is exported as.
+ */
+inline const char *formatFor(ValueTypeCode vtc) {
+    switch (vtc) {
+    case ValueTypeCode::SI8:
+        return "c";
+    case ValueTypeCode::SI32:
+        return "i";
+    case ValueTypeCode::SI64:
+        return "l";
+    case ValueTypeCode::UI8:
+        return "C";
+    case ValueTypeCode::UI32:
+        return "I";
+    case ValueTypeCode::UI64:
+        return "L";
+    case ValueTypeCode::F32:
+        return "f";
+    case ValueTypeCode::F64:
+        return "g";
+    case ValueTypeCode::STR:
+        return "U"; // large UTF-8, i.e., with 64-bit offsets
+    default:
+        throw std::runtime_error("ArrowCData: value type " + ValueTypeUtils::cppNameForCode(vtc) +
+                                 " cannot be exported");
+    }
+}
+
+/**
+ * @brief Returns the DAPHNE value type an Arrow column of the given format is
+ * imported as.
+ *
+ * Types without a DAPHNE counterpart are widened (16-bit integers to 32-bit
+ * integers, booleans to `UI8`). DAPHNE has no notion of missing values, so
+ * like in pandas, integer columns with nulls become `F64` columns with NaN
+ * for the nulls. DaphneLib mirrors this mapping to infer the frame's schema at
+ * compile-time.
+ */
+inline ValueTypeCode valueTypeCodeFor(const std::string &format, bool hasNulls) {
+    if (format == "g")
+        return ValueTypeCode::F64;
+    if (format == "f")
+        return ValueTypeCode::F32;
+    if (format == "u" || format == "U")
+        return ValueTypeCode::STR;
+
+    ValueTypeCode vtc;
+    if (format == "c")
+        vtc = ValueTypeCode::SI8;
+    else if (format == "s" || format == "i")
+        vtc = ValueTypeCode::SI32;
+    else if (format == "l")
+        vtc = ValueTypeCode::SI64;
+    else if (format == "C" || format == "b")
+        vtc = ValueTypeCode::UI8;
+    else if (format == "S" || format == "I")
+        vtc = ValueTypeCode::UI32;
+    else if (format == "L")
+        vtc = ValueTypeCode::UI64;
+    else
+        throw std::runtime_error("ArrowCData: Arrow format '" + format + "' cannot be imported");
+    return hasNulls ? ValueTypeCode::F64 : vtc;
+}
+
+// ****************************************************************************
+// Export
+// ****************************************************************************
+
+namespace detail {
+
+// The private data of an exported schema: the storage of its strings and its
+// children.
+struct ExportedSchema {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema *> children;
+};
+
+// The private data of an exported array: a reference to the exported frame,
+// the buffers owned by the array itself (the offsets and characters of
+// strings), and its children.
+struct ExportedArray {
+    std::shared_ptr<const Frame> frame;
+    std::vector<int64_t> offsets;
+    std::string chars;
+    std::vector<const void *> buffers;
+    std::vector<ArrowArray *> children;
+
+    explicit ExportedArray(std::shared_ptr<const Frame> frame) : frame(std::move(frame)) {}
+};
+
+// Consumers may move children out of their parent (by copying the struct and
+// setting the release callback of the original to null), so children are
+// released only if they are still in place.
+inline void releaseSchema(ArrowSchema *schema) {
+    auto *priv = static_cast<ExportedSchema *>(schema->private_data);
+    for (ArrowSchema *child : priv->children) {
+        if (child->release)
+            child->release(child);
+        delete child;
+    }
+    delete priv;
+    schema->release = nullptr;
+}
+
+inline void releaseArray(ArrowArray *array) {
+    auto *priv = static_cast<ExportedArray *>(array->private_data);
+    for (ArrowArray *child : priv->children) {
+        if (child->release)
+            child->release(child);
+        delete child;
+    }
+    delete priv;
+    array->release = nullptr;
+}
+
+inline void initSchema(ArrowSchema *schema, ExportedSchema *priv) {
+    schema->format = priv->format.c_str();
+    schema->name = priv->name.c_str();
+    schema->metadata = nullptr;
+    schema->flags = 0;
+    schema->n_children = static_cast<int64_t>(priv->children.size());
+    schema->children = priv->children.empty() ? nullptr : priv->children.data();
+    schema->dictionary = nullptr;
+    schema->release = &releaseSchema;
+    schema->private_data = priv;
+}
+
+inline void initArray(ArrowArray *array, ExportedArray *priv, size_t length) {
+    array->length = static_cast<int64_t>(length);
+    array->null_count = 0;
+    array->offset = 0;
+    array->n_buffers = static_cast<int64_t>(priv->buffers.size());
+    array->n_children = static_cast<int64_t>(priv->children.size());
+    array->buffers = priv->buffers.data();
+    array->children = priv->children.empty() ? nullptr : priv->children.data();
+    array->dictionary = nullptr;
+    array->release = &releaseArray;
+    array->private_data = priv;
+}
+
+} // namespace detail
+
+/**
+ * @brief Exports the given frame through the Arrow C data interface.
+ *
+ * The numeric columns are shared with the consumer. The frame is kept alive
+ * until the consumer has released the array (and all children it moved out
+ * of it), even if DAPHNE is done with the frame in the meantime.
+ *
+ * @param frame The frame to export.
+ * @param array The struct to export the data into; must not hold an array yet.
+ * @param schema The struct to export the schema into; must not hold a schema
+ * yet.
+ */
+inline void exportFrame(const Frame *frame, ArrowArray *array, ArrowSchema *schema) {
+    const size_t numRows = frame->getNumRows();
+    const size_t numCols = frame->getNumCols();
+    const std::string *labels = frame->getLabels();
+
+    // Check all columns before allocating anything.
+    for (size_t c = 0; c < numCols; c++)
+        formatFor(frame->getColumnType(c));
+
+    frame->increaseRefCounter();
+    std::shared_ptr<const Frame> ref(frame, [](const Frame *f) { DataObjectFactory::destroy(f); });
+
+    auto *rootSchema = new detail::ExportedSchema{"+s", "", {}};
+    auto *rootArray = new detail::ExportedArray(ref);
+    rootArray->buffers = {nullptr};
+    for (size_t c = 0; c < numCols; c++) {
+        const ValueTypeCode vtc = frame->getColumnType(c);
+
+        auto *childSchema = new ArrowSchema;
+        detail::initSchema(childSchema, new detail::ExportedSchema{formatFor(vtc), labels[c], {}});
+        rootSchema->children.push_back(childSchema);
+
+        auto *childPriv = new detail::ExportedArray(ref);
+        if (vtc == ValueTypeCode::STR) {
+            // The strings are copied, so this column does not need the frame.
+            childPriv->frame.reset();
+            const auto *values = static_cast<const std::string *>(frame->getColumnRaw(c));
+            childPriv->offsets.resize(numRows + 1);
+            childPriv->offsets[0] = 0;
+            for (size_t r = 0; r < numRows; r++) {
+                childPriv->chars += values[r];
+                childPriv->offsets[r + 1] = static_cast<int64_t>(childPriv->chars.size());
+            }
+            childPriv->buffers = {nullptr, childPriv->offsets.data(), childPriv->chars.data()};
+        } else
+            childPriv->buffers = {nullptr, frame->getColumnRaw(c)};
+        auto *childArray = new ArrowArray;
+        detail::initArray(childArray, childPriv, numRows);
+        rootArray->children.push_back(childArray);
+    }
+    detail::initSchema(schema, rootSchema);
+    detail::initArray(array, rootArray, numRows);
+}
+
+// ****************************************************************************
+// Import
+// ****************************************************************************
+
+namespace detail {
+
+// Takes over an imported array and releases it once the last column sharing
+// its buffers is gone.
+struct ImportedArray {
+    ArrowArray array;
+
+    explicit ImportedArray(ArrowArray *src) : array(*src) { src->release = nullptr; }
+    ImportedArray(const ImportedArray &) = delete;
+    ImportedArray &operator=(const ImportedArray &) = delete;
+    ~ImportedArray() {
+        if (array.release)
+            array.release(&array);
+    }
+};
+
+// Takes over an imported schema and releases it at the end of the import.
+struct ImportedSchema {
+    ArrowSchema schema;
+
+    explicit ImportedSchema(ArrowSchema *src) : schema(*src) { src->release = nullptr; }
+    ImportedSchema(const ImportedSchema &) = delete;
+    ImportedSchema &operator=(const ImportedSchema &) = delete;
+    ~ImportedSchema() {
+        if (schema.release)
+            schema.release(&schema);
+    }
+};
+
+// The index `i` includes the array's offset.
+inline bool isValid(const ArrowArray *array, int64_t i) {
+    const auto *validity = static_cast<const uint8_t *>(array->buffers[0]);
+    return !validity || ((validity[i >> 3] >> (i & 7)) & 1);
+}
+
+// The null count is optional (-1 if unknown), so it is determined from the
+// validity bitmap if necessary.
+inline bool hasNulls(const ArrowArray *array, int64_t off, int64_t length) {
+    if (array->null_count == 0 || array->n_buffers == 0 || !array->buffers[0])
+        return false;
+    for (int64_t r = 0; r < length; r++)
+        if (!isValid(array, off + r))
+            return true;
+    return false;
+}
+
+template <typename VT> VT nullValue() {
+    if constexpr (std::is_floating_point_v<VT>)
+        return std::numeric_limits<VT>::quiet_NaN();
+    else
+        return VT();
+}
+
+// Imports a numeric column, without copying if it can be used as is.
+template <typename VTRes, typename VTArg>
+Structure *importNumeric(const ArrowArray *array, int64_t off, size_t numRows,
+                         const std::shared_ptr<ImportedArray> &owner) {
+    const VTArg *values = static_cast<const VTArg *>(array->buffers[1]) + off;
+    if constexpr (std::is_same_v<VTRes, VTArg>) {
+        if (!hasNulls(array, off, numRows)) {
+            std::shared_ptr<VTRes[]> shared(const_cast<VTRes *>(values), [owner](VTRes *) {});
+            return DataObjectFactory::create<DenseMatrix<VTRes>>(numRows, 1, shared);
+        }
+    }
+    auto *res = DataObjectFactory::create<DenseMatrix<VTRes>>(numRows, 1, false);
+    VTRes *valuesRes = res->getValues();
+    for (size_t r = 0; r < numRows; r++)
+        valuesRes[r] = isValid(array, off + r) ? static_cast<VTRes>(values[r]) : nullValue<VTRes>();
+    return res;
+}
+
+template <typename VTRes>
+Structure *importBoolean(const ArrowArray *array, int64_t off, size_t numRows) {
+    const auto *bits = static_cast<const uint8_t *>(array->buffers[1]);
+    auto *res = DataObjectFactory::create<DenseMatrix<VTRes>>(numRows, 1, false);
+    VTRes *valuesRes = res->getValues();
+    for (size_t r = 0; r < numRows; r++) {
+        const int64_t i = off + r;
+        valuesRes[r] = isValid(array, i) ? static_cast<VTRes>((bits[i >> 3] >> (i & 7)) & 1) : nullValue<VTRes>();
+    }
+    return res;
+}
+
+// Nulls become empty strings.
+template <typename OffsetType> Structure *importString(const ArrowArray *array, int64_t off, size_t numRows) {
+    const auto *offsets = static_cast<const OffsetType *>(array->buffers[1]);
+    const auto *chars = static_cast<const char *>(array->buffers[2]);
+    auto *res = DataObjectFactory::create<DenseMatrix<std::string>>(numRows, 1, false);
+    std::string *valuesRes = res->getValues();
+    for (size_t r = 0; r < numRows; r++)
+        if (isValid(array, off + r))
+            valuesRes[r].assign(chars + offsets[off + r], offsets[off + r + 1] - offsets[off + r]);
+        else
+            valuesRes[r].clear();
+    return res;
+}
+
+// Decodes a dictionary-encoded column by looking up the indices in the
+// already imported dictionary.
+template <typename VT> struct DecodeDictionary {
+    template <typename IT>
+    static void gather(Structure *&res, const Structure *dict, const ArrowArray *indices, int64_t off,
+                       size_t numRows) {
+        const VT *dictValues = static_cast<const DenseMatrix<VT> *>(dict)->getValues();
+        const size_t dictSize = dict->getNumRows();
+        const IT *idxs = static_cast<const IT *>(indices->buffers[1]) + off;
+        auto *resMat = DataObjectFactory::create<DenseMatrix<VT>>(numRows, 1, false);
+        VT *valuesRes = resMat->getValues();
+        for (size_t r = 0; r < numRows; r++) {
+            if (!isValid(indices, off + r)) {
+                valuesRes[r] = nullValue<VT>();
+                continue;
+            }
+            const IT idx = idxs[r];
+            // Negative indices become too large when converted to unsigned.
+            if (static_cast<uint64_t>(idx) >= dictSize) {
+                DataObjectFactory::destroy(resMat);
+                throw std::runtime_error("ArrowCData: dictionary index " + std::to_string(idx) + " in row " +
+                                         std::to_string(r) + " is out of bounds for a dictionary of " +
+                                         std::to_string(dictSize) + " values");
+            }
+            valuesRes[r] = dictValues[idx];
+        }
+        res = resMat;
+    }
+
+    static void apply(Structure *&res, const Structure *dict, const ArrowArray *indices, const std::string &format,
+                      int64_t off, size_t numRows) {
+        if (format == "c")
+            gather<int8_t>(res, dict, indices, off, numRows);
+        else if (format == "s")
+            gather<int16_t>(res, dict, indices, off, numRows);
+        else if (format == "i")
+            gather<int32_t>(res, dict, indices, off, numRows);
+        else if (format == "l")
+            gather<int64_t>(res, dict, indices, off, numRows);
+        else if (format == "C")
+            gather<uint8_t>(res, dict, indices, off, numRows);
+        else if (format == "S")
+            gather<uint16_t>(res, dict, indices, off, numRows);
+        else if (format == "I")
+            gather<uint32_t>(res, dict, indices, off, numRows);
+        else if (format == "L")
+            gather<uint64_t>(res, dict, indices, off, numRows);
+        else
+            throw std::runtime_error("ArrowCData: dictionary indices of format '" + format + "' are not supported");
+    }
+};
+
+// Helper for DeduceValueTypeAndExecute.
+template <typename VTRes> struct ImportNumeric {
+    static void apply(Structure *&res, const std::string &format, const ArrowArray *array, int64_t off,
+                      size_t numRows, const std::shared_ptr<ImportedArray> &owner) {
+        if (format == "c")
+            res = importNumeric<VTRes, int8_t>(array, off, numRows, owner);
+        else if (format == "s")
+            res = importNumeric<VTRes, int16_t>(array, off, numRows, owner);
+        else if (format == "i")
+            res = importNumeric<VTRes, int32_t>(array, off, numRows, owner);
+        else if (format == "l")
+            res = importNumeric<VTRes, int64_t>(array, off, numRows, owner);
+        else if (format == "C")
+            res = importNumeric<VTRes, uint8_t>(array, off, numRows, owner);
+        else if (format == "S")
+            res = importNumeric<VTRes, uint16_t>(array, off, numRows, owner);
+        else if (format == "I")
+            res = importNumeric<VTRes, uint32_t>(array, off, numRows, owner);
+        else if (format == "L")
+            res = importNumeric<VTRes, uint64_t>(array, off, numRows, owner);
+        else if (format == "f")
+            res = importNumeric<VTRes, float>(array, off, numRows, owner);
+        else if (format == "g")
+            res = importNumeric<VTRes, double>(array, off, numRows, owner);
+        else // "b"
+            res = importBoolean<VTRes>(array, off, numRows);
+    }
+};
+
+/**
+ * @brief Imports one Arrow array as a single-column `DenseMatrix`.
+ *
+ * @param off The offset of the first row in the array, i.e., the offset of
+ * the array itself plus the offset of its parent.
+ * @param forceNullable Whether the column must be able to represent nulls,
+ * because the indices referring to this dictionary contain nulls.
+ */
+inline Structure *importColumn(const ArrowSchema *schema, const ArrowArray *array, int64_t off, size_t numRows,
+                               bool forceNullable, const std::shared_ptr<ImportedArray> &owner) {
+    if (off + static_cast<int64_t>(numRows) > array->offset + array->length)
+        throw std::runtime_error("ArrowCData: array is shorter than expected");
+    const std::string format(schema->format);
+
+    if (schema->dictionary) {
+        const bool nullIndices = hasNulls(array, off, numRows);
+        const ArrowArray *dictArray = array->dictionary;
+        Structure *dict = importColumn(schema->dictionary, dictArray, dictArray->offset, dictArray->length,
+                                       forceNullable || nullIndices, owner);
+        Structure *res = nullptr;
+        try {
+            const ValueTypeCode vtc = valueTypeCodeFor(schema->dictionary->format,
+                                                       forceNullable || nullIndices ||
+                                                           hasNulls(dictArray, dictArray->offset, dictArray->length));
+            if (vtc == ValueTypeCode::STR)
+                DecodeDictionary<std::string>::apply(res, dict, array, format, off, numRows);
+            else
+                DeduceValueTypeAndExecute<DecodeDictionary>::apply(vtc, res, dict, array, format, off, numRows);
+        } catch (...) {
+            DataObjectFactory::destroy(dict);
+            throw;
+        }
+        DataObjectFactory::destroy(dict);
+        return res;
+    }
+
+    if (format == "u")
+        return importString<int32_t>(array, off, numRows);
+    if (format == "U")
+        return importString<int64_t>(array, off, numRows);
+
+    Structure *res = nullptr;
+    const ValueTypeCode vtc = valueTypeCodeFor(format, forceNullable || hasNulls(array, off, numRows));
+    DeduceValueTypeAndExecute<ImportNumeric>::apply(vtc, res, format, array, off, numRows, owner);
+    return res;
+}
+
+} // namespace detail
+
+/**
+ * @brief Imports a struct array (e.g., an exported record batch) as a frame.
+ *
+ * Takes over both the array and the schema, i.e., their release callbacks are
+ * set to null and DAPHNE releases them when they are no longer needed. Numeric
+ * columns without nulls are used without copying; the array is released only
+ * when no data object refers to its buffers anymore. The validity of the
+ * struct array itself is ignored.
+ *
+ * @param res The imported frame.
+ * @param array The struct array.
+ * @param schema The schema of the struct array.
+ * @param labels The column labels; if `numLabels` is zero, the names of the
+ * struct's children are used instead.
+ * @param numLabels The number of column labels, either zero or the number of
+ * columns.
+ */
+inline void importFrame(Frame *&res, ArrowArray *array, ArrowSchema *schema, const char **labels = nullptr,
+                        size_t numLabels = 0) {
+    if (!array->release || !schema->release)
+        throw std::runtime_error("ArrowCData: cannot import an array or schema that was already released");
+    auto owner = std::make_shared<detail::ImportedArray>(array);
+    detail::ImportedSchema ownedSchema(schema);
+    const ArrowArray *root = &owner->array;
+    const ArrowSchema *rootSchema = &ownedSchema.schema;
+
+    if (std::string(rootSchema->format) != "+s")
+        throw std::runtime_error("ArrowCData: only struct arrays can be imported as frames, but the format is '" +
+                                 std::string(rootSchema->format) + "'");
+    if (rootSchema->n_children != root->n_children)
+        throw std::runtime_error("ArrowCData: the array and the schema have a different number of children");
+    const size_t numCols = root->n_children;
+    if (numLabels && numLabels != numCols)
+        throw std::runtime_error("ArrowCData: expected " + std::to_string(numCols) + " column labels, but got " +
+                                 std::to_string(numLabels));
+    const size_t numRows = root->length;
+
+    std::vector<Structure *> cols;
+    std::vector<std::string> colLabels;
+    try {
+        for (size_t c = 0; c < numCols; c++) {
+            const ArrowSchema *childSchema = rootSchema->children[c];
+            const ArrowArray *child = root->children[c];
+            cols.push_back(
+                detail::importColumn(childSchema, child, child->offset + root->offset, numRows, false, owner));
+            if (numLabels)
+                colLabels.emplace_back(labels[c]);
+            else if (childSchema->name && *childSchema->name)
+                colLabels.emplace_back(childSchema->name);
+            else
+                colLabels.emplace_back(Frame::getDefaultLabel(c));
+        }
+        res = DataObjectFactory::create<Frame>(cols, colLabels.data());
+    } catch (...) {
+        for (Structure *col : cols)
+            DataObjectFactory::destroy(col);
+        throw;
+    }
+    for (Structure *col : cols)
+        DataObjectFactory::destroy(col);
+}
+
+} // namespace ArrowCData
@@ -0,0 +1,364 @@
+/*
+ * Copyright 2021 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/io/CompressionCodec.h>
+#include <runtime/local/io/DaphneSerializer.h>
+
+#include <arrow/util/compression.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ****************************************************************************
+// Compressed frames of serialized chunks
+// ****************************************************************************
+
+/**
+ * @brief The header of a compressed chunk (a "frame").
+ *
+ * A chunk produced by `DaphneSerializerChunks` is compressed in two optional
+ * stages:
+ * 1. A range of 64-bit words (e.g., the row offsets and column indices of a
+ *    `CSRMatrix`) is delta-encoded and bit-packed in place.
+ * 2. The result is compressed by a general-purpose codec (LZ4 or Zstd).
+ *
+ * Each stage is only applied if it actually makes the chunk smaller, so the
+ * payload of a frame is never larger than the original chunk.
+ */
+struct ChunkFrameHeader {
+    // The codec the payload is compressed with (`CompressionCodec`).
+    uint8_t codec;
+    // The length of the original chunk.
+    uint64_t rawLength;
+    // The length of the chunk after stage 1, i.e., the input of the codec.
+    uint64_t filteredLength;
+    // The byte offset of the packed words in the original chunk.
+    uint64_t wordsBegin;
+    // The number of packed words, 0 if stage 1 was not applied.
+    uint64_t numWords;
+    // The number of bytes the packed words take after stage 1.
+    uint64_t packedLength;
+} __attribute__((__packed__));
+
+namespace ChunkCompression {
+
+/**
+ * @brief The number of words which share the same bit width when bit-packing.
+ */
+static constexpr size_t PACKING_BLOCK_SIZE = 128;
+
+/**
+ * @brief Returns the maximum length of a frame for chunks of the given size.
+ */
+inline size_t maxFrameLength(size_t chunkSize) { return sizeof(ChunkFrameHeader) + chunkSize; }
+
+// ----------------------------------------------------------------------------
+// Delta encoding and bit-packing
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Delta-encodes and bit-packs the given 64-bit words.
+ *
+ * The deltas are zig-zag encoded, such that small negative deltas (e.g., when
+ * the column indices restart in the next row of a `CSRMatrix`) stay small.
+ * Each block of `PACKING_BLOCK_SIZE` deltas is stored with the bit width of its
+ * largest delta, which is stored in the block's first byte.
+ *
+ * @param src The words, not necessarily aligned.
+ * @param numWords The number of words.
+ * @param dst The output buffer, which must have room for
+ * `numWords * 9` bytes.
+ * @return The number of bytes written.
+ */
+inline size_t packWords(const char *src, size_t numWords, char *dst) {
+    uint64_t block[PACKING_BLOCK_SIZE];
+    uint64_t prev = 0;
+    size_t out = 0;
+    for (size_t b = 0; b < numWords; b += PACKING_BLOCK_SIZE) {
+        const size_t n = std::min(PACKING_BLOCK_SIZE, numWords - b);
+        uint64_t any = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t word;
+            std::memcpy(&word, src + (b + i) * sizeof(uint64_t), sizeof(uint64_t));
+            const int64_t delta = static_cast<int64_t>(word - prev);
+            prev = word;
+            block[i] = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+            any |= block[i];
+        }
+        const unsigned width = any ? 64 - __builtin_clzll(any) : 0;
+        dst[out++] = static_cast<char>(width);
+
+        unsigned __int128 acc = 0;
+        unsigned bits = 0;
+        for (size_t i = 0; i < n && width; i++) {
+            acc |= static_cast<unsigned __int128>(block[i]) << bits;
+            bits += width;
+            for (; bits >= 8; bits -= 8, acc >>= 8)
+                dst[out++] = static_cast<char>(acc & 0xff);
+        }
+        if (bits)
+            dst[out++] = static_cast<char>(acc & 0xff);
+    }
+    return out;
+}
+
+/**
+ * @brief Reverses `packWords`.
+ *
+ * @param src The packed words.
+ * @param srcLength The number of bytes available at `src`.
+ * @param numWords The number of words.
+ * @param dst The output buffer for `numWords` words, not necessarily aligned.
+ * @return The number of bytes read.
+ */
+inline size_t unpackWords(const char *src, size_t srcLength, size_t numWords, char *dst) {
+    uint64_t prev = 0;
+    size_t in = 0;
+    for (size_t b = 0; b < numWords; b += PACKING_BLOCK_SIZE) {
+        const size_t n = std::min(PACKING_BLOCK_SIZE, numWords - b);
+        if (in == srcLength)
+            throw std::runtime_error("ChunkCompression: corrupt packed words");
+        const unsigned width = static_cast<uint8_t>(src[in++]);
+        if (width > 64 || (n * width + 7) / 8 > srcLength - in)
+            throw std::runtime_error("ChunkCompression: corrupt packed words");
+        const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+
+        unsigned __int128 acc = 0;
+        unsigned bits = 0;
+        for (size_t i = 0; i < n; i++) {
+            for (; bits < width; bits += 8)
+                acc |= static_cast<unsigned __int128>(static_cast<uint8_t>(src[in++])) << bits;
+            const uint64_t zigzag = static_cast<uint64_t>(acc) & mask;
+            acc >>= width;
+            bits -= width;
+            const uint64_t word = prev + ((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            prev = word;
+            std::memcpy(dst + (b + i) * sizeof(uint64_t), &word, sizeof(uint64_t));
+        }
+    }
+    return in;
+}
+
+// ----------------------------------------------------------------------------
+// General-purpose codecs
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Returns this thread's instance of the given codec.
+ */
+inline arrow::util::Codec *getCodec(CompressionCodec codec) {
+    thread_local std::unique_ptr<arrow::util::Codec> codecs[3];
+    auto &instance = codecs[static_cast<size_t>(codec)];
+    if (!instance) {
+        arrow::Compression::type type;
+        switch (codec) {
+        case CompressionCodec::LZ4:
+            type = arrow::Compression::LZ4;
+            break;
+        case CompressionCodec::ZSTD:
+            type = arrow::Compression::ZSTD;
+            break;
+        default:
+            throw std::runtime_error("ChunkCompression: no codec for NONE");
+        }
+        auto result = arrow::util::Codec::Create(type);
+        if (!result.ok())
+            throw std::runtime_error("ChunkCompression: " + result.status().ToString());
+        instance = std::move(result).ValueOrDie();
+    }
+    return instance.get();
+}
+
+/**
+ * @brief Returns the byte range of 64-bit words in the serialization of the
+ * given object, which are worth delta-encoding and bit-packing.
+ */
+template <class DT> std::pair<size_t, size_t> packableRange(const DT *arg) { return {0, 0}; }
+template <typename VT> std::pair<size_t, size_t> packableRange(const CSRMatrix<VT> *arg) {
+    return DaphneSerializer<CSRMatrix<VT>>::indexRange(arg);
+}
+
+// ----------------------------------------------------------------------------
+// Compression and decompression of chunks
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Compresses the chunks of one transfer.
+ *
+ * The codec is chosen per transfer. If the first chunk without packed words
+ * does not compress well (e.g., dense floating-point data), the codec is
+ * switched off for the rest of the transfer to spare the CPU time. Stage 1 is
+ * decided per chunk, as it is cheap.
+ */
+class ChunkCompressor {
+    CompressionCodec codec;
+    // The packable byte range of the serialized object.
+    std::pair<size_t, size_t> packable;
+    // Whether the codec has been tried on a representative chunk yet.
+    bool probed = false;
+    std::vector<char> filtered;
+
+  public:
+    /**
+     * @brief The probed chunk has to shrink at least to this fraction of its
+     * size to keep compressing the remaining chunks.
+     */
+    static constexpr double MIN_COMPRESSION_RATIO = 0.9;
+
+    /**
+     * @param codec The codec to use; if `NONE`, only stage 1 is applied.
+     * @param packable The byte range of 64-bit words in the serialized object
+     * which shall be delta-encoded and bit-packed (see `packableRange`).
+     */
+    ChunkCompressor(CompressionCodec codec, std::pair<size_t, size_t> packable = {0, 0})
+        : codec(codec), packable(packable) {}
+
+    /**
+     * @brief Compresses one chunk into a frame.
+     *
+     * @param chunk The chunk.
+     * @param length The length of the chunk.
+     * @param offset The byte offset of the chunk in the serialized object.
+     * @param frame The output frame, resized as needed.
+     * @return The length of the frame.
+     */
+    size_t compress(const char *chunk, size_t length, size_t offset, std::vector<char> &frame) {
+        ChunkFrameHeader header{};
+        header.codec = static_cast<uint8_t>(CompressionCodec::NONE);
+        header.rawLength = length;
+
+        // Stage 1: the whole 64-bit words of the packable range in this chunk.
+        const size_t begin = std::max(packable.first, offset);
+        const size_t end = std::min(packable.second, offset + length);
+        if (begin < end) {
+            const size_t firstWord = begin + (sizeof(uint64_t) - (begin - packable.first) % sizeof(uint64_t)) %
+                                                 sizeof(uint64_t);
+            if (firstWord < end) {
+                header.wordsBegin = firstWord - offset;
+                header.numWords = (end - firstWord) / sizeof(uint64_t);
+            }
+        }
+        const char *input = chunk;
+        size_t inputLength = length;
+        if (header.numWords) {
+            const size_t wordBytes = header.numWords * sizeof(uint64_t);
+            filtered.resize(length + header.numWords + 1);
+            std::memcpy(filtered.data(), chunk, header.wordsBegin);
+            header.packedLength =
+                packWords(chunk + header.wordsBegin, header.numWords, filtered.data() + header.wordsBegin);
+            if (header.packedLength < wordBytes) {
+                const size_t tail = length - header.wordsBegin - wordBytes;
+                std::memcpy(filtered.data() + header.wordsBegin + header.packedLength,
+                            chunk + header.wordsBegin + wordBytes, tail);
+                input = filtered.data();
+                inputLength = header.wordsBegin + header.packedLength + tail;
+            } else
+                header.numWords = header.packedLength = 0;
+        }
+        if (!header.numWords)
+            header.wordsBegin = 0;
+        header.filteredLength = inputLength;
+
+        // Stage 2: the general-purpose codec.
+        size_t payloadLength = inputLength;
+        if (codec != CompressionCodec::NONE) {
+            auto c = getCodec(codec);
+            const auto in = reinterpret_cast<const uint8_t *>(input);
+            const auto bound = c->MaxCompressedLen(static_cast<int64_t>(inputLength), in);
+            frame.resize(sizeof(header) + std::max<size_t>(bound, inputLength));
+            auto result = c->Compress(static_cast<int64_t>(inputLength), in, bound,
+                                      reinterpret_cast<uint8_t *>(frame.data() + sizeof(header)));
+            if (!result.ok())
+                throw std::runtime_error("ChunkCompression: " + result.status().ToString());
+            const size_t compressedLength = static_cast<size_t>(result.ValueOrDie());
+            if (compressedLength < inputLength) {
+                header.codec = static_cast<uint8_t>(codec);
+                payloadLength = compressedLength;
+            }
+            // Packed words hardly compress any further, so only plain chunks are representative.
+            if (!probed && !header.numWords) {
+                probed = true;
+                if (compressedLength > MIN_COMPRESSION_RATIO * inputLength)
+                    codec = CompressionCodec::NONE;
+            }
+        } else
+            frame.resize(sizeof(header) + inputLength);
+        if (header.codec == static_cast<uint8_t>(CompressionCodec::NONE))
+            std::memcpy(frame.data() + sizeof(header), input, inputLength);
+
+        std::memcpy(frame.data(), &header, sizeof(header));
+        return sizeof(header) + payloadLength;
+    }
+};
+
+/**
+ * @brief Restores the original chunk from a frame.
+ *
+ * @param frame The frame.
+ * @param length The length of the frame.
+ * @param chunk The output chunk, resized as needed.
+ * @return The length of the chunk.
+ */
+inline size_t decompress(const char *frame, size_t length, std::vector<char> &chunk) {
+    if (length < sizeof(ChunkFrameHeader))
+        throw std::runtime_error("ChunkCompression: truncated frame");
+    ChunkFrameHeader header;
+    std::memcpy(&header, frame, sizeof(header));
+    const char *payload = frame + sizeof(header);
+    const size_t payloadLength = length - sizeof(header);
+
+    std::vector<char> filtered;
+    const char *input = payload;
+    if (header.codec != static_cast<uint8_t>(CompressionCodec::NONE)) {
+        // Without stage 1, we can decompress right into the output.
+        auto &target = header.numWords ? filtered : chunk;
+        target.resize(header.filteredLength);
+        auto result = getCodec(static_cast<CompressionCodec>(header.codec))
+                          ->Decompress(static_cast<int64_t>(payloadLength), reinterpret_cast<const uint8_t *>(payload),
+                                       static_cast<int64_t>(header.filteredLength),
+                                       reinterpret_cast<uint8_t *>(target.data()));
+        if (!result.ok())
+            throw std::runtime_error("ChunkCompression: " + result.status().ToString());
+        if (!header.numWords)
+            return header.rawLength;
+        input = filtered.data();
+    } else if (payloadLength != header.filteredLength)
+        throw std::runtime_error("ChunkCompression: corrupt frame");
+
+    chunk.resize(header.rawLength);
+    if (!header.numWords) {
+        std::memcpy(chunk.data(), input, header.rawLength);
+        return header.rawLength;
+    }
+    if (header.wordsBegin > header.filteredLength || header.packedLength > header.filteredLength - header.wordsBegin)
+        throw std::runtime_error("ChunkCompression: corrupt frame");
+    const size_t wordBytes = header.numWords * sizeof(uint64_t);
+    std::memcpy(chunk.data(), input, header.wordsBegin);
+    unpackWords(input + header.wordsBegin, header.packedLength, header.numWords, chunk.data() + header.wordsBegin);
+    std::memcpy(chunk.data() + header.wordsBegin + wordBytes, input + header.wordsBegin + header.packedLength,
+                header.rawLength - header.wordsBegin - wordBytes);
+    return header.rawLength;
+}
+
+} // namespace ChunkCompression
@@ -0,0 +1,562 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/io/ChunkCompression.h>
+#include <runtime/local/io/CompressionCodec.h>
+#include <runtime/local/io/DaphneFile.h>
+#include <runtime/local/kernels/ParallelFor.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ****************************************************************************
+// Columnar DAPHNE binary format (version 2)
+// ****************************************************************************
+
+// The layout is specified in doc/BinaryFormat.md. In short, the rows are split
+// into row groups, each row group is stored as one chunk per column, and a
+// footer at the end of the file indexes all chunks along with their
+// statistics, such that a reader can fetch only the chunks it needs.
+
+constexpr uint8_t DCF_VERSION = 2;
+constexpr char DCF_MAGIC[4] = {'D', 'C', 'F', '2'};
+constexpr size_t DCF_DEFAULT_ROW_GROUP_SIZE = size_t(1) << 16;
+
+enum class DCF_encoding_t : uint8_t { PLAIN = 0, BITPACKED = 1, DICTIONARY = 2 };
+
+/**
+ * @brief The footer entry of one column chunk.
+ */
+struct DCF_chunk {
+    // The byte offset of the chunk in the file.
+    uint64_t offset;
+    // The number of bytes stored in the file.
+    uint64_t length;
+    // The number of bytes after decompressing with `codec`.
+    uint64_t encodedLength;
+    // The encoding of the values (`DCF_encoding_t`).
+    uint8_t encoding;
+    // The general-purpose codec applied after the encoding (`CompressionCodec`).
+    uint8_t codec;
+    // The number of NaNs (floating-point columns only).
+    uint64_t numNulls;
+    // Whether `min` and `max` are valid, i.e., the chunk has a non-NaN numeric
+    // value.
+    uint8_t hasMinMax;
+    // The minimum and maximum as int64_t, uint64_t, or double bits, depending
+    // on the signedness of the value type.
+    uint64_t min;
+    uint64_t max;
+} __attribute__((__packed__));
+
+/**
+ * @brief The contents of the footer of a columnar file.
+ */
+struct DaphneColumnarFooter {
+    uint8_t dt;
+    uint64_t numRows;
+    uint64_t numCols;
+    std::vector<ValueTypeCode> schema;
+    // Empty unless the file contains a frame.
+    std::vector<std::string> labels;
+    // The first row of each row group, plus the number of rows at the end.
+    std::vector<uint64_t> rowGroupStarts;
+    // The chunks in row-major order, i.e., `rowGroup * numCols + col`.
+    std::vector<DCF_chunk> chunks;
+
+    size_t getNumRowGroups() const { return rowGroupStarts.size() - 1; }
+    const DCF_chunk &getChunk(size_t rowGroup, size_t col) const { return chunks[rowGroup * numCols + col]; }
+};
+
+namespace DaphneColumnar {
+
+// ----------------------------------------------------------------------------
+// Statistics
+// ----------------------------------------------------------------------------
+
+template <typename VT> uint64_t statBits(VT v) {
+    if constexpr (std::is_floating_point_v<VT>)
+        return std::bit_cast<uint64_t>(static_cast<double>(v));
+    else if constexpr (std::is_signed_v<VT>)
+        return static_cast<uint64_t>(static_cast<int64_t>(v));
+    else
+        return static_cast<uint64_t>(v);
+}
+
+/**
+ * @brief Converts a statistic back to a number; `long double` represents all
+ * 64-bit integers exactly on the platforms we support.
+ */
+inline long double statValue(uint64_t bits, ValueTypeCode vtc) {
+    switch (vtc) {
+    case ValueTypeCode::SI8:
+    case ValueTypeCode::SI32:
+    case ValueTypeCode::SI64:
+        return static_cast<int64_t>(bits);
+    case ValueTypeCode::UI8:
+    case ValueTypeCode::UI32:
+    case ValueTypeCode::UI64:
+        return bits;
+    case ValueTypeCode::F32:
+    case ValueTypeCode::F64:
+        return std::bit_cast<double>(bits);
+    default:
+        throw std::runtime_error("DaphneColumnar: no statistics for this value type");
+    }
+}
+
+template <typename VT> void computeStats(const VT *values, size_t rowSkip, size_t numRows, DCF_chunk &chunk) {
+    chunk.numNulls = 0;
+    chunk.hasMinMax = 0;
+    if constexpr (!std::is_same_v<VT, std::string>) {
+        VT mn{}, mx{};
+        for (size_t r = 0; r < numRows; r++) {
+            const VT v = values[r * rowSkip];
+            if constexpr (std::is_floating_point_v<VT>)
+                if (std::isnan(v)) {
+                    chunk.numNulls++;
+                    continue;
+                }
+            if (!chunk.hasMinMax) {
+                mn = mx = v;
+                chunk.hasMinMax = 1;
+            } else if (v < mn)
+                mn = v;
+            else if (v > mx)
+                mx = v;
+        }
+        if (chunk.hasMinMax) {
+            chunk.min = statBits(mn);
+            chunk.max = statBits(mx);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Encodings
+// ----------------------------------------------------------------------------
+
+template <typename VT> void writePlain(const VT *values, size_t rowSkip, size_t numRows, std::vector<char> &out) {
+    if constexpr (std::is_same_v<VT, std::string>) {
+        for (size_t r = 0; r < numRows; r++) {
+            const std::string &s = values[r * rowSkip];
+            const uint32_t len = static_cast<uint32_t>(s.size());
+            out.insert(out.end(), reinterpret_cast<const char *>(&len), reinterpret_cast<const char *>(&len) + 4);
+            out.insert(out.end(), s.begin(), s.end());
+        }
+    } else {
+        const size_t pos = out.size();
+        out.resize(pos + numRows * sizeof(VT));
+        if (rowSkip == 1)
+            std::memcpy(out.data() + pos, values, numRows * sizeof(VT));
+        else
+            for (size_t r = 0; r < numRows; r++)
+                std::memcpy(out.data() + pos + r * sizeof(VT), values + r * rowSkip, sizeof(VT));
+    }
+}
+
+/**
+ * @brief Reads the rows `[begin, end)` of `numRows` plainly encoded values.
+ *
+ * @param length The number of bytes available at `p`.
+ * @return The position after all `numRows` values.
+ */
+template <typename VT>
+const char *readPlain(const char *p, size_t length, size_t numRows, size_t begin, size_t end, VT *dst,
+                      size_t rowSkip) {
+    if constexpr (std::is_same_v<VT, std::string>) {
+        const char *const pEnd = p + length;
+        for (size_t r = 0; r < numRows; r++) {
+            uint32_t len;
+            if (pEnd - p < 4)
+                throw std::runtime_error("DaphneColumnar: corrupt chunk");
+            std::memcpy(&len, p, 4);
+            p += 4;
+            if (static_cast<size_t>(pEnd - p) < len)
+                throw std::runtime_error("DaphneColumnar: corrupt chunk");
+            if (r >= begin && r < end)
+                dst[(r - begin) * rowSkip].assign(p, len);
+            p += len;
+        }
+        return p;
+    } else {
+        if (numRows > length / sizeof(VT))
+            throw std::runtime_error("DaphneColumnar: corrupt chunk");
+        if (rowSkip == 1)
+            std::memcpy(dst, p + begin * sizeof(VT), (end - begin) * sizeof(VT));
+        else
+            for (size_t r = begin; r < end; r++)
+                std::memcpy(dst + (r - begin) * rowSkip, p + r * sizeof(VT), sizeof(VT));
+        return p + numRows * sizeof(VT);
+    }
+}
+
+inline void appendPackedWords(const std::vector<uint64_t> &words, std::vector<char> &out) {
+    const size_t pos = out.size();
+    out.resize(pos + words.size() * 9 + 1);
+    out.resize(pos + ChunkCompression::packWords(reinterpret_cast<const char *>(words.data()), words.size(),
+                                                 out.data() + pos));
+}
+
+/**
+ * @brief Dictionary-encodes the values, unless there are too many distinct
+ * ones.
+ *
+ * Floating-point values are keyed by their bits, such that NaNs are encoded
+ * like any other value.
+ *
+ * @return `false` if the dictionary would exceed `maxDictSize` entries.
+ */
+template <typename VT>
+bool writeDictionary(const VT *values, size_t rowSkip, size_t numRows, size_t maxDictSize, std::vector<char> &out) {
+    using KT = std::conditional_t<std::is_same_v<VT, std::string>, std::string,
+                                  std::conditional_t<sizeof(VT) == 8, uint64_t,
+                                                     std::conditional_t<sizeof(VT) == 4, uint32_t, uint8_t>>>;
+    std::unordered_map<KT, uint64_t> codeOf;
+    std::vector<VT> dict;
+    std::vector<uint64_t> codes(numRows);
+    for (size_t r = 0; r < numRows; r++) {
+        const VT &v = values[r * rowSkip];
+        KT key;
+        if constexpr (std::is_same_v<VT, std::string>)
+            key = v;
+        else
+            key = std::bit_cast<KT>(v);
+        auto it = codeOf.try_emplace(key, dict.size()).first;
+        if (it->second == dict.size()) {
+            if (dict.size() == maxDictSize)
+                return false;
+            dict.push_back(v);
+        }
+        codes[r] = it->second;
+    }
+    const uint32_t dictSize = static_cast<uint32_t>(dict.size());
+    out.insert(out.end(), reinterpret_cast<const char *>(&dictSize), reinterpret_cast<const char *>(&dictSize) + 4);
+    writePlain(dict.data(), 1, dict.size(), out);
+    appendPackedWords(codes, out);
+    return true;
+}
+
+/**
+ * @brief Encodes and optionally compresses one column chunk and computes its
+ * statistics.
+ *
+ * Integers are delta-encoded and bit-packed (see `ChunkCompression`), while
+ * floating-point values and strings with few distinct values are
+ * dictionary-encoded. Both encodings as well as the codec are only applied if
+ * they make the chunk smaller.
+ *
+ * @param values Pointer to the value of the first row.
+ * @param rowSkip The distance between the values of consecutive rows.
+ * @param numRows The number of rows of the chunk.
+ * @param codec The general-purpose codec to try on the encoded chunk.
+ * @param chunk The footer entry, except for the offset, which the caller sets.
+ * @param out The stored bytes of the chunk.
+ */
+template <typename VT>
+void encodeChunk(const VT *values, size_t rowSkip, size_t numRows, CompressionCodec codec, DCF_chunk &chunk,
+                 std::vector<char> &out) {
+    computeStats(values, rowSkip, numRows, chunk);
+
+    std::vector<char> encoded;
+    writePlain(values, rowSkip, numRows, encoded);
+    chunk.encoding = static_cast<uint8_t>(DCF_encoding_t::PLAIN);
+    if (numRows) {
+        std::vector<char> alt;
+        DCF_encoding_t altEncoding;
+        if constexpr (std::is_integral_v<VT>) {
+            std::vector<uint64_t> words(numRows);
+            for (size_t r = 0; r < numRows; r++)
+                words[r] = statBits(values[r * rowSkip]);
+            appendPackedWords(words, alt);
+            altEncoding = DCF_encoding_t::BITPACKED;
+        } else {
+            if (!writeDictionary(values, rowSkip, numRows, numRows / 4, alt))
+                alt.clear();
+            altEncoding = DCF_encoding_t::DICTIONARY;
+        }
+        if (!alt.empty() && alt.size() < encoded.size()) {
+            encoded.swap(alt);
+            chunk.encoding = static_cast<uint8_t>(altEncoding);
+        }
+    }
+    chunk.encodedLength = encoded.size();
+
+    chunk.codec = static_cast<uint8_t>(CompressionCodec::NONE);
+    if (codec != CompressionCodec::NONE && !encoded.empty()) {
+        auto c = ChunkCompression::getCodec(codec);
+        const auto in = reinterpret_cast<const uint8_t *>(encoded.data());
+        const auto bound = c->MaxCompressedLen(static_cast<int64_t>(encoded.size()), in);
+        out.resize(bound);
+        auto result = c->Compress(static_cast<int64_t>(encoded.size()), in, bound,
+                                  reinterpret_cast<uint8_t *>(out.data()));
+        if (!result.ok())
+            throw std::runtime_error("DaphneColumnar: " + result.status().ToString());
+        const size_t compressedLength = static_cast<size_t>(result.ValueOrDie());
+        if (compressedLength < encoded.size()) {
+            out.resize(compressedLength);
+            chunk.codec = static_cast<uint8_t>(codec);
+        }
+    }
+    if (chunk.codec == static_cast<uint8_t>(CompressionCodec::NONE))
+        out.swap(encoded);
+    chunk.length = out.size();
+}
+
+/**
+ * @brief Decodes the rows `[begin, end)` of one column chunk.
+ *
+ * @param data The stored bytes of the chunk.
+ * @param chunk The footer entry of the chunk.
+ * @param numRows The number of rows of the chunk.
+ * @param dst Pointer to the destination of row `begin`.
+ * @param rowSkip The distance between the destinations of consecutive rows.
+ */
+template <typename VT>
+void decodeChunk(const char *data, const DCF_chunk &chunk, size_t numRows, size_t begin, size_t end, VT *dst,
+                 size_t rowSkip) {
+    thread_local std::vector<char> decompressed;
+    thread_local std::vector<uint64_t> words;
+
+    // The footer and the chunk come from the file, so every read is checked
+    // against the length of the encoded chunk.
+    const char *encoded = data;
+    const size_t encodedLength = chunk.encodedLength;
+    if (chunk.codec != static_cast<uint8_t>(CompressionCodec::NONE)) {
+        decompressed.resize(encodedLength);
+        auto result = ChunkCompression::getCodec(static_cast<CompressionCodec>(chunk.codec))
+                          ->Decompress(static_cast<int64_t>(chunk.length), reinterpret_cast<const uint8_t *>(data),
+                                       static_cast<int64_t>(encodedLength),
+                                       reinterpret_cast<uint8_t *>(decompressed.data()));
+        if (!result.ok())
+            throw std::runtime_error("DaphneColumnar: " + result.status().ToString());
+        if (static_cast<size_t>(result.ValueOrDie()) != encodedLength)
+            throw std::runtime_error("DaphneColumnar: corrupt chunk");
+        encoded = decompressed.data();
+    } else if (chunk.length != encodedLength)
+        throw std::runtime_error("DaphneColumnar: corrupt chunk");
+
+    switch (static_cast<DCF_encoding_t>(chunk.encoding)) {
+    case DCF_encoding_t::PLAIN:
+        if (readPlain(encoded, encodedLength, numRows, begin, end, dst, rowSkip) != encoded + encodedLength)
+            throw std::runtime_error("DaphneColumnar: corrupt chunk");
+        break;
+    case DCF_encoding_t::BITPACKED:
+        if constexpr (std::is_integral_v<VT>) {
+            words.resize(numRows);
+            ChunkCompression::unpackWords(encoded, encodedLength, numRows, reinterpret_cast<char *>(words.data()));
+            for (size_t r = begin; r < end; r++)
+                dst[(r - begin) * rowSkip] = static_cast<VT>(words[r]);
+            break;
+        } else
+            throw std::runtime_error("DaphneColumnar: bit-packed chunk of non-integer values");
+    case DCF_encoding_t::DICTIONARY: {
+        uint32_t dictSize;
+        if (encodedLength < 4)
+            throw std::runtime_error("DaphneColumnar: corrupt chunk");
+        std::memcpy(&dictSize, encoded, 4);
+        // Each dictionary entry takes at least four bytes (the length of a
+        // string) or the size of a value.
+        if (dictSize > (encodedLength - 4) / std::min<size_t>(4, sizeof(VT)))
+            throw std::runtime_error("DaphneColumnar: corrupt chunk");
+        std::vector<VT> dict(dictSize);
+        const char *codes = readPlain(encoded + 4, encodedLength - 4, dictSize, 0, dictSize, dict.data(), 1);
+        words.resize(numRows);
+        ChunkCompression::unpackWords(codes, encoded + encodedLength - codes, numRows,
+                                      reinterpret_cast<char *>(words.data()));
+        for (size_t r = begin; r < end; r++) {
+            if (words[r] >= dictSize)
+                throw std::runtime_error("DaphneColumnar: corrupt dictionary code");
+            dst[(r - begin) * rowSkip] = dict[words[r]];
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error("DaphneColumnar: unknown chunk encoding");
+    }
+}
+
+/**
+ * @brief Like `parallelFor`, but rethrows the first exception of any thread in
+ * the calling thread, e.g., if a chunk is corrupt.
+ */
+template <class Func> void parallelForChunks(size_t numTasks, size_t numThreads, Func func) {
+    std::vector<std::exception_ptr> errors(std::max<size_t>(numThreads, 1));
+    parallelFor(numTasks, numThreads, [&](size_t begin, size_t end, size_t t) {
+        try {
+            for (size_t i = begin; i < end; i++)
+                func(i);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    });
+    for (auto &e : errors)
+        if (e)
+            std::rethrow_exception(e);
+}
+
+// ----------------------------------------------------------------------------
+// Footer
+// ----------------------------------------------------------------------------
+
+template <typename T> void append(std::vector<char> &out, const T &v) {
+    out.insert(out.end(), reinterpret_cast<const char *>(&v), reinterpret_cast<const char *>(&v) + sizeof(T));
+}
+
+/**
+ * @brief Throws if a label is too long for its 16-bit length in the footer.
+ */
+inline void checkLabelLengths(const DaphneColumnarFooter &footer) {
+    for (size_t c = 0; c < footer.labels.size(); c++)
+        if (footer.labels[c].size() > std::numeric_limits<uint16_t>::max())
+            throw std::runtime_error("DaphneColumnar: the label of column " + std::to_string(c) + " exceeds " +
+                                     std::to_string(std::numeric_limits<uint16_t>::max()) + " bytes");
+}
+
+/**
+ * @brief Serializes the footer including the trailing footer length and magic
+ * bytes.
+ */
+inline std::vector<char> serializeFooter(const DaphneColumnarFooter &footer) {
+    checkLabelLengths(footer);
+    std::vector<char> out;
+    append(out, static_cast<uint64_t>(footer.getNumRowGroups()));
+    for (size_t rg = 0; rg < footer.getNumRowGroups(); rg++)
+        append(out, static_cast<uint64_t>(footer.rowGroupStarts[rg + 1] - footer.rowGroupStarts[rg]));
+    for (ValueTypeCode vtc : footer.schema)
+        append(out, vtc);
+    for (const std::string &label : footer.labels) {
+        append(out, static_cast<uint16_t>(label.size()));
+        out.insert(out.end(), label.begin(), label.end());
+    }
+    for (const DCF_chunk &chunk : footer.chunks)
+        append(out, chunk);
+    append(out, static_cast<uint64_t>(out.size()));
+    out.insert(out.end(), DCF_MAGIC, DCF_MAGIC + sizeof(DCF_MAGIC));
+    return out;
+}
+
+/**
+ * @brief Reads the header and the footer of an open columnar file.
+ */
+inline DaphneColumnarFooter readFooter(int fd, const std::string &filename) {
+    auto fail = [&](const char *msg) {
+        throw std::runtime_error("DaphneColumnar: " + filename + ": " + msg);
+    };
+    auto readAt = [&](void *buf, size_t len, uint64_t offset) {
+        if (pread(fd, buf, len, static_cast<off_t>(offset)) != static_cast<ssize_t>(len))
+            fail("unexpected end of file");
+    };
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        fail("could not stat file");
+    const uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+    DF_header h;
+    const size_t trailerSize = sizeof(uint64_t) + sizeof(DCF_MAGIC);
+    if (fileSize < sizeof(h) + trailerSize)
+        fail("not a columnar DAPHNE binary file");
+    readAt(&h, sizeof(h), 0);
+    char trailer[trailerSize];
+    readAt(trailer, trailerSize, fileSize - trailerSize);
+    uint64_t footerLength;
+    std::memcpy(&footerLength, trailer, sizeof(footerLength));
+    if (h.version != DCF_VERSION || std::memcmp(trailer + sizeof(footerLength), DCF_MAGIC, sizeof(DCF_MAGIC)) != 0)
+        fail("not a columnar DAPHNE binary file");
+    if (footerLength > fileSize - sizeof(h) - trailerSize)
+        fail("corrupt footer");
+
+    std::vector<char> buf(footerLength);
+    readAt(buf.data(), footerLength, fileSize - trailerSize - footerLength);
+    size_t pos = 0;
+    auto take = [&](void *dst, size_t len) {
+        if (len > buf.size() - pos)
+            fail("corrupt footer");
+        if (len == 0)
+            return;
+        std::memcpy(dst, buf.data() + pos, len);
+        pos += len;
+    };
+
+    DaphneColumnarFooter footer;
+    footer.dt = h.dt;
+    footer.numRows = h.nbrows;
+    footer.numCols = h.nbcols;
+    uint64_t numRowGroups;
+    take(&numRowGroups, sizeof(numRowGroups));
+    if (numRowGroups > buf.size() / sizeof(uint64_t) || footer.numCols > buf.size())
+        fail("corrupt footer");
+    footer.rowGroupStarts.resize(numRowGroups + 1, 0);
+    for (size_t rg = 0; rg < numRowGroups; rg++) {
+        uint64_t n;
+        take(&n, sizeof(n));
+        footer.rowGroupStarts[rg + 1] = footer.rowGroupStarts[rg] + n;
+    }
+    if (footer.rowGroupStarts.back() != footer.numRows)
+        fail("corrupt footer");
+    footer.schema.resize(footer.numCols);
+    take(footer.schema.data(), footer.numCols * sizeof(ValueTypeCode));
+    if (footer.dt == DF_data_t::Frame_t) {
+        footer.labels.resize(footer.numCols);
+        for (std::string &label : footer.labels) {
+            uint16_t len;
+            take(&len, sizeof(len));
+            label.resize(len);
+            take(label.data(), len);
+        }
+    }
+    if (numRowGroups * footer.numCols > (buf.size() - pos) / sizeof(DCF_chunk))
+        fail("corrupt footer");
+    footer.chunks.resize(numRowGroups * footer.numCols);
+    take(footer.chunks.data(), footer.chunks.size() * sizeof(DCF_chunk));
+    for (const DCF_chunk &chunk : footer.chunks)
+        if (chunk.offset > fileSize || chunk.length > fileSize - chunk.offset)
+            fail("corrupt footer");
+    return footer;
+}
+
+/**
+ * @brief Returns whether the given file is in the columnar DAPHNE binary
+ * format, as opposed to the original format (version 1).
+ */
+inline bool isColumnarFile(const char *filename) {
+    std::ifstream f(filename, std::ios::in | std::ios::binary);
+    uint8_t version = 0;
+    f.read(reinterpret_cast<char *>(&version), sizeof(version));
+    return f.good() && version == DCF_VERSION;
+}
+
+} // namespace DaphneColumnar
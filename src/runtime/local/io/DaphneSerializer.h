@@ -24,11 +24,17 @@
 #include <runtime/local/datastructures/ValueTypeCode.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 #include <stdlib.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 // ****************************************************************************
 // Helper functions
@@ -469,6 +475,16 @@ template <typename VT> struct DaphneSerializer<CSRMatrix<VT>, false> {
 
         return len;
     };
+    /**
+     * @brief Returns the byte range of the row offsets and the column indices
+     * (consecutive `size_t` words) in the serialized object.
+     */
+    static std::pair<size_t, size_t> indexRange(const CSRMatrix<VT> *arg) {
+        size_t nzb = 0;
+        for (size_t r = 0; r < arg->getNumRows(); r++)
+            nzb += arg->getNumNonZeros(r);
+        return {HEADER_BUFFER_SIZE, HEADER_BUFFER_SIZE + (arg->getNumRows() + 1 + nzb) * sizeof(size_t)};
+    }
     /**
      * @brief Creates a header and copies it to the buffer, containing
      * information about the object (dimensions, types, other)
@@ -923,21 +939,375 @@ struct DaphneSerializer<const CSRMatrix<VT>, false> : public DaphneSerializer<CS
  *
  * Contains static methods for finding the length in bytes, serializing and
  * deserializing Frame objects.
+ *
+ * The serialized Frame consists of a header (the common DF_header, the total
+ * length in bytes, the schema and the column labels) followed by the columns
+ * in order. A column of a fixed-size value type is stored as its raw values,
+ * a string column as the lengths of all strings followed by their characters.
+ * Since the length of a Frame with string columns cannot be derived from its
+ * header alone, the total length is part of the header (see
+ * serializedLength()).
  */
 template <> struct DaphneSerializer<Frame> {
-    static size_t length(const Frame *arg) { throw std::runtime_error("not implemented"); };
+    /**
+     * @brief The default serialization chunk size
+     */
+    static const size_t DEFAULT_SERIALIZATION_BUFFER_SIZE = 1048576;
+    // Size of the fixed part of the header, the schema and the labels follow.
+    static const size_t HEADER_BUFFER_SIZE = sizeof(DF_header) + sizeof(uint64_t);
 
-    static size_t serialize(const Frame *arg, char *buf, size_t chunkSize = 0, size_t serializeFromByte = 0) {
-        throw std::runtime_error("not implemented");
+    /**
+     * @brief Returns the size of the header (including schema and labels).
+     *
+     * Throws if a label is too long to be serialized.
+     */
+    static size_t headerSize(const Frame *arg) {
+        size_t len = HEADER_BUFFER_SIZE;
+        const std::string *labels = arg->getLabels();
+        for (size_t c = 0; c < arg->getNumCols(); c++) {
+            // The length of each label is stored as an uint16_t.
+            if (labels[c].size() > std::numeric_limits<uint16_t>::max())
+                throw std::runtime_error("Frame serialize(): the label of column " + std::to_string(c) + " exceeds " +
+                                         std::to_string(std::numeric_limits<uint16_t>::max()) + " bytes");
+            len += sizeof(ValueTypeCode) + sizeof(uint16_t) + labels[c].size();
+        }
+        return len;
+    }
+
+    /**
+     * @brief The byte positions of the columns and strings of a Frame in its
+     * serialized form.
+     *
+     * The position of a string depends on the lengths of all strings before
+     * it. The chunked (de)serializers keep one Layout per Frame across its
+     * chunks (see DaphneChunkState), so it is computed only once and each
+     * chunk starts directly at the first row of its window.
+     */
+    struct Layout {
+        // The byte index at which each column starts, followed by the end of
+        // the last column. Covers the columns in strBegin and the next one.
+        std::vector<size_t> colBegin;
+        // For each string column, the byte index at which the characters of
+        // each row start, followed by the end of the column (empty for other
+        // columns).
+        std::vector<std::vector<size_t>> strBegin;
     };
+
+    /**
+     * @brief Extends the layout to the first numCols columns.
+     *
+     * The lengths of the strings in these columns must be final.
+     */
+    static void extendLayout(const Frame *arg, Layout &layout, size_t numCols) {
+        const size_t numRows = arg->getNumRows();
+        if (layout.colBegin.empty())
+            layout.colBegin.push_back(headerSize(arg));
+        for (size_t c = layout.strBegin.size(); c < numCols; c++) {
+            size_t pos = layout.colBegin[c];
+            std::vector<size_t> strBegin;
+            if (arg->getColumnType(c) == ValueTypeCode::STR) {
+                const std::string *col = static_cast<const std::string *>(arg->getColumnRaw(c));
+                pos += numRows * sizeof(uint64_t);
+                strBegin.resize(numRows + 1);
+                for (size_t r = 0; r < numRows; r++) {
+                    strBegin[r] = pos;
+                    pos += col[r].size();
+                }
+                strBegin[numRows] = pos;
+            } else
+                pos += numRows * ValueTypeUtils::sizeOf(arg->getColumnType(c));
+            layout.strBegin.push_back(std::move(strBegin));
+            layout.colBegin.push_back(pos);
+        }
+    }
+
+    /**
+     * @brief Calculates the byte length of the object.
+     */
+    static size_t length(const Frame *arg) {
+        const size_t numRows = arg->getNumRows();
+        size_t len = headerSize(arg);
+        for (size_t c = 0; c < arg->getNumCols(); c++) {
+            if (arg->getColumnType(c) == ValueTypeCode::STR) {
+                const std::string *col = static_cast<const std::string *>(arg->getColumnRaw(c));
+                len += numRows * sizeof(uint64_t);
+                for (size_t r = 0; r < numRows; r++)
+                    len += col[r].size();
+            } else
+                len += numRows * ValueTypeUtils::sizeOf(arg->getColumnType(c));
+        }
+        return len;
+    }
+
+    /**
+     * @brief Returns the byte length of the Frame serialized in the buffer,
+     * as stored in its header.
+     */
+    static size_t serializedLength(const char *buf) {
+        uint64_t len;
+        std::copy(buf + sizeof(DF_header), buf + HEADER_BUFFER_SIZE, reinterpret_cast<char *>(&len));
+        return len;
+    }
+
+    /**
+     * @brief Creates a header and copies it to the buffer, containing
+     * information about the object (dimensions, total length, schema and
+     * labels).
+     *
+     * @param arg The object to be serialized.
+     * @param buffer A pointer to copy the data.
+     * @return size_t The size of the header in bytes.
+     */
+    static size_t serializeHeader(const Frame *arg, char *buffer) { return serializeHeader(arg, buffer, length(arg)); }
+    // Same as above, for a Frame of the given (already known) byte length.
+    static size_t serializeHeader(const Frame *arg, char *buffer, uint64_t len) {
+        size_t bufferIdx = 0;
+
+        DF_header h;
+        h.version = 1;
+        h.dt = (uint8_t)DF_data_t::Frame_t;
+        h.nbrows = (uint64_t)arg->getNumRows();
+        h.nbcols = (uint64_t)arg->getNumCols();
+        std::copy(reinterpret_cast<const char *>(&h), reinterpret_cast<const char *>(&h) + sizeof(h),
+                  buffer + bufferIdx);
+        bufferIdx += sizeof(h);
+
+        std::copy(reinterpret_cast<const char *>(&len), reinterpret_cast<const char *>(&len) + sizeof(len),
+                  buffer + bufferIdx);
+        bufferIdx += sizeof(len);
+
+        const ValueTypeCode *schema = arg->getSchema();
+        std::copy(reinterpret_cast<const char *>(schema),
+                  reinterpret_cast<const char *>(schema) + arg->getNumCols() * sizeof(ValueTypeCode),
+                  buffer + bufferIdx);
+        bufferIdx += arg->getNumCols() * sizeof(ValueTypeCode);
+
+        const std::string *labels = arg->getLabels();
+        for (size_t c = 0; c < arg->getNumCols(); c++) {
+            const uint16_t labelLen = static_cast<uint16_t>(labels[c].size());
+            std::copy(reinterpret_cast<const char *>(&labelLen),
+                      reinterpret_cast<const char *>(&labelLen) + sizeof(labelLen), buffer + bufferIdx);
+            bufferIdx += sizeof(labelLen);
+            std::copy(labels[c].begin(), labels[c].end(), buffer + bufferIdx);
+            bufferIdx += labelLen;
+        }
+        return bufferIdx;
+    }
+
+    /**
+     * @brief Serializes a Frame to a buffer.
+     *
+     * Serialization can be done partially by specifying a byte-index as a
+     * starting point (related to length(arg)).
+     *
+     * @param arg The Frame to serialize.
+     * @param buf The buffer to write data.
+     * @param chunkSize The size of the buffer (0 for the whole Frame). The
+     * first chunk must hold the whole header (see headerSize()).
+     * @param serializeFromByte (Optional) The byte index of the object, at
+     * which serialization should begin.
+     * @return size_t The number of bytes written to the buffer.
+     */
+    static size_t serialize(const Frame *arg, char *buf, size_t chunkSize = 0, size_t serializeFromByte = 0) {
+        Layout layout;
+        return serialize(arg, layout, buf, chunkSize, serializeFromByte);
+    }
+    // Same as above, but reuses the layout of the Frame from previous chunks.
+    static size_t serialize(const Frame *arg, Layout &layout, char *buf, size_t chunkSize, size_t serializeFromByte) {
+        extendLayout(arg, layout, arg->getNumCols());
+        const size_t len = layout.colBegin.back();
+        if (chunkSize == 0)
+            chunkSize = len;
+        if (serializeFromByte == 0 && chunkSize < layout.colBegin[0])
+            throw std::runtime_error("Minimum starting chunk size " + std::to_string(layout.colBegin[0]) + " bytes");
+
+        const size_t winBegin = serializeFromByte;
+        const size_t winEnd = std::min(len, serializeFromByte + chunkSize);
+        const size_t numRows = arg->getNumRows();
+
+        if (serializeFromByte == 0)
+            serializeHeader(arg, buf, len);
+        for (size_t c = 0; c < arg->getNumCols() && layout.colBegin[c] < winEnd; c++) {
+            if (layout.colBegin[c + 1] <= winBegin)
+                continue;
+            const size_t pos = layout.colBegin[c];
+            if (arg->getColumnType(c) == ValueTypeCode::STR) {
+                const std::string *col = static_cast<const std::string *>(arg->getColumnRaw(c));
+                for (size_t r = firstWord(pos, winBegin); r < numRows && pos + r * sizeof(uint64_t) < winEnd; r++) {
+                    const uint64_t strLen = col[r].size();
+                    toWindow(reinterpret_cast<const char *>(&strLen), sizeof(strLen), pos + r * sizeof(uint64_t), buf,
+                             winBegin, winEnd);
+                }
+                const std::vector<size_t> &strBegin = layout.strBegin[c];
+                for (size_t r = firstString(strBegin, winBegin); r < numRows && strBegin[r] < winEnd; r++)
+                    toWindow(col[r].data(), col[r].size(), strBegin[r], buf, winBegin, winEnd);
+            } else {
+                const size_t colLen = layout.colBegin[c + 1] - pos;
+                toWindow(static_cast<const char *>(arg->getColumnRaw(c)), colLen, pos, buf, winBegin, winEnd);
+            }
+        }
+        return winEnd - winBegin;
+    }
+    // Serializes into the vector<char> buffer. If its size is less than
+    // chunksize, it is resized.
     static size_t serialize(const Frame *arg, std::vector<char> &buf, size_t chunkSize = 0,
                             size_t serializeFromByte = 0) {
+        chunkSize = chunkSize == 0 ? length(arg) : chunkSize;
+        if (buf.size() < chunkSize)
+            buf.resize(chunkSize);
         return serialize(arg, buf.data(), chunkSize, serializeFromByte);
     }
 
-    static Frame *deserialize(const char *buf) { throw std::runtime_error("not implemented"); };
+    /**
+     * @brief Deserializes the header of a buffer containing information about a
+     * Frame.
+     *
+     * @param buf The buffer which contains the header.
+     * @param frame The Frame to initialize with the header information.
+     * @return Frame* The result frame.
+     */
+    static Frame *deserializeHeader(const char *buf, Frame *frame = nullptr) {
+        if (DF_Dtype(buf) != DF_data_t::Frame_t)
+            throw std::runtime_error("Frame deserialize(): DT mismatch");
+        if (frame != nullptr)
+            return frame;
+
+        DF_header h;
+        std::copy(buf, buf + sizeof(h), reinterpret_cast<char *>(&h));
+        size_t bufIdx = HEADER_BUFFER_SIZE;
+
+        const size_t numCols = h.nbcols;
+        auto schema = std::make_unique<ValueTypeCode[]>(numCols);
+        std::copy(buf + bufIdx, buf + bufIdx + numCols * sizeof(ValueTypeCode),
+                  reinterpret_cast<char *>(schema.get()));
+        bufIdx += numCols * sizeof(ValueTypeCode);
+
+        auto labels = std::make_unique<std::string[]>(numCols);
+        for (size_t c = 0; c < numCols; c++) {
+            uint16_t labelLen;
+            std::copy(buf + bufIdx, buf + bufIdx + sizeof(labelLen), reinterpret_cast<char *>(&labelLen));
+            bufIdx += sizeof(labelLen);
+            labels[c].assign(buf + bufIdx, labelLen);
+            bufIdx += labelLen;
+        }
+        return DataObjectFactory::create<Frame>(h.nbrows, numCols, schema.get(), labels.get(), false);
+    }
+
+    /**
+     * @brief Deserializes a Frame from a buffer.
+     *
+     * Deserialization can be done partially by specifing an byte-index as a
+     * starting point in the Frame. The chunks of a Frame with string columns
+     * must be deserialized in order, since the lengths of the strings
+     * determine the positions of their characters.
+     *
+     * @param buf The buffer containing the serialized data.
+     * @param chunkSize The size of the buffer. The first chunk must hold the
+     * whole header.
+     * @param frame The result frame to write data.
+     * @param deserializeFromByte (Optional) The index of the @frame that
+     * deserialization should begin writing data.
+     * @return Frame* The result frame.
+     */
+    static Frame *deserialize(const char *buf, size_t chunkSize, Frame *frame = nullptr,
+                              size_t deserializeFromByte = 0) {
+        Layout layout;
+        return deserialize(buf, chunkSize, frame, deserializeFromByte, layout);
+    }
+    // Same as above, but reuses the layout of the Frame from previous chunks.
+    static Frame *deserialize(const char *buf, size_t chunkSize, Frame *frame, size_t deserializeFromByte,
+                              Layout &layout) {
+        if (deserializeFromByte == 0) {
+            if (chunkSize < HEADER_BUFFER_SIZE)
+                throw std::runtime_error("Minimum starting chunk size " + std::to_string(HEADER_BUFFER_SIZE) +
+                                         " bytes");
+            frame = deserializeHeader(buf, frame);
+            if (chunkSize < headerSize(frame))
+                throw std::runtime_error("Minimum starting chunk size " + std::to_string(headerSize(frame)) +
+                                         " bytes");
+        }
+
+        const size_t winBegin = deserializeFromByte;
+        const size_t winEnd = deserializeFromByte + chunkSize;
+        const size_t numRows = frame->getNumRows();
+
+        for (size_t c = 0; c < frame->getNumCols(); c++) {
+            // All columns before c are complete, so their layout is known.
+            extendLayout(frame, layout, c);
+            const size_t pos = layout.colBegin[c];
+            if (pos >= winEnd)
+                break;
+            if (frame->getColumnType(c) == ValueTypeCode::STR) {
+                std::string *col = static_cast<std::string *>(frame->getColumnRaw(c));
+                // Until its length is complete, each string holds the bytes
+                // of its length received so far.
+                for (size_t r = firstWord(pos, winBegin); r < numRows && pos + r * sizeof(uint64_t) < winEnd; r++) {
+                    const size_t wordBegin = pos + r * sizeof(uint64_t);
+                    if (col[r].size() != sizeof(uint64_t))
+                        col[r].assign(sizeof(uint64_t), '\0');
+                    fromWindow(buf, winBegin, winEnd, col[r].data(), sizeof(uint64_t), wordBegin);
+                    if (wordBegin + sizeof(uint64_t) <= winEnd) {
+                        uint64_t strLen;
+                        std::copy(col[r].begin(), col[r].end(), reinterpret_cast<char *>(&strLen));
+                        col[r].assign(strLen, '\0');
+                    }
+                }
+                // The characters follow the lengths, so they start in a later
+                // chunk if the lengths are not complete yet.
+                if (pos + numRows * sizeof(uint64_t) >= winEnd)
+                    break;
+                extendLayout(frame, layout, c + 1);
+                const std::vector<size_t> &strBegin = layout.strBegin[c];
+                for (size_t r = firstString(strBegin, winBegin); r < numRows && strBegin[r] < winEnd; r++)
+                    fromWindow(buf, winBegin, winEnd, col[r].data(), col[r].size(), strBegin[r]);
+            } else {
+                const size_t colLen = numRows * ValueTypeUtils::sizeOf(frame->getColumnType(c));
+                fromWindow(buf, winBegin, winEnd, static_cast<char *>(frame->getColumnRaw(c)), colLen, pos);
+            }
+        }
+        return frame;
+    }
+    static Frame *deserialize(const std::vector<char> &buffer, Frame *frame = nullptr,
+                              size_t deserializeFromByte = 0) {
+        return deserialize(buffer.data(), buffer.size(), frame, deserializeFromByte);
+    }
+
+  private:
+    // The index of the first 8-byte word of a segment starting at segBegin
+    // that intersects a window starting at winBegin.
+    static size_t firstWord(size_t segBegin, size_t winBegin) {
+        return winBegin > segBegin ? (winBegin - segBegin) / sizeof(uint64_t) : 0;
+    }
+    // The index of the first string of a column that intersects a window
+    // starting at winBegin, given the positions of its strings.
+    static size_t firstString(const std::vector<size_t> &strBegin, size_t winBegin) {
+        const auto it = std::upper_bound(strBegin.begin(), strBegin.end() - 1, winBegin);
+        return it == strBegin.begin() ? 0 : it - strBegin.begin() - 1;
+    }
+    // Copies the part of the segment [segBegin, segBegin + len) of the
+    // serialized object that falls into the window [winBegin, winEnd) held by
+    // the buffer.
+    static void toWindow(const char *src, size_t len, size_t segBegin, char *buf, size_t winBegin, size_t winEnd) {
+        const size_t lo = std::max(segBegin, winBegin);
+        const size_t hi = std::min(segBegin + len, winEnd);
+        if (lo < hi)
+            std::copy(src + (lo - segBegin), src + (hi - segBegin), buf + (lo - winBegin));
+    }
+    // The inverse of toWindow().
+    static void fromWindow(const char *buf, size_t winBegin, size_t winEnd, char *dst, size_t len, size_t segBegin) {
+        const size_t lo = std::max(segBegin, winBegin);
+        const size_t hi = std::min(segBegin + len, winEnd);
+        if (lo < hi)
+            std::copy(buf + (lo - winBegin), buf + (hi - winBegin), dst + (lo - segBegin));
+    }
 };
 
+// ----------------------------------------------------------------------------
+// const Frame
+// ----------------------------------------------------------------------------
+
+template <> struct DaphneSerializer<const Frame> : public DaphneSerializer<Frame> {};
+
 // ----------------------------------------------------------------------------
 // Structure
 // ----------------------------------------------------------------------------
@@ -957,9 +1327,9 @@ template <> struct DaphneSerializer<Structure> {
     // specific type of the object (Dense, CSR, etc.), the minimum chunk size
     // should be the maximum possible header size in bytes (so the header won't
     // be partially serialized).
-    // TODO Other types?
-    static const size_t HEADER_BUFFER_SIZE = std::min(DaphneSerializer<DenseMatrix<double>>::HEADER_BUFFER_SIZE,
-                                                      DaphneSerializer<CSRMatrix<double>>::HEADER_BUFFER_SIZE);
+    static const size_t HEADER_BUFFER_SIZE = std::min({DaphneSerializer<DenseMatrix<double>>::HEADER_BUFFER_SIZE,
+                                                       DaphneSerializer<CSRMatrix<double>>::HEADER_BUFFER_SIZE,
+                                                       DaphneSerializer<Frame>::HEADER_BUFFER_SIZE});
 
     const Structure *obj;
     Structure **objPtr;
@@ -1016,6 +1386,9 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::headerSize(mat);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::headerSize(mat);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame *>(arg))
+            return DaphneSerializer<Frame>::headerSize(frame);
         // else
         throw std::runtime_error("Serialization headerSize: uknown value type");
     };
@@ -1060,6 +1433,9 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::length(mat);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::length(mat);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame *>(arg))
+            return DaphneSerializer<Frame>::length(frame);
         // else
         throw std::runtime_error("Serialization length: uknown value type");
     };
@@ -1101,6 +1477,9 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::serializeHeader(mat, buffer);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::serializeHeader(mat, buffer);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame *>(arg))
+            return DaphneSerializer<Frame>::serializeHeader(frame, buffer);
         // else
         throw std::runtime_error("Serialization serializeHeader: uknown value type");
     };
@@ -1151,6 +1530,9 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame *>(arg))
+            return DaphneSerializer<Frame>::serialize(frame, buf, chunkSize, serializeFromByte);
         // else
         throw std::runtime_error("Serialization serialize: uknown value type");
     };
@@ -1236,6 +1618,8 @@ template <> struct DaphneSerializer<Structure> {
             default:
                 throw std::runtime_error("unknown value type code");
             }
+        } else if (DF_Dtype(buffer) == DF_data_t::Frame_t) {
+            return DaphneSerializer<Frame>::deserializeHeader(buffer);
         } else {
             throw std::runtime_error("unknown value type code");
         }
@@ -1277,6 +1661,9 @@ template <> struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
         if (auto mat = dynamic_cast<CSRMatrix<uint64_t> *>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        /* Frame */
+        if (auto frame = dynamic_cast<Frame *>(arg))
+            return DaphneSerializer<Frame>::deserialize(buffer, chunkSize, frame, deserializeFromByte);
         // else
         throw std::runtime_error("Serialization serialize: uknown value type");
     };
@@ -1423,11 +1810,26 @@ inline Structure *DF_deserialize(const char *buf, size_t bufferSize) {
         default:
             throw std::runtime_error("unknown value type code");
         }
+    } else if (DF_Dtype(buf) == DF_data_t::Frame_t) {
+        return DaphneSerializer<Frame>::deserialize(buf, bufferSize);
     } else {
         throw std::runtime_error("unknown value type code");
     }
 }
 
+/**
+ * @brief Returns the byte length of a serialized object, given the buffer
+ * holding (at least) its header and the object deserialized from it.
+ *
+ * The length of a Frame is read from its header, since it depends on the
+ * strings that are not yet deserialized.
+ */
+template <class DT> size_t DF_length(const char *buf, const DT *obj) {
+    if (DF_Dtype(buf) == DF_data_t::Frame_t)
+        return DaphneSerializer<Frame>::serializedLength(buf);
+    return DaphneSerializer<DT>::length(obj);
+}
+
 /**
  * @brief Deserializes a vector<char> buffer to a Daphne object.
  * @param buf the vector<char> buffer.
@@ -1436,6 +1838,75 @@ inline Structure *DF_deserialize(const char *buf, size_t bufferSize) {
  */
 inline Structure *DF_deserialize(const std::vector<char> &buf) { return DF_deserialize(buf.data(), buf.size()); }
 
+/**
+ * @brief The state the chunked (de)serializers keep for one object across its
+ * chunks.
+ *
+ * Only Frames need such state (see DaphneSerializer<Frame>::Layout). For all
+ * other data types, the chunks are (de)serialized by DaphneSerializer alone.
+ */
+template <class DT> struct DaphneChunkState {
+    size_t length(const DT *obj) { return DaphneSerializer<DT>::length(obj); }
+    size_t serializeHeader(const DT *obj, char *buf) { return DaphneSerializer<DT>::serializeHeader(obj, buf); }
+    size_t serialize(const DT *obj, char *buf, size_t chunkSize, size_t serializeFromByte) {
+        return DaphneSerializer<DT>::serialize(obj, buf, chunkSize, serializeFromByte);
+    }
+    DT *deserialize(const char *buf, size_t chunkSize, DT *obj, size_t deserializeFromByte) {
+        return DaphneSerializer<DT>::deserialize(buf, chunkSize, obj, deserializeFromByte);
+    }
+};
+
+template <> struct DaphneChunkState<Frame> {
+    // Either the layout of the Frame being serialized or the part of the
+    // layout of the Frame being deserialized that is known so far.
+    DaphneSerializer<Frame>::Layout layout;
+
+    // Only valid for serialization, the length of a Frame being deserialized
+    // is known from its header only (see DF_length()).
+    size_t length(const Frame *obj) {
+        DaphneSerializer<Frame>::extendLayout(obj, layout, obj->getNumCols());
+        return layout.colBegin.back();
+    }
+    size_t serializeHeader(const Frame *obj, char *buf) {
+        return DaphneSerializer<Frame>::serializeHeader(obj, buf, length(obj));
+    }
+    size_t serialize(const Frame *obj, char *buf, size_t chunkSize, size_t serializeFromByte) {
+        return DaphneSerializer<Frame>::serialize(obj, layout, buf, chunkSize, serializeFromByte);
+    }
+    Frame *deserialize(const char *buf, size_t chunkSize, Frame *obj, size_t deserializeFromByte) {
+        return DaphneSerializer<Frame>::deserialize(buf, chunkSize, obj, deserializeFromByte, layout);
+    }
+};
+
+template <> struct DaphneChunkState<const Frame> : public DaphneChunkState<Frame> {};
+
+template <> struct DaphneChunkState<Structure> {
+    DaphneChunkState<Frame> frameState;
+
+    size_t length(const Structure *obj) {
+        if (auto frame = dynamic_cast<const Frame *>(obj))
+            return frameState.length(frame);
+        return DaphneSerializer<Structure>::length(obj);
+    }
+    size_t serializeHeader(const Structure *obj, char *buf) {
+        if (auto frame = dynamic_cast<const Frame *>(obj))
+            return frameState.serializeHeader(frame, buf);
+        return DaphneSerializer<Structure>::serializeHeader(obj, buf);
+    }
+    size_t serialize(const Structure *obj, char *buf, size_t chunkSize, size_t serializeFromByte) {
+        if (auto frame = dynamic_cast<const Frame *>(obj))
+            return frameState.serialize(frame, buf, chunkSize, serializeFromByte);
+        return DaphneSerializer<Structure>::serialize(obj, buf, chunkSize, serializeFromByte);
+    }
+    Structure *deserialize(const char *buf, size_t chunkSize, Structure *obj, size_t deserializeFromByte) {
+        if (auto frame = dynamic_cast<Frame *>(obj))
+            return frameState.deserialize(buf, chunkSize, frame, deserializeFromByte);
+        return DaphneSerializer<Structure>::deserialize(buf, chunkSize, obj, deserializeFromByte);
+    }
+};
+
+template <> struct DaphneChunkState<const Structure> : public DaphneChunkState<Structure> {};
+
 /**
  * @brief Serialization out of order.
  *
@@ -1451,6 +1922,7 @@ inline Structure *DF_deserialize(const std::vector<char> &buf) { return DF_deser
 template <class DT> struct DaphneSerializerOutOfOrderChunks {
   private:
     std::mutex lock;
+    DaphneChunkState<DT> state;
 
   public:
     /**
@@ -1460,6 +1932,8 @@ template <class DT> struct DaphneSerializerOutOfOrderChunks {
     DT *obj;
     size_t chunkSize;
     size_t startOffset = 0;
+    // The byte length of the serialized object.
+    size_t length;
 
     /**
      * @brief Construct a new Daphne Serializer Out Of Order Chunks object
@@ -1469,8 +1943,8 @@ template <class DT> struct DaphneSerializerOutOfOrderChunks {
      * chunk (default DEFAULT_SERIALIZATION_BUFFER_SIZE)
      */
     DaphneSerializerOutOfOrderChunks(DT *obj, size_t chunkSize_ = DEFAULT_SERIALIZATION_BUFFER_SIZE)
-        : obj(obj), chunkSize(chunkSize_), startOffset(0) {
-        chunkSize = chunkSize_ == 0 ? DaphneSerializer<DT>::length(obj) : chunkSize_;
+        : obj(obj), chunkSize(chunkSize_), startOffset(0), length(state.length(obj)) {
+        chunkSize = chunkSize_ == 0 ? length : chunkSize_;
     };
 
   public:
@@ -1491,15 +1965,14 @@ template <class DT> struct DaphneSerializerOutOfOrderChunks {
 
         // Serialize header (needed for all chunks, we don't know which arrives
         // first)
-        auto bufferIdx = DaphneSerializer<DT>::serializeHeader(obj, buffer.data());
+        auto bufferIdx = state.serializeHeader(obj, buffer.data());
 
         // Serialize startOffset index
         std::memcpy(buffer.data() + bufferIdx, reinterpret_cast<char *>(&startOffset), sizeof(startOffset));
         bufferIdx += sizeof(startOffset);
 
         // TODO use locks for parallel serialization
-        size_t len =
-            DaphneSerializer<DT>::serialize(obj, buffer.data() + bufferIdx, chunkSize - bufferIdx, startOffset);
+        size_t len = state.serialize(obj, buffer.data() + bufferIdx, chunkSize - bufferIdx, startOffset);
         bufferIdx += len;
         startOffset += len;
 
@@ -1512,7 +1985,7 @@ template <class DT> struct DaphneSerializerOutOfOrderChunks {
      * @return true
      * @return false
      */
-    bool HasNextChunk() { return startOffset != DaphneSerializer<DT>::length(obj); }
+    bool HasNextChunk() { return startOffset != length; }
 };
 
 /**
@@ -1527,10 +2000,14 @@ template <class DT> struct DaphneSerializerOutOfOrderChunks {
 template <class DT> struct DaphneDeserializerOutOfOrderChunks {
   private:
     std::mutex lock;
+    DaphneChunkState<DT> state;
 
   public:
     DT *obj;
     size_t bytesDeserialized;
+    // The byte length of the serialized object, known once the first chunk
+    // was received (0 before).
+    size_t totalLength = 0;
 
     /**
      * @brief Construct a new Daphne Deserializer Out Of Order Chunks object
@@ -1550,8 +2027,10 @@ template <class DT> struct DaphneDeserializerOutOfOrderChunks {
         size_t startOffset;
         size_t bufferIdx = 0;
 
-        if (obj == nullptr)
+        if (obj == nullptr) {
             obj = DaphneSerializer<DT>::deserializeHeader(buffer.data(), obj);
+            totalLength = DF_length(buffer.data(), obj);
+        }
         bufferIdx += DaphneSerializer<DT>::headerSize(obj);
 
         std::memcpy(reinterpret_cast<char *>(&startOffset), buffer.data() + bufferIdx, sizeof(size_t));
@@ -1559,7 +2038,7 @@ template <class DT> struct DaphneDeserializerOutOfOrderChunks {
 
         // TODO use locks for parallel deserialization
         size_t deserializeLength = chunkSize - bufferIdx;
-        obj = DaphneSerializer<DT>::deserialize(buffer.data() + bufferIdx, deserializeLength, obj, startOffset);
+        obj = state.deserialize(buffer.data() + bufferIdx, deserializeLength, obj, startOffset);
         bytesDeserialized += deserializeLength;
 
         return obj;
@@ -1574,7 +2053,7 @@ template <class DT> struct DaphneDeserializerOutOfOrderChunks {
         if (obj == nullptr)
             return true;
         else
-            return bytesDeserialized < DaphneSerializer<DT>::length(obj);
+            return bytesDeserialized < totalLength;
     }
 };
 
@@ -1597,6 +2076,8 @@ template <class DT> struct DaphneSerializerChunks {
 
     DT *obj;
     size_t chunkSize;
+    // The byte length of the serialized object.
+    size_t length;
     /**
      * @brief Construct a new Daphne Serializer Chunks object
      *
@@ -1607,7 +2088,7 @@ template <class DT> struct DaphneSerializerChunks {
      * the header won't be partially serialized).
      */
     DaphneSerializerChunks(DT *obj, size_t chunkSize_ = DEFAULT_SERIALIZATION_BUFFER_SIZE)
-        : obj(obj), chunkSize(chunkSize_) {
+        : obj(obj), chunkSize(chunkSize_), length(DaphneSerializer<DT>::length(obj)) {
         // Since at least one chunk will contain the header, the minimum chunk
         // size should be HEADER_BUFFER_SIZE bytes (so the header won't be
         // partially serialized).
@@ -1615,8 +2096,7 @@ template <class DT> struct DaphneSerializerChunks {
             throw std::runtime_error("Minimum chunk size " + std::to_string(HEADER_BUFFER_SIZE) +
                                      " bytes"); // For now..?
         // Get minimum possible chunk size
-        this->chunkSize =
-            chunkSize_ > DaphneSerializer<DT>::length(obj) ? DaphneSerializer<DT>::length(obj) : chunkSize_;
+        this->chunkSize = chunkSize_ > length ? length : chunkSize_;
     };
     /**
      * @brief An iterator used to serialize the object
@@ -1634,6 +2114,8 @@ template <class DT> struct DaphneSerializerChunks {
         const DT *obj;
         size_t chunkSize;
         value_type serializedData;
+        // Shared by the copies of the iterator.
+        std::shared_ptr<DaphneChunkState<DT>> state;
 
       public:
         size_t numberOfBytesSerialized = 0;
@@ -1649,9 +2131,10 @@ template <class DT> struct DaphneSerializerChunks {
             // assign buffer
             serializedData.second = std::make_shared<std::vector<char>>();
             serializedData.second->resize(chunkSize);
+            state = std::make_shared<DaphneChunkState<DT>>();
 
             serializedData.first =
-                DaphneSerializer<DT>::serialize(obj, serializedData.second->data(), chunkSize, numberOfBytesSerialized);
+                state->serialize(obj, serializedData.second->data(), chunkSize, numberOfBytesSerialized);
             numberOfBytesSerialized += serializedData.first;
         };
 
@@ -1662,7 +2145,7 @@ template <class DT> struct DaphneSerializerChunks {
         Iterator operator++() {
             index++;
             serializedData.first =
-                DaphneSerializer<DT>::serialize(obj, serializedData.second->data(), chunkSize, numberOfBytesSerialized);
+                state->serialize(obj, serializedData.second->data(), chunkSize, numberOfBytesSerialized);
             numberOfBytesSerialized += serializedData.first;
             return *this;
         };
@@ -1693,7 +2176,7 @@ template <class DT> struct DaphneSerializerChunks {
      */
     Iterator end() {
         Iterator iter;
-        iter.index = std::ceil(DaphneSerializer<DT>::length(obj) / (double)chunkSize);
+        iter.index = std::ceil(length / (double)chunkSize);
         return iter;
     }
 };
@@ -1712,6 +2195,9 @@ template <class DT> struct DaphneDeserializerChunks {
 
     DT **objPtr;
     size_t chunkSize;
+    // The byte length of the serialized object, known once the header was
+    // received (0 before).
+    size_t totalLength = 0;
     /**
      * @brief Construct a new Daphne Deserializer Chunks object
      *
@@ -1735,7 +2221,10 @@ template <class DT> struct DaphneDeserializerChunks {
 
       private:
         size_t chunkSize;
+        size_t *totalLength;
         value_type serializedData;
+        // Shared by the copies of the iterator.
+        std::shared_ptr<DaphneChunkState<DT>> state;
 
       public:
         size_t numberOfBytesDeserialized = 0;
@@ -1743,14 +2232,15 @@ template <class DT> struct DaphneDeserializerChunks {
 
         // Constructors
         Iterator(){};
-        Iterator(DT **obj, size_t chunkSize)
-            : objPtr(obj), chunkSize(chunkSize), numberOfBytesDeserialized(0), index(0) {
+        Iterator(DT **obj, size_t chunkSize, size_t *totalLength)
+            : objPtr(obj), chunkSize(chunkSize), totalLength(totalLength), numberOfBytesDeserialized(0), index(0) {
             if (chunkSize < HEADER_BUFFER_SIZE)
                 throw std::runtime_error("Minimum chunk size " + std::to_string(HEADER_BUFFER_SIZE) +
                                          " bytes"); // For now..?
             // assign buffer
             serializedData.second = std::make_shared<std::vector<char>>();
             serializedData.second->resize(chunkSize);
+            state = std::make_shared<DaphneChunkState<DT>>();
         };
 
         reference operator*() { return serializedData; }
@@ -1760,10 +2250,11 @@ template <class DT> struct DaphneDeserializerChunks {
         Iterator operator++() {
             if (index == 0 || objPtr == nullptr) {
                 *objPtr = DaphneSerializer<DT>::deserializeHeader(serializedData.second->data(), *objPtr);
+                *totalLength = DF_length(serializedData.second->data(), *objPtr);
             }
             index++;
-            *objPtr = DaphneSerializer<DT>::deserialize(serializedData.second->data(), serializedData.first, *objPtr,
-                                                        numberOfBytesDeserialized);
+            *objPtr =
+                state->deserialize(serializedData.second->data(), serializedData.first, *objPtr, numberOfBytesDeserialized);
             numberOfBytesDeserialized += serializedData.first;
             return *this;
         }
@@ -1777,7 +2268,7 @@ template <class DT> struct DaphneDeserializerChunks {
         friend bool operator==(const Iterator &a, const Iterator &b) { return a.index == b.index; };
         friend bool operator!=(const Iterator &a, const Iterator &b) { return a.index != b.index; };
     };
-    Iterator begin() { return Iterator(objPtr, chunkSize); }
+    Iterator begin() { return Iterator(objPtr, chunkSize, &totalLength); }
     // Iterator end
     Iterator end() {
         Iterator iter;
@@ -1786,7 +2277,9 @@ template <class DT> struct DaphneDeserializerChunks {
         // uninitialized. If object is uninitialized we simply set
         // Iterator::end() as 1, otherwise we calculate it based on object
         // information.
-        if (*objPtr != nullptr)
+        if (totalLength != 0)
+            iter.index = std::ceil(totalLength / (double)chunkSize);
+        else if (*objPtr != nullptr)
             iter.index = std::ceil(DaphneSerializer<DT>::length(*objPtr) / (double)chunkSize);
         else
             iter.index = 1;
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+
+#include <future>
+#include <utility>
+
+/**
+ * @brief Type-independent base class of all futures, such that pending
+ * futures can be owned in a common container.
+ */
+class IFuture {
+  public:
+    virtual ~IFuture() = default;
+};
+
+/**
+ * @brief The pending result of an asynchronous operation producing a data
+ * object, e.g., an asynchronous read.
+ *
+ * Corresponds to the `Future` type in DaphneIR. The data object is obtained
+ * once by `get()`, which blocks until it is available and rethrows any
+ * exception the operation failed with. If the data object is never obtained,
+ * it is destroyed together with the future.
+ */
+template <class DT> class Future : public IFuture {
+    std::future<DT *> result;
+
+  public:
+    explicit Future(std::future<DT *> result) : result(std::move(result)) {}
+
+    ~Future() override {
+        if (!result.valid())
+            return;
+        try {
+            if (DT *obj = result.get())
+                DataObjectFactory::destroy(obj);
+        } catch (...) {
+            // Nobody is interested in the error of an operation whose result
+            // is not used.
+        }
+    }
+
+    DT *get() { return result.get(); }
+};
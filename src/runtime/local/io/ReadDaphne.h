@@ -116,7 +116,8 @@ template <> struct ReadDaphne<Frame> {
             for (uint64_t c = 0; c < h.nbcols; c++) {
                 uint16_t len;
                 f.read((char *)&len, sizeof(len));
-                f.read((char *)&(labels[c]), len);
+                labels[c].resize(len);
+                f.read(labels[c].data(), len);
             }
 
             DF_body b;
@@ -127,7 +128,7 @@ template <> struct ReadDaphne<Frame> {
             // TODO: Consider alternative representations for frames
 
             if (res == nullptr) {
-                res = DataObjectFactory::create<Frame>(h.nbrows, h.nbcols, schema, nullptr, false);
+                res = DataObjectFactory::create<Frame>(h.nbrows, h.nbcols, schema, labels, false);
             }
 
             uint8_t **rawCols = new uint8_t *[h.nbcols];
@@ -186,6 +187,7 @@ template <> struct ReadDaphne<Frame> {
 
             delete[] rawCols;
             delete[] schema;
+            delete[] labels;
         }
         f.close();
         return;
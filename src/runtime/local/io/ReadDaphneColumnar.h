@@ -0,0 +1,267 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/io/DaphneColumnarFile.h>
+#include <runtime/local/kernels/ParallelFor.h>
+#include <util/DeduceType.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @brief A range predicate on a numeric column: only row groups whose chunk of
+ * the column may contain a value in `[lo, hi]` are read.
+ *
+ * Note that the predicate is evaluated on the chunk statistics only, so the
+ * rows read can still contain values outside the range.
+ */
+struct ColumnarPredicate {
+    size_t colIdx;
+    double lo;
+    double hi;
+};
+
+/**
+ * @brief Options for reading the columnar DAPHNE binary format.
+ */
+struct DaphneColumnarReadOptions {
+    // The columns to read in this order, all columns if empty.
+    std::vector<size_t> colIdxs;
+    // Row groups for which any predicate fails are skipped.
+    std::vector<ColumnarPredicate> predicates;
+    // The range of rows to read, e.g., the partition of one distributed worker.
+    size_t startRow = 0;
+    size_t numRows = std::numeric_limits<size_t>::max();
+};
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+/**
+ * @brief Reads a data object in the columnar DAPHNE binary format (see
+ * `DaphneColumnarFile.h`).
+ *
+ * Only the chunks of the requested columns in the requested row range and in
+ * row groups not ruled out by the predicates are read; they are fetched and
+ * decoded in parallel.
+ */
+template <class DTRes> struct ReadDaphneColumnar {
+    static void apply(DTRes *&res, const char *filename, const DaphneColumnarReadOptions &opts, DCTX(ctx)) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTRes>
+void readDaphneColumnar(DTRes *&res, const char *filename, const DaphneColumnarReadOptions &opts, DCTX(ctx)) {
+    ReadDaphneColumnar<DTRes>::apply(res, filename, opts, ctx);
+}
+
+// ****************************************************************************
+// Functions called by multiple template specializations
+// ****************************************************************************
+
+/**
+ * @brief An open columnar file and the plan of which rows to read.
+ */
+class ColumnarReadPlan {
+    int fd;
+    std::string filename;
+
+  public:
+    DaphneColumnarFooter footer;
+    // The columns of the file to read.
+    std::vector<size_t> colIdxs;
+    // The row groups to read, along with the rows `[begin, end)` within each
+    // row group and their first row in the result.
+    struct Part {
+        size_t rowGroup;
+        size_t begin;
+        size_t end;
+        size_t resRow;
+    };
+    std::vector<Part> parts;
+    size_t numResRows = 0;
+
+    ColumnarReadPlan(const char *filename, const DaphneColumnarReadOptions &opts) : filename(filename) {
+        fd = open(filename, O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("ReadDaphneColumnar: could not open file " + this->filename);
+        try {
+            init(opts);
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+    }
+
+    ColumnarReadPlan(const ColumnarReadPlan &) = delete;
+    ColumnarReadPlan &operator=(const ColumnarReadPlan &) = delete;
+
+    ~ColumnarReadPlan() { close(fd); }
+
+  private:
+    void init(const DaphneColumnarReadOptions &opts) {
+        footer = DaphneColumnar::readFooter(fd, filename);
+        colIdxs = opts.colIdxs;
+        if (colIdxs.empty())
+            for (size_t c = 0; c < footer.numCols; c++)
+                colIdxs.push_back(c);
+        for (size_t c : colIdxs)
+            if (c >= footer.numCols)
+                throw std::out_of_range("ReadDaphneColumnar: column index out of bounds");
+        for (const ColumnarPredicate &p : opts.predicates)
+            if (p.colIdx >= footer.numCols || footer.schema[p.colIdx] == ValueTypeCode::STR)
+                throw std::runtime_error("ReadDaphneColumnar: predicates require a numeric column");
+
+        const size_t startRow = std::min<size_t>(opts.startRow, footer.numRows);
+        const size_t endRow = startRow + std::min<size_t>(opts.numRows, footer.numRows - startRow);
+        for (size_t rg = 0; rg < footer.getNumRowGroups(); rg++) {
+            const size_t rgBegin = footer.rowGroupStarts[rg];
+            const size_t rgEnd = footer.rowGroupStarts[rg + 1];
+            if (rgEnd <= startRow || rgBegin >= endRow || !mayMatch(rg, opts.predicates))
+                continue;
+            const size_t begin = std::max(rgBegin, startRow) - rgBegin;
+            const size_t end = std::min(rgEnd, endRow) - rgBegin;
+            parts.push_back({rg, begin, end, numResRows});
+            numResRows += end - begin;
+        }
+    }
+
+  public:
+    bool mayMatch(size_t rowGroup, const std::vector<ColumnarPredicate> &predicates) const {
+        for (const ColumnarPredicate &p : predicates) {
+            const DCF_chunk &chunk = footer.getChunk(rowGroup, p.colIdx);
+            const ValueTypeCode vtc = footer.schema[p.colIdx];
+            if (!chunk.hasMinMax || DaphneColumnar::statValue(chunk.max, vtc) < p.lo ||
+                DaphneColumnar::statValue(chunk.min, vtc) > p.hi)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Fetches all planned chunks in parallel and calls
+     * `decode(resCol, part, data, chunk)` for each of them.
+     */
+    template <class DecodeFunc> void execute(DecodeFunc decode, DCTX(ctx)) const {
+        const size_t numTasks = parts.size() * colIdxs.size();
+        const size_t numThreads = getNumKernelThreads(numTasks, numResRows * colIdxs.size(), ctx);
+        DaphneColumnar::parallelForChunks(numTasks, numThreads, [&](size_t i) {
+            thread_local std::vector<char> data;
+            const Part &part = parts[i / colIdxs.size()];
+            const size_t resCol = i % colIdxs.size();
+            const DCF_chunk &chunk = footer.getChunk(part.rowGroup, colIdxs[resCol]);
+            data.resize(chunk.length);
+            if (pread(fd, data.data(), chunk.length, static_cast<off_t>(chunk.offset)) !=
+                static_cast<ssize_t>(chunk.length))
+                throw std::runtime_error("ReadDaphneColumnar: could not read file " + filename);
+            decode(resCol, part, data.data(), chunk);
+        });
+    }
+
+    size_t getRowGroupSize(size_t rowGroup) const {
+        return footer.rowGroupStarts[rowGroup + 1] - footer.rowGroupStarts[rowGroup];
+    }
+};
+
+template <typename VT> struct DecodeColumnarChunk {
+    static void apply(const ColumnarReadPlan &plan, const ColumnarReadPlan::Part &part, const char *data,
+                      const DCF_chunk &chunk, void *column) {
+        DaphneColumnar::decodeChunk(data, chunk, plan.getRowGroupSize(part.rowGroup), part.begin, part.end,
+                                    static_cast<VT *>(column) + part.resRow, 1);
+    }
+};
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct ReadDaphneColumnar<DenseMatrix<VT>> {
+    static void apply(DenseMatrix<VT> *&res, const char *filename, const DaphneColumnarReadOptions &opts,
+                      DCTX(ctx)) {
+        ColumnarReadPlan plan(filename, opts);
+        for (size_t c : plan.colIdxs)
+            if (plan.footer.schema[c] != ValueTypeUtils::codeFor<VT>)
+                throw std::runtime_error("ReadDaphneColumnar: the value type of column " + std::to_string(c) +
+                                         " does not match the value type of the matrix");
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(plan.numResRows, plan.colIdxs.size(), false);
+        VT *values = res->getValues();
+        const size_t rowSkip = res->getRowSkip();
+        plan.execute(
+            [&](size_t resCol, const ColumnarReadPlan::Part &part, const char *data, const DCF_chunk &chunk) {
+                DaphneColumnar::decodeChunk(data, chunk, plan.getRowGroupSize(part.rowGroup), part.begin, part.end,
+                                            values + part.resRow * rowSkip + resCol, rowSkip);
+            },
+            ctx);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+template <> struct ReadDaphneColumnar<Frame> {
+    static void apply(Frame *&res, const char *filename, const DaphneColumnarReadOptions &opts, DCTX(ctx)) {
+        ColumnarReadPlan plan(filename, opts);
+        std::vector<ValueTypeCode> schema;
+        std::vector<std::string> labels;
+        for (size_t c : plan.colIdxs) {
+            schema.push_back(plan.footer.schema[c]);
+            if (!plan.footer.labels.empty())
+                labels.push_back(plan.footer.labels[c]);
+        }
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<Frame>(plan.numResRows, schema.size(), schema.data(),
+                                                   labels.empty() ? nullptr : labels.data(), false);
+        plan.execute(
+            [&](size_t resCol, const ColumnarReadPlan::Part &part, const char *data, const DCF_chunk &chunk) {
+                void *column = res->getColumnRaw(resCol);
+                if (schema[resCol] == ValueTypeCode::STR)
+                    DecodeColumnarChunk<std::string>::apply(plan, part, data, chunk, column);
+                else
+                    DeduceValueTypeAndExecute<DecodeColumnarChunk>::apply(schema[resCol], plan, part, data, chunk,
+                                                                          column);
+            },
+            ctx);
+    }
+};
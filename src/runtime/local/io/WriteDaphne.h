@@ -27,6 +27,9 @@
 #include <runtime/local/io/DaphneSerializer.h>
 #include <runtime/local/io/utils.h>
 
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 
 #include <cstddef>
@@ -104,6 +107,11 @@ template <typename VT> struct WriteDaphne<CSRMatrix<VT>> {
 
 template <> struct WriteDaphne<Frame> {
     static void apply(const Frame *arg, const char *filename) {
+        // The length of each label is stored as an uint16_t.
+        for (size_t c = 0; c < arg->getNumCols(); c++)
+            if (arg->getLabels()[c].length() > std::numeric_limits<uint16_t>::max())
+                throw std::runtime_error("WriteDaphne: the label of column " + std::to_string(c) + " exceeds " +
+                                         std::to_string(std::numeric_limits<uint16_t>::max()) + " bytes");
 
         std::ofstream f;
         f.open(filename, std::ios::out | std::ios::binary);
@@ -127,7 +135,7 @@ template <> struct WriteDaphne<Frame> {
         for (uint64_t c = 0; c < h.nbcols; c++) {
             uint16_t len = (labels[c]).length();
             f.write((const char *)&len, sizeof(len));
-            f.write((const char *)&(labels[c]), len);
+            f.write(labels[c].data(), len);
         }
 
         DF_body b;
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/io/CompressionCodec.h>
+#include <runtime/local/io/DaphneColumnarFile.h>
+#include <runtime/local/io/DaphneFile.h>
+#include <runtime/local/kernels/ParallelFor.h>
+#include <util/DeduceType.h>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Options for writing the columnar DAPHNE binary format.
+ */
+struct DaphneColumnarWriteOptions {
+    // The maximum number of rows per row group.
+    size_t rowGroupSize = DCF_DEFAULT_ROW_GROUP_SIZE;
+    // The general-purpose codec to try on each chunk after its encoding.
+    CompressionCodec codec = CompressionCodec::NONE;
+};
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+/**
+ * @brief Writes a data object in the columnar DAPHNE binary format (see
+ * `DaphneColumnarFile.h`).
+ *
+ * The chunks of a batch of row groups are encoded in parallel and then written
+ * in order.
+ */
+template <class DTArg> struct WriteDaphneColumnar {
+    static void apply(const DTArg *arg, const char *filename, const DaphneColumnarWriteOptions &opts,
+                      DCTX(ctx)) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTArg>
+void writeDaphneColumnar(const DTArg *arg, const char *filename, const DaphneColumnarWriteOptions &opts, DCTX(ctx)) {
+    WriteDaphneColumnar<DTArg>::apply(arg, filename, opts, ctx);
+}
+
+// ****************************************************************************
+// Functions called by multiple template specializations
+// ****************************************************************************
+
+/**
+ * @brief Writes the header, all chunks, and the footer.
+ *
+ * @param footer The footer with all fields except for the row groups and
+ * chunks, which are filled in.
+ * @param encode Callback `encode(col, rowBegin, numRows, chunk, out)`, which
+ * encodes the rows `[rowBegin, rowBegin + numRows)` of the given column.
+ */
+template <class EncodeFunc>
+void writeColumnarFile(const char *filename, DaphneColumnarFooter &footer, const DaphneColumnarWriteOptions &opts,
+                       EncodeFunc encode, DCTX(ctx)) {
+    // Fail before writing anything if the footer cannot be serialized.
+    DaphneColumnar::checkLabelLengths(footer);
+
+    std::ofstream f(filename, std::ios::out | std::ios::binary);
+    if (!f.good())
+        throw std::runtime_error("WriteDaphneColumnar: could not open file " + std::string(filename));
+
+    DF_header h;
+    h.version = DCF_VERSION;
+    h.dt = footer.dt;
+    h.nbrows = footer.numRows;
+    h.nbcols = footer.numCols;
+    f.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    uint64_t offset = sizeof(h);
+
+    const size_t rowGroupSize = std::max<size_t>(opts.rowGroupSize, 1);
+    const size_t numRowGroups = (footer.numRows + rowGroupSize - 1) / rowGroupSize;
+    footer.rowGroupStarts.resize(numRowGroups + 1);
+    for (size_t rg = 0; rg <= numRowGroups; rg++)
+        footer.rowGroupStarts[rg] = std::min<uint64_t>(rg * rowGroupSize, footer.numRows);
+    footer.chunks.assign(numRowGroups * footer.numCols, DCF_chunk{});
+
+    const size_t numCols = footer.numCols;
+    const size_t numThreads = getNumKernelThreads(numRowGroups * numCols, footer.numRows * numCols, ctx);
+    // Enough row groups per batch to keep all threads busy, but not many more
+    // to bound the memory of the encoded chunks.
+    const size_t batchSize = std::max<size_t>(1, (numThreads + numCols - 1) / std::max<size_t>(numCols, 1));
+    std::vector<std::vector<char>> buffers(batchSize * numCols);
+    for (size_t first = 0; first < numRowGroups; first += batchSize) {
+        const size_t last = std::min(first + batchSize, numRowGroups);
+        const size_t numTasks = (last - first) * numCols;
+        DaphneColumnar::parallelForChunks(numTasks, numThreads, [&](size_t i) {
+            const size_t rg = first + i / numCols;
+            const size_t c = i % numCols;
+            const size_t rowBegin = footer.rowGroupStarts[rg];
+            encode(c, rowBegin, footer.rowGroupStarts[rg + 1] - rowBegin, footer.chunks[rg * numCols + c],
+                   buffers[i]);
+        });
+        for (size_t i = 0; i < numTasks; i++) {
+            DCF_chunk &chunk = footer.chunks[first * numCols + i];
+            chunk.offset = offset;
+            f.write(buffers[i].data(), buffers[i].size());
+            offset += buffers[i].size();
+        }
+    }
+
+    const std::vector<char> footerBytes = DaphneColumnar::serializeFooter(footer);
+    f.write(footerBytes.data(), footerBytes.size());
+    if (!f.good())
+        throw std::runtime_error("WriteDaphneColumnar: could not write file " + std::string(filename));
+}
+
+template <typename VT> struct EncodeColumnarChunk {
+    static void apply(const void *column, size_t rowBegin, size_t numRows, CompressionCodec codec, DCF_chunk &chunk,
+                      std::vector<char> &out) {
+        DaphneColumnar::encodeChunk(static_cast<const VT *>(column) + rowBegin, 1, numRows, codec, chunk, out);
+    }
+};
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct WriteDaphneColumnar<DenseMatrix<VT>> {
+    static void apply(const DenseMatrix<VT> *arg, const char *filename, const DaphneColumnarWriteOptions &opts,
+                      DCTX(ctx)) {
+        DaphneColumnarFooter footer;
+        footer.dt = DF_data_t::DenseMatrix_t;
+        footer.numRows = arg->getNumRows();
+        footer.numCols = arg->getNumCols();
+        footer.schema.assign(footer.numCols, ValueTypeUtils::codeFor<VT>);
+
+        const VT *values = arg->getValues();
+        const size_t rowSkip = arg->getRowSkip();
+        writeColumnarFile(
+            filename, footer, opts,
+            [&](size_t c, size_t rowBegin, size_t numRows, DCF_chunk &chunk, std::vector<char> &out) {
+                DaphneColumnar::encodeChunk(values + rowBegin * rowSkip + c, rowSkip, numRows, opts.codec, chunk, out);
+            },
+            ctx);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+template <> struct WriteDaphneColumnar<Frame> {
+    static void apply(const Frame *arg, const char *filename, const DaphneColumnarWriteOptions &opts, DCTX(ctx)) {
+        DaphneColumnarFooter footer;
+        footer.dt = DF_data_t::Frame_t;
+        footer.numRows = arg->getNumRows();
+        footer.numCols = arg->getNumCols();
+        footer.schema.assign(arg->getSchema(), arg->getSchema() + footer.numCols);
+        footer.labels.assign(arg->getLabels(), arg->getLabels() + footer.numCols);
+        for (ValueTypeCode vtc : footer.schema)
+            if (vtc == ValueTypeCode::FIXEDSTR16)
+                throw std::runtime_error("WriteDaphneColumnar: fixed-size string columns are not supported (yet)");
+
+        writeColumnarFile(
+            filename, footer, opts,
+            [&](size_t c, size_t rowBegin, size_t numRows, DCF_chunk &chunk, std::vector<char> &out) {
+                const void *column = arg->getColumnRaw(c);
+                if (footer.schema[c] == ValueTypeCode::STR)
+                    EncodeColumnarChunk<std::string>::apply(column, rowBegin, numRows, opts.codec, chunk, out);
+                else
+                    DeduceValueTypeAndExecute<EncodeColumnarChunk>::apply(footer.schema[c], column, rowBegin, numRows,
+                                                                          opts.codec, chunk, out);
+            },
+            ctx);
+    }
+};
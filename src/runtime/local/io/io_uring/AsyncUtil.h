@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
+// The alignment of buffers, file offsets, and sizes required for O_DIRECT on
+// common file systems.
+constexpr size_t IO_BUFFER_ALIGNMENT = 4096;
+
 enum struct IO_STATUS : uint8_t {
     PRE_SUBMISSION,
     IN_FLIGHT,
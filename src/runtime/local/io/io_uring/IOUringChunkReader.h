@@ -0,0 +1,381 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/ChunkedTensor.h>
+#include <runtime/local/io/io_uring/AsyncUtil.h>
+
+#include <liburing.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/**
+ * @brief The location of one chunk of a `ChunkedTensor` in a file.
+ *
+ * The chunk is stored as `chunk_element_count` values in the same layout as
+ * in memory, i.e., overhanging chunks are stored as full chunks.
+ */
+struct ChunkReadRequest {
+    size_t linearChunkId;
+    uint64_t fileOffset;
+};
+
+/**
+ * @brief Returns the read requests for a file that stores all chunks of the
+ * given tensor one after the other in linear chunk order, starting at the
+ * given offset.
+ */
+template <typename VT>
+std::vector<ChunkReadRequest> getConsecutiveChunkReadRequests(const ChunkedTensor<VT> *tensor,
+                                                              uint64_t baseOffset = 0) {
+    std::vector<ChunkReadRequest> requests(tensor->total_chunk_count);
+    for (size_t i = 0; i < tensor->total_chunk_count; i++)
+        requests[i] = {i, baseOffset + i * tensor->chunk_element_count * sizeof(VT)};
+    return requests;
+}
+
+inline IO_STATUS getIOStatusFromErrno(int err) {
+    switch (err) {
+    case EIO:
+        return IO_STATUS::IO_ERROR;
+    case EACCES:
+    case EPERM:
+        return IO_STATUS::ACCESS_DENIED;
+    case EBADF:
+        return IO_STATUS::BAD_FD;
+    case ENOSPC:
+        return IO_STATUS::OUT_OF_SPACE;
+    default:
+        return IO_STATUS::OTHER_ERROR;
+    }
+}
+
+/**
+ * @brief Reads chunks of a `ChunkedTensor` from a file asynchronously via
+ * io_uring, straight into the chunk buffers of the tensor.
+ *
+ * Each submitted chunk goes through the states of its `AsyncIOInfo`: it is
+ * `IN_FLIGHT` once submitted and becomes `SUCCESS` or one of the error states
+ * when its read completes. Consumers use
+ * `ChunkedTensor::PollChunkMaterializationAndIOStatus()` to find out if a
+ * chunk is ready (which also reverses the byte order if needed) and can work
+ * on it while the other chunks are still being read.
+ *
+ * The reader is driven by the thread that owns it: completions are only
+ * processed in `poll()`, `wait()`, and `waitAll()`, which also submit the
+ * chunks that did not fit into the submission queue before. Other threads may
+ * poll the status of chunks at any time.
+ *
+ * Where possible, the chunk buffers of the tensor are registered with the ring
+ * (fixed buffers) and the file is read with `O_DIRECT`, bypassing the page
+ * cache. The latter requires chunk sizes and file offsets that are multiples
+ * of `IO_BUFFER_ALIGNMENT`; other chunks are read through the page cache.
+ * Both are optimizations only: if the kernel or the file system do not support
+ * them, the reader falls back to ordinary reads.
+ *
+ * The tensor must not be rechunked or destroyed while chunks are in flight.
+ */
+template <typename VT> class IOUringChunkReader {
+    // The maximum size of a registered buffer supported by the kernel.
+    static constexpr size_t MAX_REGISTERED_BUFFER_SIZE = size_t(1) << 30;
+
+    struct Read {
+        size_t linearChunkId;
+        uint64_t fileOffset;
+        // The number of bytes read so far, reads may complete partially.
+        size_t numBytesDone;
+        bool direct;
+    };
+
+    ChunkedTensor<VT> *tensor;
+    const bool needsByteReversal;
+    const size_t chunkSizeInBytes;
+
+    io_uring ring;
+    int fd = -1;
+    int directFd = -1;
+    bool useDirectIO = false;
+    // The number of consecutive chunks per registered buffer, zero if the
+    // buffers could not be registered.
+    size_t chunksPerBuffer = 0;
+
+    // The reads waiting for a free slot in the ring.
+    std::deque<Read> queued;
+    // The reads in flight, indexed by the user data of their submissions.
+    std::vector<Read> slots;
+    std::vector<size_t> freeSlots;
+
+    void setStatus(const Read &read, IO_STATUS status) {
+        tensor->chunk_io_futures[read.linearChunkId].status = status;
+    }
+
+    void prepare(size_t slot) {
+        io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+        if (sqe == nullptr) {
+            io_uring_submit(&ring);
+            sqe = io_uring_get_sqe(&ring);
+            if (sqe == nullptr)
+                throw std::runtime_error("IOUringChunkReader: submission queue is full");
+        }
+
+        Read &read = slots[slot];
+        char *buf = reinterpret_cast<char *>(tensor->getPtrToChunk(read.linearChunkId)) + read.numBytesDone;
+        const size_t numBytes = chunkSizeInBytes - read.numBytesDone;
+        const uint64_t offset = read.fileOffset + read.numBytesDone;
+        read.direct = useDirectIO && (reinterpret_cast<uintptr_t>(buf) | numBytes | offset) % IO_BUFFER_ALIGNMENT == 0;
+        const int readFd = read.direct ? directFd : fd;
+        if (chunksPerBuffer)
+            io_uring_prep_read_fixed(sqe, readFd, buf, numBytes, offset, read.linearChunkId / chunksPerBuffer);
+        else
+            io_uring_prep_read(sqe, readFd, buf, numBytes, offset);
+        io_uring_sqe_set_data64(sqe, slot);
+    }
+
+    void submitQueued() {
+        bool submitted = false;
+        while (!queued.empty() && !freeSlots.empty()) {
+            const size_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            slots[slot] = queued.front();
+            queued.pop_front();
+            prepare(slot);
+            submitted = true;
+        }
+        if (submitted)
+            io_uring_submit(&ring);
+    }
+
+    void complete(size_t slot, int res) {
+        Read &read = slots[slot];
+        if (res == -EINVAL && read.direct) {
+            // The file system does not support O_DIRECT after all.
+            useDirectIO = false;
+            prepare(slot);
+            return;
+        }
+        if (res == -EINTR || res == -EAGAIN) {
+            prepare(slot);
+            return;
+        }
+
+        if (res < 0)
+            setStatus(read, getIOStatusFromErrno(-res));
+        else if (res == 0)
+            // The file ends before the chunk.
+            setStatus(read, IO_STATUS::IO_ERROR);
+        else {
+            read.numBytesDone += res;
+            if (read.numBytesDone < chunkSizeInBytes) {
+                prepare(slot);
+                return;
+            }
+            tensor->chunk_io_futures[read.linearChunkId].needs_byte_reversal = needsByteReversal;
+            setStatus(read, IO_STATUS::SUCCESS);
+        }
+        freeSlots.push_back(slot);
+    }
+
+    /**
+     * @brief Processes all available completions, waiting for at least one
+     * if `block` is set and reads are in flight. Returns the number of
+     * processed completions.
+     */
+    size_t reap(bool block) {
+        size_t numCompleted = 0;
+        io_uring_cqe *cqe;
+        if (block && getNumInFlight()) {
+            const int err = io_uring_wait_cqe(&ring, &cqe);
+            if (err < 0 && err != -EINTR)
+                throw std::runtime_error("IOUringChunkReader: waiting for completions failed: " +
+                                         std::string(strerror(-err)));
+        }
+        while (io_uring_peek_cqe(&ring, &cqe) == 0) {
+            const size_t slot = io_uring_cqe_get_data64(cqe);
+            const int res = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+            complete(slot, res);
+            numCompleted++;
+        }
+        // Resubmits partial reads and submits queued reads for free slots.
+        io_uring_submit(&ring);
+        submitQueued();
+        return numCompleted;
+    }
+
+    void registerBuffers() {
+        if (chunkSizeInBytes == 0 || chunkSizeInBytes > MAX_REGISTERED_BUFFER_SIZE)
+            return;
+        const size_t chunksPerIovec = MAX_REGISTERED_BUFFER_SIZE / chunkSizeInBytes;
+        std::vector<iovec> iovecs;
+        for (size_t first = 0; first < tensor->total_chunk_count; first += chunksPerIovec) {
+            const size_t numChunks = std::min(chunksPerIovec, tensor->total_chunk_count - first);
+            iovecs.push_back({tensor->getPtrToChunk(first), numChunks * chunkSizeInBytes});
+        }
+        // Registering pins the memory, which may exceed RLIMIT_MEMLOCK.
+        if (io_uring_register_buffers(&ring, iovecs.data(), iovecs.size()) == 0)
+            chunksPerBuffer = chunksPerIovec;
+    }
+
+  public:
+    /**
+     * @brief Opens the file and sets up the ring.
+     *
+     * @param queueDepth The maximum number of reads in flight.
+     * @param needsByteReversal Whether the byte order of the values in the
+     * file differs from the byte order of this machine.
+     */
+    IOUringChunkReader(const char *filename, ChunkedTensor<VT> *tensor, unsigned queueDepth = 64,
+                       bool needsByteReversal = false)
+        : tensor(tensor), needsByteReversal(needsByteReversal),
+          chunkSizeInBytes(tensor->chunk_element_count * sizeof(VT)) {
+        if (queueDepth == 0)
+            throw std::invalid_argument("IOUringChunkReader: the queue depth must not be zero");
+        fd = open(filename, O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("IOUringChunkReader: could not open file " + std::string(filename));
+        const int err = io_uring_queue_init(queueDepth, &ring, 0);
+        if (err < 0) {
+            close(fd);
+            throw std::runtime_error("IOUringChunkReader: could not set up io_uring: " + std::string(strerror(-err)));
+        }
+        // Not all file systems support O_DIRECT.
+        directFd = open(filename, O_RDONLY | O_DIRECT);
+        useDirectIO = directFd >= 0;
+        registerBuffers();
+
+        slots.resize(queueDepth);
+        for (size_t i = queueDepth; i > 0; i--)
+            freeSlots.push_back(i - 1);
+    }
+
+    IOUringChunkReader(const IOUringChunkReader &) = delete;
+    IOUringChunkReader &operator=(const IOUringChunkReader &) = delete;
+
+    /**
+     * @brief Waits for the reads in flight, since they write into the tensor.
+     * Queued reads that were not submitted yet are dropped.
+     */
+    ~IOUringChunkReader() {
+        for (const Read &read : queued)
+            setStatus(read, IO_STATUS::PRE_SUBMISSION);
+        queued.clear();
+        try {
+            while (getNumInFlight())
+                reap(true);
+        } catch (...) {
+            // Nothing sensible left to do in a destructor.
+        }
+        if (chunksPerBuffer)
+            io_uring_unregister_buffers(&ring);
+        io_uring_queue_exit(&ring);
+        if (directFd >= 0)
+            close(directFd);
+        close(fd);
+    }
+
+    /**
+     * @brief Submits reads of the given chunks.
+     *
+     * Reads that do not fit into the ring are queued and submitted as earlier
+     * reads complete.
+     */
+    void submit(const std::vector<ChunkReadRequest> &requests) {
+        for (const ChunkReadRequest &request : requests) {
+            if (request.linearChunkId >= tensor->total_chunk_count)
+                throw std::out_of_range("IOUringChunkReader: chunk id out of bounds");
+            tensor->chunk_materialization_flags[request.linearChunkId] = false;
+            tensor->chunk_io_futures[request.linearChunkId].needs_byte_reversal = false;
+            tensor->chunk_io_futures[request.linearChunkId].status = IO_STATUS::IN_FLIGHT;
+            queued.push_back({request.linearChunkId, request.fileOffset, 0, false});
+        }
+        submitQueued();
+    }
+
+    /**
+     * @brief Processes the completed reads without blocking.
+     */
+    size_t poll() { return reap(false); }
+
+    /**
+     * @brief Blocks until at least one read completed, unless none is pending.
+     */
+    size_t wait() { return reap(true); }
+
+    /**
+     * @brief Blocks until all submitted reads completed.
+     */
+    void waitAll() {
+        while (getNumPending())
+            reap(true);
+    }
+
+    size_t getNumInFlight() const { return slots.size() - freeSlots.size(); }
+
+    size_t getNumPending() const { return getNumInFlight() + queued.size(); }
+
+    bool usesRegisteredBuffers() const { return chunksPerBuffer != 0; }
+
+    bool usesDirectIO() const { return useDirectIO; }
+};
+
+/**
+ * @brief Calls `func(linearChunkId)` for each of the given chunks as soon as
+ * it is materialized, in the order in which their reads complete, while the
+ * reader keeps the remaining reads going.
+ *
+ * Throws if the read of a chunk failed or a chunk was neither materialized
+ * nor submitted to the reader.
+ */
+template <typename VT, class Func>
+void forEachMaterializedChunk(ChunkedTensor<VT> *tensor, IOUringChunkReader<VT> &reader,
+                              std::vector<size_t> linearChunkIds, Func func) {
+    while (!linearChunkIds.empty()) {
+        bool progress = false;
+        for (size_t i = 0; i < linearChunkIds.size();) {
+            const size_t id = linearChunkIds[i];
+            if (tensor->PollChunkMaterializationAndIOStatus(id)) {
+                func(id);
+                linearChunkIds[i] = linearChunkIds.back();
+                linearChunkIds.pop_back();
+                progress = true;
+                continue;
+            }
+            const IO_STATUS status = tensor->chunk_io_futures[id].status;
+            if (status == IO_STATUS::PRE_SUBMISSION)
+                throw std::runtime_error("forEachMaterializedChunk: chunk " + std::to_string(id) +
+                                         " is neither materialized nor being read");
+            if (status != IO_STATUS::IN_FLIGHT)
+                throw std::runtime_error("forEachMaterializedChunk: reading chunk " + std::to_string(id) +
+                                         " failed");
+            i++;
+        }
+        if (!progress && !linearChunkIds.empty() && reader.wait() == 0 && !reader.getNumPending())
+            throw std::runtime_error("forEachMaterializedChunk: chunks are in flight, but not in this reader");
+    }
+}
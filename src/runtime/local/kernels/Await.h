@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/context/IOContext.h>
+#include <runtime/local/io/Future.h>
+
+#include <memory>
+#include <stdexcept>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+/**
+ * @brief Blocks until the result of the given future is available and
+ * returns it. The future is consumed.
+ */
+template <class DTRes> struct Await {
+    static void apply(DTRes *&res, Future<DTRes> *future, DCTX(ctx)) {
+        IOContext *ioCtx = IOContext::get(ctx);
+        if (ioCtx == nullptr)
+            throw std::runtime_error("Await: the DaphneContext has no IOContext");
+        std::unique_ptr<Future<DTRes>> owner = ioCtx->release(future);
+        res = owner->get();
+    }
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTRes> void await(DTRes *&res, Future<DTRes> *future, DCTX(ctx)) {
+    Await<DTRes>::apply(res, future, ctx);
+}
@@ -21,15 +21,14 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
-#include <limits>
-#include <random>
-#include <type_traits>
+#include <vector>
 
 #include <cstddef>
 #include <cstdint>
 
 #include <cmath>
-#include <iostream>
+
+#include "ParallelFor.h"
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -58,44 +57,59 @@ void batchNorm2DTestForward(DTRes *&res, const DTArg *in, const DTArg *gamma, co
 // DenseMatrix <- DenseMatrix
 // ----------------------------------------------------------------------------
 
-template <typename VT> static inline VT getMean(const VT *in, uint32_t start, uint32_t length, VT plen) {
-    VT ret = 0;
-    auto end = start + length;
-    for (auto i = start; i < end; ++i)
-        ret += in[i];
-    return ret * plen;
-}
-
-template <typename VT> static inline VT getVar(const VT *in, uint32_t start, uint32_t length, VT plen, VT mean) {
-    VT ret = 0;
-    auto end = start + length;
-    for (auto i = start; i < end; ++i)
-        ret += (in[i] - mean) * (in[i] - mean);
-    return ret * plen;
-}
-
 template <typename VTRes, typename VTArg> struct BatchNorm2DTestForward<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
+    /**
+     * @brief Normalizes each channel of a batch of images (one per row of
+     * `in`) by the given running mean and variance per channel (one per row of
+     * `gamma`, `beta`, `emaMean`, and `emaVar`).
+     *
+     * The normalization is folded into one multiply-add per cell, and the
+     * (image, channel) planes are processed in parallel.
+     */
     static void apply(DenseMatrix<VTRes> *&res, const DenseMatrix<VTArg> *in, const DenseMatrix<VTArg> *gamma,
                       const DenseMatrix<VTArg> *beta, const DenseMatrix<VTArg> *emaMean,
                       const DenseMatrix<VTArg> *emaVar, const VTArg eps, DCTX(dctx)) {
-
-        auto start = 0;
-        auto stop = in->getNumRows();
-        auto size = in->getNumCols();
-
-        VTArg x_hat = 0;
-        auto off = 0;
-
-        if (res == nullptr) {
-            res = DataObjectFactory::create<DenseMatrix<VTArg>>(stop, size, true);
+        const size_t N = in->getNumRows();
+        const size_t CHW = in->getNumCols();
+        const size_t C = gamma->getNumRows();
+        const size_t HW = CHW / C;
+
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VTRes>>(N, CHW, false);
+
+        // x_hat = (x - mean) / sqrt(var + eps) and res = gamma * x_hat + beta
+        // is res = x * scale + shift.
+        // The per-channel parameters are vectors, but might be given as rows
+        // or columns.
+        const VTArg *valuesGamma = gamma->getValues();
+        const VTArg *valuesBeta = beta->getValues();
+        const VTArg *valuesEmaMean = emaMean->getValues();
+        const VTArg *valuesEmaVar = emaVar->getValues();
+        std::vector<VTArg> scale(C);
+        std::vector<VTArg> shift(C);
+        for (size_t c = 0; c < C; c++) {
+            scale[c] = valuesGamma[c] / std::sqrt(valuesEmaVar[c] + eps);
+            shift[c] = valuesBeta[c] - valuesEmaMean[c] * scale[c];
         }
 
-        for (uint32_t i = start; i < stop; i++) {
-            for (uint32_t j = 0; j < size; j++) {
-                off = i * size + j;
-                x_hat = (in->getValues()[off] - emaMean->getValues()[i]) / std::sqrt(emaVar->getValues()[i] + eps);
-                res->getValues()[off] = gamma->getValues()[i] * x_hat + beta->getValues()[i];
+        const VTArg *valuesIn = in->getValues();
+        VTRes *valuesRes = res->getValues();
+        const size_t rowSkipIn = in->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
+
+        const size_t numPlanes = N * C;
+        const size_t numThreads = getNumKernelThreads(numPlanes, N * CHW, dctx);
+        parallelFor(numPlanes, numThreads, [&](size_t begin, size_t end, size_t) {
+            for (size_t plane = begin; plane < end; plane++) {
+                const size_t i = plane / C;
+                const size_t c = plane % C;
+                const VTArg *x = valuesIn + i * rowSkipIn + c * HW;
+                VTRes *y = valuesRes + i * rowSkipRes + c * HW;
+                const VTArg sc = scale[c];
+                const VTArg sh = shift[c];
+                for (size_t j = 0; j < HW; j++)
+                    y[j] = static_cast<VTRes>(x[j] * sc + sh);
             }
-        }
+        });
     }
-};
\ No newline at end of file
+};
@@ -21,15 +21,12 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
-#include <limits>
-#include <random>
-#include <type_traits>
-
 #include <cstddef>
 #include <cstdint>
 
 #include <cmath>
-#include <iostream>
+
+#include "ParallelFor.h"
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -63,60 +60,85 @@ void batchNorm2DTrainForward(DTRes *&res, DTRes *&new_emaMean, DTRes *&new_emaVa
 // ----------------------------------------------------------------------------
 
 template <typename VTRes, typename VTArg> struct BatchNorm2DTrainForward<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
+    /**
+     * @brief Normalizes each channel of a batch of images (one per row of
+     * `in`) by the mean and variance of the channel over the batch, and
+     * updates the running mean and variance.
+     *
+     * The channels are processed in parallel.
+     */
     static void apply(DenseMatrix<VTRes> *&res, DenseMatrix<VTRes> *&new_emaMean, DenseMatrix<VTRes> *&new_emaVar,
                       DenseMatrix<VTRes> *&Mean, DenseMatrix<VTRes> *&invVar, const DenseMatrix<VTArg> *in,
                       const DenseMatrix<VTArg> *gamma, const DenseMatrix<VTArg> *beta,
                       const DenseMatrix<VTArg> *emaMean, const DenseMatrix<VTArg> *emaVar, const VTArg eps,
                       const VTArg mu, DCTX(dctx)) {
-
-        auto start = 0;
-        auto stop = in->getNumRows();
-        auto CHW = in->getNumCols();
-        auto C = gamma->getNumRows();
-        auto HW = CHW / C;
-
-        VTArg x_hat = 0;
-        VTArg mean = 0;
-        VTArg var = 0;
-        auto off = 0;
+        const size_t N = in->getNumRows();
+        const size_t CHW = in->getNumCols();
+        const size_t C = gamma->getNumRows();
+        const size_t HW = CHW / C;
 
         if (res == nullptr)
-            res = DataObjectFactory::create<DenseMatrix<VTArg>>(stop, CHW, true);
+            res = DataObjectFactory::create<DenseMatrix<VTRes>>(N, CHW, false);
         if (new_emaMean == nullptr)
-            new_emaMean = DataObjectFactory::create<DenseMatrix<VTArg>>(C, C, true);
+            new_emaMean = DataObjectFactory::create<DenseMatrix<VTRes>>(C, C, true);
         if (new_emaVar == nullptr)
-            new_emaVar = DataObjectFactory::create<DenseMatrix<VTArg>>(C, C, true);
+            new_emaVar = DataObjectFactory::create<DenseMatrix<VTRes>>(C, C, true);
         if (Mean == nullptr)
-            Mean = DataObjectFactory::create<DenseMatrix<VTArg>>(C, C, true);
+            Mean = DataObjectFactory::create<DenseMatrix<VTRes>>(C, C, true);
         if (invVar == nullptr)
-            invVar = DataObjectFactory::create<DenseMatrix<VTArg>>(C, C, true);
-
-        for (uint32_t c = 0; c < C; c++) {
-            mean = 0;
-            for (uint32_t i = start; i < stop; i++)
-                for (uint32_t j = 0; j < HW; j++) {
-                    off = i * CHW + c * HW + j;
-                    mean = mean + in->getValues()[off] / (stop * HW);
+            invVar = DataObjectFactory::create<DenseMatrix<VTRes>>(C, C, true);
+
+        // The per-channel parameters are vectors, but might be given as rows
+        // or columns.
+        const VTArg *valuesGamma = gamma->getValues();
+        const VTArg *valuesBeta = beta->getValues();
+        const VTArg *valuesEmaMean = emaMean->getValues();
+        const VTArg *valuesEmaVar = emaVar->getValues();
+        const VTArg *valuesIn = in->getValues();
+        VTRes *valuesRes = res->getValues();
+        VTRes *valuesNewEmaMean = new_emaMean->getValues();
+        VTRes *valuesNewEmaVar = new_emaVar->getValues();
+        VTRes *valuesMean = Mean->getValues();
+        VTRes *valuesInvVar = invVar->getValues();
+        const size_t rowSkipIn = in->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
+        const VTArg count = static_cast<VTArg>(N * HW);
+
+        const size_t numThreads = getNumKernelThreads(C, 3 * N * CHW, dctx);
+        parallelFor(C, numThreads, [&](size_t begin, size_t end, size_t) {
+            for (size_t c = begin; c < end; c++) {
+                VTArg sum = 0;
+                for (size_t i = 0; i < N; i++) {
+                    const VTArg *x = valuesIn + i * rowSkipIn + c * HW;
+                    for (size_t j = 0; j < HW; j++)
+                        sum += x[j];
                 }
+                const VTArg mean = sum / count;
 
-            var = 0;
-            for (uint32_t i = start; i < stop; i++)
-                for (uint32_t j = 0; j < HW; j++) {
-                    off = i * CHW + c * HW + j;
-                    var = var + std::pow((in->getValues()[off] - mean), 2) / (stop * HW);
+                VTArg sumSq = 0;
+                for (size_t i = 0; i < N; i++) {
+                    const VTArg *x = valuesIn + i * rowSkipIn + c * HW;
+                    for (size_t j = 0; j < HW; j++)
+                        sumSq += (x[j] - mean) * (x[j] - mean);
                 }
-
-            Mean->getValues()[c] = mean;
-            invVar->getValues()[c] = 1 / std::sqrt(var + eps);
-            new_emaMean->getValues()[c] = (1 - mu) * emaMean->getValues()[c] + mu * mean;
-            new_emaVar->getValues()[c] = (1 - mu) * emaVar->getValues()[c] + mu * var;
-            for (uint32_t i = start; i < stop; i++) {
-                for (uint32_t j = 0; j < HW; j++) {
-                    off = i * CHW + c * HW + j;
-                    x_hat = (in->getValues()[off] - mean) / std::sqrt(var + eps);
-                    res->getValues()[off] = gamma->getValues()[c] * x_hat + beta->getValues()[c];
+                const VTArg var = sumSq / count;
+                const VTArg inv = 1 / std::sqrt(var + eps);
+
+                valuesMean[c] = mean;
+                valuesInvVar[c] = inv;
+                valuesNewEmaMean[c] = (1 - mu) * valuesEmaMean[c] + mu * mean;
+                valuesNewEmaVar[c] = (1 - mu) * valuesEmaVar[c] + mu * var;
+
+                // gamma * (x - mean) * inv + beta is x * scale + shift.
+                const VTArg scale = valuesGamma[c] * inv;
+                const VTArg shift = valuesBeta[c] - mean * scale;
+                for (size_t i = 0; i < N; i++) {
+                    const VTArg *x = valuesIn + i * rowSkipIn + c * HW;
+                    VTRes *y = valuesRes + i * rowSkipRes + c * HW;
+                    for (size_t j = 0; j < HW; j++)
+                        y[j] = static_cast<VTRes>(x[j] * scale + shift);
                 }
             }
-        }
+        });
     }
-};
\ No newline at end of file
+};
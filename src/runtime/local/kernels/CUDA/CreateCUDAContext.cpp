@@ -6,6 +6,7 @@ void createCUDAContext(DCTX(ctx)) {
     // ToDo: one context per device
     if (ctx->getUserConfig().log_ptr)
         ctx->getUserConfig().log_ptr->registerLoggers();
-    ctx->cuda_contexts.emplace_back(CUDAContext::createCudaContext(0));
+    if (ctx->cuda_contexts.empty())
+        ctx->cuda_contexts.emplace_back(CUDAContext::createCudaContext(0));
 }
 } // namespace CUDA
\ No newline at end of file
@@ -68,7 +68,8 @@ template <>
 // ----------------------------------------------------------------------------
 
 template <typename VT>
-void Transpose<DenseMatrix<VT>, DenseMatrix<VT>>::apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, DCTX(dctx)) {
+void Transpose<DenseMatrix<VT>, DenseMatrix<VT>>::apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg,
+                                                       bool mayReuseArg, DCTX(dctx)) {
     const size_t numRows = arg->getNumRows();
     const size_t numCols = arg->getNumCols();
     const size_t deviceID = 0; // ToDo: multi device support
@@ -31,18 +31,18 @@ void launch_cublas_geam(const CUDAContext &ctx, size_t m, size_t n, const T *alp
 // ****************************************************************************
 
 template <class DTRes, class DTArg> struct Transpose {
-    static void apply(DTRes *&res, const DTArg *arg, DCTX(ctx)) = delete;
+    static void apply(DTRes *&res, const DTArg *arg, bool mayReuseArg, DCTX(ctx)) = delete;
 };
 
 template <typename VT> struct Transpose<DenseMatrix<VT>, DenseMatrix<VT>> {
-    static void apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, DCTX(ctx));
+    static void apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, bool mayReuseArg, DCTX(ctx));
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
-template <class DTRes, class DTArg> void transpose(DTRes *&res, const DTArg *arg, DCTX(ctx)) {
-    Transpose<DTRes, DTArg>::apply(res, arg, ctx);
+template <class DTRes, class DTArg> void transpose(DTRes *&res, const DTArg *arg, bool mayReuseArg, DCTX(ctx)) {
+    Transpose<DTRes, DTArg>::apply(res, arg, mayReuseArg, ctx);
 }
 } // namespace CUDA
\ No newline at end of file
@@ -21,18 +21,17 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
-#include <limits>
-#include <random>
-#include <type_traits>
+#include <algorithm>
+#include <vector>
 
 #include <cstddef>
 #include <cstdint>
 
-#include <cmath>
-#include <iostream>
-
+#include "ParallelFor.h"
 #include "Padding.h"
 
+#include <cblas.h>
+
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
@@ -65,76 +64,141 @@ void conv2DForward(DTRes *&res, size_t &res_h, size_t &res_w, const DTArg *data,
 // DenseMatrix <- DenseMatrix
 // ----------------------------------------------------------------------------
 
+namespace NN::Conv2D {
+
+inline void gemm(size_t m, size_t n, size_t k, const float *a, size_t lda, const float *b, size_t ldb, float *c,
+                 size_t ldc) {
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0f, a, lda, b, ldb, 0.0f, c, ldc);
+}
+
+inline void gemm(size_t m, size_t n, size_t k, const double *a, size_t lda, const double *b, size_t ldb, double *c,
+                 size_t ldc) {
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0, a, lda, b, ldb, 0.0, c, ldc);
+}
+
+/**
+ * @brief Maximum number of cells of the unfolded images multiplied with the
+ * filters at once.
+ */
+constexpr size_t MAX_UNFOLDED_CELLS = size_t(1) << 22;
+
+/**
+ * @brief Unfolds the receptive fields of one image into the columns of a
+ * matrix, such that the convolution becomes a matrix multiplication of the
+ * filters with this matrix.
+ *
+ * @param img The image of `num_channels x img_h x img_w` cells (row-major).
+ * @param col The result of `(num_channels * filter_h * filter_w) x (P * Q)`
+ * cells (row-major with row skip `rowSkipCol`), where row
+ * `(c * filter_h + h) * filter_w + w` holds the cell `(h, w)` of the receptive
+ * field of channel `c` for each output cell. Cells in the padding are zero.
+ */
 template <typename VT>
-static inline VT ConvOp(VT initial_value, const VT *in, const VT *filter, uint32_t in_start, uint32_t filter_start,
-                        uint32_t length) {
-    VT ret = 0;
-    for (uint32_t i = 0; i < length; ++i)
-        ret += in[in_start + i] * filter[filter_start + i];
-    return ret + initial_value;
+void im2col(const VT *img, VT *col, size_t rowSkipCol, size_t num_channels, size_t img_h, size_t img_w,
+            size_t filter_h, size_t filter_w, size_t stride_h, size_t stride_w, size_t pad_h, size_t pad_w, size_t P,
+            size_t Q) {
+    for (size_t c = 0; c < num_channels; c++) {
+        const VT *plane = img + c * img_h * img_w;
+        for (size_t fh = 0; fh < filter_h; fh++)
+            for (size_t fw = 0; fw < filter_w; fw++) {
+                // The output columns [qBegin, qEnd) read from inside the image,
+                // i.e., 0 <= q * stride_w + fw - pad_w < img_w.
+                const size_t qBegin = std::min(Q, pad_w > fw ? (pad_w - fw + stride_w - 1) / stride_w : 0);
+                const size_t qEnd =
+                    std::max(qBegin, img_w + pad_w > fw ? std::min(Q, (img_w + pad_w - fw - 1) / stride_w + 1) : 0);
+                VT *dst = col + ((c * filter_h + fh) * filter_w + fw) * rowSkipCol;
+                for (size_t p = 0; p < P; p++, dst += Q) {
+                    const size_t h = p * stride_h + fh;
+                    if (h < pad_h || h - pad_h >= img_h) {
+                        std::fill(dst, dst + Q, VT(0));
+                        continue;
+                    }
+                    // Shifted by -pad_w, only accessed for q in [qBegin, qEnd).
+                    const VT *src = plane + (h - pad_h) * img_w + fw - pad_w;
+                    std::fill(dst, dst + qBegin, VT(0));
+                    if (stride_w == 1)
+                        std::copy(src + qBegin, src + qEnd, dst + qBegin);
+                    else
+                        for (size_t q = qBegin; q < qEnd; q++)
+                            dst[q] = src[q * stride_w];
+                    std::fill(dst + qEnd, dst + Q, VT(0));
+                }
+            }
+    }
 }
 
-template <typename VTRes, typename VTArg> struct Conv2DForward<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
-    static void apply(DenseMatrix<VTRes> *&res, size_t &res_h, size_t &res_w, const DenseMatrix<VTArg> *data,
-                      const DenseMatrix<VTArg> *filter, const DenseMatrix<VTArg> *bias, const size_t batch_size,
+} // namespace NN::Conv2D
+
+template <typename VT> struct Conv2DForward<DenseMatrix<VT>, DenseMatrix<VT>> {
+    /**
+     * @brief Convolves a batch of images (one per row of `data`) with the
+     * filters (one per row of `filter`) and adds the bias per filter.
+     *
+     * The images are unfolded by `im2col()` side by side into one matrix,
+     * which a single BLAS GEMM multiplies with the filters. Thus, BLAS
+     * parallelizes the multiplication itself, while the unfolding and the
+     * bias are parallelized over the images. Large batches are processed in
+     * groups to bound the size of the unfolded matrix.
+     */
+    static void apply(DenseMatrix<VT> *&res, size_t &res_h, size_t &res_w, const DenseMatrix<VT> *data,
+                      const DenseMatrix<VT> *filter, const DenseMatrix<VT> *bias, const size_t batch_size,
                       const size_t num_channels, const size_t img_h, const size_t img_w, const size_t filter_h,
                       const size_t filter_w, const size_t stride_h, const size_t stride_w, const size_t pad_h,
                       const size_t pad_w, DCTX(dctx)) {
-        auto HW = img_h * img_w;
-        auto C = num_channels;
-        auto CHW = C * HW;
-        // padded height/width
-        auto P = getPQ(img_h, filter_h, pad_h, stride_h);
-        auto Q = getPQ(img_w, filter_w, pad_w, stride_w);
-        auto C_new = filter->getNumRows();
-        auto PQ = P * Q;
-        auto CPQ = C_new * PQ;
+        const size_t P = getPQ(img_h, filter_h, pad_h, stride_h);
+        const size_t Q = getPQ(img_w, filter_w, pad_w, stride_w);
+        const size_t PQ = P * Q;
+        const size_t C_new = filter->getNumRows();
+        // The length of a receptive field, i.e., the inner dimension of the
+        // matrix multiplication.
+        const size_t K = num_channels * filter_h * filter_w;
         res_h = P;
         res_w = Q;
 
-        auto start = 0;
-        auto stop = batch_size;
-
-        auto ii = start * CHW;
-        auto oi = start * CPQ;
-
-        auto off_f = 0;
-        auto f_CHW = C * filter_h * filter_w;
-
-        auto padded_img_h = img_h + 2 * pad_h;
-        auto padded_img_w = img_w + 2 * pad_w;
-        DenseMatrix<VTArg> *padded_data =
-            DataObjectFactory::create<DenseMatrix<VTArg>>(1, padded_img_h * padded_img_w, true);
-
-        if (res == nullptr) {
-            res = DataObjectFactory::create<DenseMatrix<VTArg>>(batch_size, CPQ, true);
-        }
-
-        u_int32_t off_o, off_i_padded, off_i = 0;
-        for (uint32_t i = start; i < stop; i++) {
-            for (uint32_t c_new = 0; c_new < C_new; c_new++) {
-                for (uint32_t c = 0; c < C; c++) {
-                    off_i = ii + (i - start) * CHW + c * HW;
-
-                    Padding(padded_data->getValues(), data->getValues(), pad_h, pad_w, img_w, img_h, off_i);
-
-                    for (u_int32_t p = 0; p < P; p++)
-                        for (u_int32_t h = 0; h < std::min(filter_h, padded_img_h - p * stride_h); h++)
-                            for (u_int32_t q = 0; q < Q; q++)
-                                for (u_int32_t w = 0; w < std::min(filter_w, padded_img_w - q * stride_w); w++) {
-                                    off_o = oi + (i - start) * CPQ + c_new * PQ + p * Q + q;
-                                    off_i_padded = (p * stride_h + h) * padded_img_w + q * stride_w + w;
-                                    off_f = c_new * f_CHW + c * filter_h * filter_w + h * filter_w + w;
-
-                                    res->getValues()[off_o] =
-                                        res->getValues()[off_o] +
-                                        padded_data->getValues()[off_i_padded] * filter->getValues()[off_f];
-                                }
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(batch_size, C_new * PQ, false);
+
+        const VT *valuesData = data->getValues();
+        const VT *valuesFilter = filter->getValues();
+        const VT *valuesBias = bias->getValues();
+        VT *valuesRes = res->getValues();
+        const size_t rowSkipData = data->getRowSkip();
+        const size_t rowSkipFilter = filter->getRowSkip();
+        const size_t rowSkipBias = bias->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
+        if (batch_size == 0 || C_new == 0 || PQ == 0)
+            return;
+
+        const size_t groupSize = std::clamp<size_t>(NN::Conv2D::MAX_UNFOLDED_CELLS / std::max<size_t>(K * PQ, 1), 1,
+                                                     std::max<size_t>(batch_size, 1));
+        std::vector<VT> unfolded(K * groupSize * PQ);
+        std::vector<VT> out(C_new * groupSize * PQ);
+
+        for (size_t first = 0; first < batch_size; first += groupSize) {
+            const size_t numImgs = std::min(groupSize, batch_size - first);
+            // The row skip of the unfolded images and of the output, image i
+            // occupies the columns [i * PQ, (i + 1) * PQ).
+            const size_t ld = numImgs * PQ;
+            const size_t numThreads = getNumKernelThreads(numImgs, numImgs * (K + C_new) * PQ, dctx);
+
+            parallelFor(numImgs, numThreads, [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; i++)
+                    NN::Conv2D::im2col(valuesData + (first + i) * rowSkipData, unfolded.data() + i * PQ, ld,
+                                       num_channels, img_h, img_w, filter_h, filter_w, stride_h, stride_w, pad_h,
+                                       pad_w, P, Q);
+            });
+            NN::Conv2D::gemm(C_new, ld, K, valuesFilter, rowSkipFilter, unfolded.data(), ld, out.data(), ld);
+            parallelFor(numImgs, numThreads, [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; i++) {
+                    VT *dst = valuesRes + (first + i) * rowSkipRes;
+                    for (size_t c = 0; c < C_new; c++) {
+                        const VT b = valuesBias[c * rowSkipBias];
+                        const VT *src = out.data() + c * ld + i * PQ;
+                        for (size_t l = 0; l < PQ; l++)
+                            dst[c * PQ + l] = src[l] + b;
+                    }
                 }
-                for (u_int32_t l = 0; l < PQ; l++)
-                    res->getValues()[oi + (i - start) * CPQ + c_new * PQ + l] += bias->getValues()[c_new];
-            }
+            });
         }
-        DataObjectFactory::destroy(padded_data);
     }
 };
\ No newline at end of file
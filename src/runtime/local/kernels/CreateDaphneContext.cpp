@@ -25,5 +25,10 @@ void createDaphneContext(DaphneContext *&res, uint64_t configPtr, uint64_t dispa
     auto stringRefCounter = reinterpret_cast<StringRefCounter *>(stringRefCountPtr);
     if (config->log_ptr != nullptr)
         config->log_ptr->registerLoggers();
+    // In a DaphneLib session, all scripts share the session's context.
+    if (config->session_context != nullptr) {
+        res = config->session_context;
+        return;
+    }
     res = new DaphneContext(*config, *dispatchMapping, *statistics, *stringRefCounter);
 }
@@ -24,5 +24,6 @@
 // ****************************************************************************
 
 static void createDistributedContext(DCTX(ctx)) {
-    ctx->distributed_context = DistributedContext::createDistributedContext(ctx->config);
+    if (!ctx->distributed_context)
+        ctx->distributed_context = DistributedContext::createDistributedContext(ctx->config);
 }
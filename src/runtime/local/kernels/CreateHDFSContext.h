@@ -23,4 +23,7 @@
 // Convenience function
 // ****************************************************************************
 
-static void createHDFSContext(DCTX(ctx)) { ctx->hdfs_context = HDFSContext::createHDFSContext(ctx->config); }
+static void createHDFSContext(DCTX(ctx)) {
+    if (!ctx->hdfs_context)
+        ctx->hdfs_context = HDFSContext::createHDFSContext(ctx->config);
+}
@@ -23,6 +23,10 @@
 // Convenience function
 // ****************************************************************************
 
-void destroyDaphneContext(const DaphneContext *ctx) { delete ctx; }
+void destroyDaphneContext(const DaphneContext *ctx) {
+    // The context of a DaphneLib session outlives the script.
+    if (ctx != ctx->getUserConfig().session_context)
+        delete ctx;
+}
 
 #endif // SRC_RUNTIME_LOCAL_KERNELS_DESTROYDAPHNECONTEXT_H
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/datastructures/ValueTypeCode.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/kernels/PositionList.h>
 
 #include <sstream>
 #include <stdexcept>
@@ -72,7 +73,7 @@ void extractRow(DTRes *&res, const DTArg *arg, const DenseMatrix<VTSel> *sel, DC
 // ----------------------------------------------------------------------------
 
 // 0 (row-wise) or 1 (column-wise)
-#define EXTRACTROW_FRAME_MODE 0
+#define EXTRACTROW_FRAME_MODE 1
 
 template <typename VTSel> struct ExtractRow<Frame, Frame, VTSel> {
     static void apply(Frame *&res, const Frame *arg, const DenseMatrix<VTSel> *sel, DCTX(ctx)) {
@@ -140,7 +141,21 @@ template <typename VTSel> struct ExtractRow<Frame, Frame, VTSel> {
         res->shrinkNumRows(numRowsSel);
 
 #elif EXTRACTROW_FRAME_MODE == 1
-        // TODO Implement a columnar approach.
+        // Check all positions upfront, such that the gathering of the
+        // individual columns does not need to.
+        for (size_t r = 0; r < numRowsSel; r++) {
+            const size_t pos = valuesSel[r];
+            if (valuesSel[r] < 0 || numRowsArg <= pos) {
+                std::ostringstream errMsg;
+                errMsg << "invalid argument '" << valuesSel[r]
+                       << "' passed to ExtractRow: "
+                          "out of bounds for frame with row boundaries '[0, "
+                       << numRowsArg << ")'";
+                throw std::out_of_range(errMsg.str());
+            }
+        }
+        gatherFrameRows(res, arg, valuesSel, numRowsSel);
+        res->shrinkNumRows(numRowsSel);
 #endif
     }
 };
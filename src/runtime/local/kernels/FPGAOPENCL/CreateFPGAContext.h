@@ -26,6 +26,7 @@
 namespace FPGAOPENCL {
 static void createFPGAContext(DCTX(ctx)) {
     // ToDo: one context per device
-    ctx->fpga_contexts.emplace_back(FPGAContext::createFpgaContext(0));
+    if (ctx->fpga_contexts.empty())
+        ctx->fpga_contexts.emplace_back(FPGAContext::createFpgaContext(0));
 }
 } // namespace FPGAOPENCL
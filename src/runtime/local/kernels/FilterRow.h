@@ -24,7 +24,9 @@
 #include <runtime/local/datastructures/Matrix.h>
 #include <runtime/local/datastructures/ValueTypeCode.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/kernels/PositionList.h>
 
+#include <memory>
 #include <stdexcept>
 
 #include <cstddef>
@@ -91,7 +93,7 @@ template <typename VT, typename VTSel> struct FilterRow<DenseMatrix<VT>, DenseMa
 // ----------------------------------------------------------------------------
 
 // 0 (row-wise) or 1 (column-wise)
-#define FILTERROW_FRAME_MODE 0
+#define FILTERROW_FRAME_MODE 1
 
 template <typename VTSel> struct FilterRow<Frame, Frame, VTSel> {
     static void apply(Frame *&res, const Frame *arg, const DenseMatrix<VTSel> *sel, DCTX(ctx)) {
@@ -108,13 +110,19 @@ template <typename VTSel> struct FilterRow<Frame, Frame, VTSel> {
         // Add some padding due to stores in units of 8 bytes (see below). This
         // formula is a little pessimistic, though.
         const size_t numRowsAlloc = numRows + sizeof(uint64_t) / sizeof(uint8_t) - 1;
-#elif FILTERROW_FRAME_MODE == 1
-        const size_t numRowsAlloc = numRows;
-#endif
         if (res == nullptr)
             res = DataObjectFactory::create<Frame>(numRowsAlloc, numCols, schema, arg->getLabels(), false);
 
         const VTSel *valuesSel = sel->getValues();
+#elif FILTERROW_FRAME_MODE == 1
+        // Evaluate the bit vector only once, and gather each column by the
+        // resulting positions. This allocates the result with its exact size
+        // and touches each column in a tight loop.
+        auto pos = std::make_unique<size_t[]>(numRows);
+        const size_t numRowsRes = selToPositions(pos.get(), sel->getValues(), sel->getRowSkip(), numRows);
+        if (res == nullptr)
+            res = DataObjectFactory::create<Frame>(numRowsRes, numCols, schema, arg->getLabels(), false);
+#endif
 
 #if FILTERROW_FRAME_MODE == 0
         // Some information on each column.
@@ -158,7 +166,8 @@ template <typename VTSel> struct FilterRow<Frame, Frame, VTSel> {
         delete[] argCols;
         delete[] resCols;
 #elif FILTERROW_FRAME_MODE == 1
-        // TODO Implement a columnar approach.
+        gatherFrameRows(res, arg, pos.get(), numRowsRes);
+        res->shrinkNumRows(numRowsRes);
 #endif
     }
 };
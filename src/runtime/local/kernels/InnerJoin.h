@@ -20,13 +20,13 @@
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/DictionaryEncoding.h>
 #include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/datastructures/ValueTypeCode.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
 
 #include <stdexcept>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
 #include <cstddef>
@@ -54,20 +54,48 @@ void innerJoinSet(ValueTypeCode vtcType, Frame *&res, const Frame *arg, const in
     }
 }
 
+// Index of the rhs rows by their join key. The keys are dictionary-encoded,
+// such that each key is hashed only once, and the rows with a certain key are
+// found via its code.
+template <typename VTRhs> struct RhsJoinIndex {
+    DictionaryEncoding<VTRhs> keys;
+    std::vector<std::vector<size_t>> rowsByCode;
+
+    explicit RhsJoinIndex(const DenseMatrix<VTRhs> *col) : keys(col), rowsByCode(keys.getNumDistinct()) {
+        const auto *codes = keys.getCodes();
+        for (size_t r = 0; r < keys.getNumRows(); r++)
+            rowsByCode[codes[r]].push_back(r);
+    }
+
+    const std::vector<size_t> *find(const VTRhs &key) const {
+        auto [found, code] = keys.find(key);
+        return found ? &rowsByCode[code] : nullptr;
+    }
+};
+
 // Create a hash table for rhs
-template <typename VTRhs>
-std::unordered_map<VTRhs, std::vector<size_t>> BuildHashRhs(const Frame *rhs, const char *rhsOn,
-                                                            const size_t numRowRhs) {
-    std::unordered_map<VTRhs, std::vector<size_t>> res;
+template <typename VTRhs> RhsJoinIndex<VTRhs> BuildHashRhs(const Frame *rhs, const char *rhsOn) {
     const DenseMatrix<VTRhs> *col = rhs->getColumn<VTRhs>(rhsOn);
-    for (size_t row_idx_r = 0; row_idx_r < numRowRhs; row_idx_r++) {
-        VTRhs key = col->get(row_idx_r, 0);
-        res[key].push_back(row_idx_r);
-    }
+    RhsJoinIndex<VTRhs> res(col);
     DataObjectFactory::destroy(col);
     return res;
 }
 
+// Count the result rows, i.e., the matches of all lhs rows in rhs
+template <typename VT>
+size_t CountMatchesLhs(const Frame *lhs, const char *lhsOn, const RhsJoinIndex<VT> &hashRhsIndex,
+                       const size_t numRowLhs) {
+    auto lhsFKCol = lhs->getColumn<VT>(lhsOn);
+    const VT *keysLhs = lhsFKCol->getValues();
+    const size_t rowSkipLhs = lhsFKCol->getRowSkip();
+    size_t numMatches = 0;
+    for (size_t row_idx_l = 0; row_idx_l < numRowLhs; row_idx_l++)
+        if (const std::vector<size_t> *rowsRhs = hashRhsIndex.find(keysLhs[row_idx_l * rowSkipLhs]))
+            numMatches += rowsRhs->size();
+    DataObjectFactory::destroy(lhsFKCol);
+    return numMatches;
+}
+
 template <typename VT>
 int64_t ProbeHashLhs(
     // results and results schema
@@ -81,18 +109,19 @@ int64_t ProbeHashLhs(
     // context
     DCTX(ctx),
     // hashed map of Rhs
-    std::unordered_map<VT, std::vector<size_t>> hashRhsIndex,
+    const RhsJoinIndex<VT> &hashRhsIndex,
     // Lhs rowa
     const size_t numRowLhs) {
     int64_t row_idx_res = 0;
     int64_t col_idx_res = 0;
     auto lhsFKCol = lhs->getColumn<VT>(lhsOn);
+    const VT *keysLhs = lhsFKCol->getValues();
+    const size_t rowSkipLhs = lhsFKCol->getRowSkip();
     for (size_t row_idx_l = 0; row_idx_l < numRowLhs; row_idx_l++) {
-        auto key = lhsFKCol->get(row_idx_l, 0);
-        auto it = hashRhsIndex.find(key);
+        const std::vector<size_t> *rowsRhs = hashRhsIndex.find(keysLhs[row_idx_l * rowSkipLhs]);
 
-        if (it != hashRhsIndex.end()) {
-            for (size_t row_idx_r : it->second) {
+        if (rowsRhs) {
+            for (size_t row_idx_r : *rowsRhs) {
                 col_idx_res = 0;
 
                 // Populate result row from lhs columns
@@ -128,6 +157,24 @@ int64_t ProbeHashLhs(
     return row_idx_res;
 }
 
+// Join lhs and rhs on keys of value type VT
+template <typename VT>
+int64_t InnerJoinOn(Frame *&res, ValueTypeCode *schema, std::string *labels, const Frame *lhs, const Frame *rhs,
+                    const char *lhsOn, const char *rhsOn, int64_t numRowRes, DCTX(ctx)) {
+    const size_t numRowLhs = lhs->getNumRows();
+    const size_t numColRhs = rhs->getNumCols();
+    const size_t numColLhs = lhs->getNumCols();
+
+    const RhsJoinIndex<VT> hashRhsIndex = BuildHashRhs<VT>(rhs, rhsOn);
+    // Without a given result size, count the matches instead of allocating
+    // the size of the cross product.
+    const size_t totalRows =
+        numRowRes == -1 ? CountMatchesLhs<VT>(lhs, lhsOn, hashRhsIndex, numRowLhs) : static_cast<size_t>(numRowRes);
+    res = DataObjectFactory::create<Frame>(totalRows, numColLhs + numColRhs, schema, labels, false);
+
+    return ProbeHashLhs<VT>(res, schema, lhs, rhs, lhsOn, numColRhs, numColLhs, ctx, hashRhsIndex, numRowLhs);
+}
+
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
@@ -147,9 +194,6 @@ inline void innerJoin(
     ValueTypeCode vtcLhsOn = lhs->getColumnType(lhsOn);
 
     // Perhaps check if res already allocated.
-    const size_t numRowRhs = rhs->getNumRows();
-    const size_t numRowLhs = lhs->getNumRows();
-    const size_t totalRows = numRowRes == -1 ? numRowRhs * numRowLhs : numRowRes;
     const size_t numColRhs = rhs->getNumCols();
     const size_t numColLhs = lhs->getNumCols();
     const size_t totalCols = numColRhs + numColLhs;
@@ -172,17 +216,11 @@ inline void innerJoin(
         newlabels[col_idx_res++] = oldlabels_r[col_idx_r];
     }
 
-    // Initialize result frame with an estimate
-    res = DataObjectFactory::create<Frame>(totalRows, totalCols, schema, newlabels, false);
-
     // Build hash table and prob left table
-    if (vtcLhsOn == ValueTypeCode::STR) {
-        row_idx_res = ProbeHashLhs<std::string>(res, schema, lhs, rhs, lhsOn, numColRhs, numColLhs, ctx,
-                                                BuildHashRhs<std::string>(rhs, rhsOn, numRowRhs), numRowLhs);
-    } else {
-        row_idx_res = ProbeHashLhs<int64_t>(res, schema, lhs, rhs, lhsOn, numColRhs, numColLhs, ctx,
-                                            BuildHashRhs<int64_t>(rhs, rhsOn, numRowRhs), numRowLhs);
-    }
+    if (vtcLhsOn == ValueTypeCode::STR)
+        row_idx_res = InnerJoinOn<std::string>(res, schema, newlabels, lhs, rhs, lhsOn, rhsOn, numRowRes, ctx);
+    else
+        row_idx_res = InnerJoinOn<int64_t>(res, schema, newlabels, lhs, rhs, lhsOn, rhsOn, numRowRes, ctx);
     // Shrink result frame to actual size
     res->shrinkNumRows(row_idx_res);
 }
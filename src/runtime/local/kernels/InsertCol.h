@@ -34,17 +34,26 @@
 
 template <class DTArg, class DTIns, typename VTSel> struct InsertCol {
     static void apply(DTArg *&res, const DTArg *arg, const DTIns *ins, const VTSel colLowerIncl,
-                      const VTSel colUpperExcl, DCTX(ctx)) = delete;
+                      const VTSel colUpperExcl, bool mayReuseArg, DCTX(ctx)) = delete;
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
+/**
+ * @brief Copies `arg` to `res` and replaces the columns `[colLowerIncl,
+ * colUpperExcl)` by `ins`.
+ *
+ * If `mayReuseArg` is `true`, the caller guarantees that `arg` is not used
+ * after this call. Then, the kernel may update `arg` in place and return it as
+ * `res` (with an increased reference counter), provided that nothing else
+ * refers to `arg` or its values.
+ */
 template <class DTArg, class DTIns, typename VTSel>
 void insertCol(DTArg *&res, const DTArg *arg, const DTIns *ins, const VTSel colLowerIncl, const VTSel colUpperExcl,
-               DCTX(ctx)) {
-    InsertCol<DTArg, DTIns, VTSel>::apply(res, arg, ins, colLowerIncl, colUpperExcl, ctx);
+               bool mayReuseArg, DCTX(ctx)) {
+    InsertCol<DTArg, DTIns, VTSel>::apply(res, arg, ins, colLowerIncl, colUpperExcl, mayReuseArg, ctx);
 }
 
 // ****************************************************************************
@@ -95,7 +104,7 @@ void validateArgsInsertCol(size_t colLowerIncl_Size, VTSel colLowerIncl, size_t
 
 template <typename VTArg, typename VTSel> struct InsertCol<DenseMatrix<VTArg>, DenseMatrix<VTArg>, VTSel> {
     static void apply(DenseMatrix<VTArg> *&res, const DenseMatrix<VTArg> *arg, const DenseMatrix<VTArg> *ins,
-                      VTSel colLowerIncl, VTSel colUpperExcl, DCTX(ctx)) {
+                      VTSel colLowerIncl, VTSel colUpperExcl, bool mayReuseArg, DCTX(ctx)) {
         const size_t numRowsArg = arg->getNumRows();
         const size_t numColsArg = arg->getNumCols();
         const size_t numRowsIns = ins->getNumRows();
@@ -107,15 +116,31 @@ template <typename VTArg, typename VTSel> struct InsertCol<DenseMatrix<VTArg>, D
         validateArgsInsertCol(colLowerIncl_Size, colLowerIncl, colUpperExcl_Size, colUpperExcl, numRowsArg, numColsArg,
                               numRowsIns, numColsIns);
 
+        const VTArg *valuesIns = ins->getValues();
+        const size_t rowSkipIns = ins->getRowSkip();
+
+        if (res == nullptr && mayReuseArg && ins != arg && arg->isExclusivelyOwned()) {
+            // Only the addressed columns change, all others are already in
+            // place.
+            res = const_cast<DenseMatrix<VTArg> *>(arg);
+            res->increaseRefCounter();
+            const size_t rowSkipRes = res->getRowSkip();
+            VTArg *valuesRes = res->getValues() + colLowerIncl_Size;
+            for (size_t r = 0; r < numRowsArg; r++) {
+                std::copy(valuesIns, valuesIns + numColsIns, valuesRes);
+                valuesRes += rowSkipRes;
+                valuesIns += rowSkipIns;
+            }
+            return;
+        }
+
         if (res == nullptr)
             res = DataObjectFactory::create<DenseMatrix<VTArg>>(numRowsArg, numColsArg, false);
 
         VTArg *valuesRes = res->getValues();
         const VTArg *valuesArg = arg->getValues();
-        const VTArg *valuesIns = ins->getValues();
         const size_t rowSkipRes = res->getRowSkip();
         const size_t rowSkipArg = arg->getRowSkip();
-        const size_t rowSkipIns = ins->getRowSkip();
 
         // TODO Can be simplified/more efficient in certain cases.
         for (size_t r = 0; r < numRowsArg; r++) {
@@ -135,7 +160,7 @@ template <typename VTArg, typename VTSel> struct InsertCol<DenseMatrix<VTArg>, D
 
 template <typename VTArg, typename VTSel> struct InsertCol<Matrix<VTArg>, Matrix<VTArg>, VTSel> {
     static void apply(Matrix<VTArg> *&res, const Matrix<VTArg> *arg, const Matrix<VTArg> *ins, VTSel colLowerIncl,
-                      VTSel colUpperExcl, DCTX(ctx)) {
+                      VTSel colUpperExcl, bool mayReuseArg, DCTX(ctx)) {
         const size_t numRowsArg = arg->getNumRows();
         const size_t numColsArg = arg->getNumCols();
 
@@ -34,17 +34,26 @@
 
 template <class DTArg, class DTIns, typename VTSel> struct InsertRow {
     static void apply(DTArg *&res, const DTArg *arg, const DTIns *ins, const VTSel rowLowerIncl,
-                      const VTSel rowUpperExcl, DCTX(ctx)) = delete;
+                      const VTSel rowUpperExcl, bool mayReuseArg, DCTX(ctx)) = delete;
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
+/**
+ * @brief Copies `arg` to `res` and replaces the rows `[rowLowerIncl,
+ * rowUpperExcl)` by `ins`.
+ *
+ * If `mayReuseArg` is `true`, the caller guarantees that `arg` is not used
+ * after this call. Then, the kernel may update `arg` in place and return it as
+ * `res` (with an increased reference counter), provided that nothing else
+ * refers to `arg` or its values.
+ */
 template <class DTArg, class DTIns, typename VTSel>
 void insertRow(DTArg *&res, const DTArg *arg, const DTIns *ins, const VTSel rowLowerIncl, const VTSel rowUpperExcl,
-               DCTX(ctx)) {
-    InsertRow<DTArg, DTIns, VTSel>::apply(res, arg, ins, rowLowerIncl, rowUpperExcl, ctx);
+               bool mayReuseArg, DCTX(ctx)) {
+    InsertRow<DTArg, DTIns, VTSel>::apply(res, arg, ins, rowLowerIncl, rowUpperExcl, mayReuseArg, ctx);
 }
 
 // ****************************************************************************
@@ -95,7 +104,7 @@ void validateArgsInsertRow(size_t rowLowerIncl_Size, VTSel rowLowerIncl, size_t
 
 template <typename VT, typename VTSel> struct InsertRow<DenseMatrix<VT>, DenseMatrix<VT>, VTSel> {
     static void apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, const DenseMatrix<VT> *ins, VTSel rowLowerIncl,
-                      VTSel rowUpperExcl, DCTX(ctx)) {
+                      VTSel rowUpperExcl, bool mayReuseArg, DCTX(ctx)) {
         const size_t numRowsArg = arg->getNumRows();
         const size_t numColsArg = arg->getNumCols();
         const size_t numRowsIns = ins->getNumRows();
@@ -107,15 +116,30 @@ template <typename VT, typename VTSel> struct InsertRow<DenseMatrix<VT>, DenseMa
         validateArgsInsertRow(rowLowerIncl_Size, rowLowerIncl, rowUpperExcl_Size, rowUpperExcl, numRowsArg, numColsArg,
                               numRowsIns, numColsIns);
 
+        const VT *valuesIns = ins->getValues();
+        const size_t rowSkipIns = ins->getRowSkip();
+
+        if (res == nullptr && mayReuseArg && ins != arg && arg->isExclusivelyOwned()) {
+            // Only the addressed rows change, all others are already in place.
+            res = const_cast<DenseMatrix<VT> *>(arg);
+            res->increaseRefCounter();
+            const size_t rowSkipRes = res->getRowSkip();
+            VT *valuesRes = res->getValues() + rowLowerIncl_Size * rowSkipRes;
+            for (size_t r = rowLowerIncl_Size; r < rowUpperExcl_Size; r++) {
+                std::copy(valuesIns, valuesIns + numColsArg, valuesRes);
+                valuesRes += rowSkipRes;
+                valuesIns += rowSkipIns;
+            }
+            return;
+        }
+
         if (res == nullptr)
             res = DataObjectFactory::create<DenseMatrix<VT>>(numRowsArg, numColsArg, false);
 
         VT *valuesRes = res->getValues();
         const VT *valuesArg = arg->getValues();
-        const VT *valuesIns = ins->getValues();
         const size_t rowSkipRes = res->getRowSkip();
         const size_t rowSkipArg = arg->getRowSkip();
-        const size_t rowSkipIns = ins->getRowSkip();
 
         // TODO Can be simplified/more efficient in certain cases.
         for (size_t r = 0; r < rowLowerIncl_Size; r++) {
@@ -143,7 +167,7 @@ template <typename VT, typename VTSel> struct InsertRow<DenseMatrix<VT>, DenseMa
 
 template <typename VT, typename VTSel> struct InsertRow<Matrix<VT>, Matrix<VT>, VTSel> {
     static void apply(Matrix<VT> *&res, const Matrix<VT> *arg, const Matrix<VT> *ins, VTSel rowLowerIncl,
-                      VTSel rowUpperExcl, DCTX(ctx)) {
+                      VTSel rowUpperExcl, bool mayReuseArg, DCTX(ctx)) {
         const size_t numRowsArg = arg->getNumRows();
         const size_t numColsArg = arg->getNumCols();
 
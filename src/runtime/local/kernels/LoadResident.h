@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/context/ResidentObjectStore.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <cstddef>
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Returns the data object stored under the given name in the resident
+ * object store of the current DaphneLib session.
+ *
+ * The type of the result is determined when the script is compiled. If the
+ * object was replaced by one of a different type since then, an exception is
+ * thrown.
+ *
+ * @param schema The column types of a frame result the script was compiled
+ * for; ignored for matrices, whose value type is part of `DTRes`.
+ * @param numCols The number of elements in `schema`.
+ * @param labels The column labels of a frame result the script was compiled
+ * for; ignored for matrices.
+ * @param numLabels The number of elements in `labels`, zero if unknown.
+ */
+template <class DTRes>
+void loadResident(DTRes *&res, const char *name, const ValueTypeCode *schema, size_t numCols, const char **labels,
+                  size_t numLabels, DCTX(ctx)) {
+    ResidentObjectStore *store = ctx->getUserConfig().resident_objects;
+    if (!store)
+        throw std::runtime_error("loadResident(): resident objects are only available in a DaphneLib session");
+    // The result is a new reference to the object.
+    Structure *obj = store->acquire(name);
+    res = dynamic_cast<DTRes *>(obj);
+    bool matches = res != nullptr;
+    if constexpr (std::is_same_v<DTRes, Frame>) {
+        if (matches) {
+            matches = res->getNumCols() == numCols && std::equal(schema, schema + numCols, res->getSchema());
+            if (matches && numLabels) {
+                auto eq = [](const char *l, const std::string &r) { return r == l; };
+                matches = numLabels == numCols && std::equal(labels, labels + numLabels, res->getLabels(), eq);
+            }
+        }
+    }
+    if (!matches) {
+        DataObjectFactory::destroy(obj);
+        res = nullptr;
+        throw std::runtime_error("loadResident(): the type of the resident object '" + std::string(name) +
+                                 "' changed since the script was compiled");
+    }
+}
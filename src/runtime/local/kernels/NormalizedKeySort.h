@@ -0,0 +1,299 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/kernels/ParallelFor.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Sorts rows by multiple key columns using normalized keys and a
+ * stable LSD radix sort.
+ *
+ * Each key column is first mapped to unsigned integers whose unsigned order
+ * equals the requested order of the values (sign bit flipped for signed
+ * integers, IEEE-754 bit tricks for floating-point values, complemented for
+ * descending order). The minimum of each column is subtracted, such that a
+ * column only needs as many bits as its value range; the keys of consecutive
+ * columns are then packed into as few 64-bit words as possible. Sorting
+ * compares integers only and is independent of the number of key columns,
+ * unlike comparison sorts with one column per pass.
+ *
+ * The sort is stable, i.e., rows with equal keys keep their input order.
+ * Floating-point `-0.0` and `+0.0` are considered equal, and all NaNs are
+ * considered equal and greater than any other value. Thus, NaNs come last in
+ * ascending and first in descending order.
+ *
+ * Usage: add the key columns in order of decreasing significance via
+ * `addKey()`, then call `sort()` or `topK()`.
+ */
+class NormalizedKeySort {
+    size_t numRows;
+    /**
+     * @brief The normalized key per key column and row, reduced by the
+     * minimum of the column.
+     */
+    std::vector<std::vector<uint64_t>> keys;
+    /**
+     * @brief The number of bits required by each key column, `0` if the
+     * column is constant.
+     */
+    std::vector<unsigned> bits;
+
+    template <typename VT> static uint64_t normalize(VT v) {
+        if constexpr (std::is_floating_point_v<VT>) {
+            using UT = std::conditional_t<sizeof(VT) == 4, uint32_t, uint64_t>;
+            constexpr UT signBit = UT(1) << (sizeof(VT) * 8 - 1);
+            if (std::isnan(v))
+                v = std::numeric_limits<VT>::quiet_NaN();
+            else if (v == VT(0))
+                v = VT(0);
+            const UT u = std::bit_cast<UT>(v);
+            return static_cast<uint64_t>((u & signBit) ? UT(~u) : UT(u | signBit));
+        } else if constexpr (std::is_signed_v<VT>)
+            return static_cast<uint64_t>(static_cast<int64_t>(v)) ^ (uint64_t(1) << 63);
+        else
+            return static_cast<uint64_t>(v);
+    }
+
+    /**
+     * @brief A group of consecutive key columns packed into one 64-bit word.
+     */
+    struct Word {
+        size_t firstKey;
+        size_t lastKey;
+        unsigned numBits;
+    };
+
+    uint64_t pack(const Word &w, size_t row) const {
+        uint64_t res = 0;
+        for (size_t k = w.firstKey; k < w.lastKey; k++)
+            if (bits[k])
+                res = (bits[k] == 64 ? 0 : res << bits[k]) | keys[k][row];
+        return res;
+    }
+
+    std::vector<Word> packWords() const {
+        std::vector<Word> words;
+        for (size_t k = 0; k < keys.size(); k++) {
+            if (!bits[k])
+                continue;
+            if (words.empty() || words.back().numBits + bits[k] > 64)
+                words.push_back({k, k + 1, bits[k]});
+            else {
+                words.back().lastKey = k + 1;
+                words.back().numBits += bits[k];
+            }
+        }
+        return words;
+    }
+
+  public:
+    explicit NormalizedKeySort(size_t numRows) : numRows(numRows) {}
+
+    /**
+     * @brief Adds the next (less significant) key column.
+     *
+     * @param values Pointer to the value of the first row.
+     * @param rowSkip The distance between the values of consecutive rows.
+     * @param ascending Whether to sort this column in ascending order.
+     */
+    template <typename VT> void addKey(const VT *values, size_t rowSkip, bool ascending) {
+        static_assert(std::is_arithmetic_v<VT>, "NormalizedKeySort supports only numeric key columns");
+        std::vector<uint64_t> col(numRows);
+        uint64_t minKey = std::numeric_limits<uint64_t>::max();
+        uint64_t maxKey = 0;
+        for (size_t r = 0; r < numRows; r++) {
+            const uint64_t u = normalize(values[r * rowSkip]);
+            col[r] = ascending ? u : ~u;
+            minKey = std::min(minKey, col[r]);
+            maxKey = std::max(maxKey, col[r]);
+        }
+        const uint64_t range = numRows ? maxKey - minKey : 0;
+        if (range)
+            for (size_t r = 0; r < numRows; r++)
+                col[r] -= minKey;
+        else
+            col.clear();
+        keys.push_back(std::move(col));
+        bits.push_back(static_cast<unsigned>(std::bit_width(range)));
+    }
+
+    /**
+     * @brief Sorts the rows by all key columns added so far.
+     *
+     * @param perm Output array of `numRows` elements, which receives the row
+     * indices in sorted order.
+     * @param groups If not `nullptr`, the half-open position ranges in `perm`
+     * of the runs of at least two rows with equal keys are appended in
+     * ascending order.
+     */
+    void sort(size_t *perm, std::vector<std::pair<size_t, size_t>> *groups, DCTX(ctx)) const {
+        const std::vector<Word> words = packWords();
+        size_t numDigits = 0;
+        for (const Word &w : words)
+            numDigits += (w.numBits + 7) / 8;
+        const size_t numThreads = getNumKernelThreads(numRows, numRows * std::max<size_t>(numDigits, 1), ctx);
+
+        std::vector<size_t> idx(numRows);
+        std::iota(idx.begin(), idx.end(), 0);
+        if (!words.empty()) {
+            std::vector<size_t> idxTmp(numRows);
+            std::vector<uint64_t> cur(numRows);
+            std::vector<uint64_t> tmp(numRows);
+            std::vector<std::array<size_t, 256>> hist(numThreads);
+
+            // LSD radix sort: least significant word first, each word by 8-bit
+            // digits. Every pass is stable, so is the whole sort.
+            for (size_t w = words.size(); w-- > 0;) {
+                parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t) {
+                    for (size_t i = begin; i < end; i++)
+                        cur[i] = pack(words[w], idx[i]);
+                });
+                for (unsigned shift = 0; shift < words[w].numBits; shift += 8) {
+                    parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t t) {
+                        auto &h = hist[t];
+                        h.fill(0);
+                        for (size_t i = begin; i < end; i++)
+                            h[(cur[i] >> shift) & 0xFF]++;
+                    });
+                    // Turn the per-thread counts into per-thread start
+                    // positions; skip the pass if all rows share the digit.
+                    bool trivial = false;
+                    size_t pos = 0;
+                    for (size_t d = 0; d < 256; d++) {
+                        const size_t start = pos;
+                        for (auto &h : hist) {
+                            const size_t cnt = h[d];
+                            h[d] = pos;
+                            pos += cnt;
+                        }
+                        trivial |= pos - start == numRows;
+                    }
+                    if (trivial)
+                        continue;
+                    parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t t) {
+                        auto &h = hist[t];
+                        for (size_t i = begin; i < end; i++) {
+                            const size_t p = h[(cur[i] >> shift) & 0xFF]++;
+                            tmp[p] = cur[i];
+                            idxTmp[p] = idx[i];
+                        }
+                    });
+                    cur.swap(tmp);
+                    idx.swap(idxTmp);
+                }
+            }
+        }
+        std::copy(idx.begin(), idx.end(), perm);
+
+        if (groups == nullptr || numRows < 2)
+            return;
+        // Mark the positions whose keys equal those of their predecessor,
+        // then collect the runs of such positions.
+        std::vector<uint8_t> same(numRows, 0);
+        parallelFor(numRows - 1, numThreads, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin + 1; i < end + 1; i++) {
+                bool eq = true;
+                for (size_t k = 0; k < keys.size() && eq; k++)
+                    eq = !bits[k] || keys[k][idx[i]] == keys[k][idx[i - 1]];
+                same[i] = eq;
+            }
+        });
+        for (size_t i = 1; i < numRows; i++) {
+            if (!same[i])
+                continue;
+            const size_t first = i - 1;
+            while (i < numRows && same[i])
+                i++;
+            groups->emplace_back(first, i);
+        }
+    }
+
+    /**
+     * @brief Determines the first `k` rows in the order of `sort()` without
+     * sorting all rows.
+     *
+     * Each thread keeps the first `k` rows of its part of the input in a heap,
+     * and the heaps are merged at the end. If `k` is not much smaller than the
+     * number of rows, all rows are sorted instead.
+     *
+     * @param k The number of rows to determine, at most the number of rows.
+     * @param perm Output array of `k` elements, which receives the indices of
+     * the first `k` rows in sorted order.
+     */
+    void topK(size_t k, size_t *perm, DCTX(ctx)) const {
+        k = std::min(k, numRows);
+        if (k == 0)
+            return;
+        if (k > numRows / 16) {
+            std::vector<size_t> all(numRows);
+            sort(all.data(), nullptr, ctx);
+            std::copy_n(all.begin(), k, perm);
+            return;
+        }
+
+        const std::vector<Word> words = packWords();
+        // Ties are broken by the row index, which keeps the order stable.
+        auto before = [&](size_t i, size_t j) {
+            for (const Word &w : words) {
+                const uint64_t a = pack(w, i);
+                const uint64_t b = pack(w, j);
+                if (a != b)
+                    return a < b;
+            }
+            return i < j;
+        };
+
+        const size_t numThreads = getNumKernelThreads(numRows, numRows, ctx);
+        // Max-heaps w.r.t. the order, i.e., the front is the last row kept.
+        std::vector<std::vector<size_t>> heaps(numThreads);
+        parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t t) {
+            auto &heap = heaps[t];
+            heap.reserve(std::min(k, end - begin));
+            for (size_t r = begin; r < end; r++) {
+                if (heap.size() < k) {
+                    heap.push_back(r);
+                    std::push_heap(heap.begin(), heap.end(), before);
+                } else if (before(r, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), before);
+                    heap.back() = r;
+                    std::push_heap(heap.begin(), heap.end(), before);
+                }
+            }
+        });
+
+        std::vector<size_t> candidates;
+        candidates.reserve(numThreads * k);
+        for (const auto &heap : heaps)
+            candidates.insert(candidates.end(), heap.begin(), heap.end());
+        std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end(), before);
+        std::copy_n(candidates.begin(), k, perm);
+    }
+};
@@ -19,10 +19,12 @@
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/DictionaryEncoding.h>
 #include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/datastructures/ValueTypeCode.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
 #include <runtime/local/kernels/ExtractRow.h>
+#include <runtime/local/kernels/NormalizedKeySort.h>
 #include <util/DeduceType.h>
 
 #include <algorithm>
@@ -59,25 +61,7 @@ void order(DTRes *&res, const DTArg *arg, size_t *colIdxs, size_t numColIdxs, bo
 // ****************************************************************************
 
 // sorts input idx DenseMatrix within the index ranges in the input groups
-// vector on the values of the input column (column with id colIdx in
-// DenseMatrix arg; id 0 for column matrices)
-template <typename VTIdx, typename VT>
-void columnIDSort(DenseMatrix<VTIdx> *&idx, const DenseMatrix<VT> *arg, size_t colIdx,
-                  std::vector<std::pair<VTIdx, VTIdx>> &groups, bool ascending, DCTX(ctx)) {
-    VTIdx *indices = idx->getValues();
-    const VT *values = arg->getValues();
-    const size_t rowSkip = arg->getRowSkip();
-    auto compare = ascending ? std::function{[&values, rowSkip, colIdx](VTIdx i, VTIdx j) {
-        return values[i * rowSkip + colIdx] < values[j * rowSkip + colIdx];
-    }}
-                             : std::function{[&values, rowSkip, colIdx](VTIdx i, VTIdx j) {
-                                   return values[i * rowSkip + colIdx] > values[j * rowSkip + colIdx];
-                               }};
-    for (const auto &group : groups)
-        std::stable_sort(indices + group.first, indices + group.second, compare);
-}
-
-// function overload for generic Matrix type
+// vector on the values of the input column (column with id colIdx in arg)
 template <typename VTIdx, typename VT>
 void columnIDSort(DenseMatrix<VTIdx> *&idx, const Matrix<VT> *arg, size_t colIdx,
                   std::vector<std::pair<VTIdx, VTIdx>> &groups, bool ascending, DCTX(ctx)) {
@@ -90,15 +74,6 @@ void columnIDSort(DenseMatrix<VTIdx> *&idx, const Matrix<VT> *arg, size_t colIdx
         std::stable_sort(indices + group.first, indices + group.second, compare);
 }
 
-template <typename VT> VT *nextWithRowskip(VT *&first, VT *&last, const size_t rowSkip) {
-    for (VT *next = first; next != last; next += rowSkip) {
-        if (*next != *first)
-            return next;
-    }
-    return last;
-}
-
-// function overload for generic Matrix type
 template <typename VT>
 size_t nextWithRowskip(const size_t firstIdx, const size_t lastIdx, const size_t colIdx, Matrix<VT> *arg) {
     const VT firstVal = arg->get(firstIdx, colIdx);
@@ -111,29 +86,8 @@ size_t nextWithRowskip(const size_t firstIdx, const size_t lastIdx, const size_t
 
 // scans a column for groups of duplicates (stored as VTIdx pairs forming index
 // ranges) performed only within the index ranges in the input groups vector on
-// the values of the input column (DenseMatrix) replaces the groups in the input
-// vector with the groups found during the scan
-template <typename VTIdx, typename VT>
-void columnGroupScan(std::vector<std::pair<VTIdx, VTIdx>> &groups, DenseMatrix<VT> *col, const size_t colIdx,
-                     DCTX(ctx)) {
-    const size_t numOldGroups = groups.size();
-    VT *values = col->getValues();
-    const size_t rowSkip = col->getRowSkip();
-    for (size_t g = 0; g < numOldGroups; g++) {
-        VT *first = values + groups[g].first * rowSkip + colIdx;
-        VT *last = values + groups[g].second * rowSkip + colIdx;
-        while (first != last) {
-            VT *next = nextWithRowskip<VT>(first, last, rowSkip);
-            if ((size_t)(next - first) > rowSkip)
-                groups.push_back(
-                    std::make_pair((first - values - colIdx) / rowSkip, (next - values - colIdx) / rowSkip));
-            first = next;
-        }
-    }
-    groups.erase(groups.begin(), groups.begin() + numOldGroups);
-}
-
-// function overload for generic Matrix type
+// the values of the input column, replaces the groups in the input vector with
+// the groups found during the scan
 template <typename VTIdx, typename VT>
 void columnGroupScan(std::vector<std::pair<VTIdx, VTIdx>> &groups, Matrix<VT> *col, const size_t colIdx, DCTX(ctx)) {
     const size_t numOldGroups = groups.size();
@@ -167,20 +121,22 @@ void multiColumnIDSort(DenseMatrix<VTIdx> *&idx, const DTCol *col, size_t colIdx
 //  Frame order structs
 // ----------------------------------------------------------------------------
 
-template <typename VTCol> struct ColumnIDSort {
-    static void apply(const Frame *arg, DenseMatrix<size_t> *&idx, std::vector<std::pair<size_t, size_t>> &groups,
-                      bool ascending, size_t colIdx, DCTX(ctx)) {
-        columnIDSort(idx, arg->getColumn<VTCol>(colIdx), 0, groups, ascending, ctx);
+template <typename VTCol> struct AddNormalizedKey {
+    static void apply(NormalizedKeySort &sorter, const Frame *arg, size_t colIdx, bool ascending) {
+        auto col = arg->getColumn<VTCol>(colIdx);
+        sorter.addKey(col->getValues(), col->getRowSkip(), ascending);
+        DataObjectFactory::destroy(col);
     }
 };
 
-// sorts IDs inside groups by the key column, reorder the column via a row
-// extraction into a temporary DenseMatrix and then scan for groups of
-// duplicates to be tie broken by another subsequent key column
-template <typename VTCol> struct MultiColumnIDSort {
-    static void apply(const Frame *arg, DenseMatrix<size_t> *&idx, std::vector<std::pair<size_t, size_t>> &groups,
-                      bool ascending, size_t colIdx, DCTX(ctx)) {
-        multiColumnIDSort(idx, arg->getColumn<VTCol>(colIdx), 0, groups, ascending, ctx);
+// String columns are sorted on their order-preserving dictionary codes, such
+// that the sort compares integers instead of strings.
+template <> struct AddNormalizedKey<std::string> {
+    static void apply(NormalizedKeySort &sorter, const Frame *arg, size_t colIdx, bool ascending) {
+        auto col = arg->getColumn<std::string>(colIdx);
+        DictionaryEncoding<std::string> enc(col, 0, true);
+        sorter.addKey(enc.getCodes(), 1, ascending);
+        DataObjectFactory::destroy(col);
     }
 };
 
@@ -189,39 +145,16 @@ struct OrderFrame {
                       size_t numAscending, std::vector<std::pair<size_t, size_t>> *groupsRes, DCTX(ctx)) {
         size_t numRows = arg->getNumRows();
         idx = DataObjectFactory::create<DenseMatrix<size_t>>(numRows, 1, false);
-        auto indices = idx->getValues();
-        std::iota(indices, indices + numRows, 0);
 
-        std::vector<std::pair<size_t, size_t>> groups;
-        groups.push_back(std::make_pair(0, numRows));
-
-        if (numColIdxs > 1) {
-            for (size_t i = 0; i < numColIdxs - 1; i++) {
-                if (arg->getSchema()[colIdxs[i]] == ValueTypeCode::STR)
-                    MultiColumnIDSort<std::string>::apply(arg, idx, groups, ascending[i], colIdxs[i], ctx);
-                else
-                    DeduceValueTypeAndExecute<MultiColumnIDSort>::apply(arg->getSchema()[colIdxs[i]], arg, idx, groups,
-                                                                        ascending[i], colIdxs[i], ctx);
-            }
-        }
-
-        // efficient last sort pass OR finalizing the groups vector for further
-        // use
-        size_t colIdx = colIdxs[numColIdxs - 1];
-        if (groupsRes == nullptr) {
-            if (arg->getSchema()[colIdx] == ValueTypeCode::STR)
-                ColumnIDSort<std::string>::apply(arg, idx, groups, ascending[numColIdxs - 1], colIdx, ctx);
-            else
-                DeduceValueTypeAndExecute<ColumnIDSort>::apply(arg->getSchema()[colIdx], arg, idx, groups,
-                                                               ascending[numColIdxs - 1], colIdx, ctx);
-        } else {
-            if (arg->getSchema()[colIdx] == ValueTypeCode::STR)
-                MultiColumnIDSort<std::string>::apply(arg, idx, groups, ascending[numColIdxs - 1], colIdx, ctx);
+        NormalizedKeySort sorter(numRows);
+        for (size_t i = 0; i < numColIdxs; i++) {
+            const ValueTypeCode vtc = arg->getSchema()[colIdxs[i]];
+            if (vtc == ValueTypeCode::STR)
+                AddNormalizedKey<std::string>::apply(sorter, arg, colIdxs[i], ascending[i]);
             else
-                DeduceValueTypeAndExecute<MultiColumnIDSort>::apply(arg->getSchema()[colIdx], arg, idx, groups,
-                                                                    ascending[numColIdxs - 1], colIdx, ctx);
-            groupsRes->insert(groupsRes->end(), groups.begin(), groups.end());
+                DeduceValueTypeAndExecute<AddNormalizedKey>::apply(vtc, sorter, arg, colIdxs[i], ascending[i]);
         }
+        sorter.sort(idx->getValues(), groupsRes, ctx);
     }
 };
 
@@ -280,23 +213,10 @@ template <typename VTRes, typename VTArg> struct Order<DenseMatrix<VTRes>, Dense
         }
 
         auto idx = DataObjectFactory::create<DenseMatrix<size_t>>(numRows, 1, false);
-        auto indices = idx->getValues();
-        std::iota(indices, indices + numRows, 0);
-        std::vector<std::pair<size_t, size_t>> groups;
-        groups.push_back(std::make_pair(0, numRows));
-
-        if (numColIdxs > 1) {
-            for (size_t i = 0; i < numColIdxs - 1; i++) {
-                multiColumnIDSort(idx, arg, colIdxs[i], groups, ascending[i], ctx);
-            }
-        }
-
-        if (groupsRes == nullptr) {
-            columnIDSort(idx, arg, colIdxs[numColIdxs - 1], groups, ascending[numColIdxs - 1], ctx);
-        } else {
-            multiColumnIDSort(idx, arg, colIdxs[numColIdxs - 1], groups, ascending[numColIdxs - 1], ctx);
-            groupsRes->insert(groupsRes->end(), groups.begin(), groups.end());
-        }
+        NormalizedKeySort sorter(numRows);
+        for (size_t i = 0; i < numColIdxs; i++)
+            sorter.addKey(arg->getValues() + colIdxs[i], arg->getRowSkip(), ascending[i]);
+        sorter.sort(idx->getValues(), groupsRes, ctx);
 
         if (returnIdx) {
             res = (DenseMatrix<VTRes> *)idx;
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+/**
+ * @brief Minimum amount of work (roughly the number of scalar operations) for
+ * which a kernel is split across multiple threads.
+ */
+constexpr size_t MIN_WORK_PARALLEL = size_t(1) << 20;
+
+/**
+ * @brief Whether the calling thread is a worker of a vectorized pipeline.
+ *
+ * Set by the workers of the vectorized engine (see `WorkerCPU`) for their
+ * whole lifetime.
+ */
+inline thread_local bool insideVectorizedPipeline = false;
+
+/**
+ * @brief Determines the number of threads a kernel uses for the given number
+ * of independent tasks and total amount of work.
+ *
+ * If the kernel runs inside a vectorized pipeline, the pipeline already keeps
+ * all cores busy, so we stay single-threaded to avoid oversubscription.
+ */
+inline size_t getNumKernelThreads(size_t numTasks, size_t work, DCTX(ctx)) {
+    if (numTasks < 2 || work < MIN_WORK_PARALLEL || ctx == nullptr || insideVectorizedPipeline)
+        return 1;
+    const int numThreads = ctx->config.numberOfThreads;
+    const size_t n =
+        numThreads > 0 ? static_cast<size_t>(numThreads) : std::max(1u, std::thread::hardware_concurrency());
+    return std::min(n, numTasks);
+}
+
+/**
+ * @brief Runs `func(begin, end, threadIdx)` for contiguous blocks of the tasks
+ * `[0, numTasks)` on up to `numThreads` threads.
+ *
+ * `threadIdx` is in `[0, numThreads)` and can be used to index per-thread
+ * scratch buffers.
+ */
+template <class Func> void parallelFor(size_t numTasks, size_t numThreads, Func func) {
+    numThreads = std::min(numThreads, numTasks);
+    if (numThreads <= 1) {
+        func(0, numTasks, 0);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    const size_t block = (numTasks + numThreads - 1) / numThreads;
+    for (size_t t = 1; t < numThreads; t++) {
+        const size_t begin = std::min(t * block, numTasks);
+        const size_t end = std::min(begin + block, numTasks);
+        threads.emplace_back(func, begin, end, t);
+    }
+    func(0, std::min(block, numTasks), 0);
+    for (auto &t : threads)
+        t.join();
+}
@@ -15,8 +15,11 @@
  */
 
 #include "Pooling.h"
+#include "ParallelFor.h"
 #include "Padding.h"
 
+#include <vector>
+
 namespace NN::Pooling {
 
 // uint32_t getPQ(uint32_t img_extent, uint32_t filter_extent, uint32_t
@@ -31,79 +34,71 @@ void Forward<OP, DTRes, DTArg>::apply(DTRes *&res, size_t &res_h, size_t &res_w,
                                       const size_t img_w, const size_t pool_h, const size_t pool_w,
                                       const size_t stride_h, const size_t stride_w, const size_t pad_h,
                                       const size_t pad_w, DCTX(dctx)) {
-    auto HW = img_h * img_w;
-    auto C = num_channels;
-    auto CHW = C * HW;
-    // padded height/width
-    auto P = getPQ(img_h, pool_h, pad_h, stride_w);
-    auto Q = getPQ(img_w, pool_w, pad_w, stride_h);
-    auto CPQ = C * P * Q;
+    using VT = typename DTRes::VT;
+    const size_t HW = img_h * img_w;
+    const size_t C = num_channels;
+    const size_t P = getPQ(img_h, pool_h, pad_h, stride_h);
+    const size_t Q = getPQ(img_w, pool_w, pad_w, stride_w);
+    const size_t PQ = P * Q;
     res_h = P;
     res_w = Q;
-    auto start = 0;
-    auto stop = batch_size;
-
-    auto ii = start * CHW;
-    auto oi = start * CPQ;
 
     // 1 / pool length for averaging
-    auto plen = static_cast<typename DTRes::VT>(1) / static_cast<typename DTRes::VT>(pool_w * pool_h);
+    const VT plen = static_cast<VT>(1) / static_cast<VT>(pool_w * pool_h);
 
-    auto padded_img_h = img_h + 2 * pad_h;
-    auto padded_img_w = img_w + 2 * pad_w;
-    DTArg *padded_data = DataObjectFactory::create<DTArg>(1, padded_img_h * padded_img_w, true);
+    const bool padded = pad_h != 0 || pad_w != 0;
+    const size_t padded_img_h = img_h + 2 * pad_h;
+    const size_t padded_img_w = img_w + 2 * pad_w;
 
-    if (res == nullptr) {
-        res = DataObjectFactory::create<DTRes>(batch_size, CPQ, true);
-    }
-    if (P == 1 && Q == 1 && img_w == 1) {
-        // quick-path w/o materialized index arrays and
-        // simplified inner loops for P = 1, Q = 1, W = 1
-        uint32_t lenh = std::min(pool_h, img_h);
-        for (uint32_t i = start; i < stop; i++, oi += C)
-            for (uint32_t c = 0, off = ii + (i - start) * CHW; c < C; c++, off += img_h) {
-                res->getValues()[oi + c] = OP<typename DTArg::VT>::run(OP<typename DTArg::VT>::getNeutralElement(),
-                                                                       data->getValues(), off, lenh, plen);
-            }
-    } else if (stride_w == 1 && stride_h == 1 && pad_h == 0 && pad_w == 0) {
-        // quick-path w/o materialized index arrays
-        for (uint32_t i = start; i < stop; i++)
-            for (uint32_t c = 0, off = ii + (i - start) * CHW, oix = oi + (i - start) * CPQ; c < C; c++, off += HW)
-                for (uint32_t p = 0; p < P; p++, oix += Q)
-                    for (uint32_t h = p; h < std::min(p + pool_h, img_h); h++)
-                        for (uint32_t q = 0, off2 = off + h * img_w; q < Q; q++) {
-                            res->getValues()[oix + q] =
-                                OP<typename DTArg::VT>::run(res->getValues()[oix + q], data->getValues(), off2 + q,
-                                                            std::min(pool_w, img_w - q), plen);
-                        }
-    } else if (pad_h == 0 && pad_w == 0) {
-        // throw std::runtime_error("ToDo: pooling general case with stride &
-        // padding");
-        for (uint32_t i = start; i < stop; i++)
-            for (uint32_t c = 0, off = ii + (i - start) * CHW, oix = oi + (i - start) * CPQ; c < C; c++, off += HW)
-                for (uint32_t p = 0; p < P; p++, oix += Q)
-                    for (uint32_t h = p * stride_h; h < std::min(p * stride_h + pool_h, img_h); h++)
-                        for (uint32_t q = 0, off2 = off + h * img_w; q < Q; q++) {
-                            res->getValues()[oix + q] = OP<typename DTArg::VT>::run(
-                                res->getValues()[oix + q], data->getValues(), off2 + q * stride_w,
-                                std::min(pool_w, img_w - q * stride_w), plen);
-                        }
-    } else {
-        for (uint32_t i = start; i < stop; i++)
-            for (uint32_t c = 0, off = ii + (i - start) * CHW, oix = oi + (i - start) * CPQ; c < C; c++, off += HW) {
+    if (res == nullptr)
+        res = DataObjectFactory::create<DTRes>(batch_size, C * PQ, false);
 
-                Padding(padded_data->getValues(), data->getValues(), pad_h, pad_w, img_w, img_h, off);
+    const VT *valuesData = data->getValues();
+    VT *valuesRes = res->getValues();
+    const size_t rowSkipData = data->getRowSkip();
+    const size_t rowSkipRes = res->getRowSkip();
 
-                for (uint32_t p = 0; p < P; p++, oix += Q)
-                    for (uint32_t h = p * stride_h; h < std::min(p * stride_h + pool_h, padded_img_h); h++)
-                        for (uint32_t q = 0, off2 = h * padded_img_w; q < Q; q++) {
-                            res->getValues()[oix + q] = OP<typename DTArg::VT>::run(
-                                res->getValues()[oix + q], padded_data->getValues(), off2 + q * stride_w,
-                                std::min(pool_w, padded_img_w - q * stride_w), plen);
-                        }
+    // Each (image, channel) plane is pooled independently. The windows are
+    // accumulated for a whole output row at once, so that the innermost loop
+    // runs over consecutive cells and can be vectorized for stride 1.
+    const size_t numPlanes = batch_size * C;
+    const size_t numThreads = getNumKernelThreads(numPlanes, numPlanes * PQ * pool_h * pool_w, dctx);
+    parallelFor(numPlanes, numThreads, [&](size_t begin, size_t end, size_t) {
+        // The padding stays zero, only the interior is overwritten per plane.
+        std::vector<VT> paddedPlane(padded ? padded_img_h * padded_img_w : 0, VT(0));
+        std::vector<VT> acc(Q);
+        for (size_t plane = begin; plane < end; plane++) {
+            const size_t i = plane / C;
+            const size_t c = plane % C;
+            const VT *in = valuesData + i * rowSkipData + c * HW;
+            size_t inRowSkip = img_w;
+            if (padded) {
+                for (size_t h = 0; h < img_h; h++)
+                    std::copy(in + h * img_w, in + (h + 1) * img_w,
+                              paddedPlane.data() + (h + pad_h) * padded_img_w + pad_w);
+                in = paddedPlane.data();
+                inRowSkip = padded_img_w;
+            }
+            VT *out = valuesRes + i * rowSkipRes + c * PQ;
+            for (size_t p = 0; p < P; p++, out += Q) {
+                std::fill(acc.begin(), acc.end(), OP<VT>::getNeutralElement());
+                for (size_t h = 0; h < pool_h; h++) {
+                    const VT *inRow = in + (p * stride_h + h) * inRowSkip;
+                    for (size_t w = 0; w < pool_w; w++) {
+                        const VT *x = inRow + w;
+                        if (stride_w == 1)
+                            for (size_t q = 0; q < Q; q++)
+                                acc[q] = OP<VT>::apply(acc[q], x[q]);
+                        else
+                            for (size_t q = 0; q < Q; q++)
+                                acc[q] = OP<VT>::apply(acc[q], x[q * stride_w]);
+                    }
+                }
+                for (size_t q = 0; q < Q; q++)
+                    out[q] = OP<VT>::finish(acc[q], plen);
             }
-    }
-    DataObjectFactory::destroy(padded_data);
+        }
+    });
 }
 
 template struct Forward<AVG, DenseMatrix<float>, DenseMatrix<float>>;
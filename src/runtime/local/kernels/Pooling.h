@@ -21,9 +21,8 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
+#include <algorithm>
 #include <limits>
-#include <random>
-#include <type_traits>
 
 #include <cstddef>
 #include <cstdint>
@@ -31,29 +30,18 @@
 namespace NN::Pooling {
 
 template <typename VT> struct AVG {
-    static inline VT run(VT initial_value, const VT *in, uint32_t start, uint32_t length, VT plen) {
-        VT ret = 0;
-        auto end = start + length;
-        for (auto i = start; i < end; ++i)
-            ret += in[i];
-        return ret * plen + initial_value;
-    }
+    static inline VT apply(VT acc, VT in) { return acc + in; }
+    static inline VT finish(VT acc, VT plen) { return acc * plen; }
 
     static inline VT getNeutralElement() { return 0; }
     static inline bool isMAX() { return false; }
 };
 
 template <typename VT> struct MAX {
-    static inline VT run(VT initial_value, const VT *in, uint32_t start, uint32_t length,
-                         __attribute__((unused)) VT plen) {
-        VT ret = initial_value;
-        auto end = start + length;
-        for (auto i = start; i < end; ++i)
-            ret = std::max(ret, in[i]);
-        return ret;
-    }
+    static inline VT apply(VT acc, VT in) { return std::max(acc, in); }
+    static inline VT finish(VT acc, __attribute__((unused)) VT plen) { return acc; }
 
-    static inline VT getNeutralElement() { return std::numeric_limits<VT>::max(); }
+    static inline VT getNeutralElement() { return std::numeric_limits<VT>::lowest(); }
     static inline bool isMAX() { return true; }
 };
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_RUNTIME_LOCAL_KERNELS_POSITIONLIST_H
+#define SRC_RUNTIME_LOCAL_KERNELS_POSITIONLIST_H
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+
+#include <stdexcept>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ****************************************************************************
+// Utility functions
+// ****************************************************************************
+
+/**
+ * @brief Writes the positions of the non-zero entries of the bit vector `sel`
+ * to `pos` and returns their number.
+ *
+ * `pos` must have space for `numRows` positions.
+ */
+template <typename VTPos, typename VTSel>
+size_t selToPositions(VTPos *pos, const VTSel *sel, size_t rowSkipSel, size_t numRows) {
+    // Branch-free: the position is always written, but only kept if the row
+    // is selected. This avoids mispredictions for selectivities around 50%.
+    size_t numPos = 0;
+    for (size_t r = 0; r < numRows; r++) {
+        pos[numPos] = static_cast<VTPos>(r);
+        numPos += sel[r * rowSkipSel] != VTSel(0);
+    }
+    return numPos;
+}
+
+template <typename VT, typename VTPos>
+void gatherColumn(VT *resCol, const VT *argCol, const VTPos *pos, size_t numPos) {
+    for (size_t i = 0; i < numPos; i++)
+        resCol[i] = argCol[static_cast<size_t>(pos[i])];
+}
+
+/**
+ * @brief Copies the rows at the given positions of `arg` to the first
+ * `numPos` rows of `res`, one column at a time.
+ *
+ * `res` must have the same schema as `arg` and at least `numPos` rows. The
+ * positions are not checked.
+ */
+template <typename VTPos> void gatherFrameRows(Frame *res, const Frame *arg, const VTPos *pos, size_t numPos) {
+    const ValueTypeCode *schema = arg->getSchema();
+    for (size_t c = 0; c < arg->getNumCols(); c++) {
+        const void *argCol = arg->getColumnRaw(c);
+        void *resCol = res->getColumnRaw(c);
+        // Non-string columns are copied by the size of their elements only,
+        // which keeps the number of instantiations low.
+        if (schema[c] == ValueTypeCode::STR)
+            gatherColumn(static_cast<std::string *>(resCol), static_cast<const std::string *>(argCol), pos, numPos);
+        else
+            switch (ValueTypeUtils::sizeOf(schema[c])) {
+            case 1:
+                gatherColumn(static_cast<uint8_t *>(resCol), static_cast<const uint8_t *>(argCol), pos, numPos);
+                break;
+            case 4:
+                gatherColumn(static_cast<uint32_t *>(resCol), static_cast<const uint32_t *>(argCol), pos, numPos);
+                break;
+            case 8:
+                gatherColumn(static_cast<uint64_t *>(resCol), static_cast<const uint64_t *>(argCol), pos, numPos);
+                break;
+            default: {
+                const size_t elementSize = ValueTypeUtils::sizeOf(schema[c]);
+                auto resBytes = static_cast<uint8_t *>(resCol);
+                auto argBytes = static_cast<const uint8_t *>(argCol);
+                for (size_t i = 0; i < numPos; i++)
+                    memcpy(resBytes + i * elementSize, argBytes + static_cast<size_t>(pos[i]) * elementSize,
+                           elementSize);
+            }
+            }
+    }
+}
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+template <class DTRes, class DTSel> struct PositionList {
+    static void apply(DTRes *&res, const DTSel *sel, DCTX(ctx)) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Converts a bit vector into the list of the positions of its non-zero
+ * entries.
+ *
+ * The result can be used with `ExtractRow` to select the same rows from
+ * several data objects without evaluating the bit vector again.
+ */
+template <class DTRes, class DTSel> void positionList(DTRes *&res, const DTSel *sel, DCTX(ctx)) {
+    PositionList<DTRes, DTSel>::apply(res, sel, ctx);
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix <- DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VTPos, typename VTSel> struct PositionList<DenseMatrix<VTPos>, DenseMatrix<VTSel>> {
+    static void apply(DenseMatrix<VTPos> *&res, const DenseMatrix<VTSel> *sel, DCTX(ctx)) {
+        if (sel->getNumCols() != 1)
+            throw std::runtime_error("PositionList: sel must be a single-column matrix");
+
+        const size_t numRows = sel->getNumRows();
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VTPos>>(numRows, 1, false);
+
+        const size_t numPos = selToPositions(res->getValues(), sel->getValues(), sel->getRowSkip(), numRows);
+        res->shrinkNumRows(numPos);
+    }
+};
+
+#endif // SRC_RUNTIME_LOCAL_KERNELS_POSITIONLIST_H
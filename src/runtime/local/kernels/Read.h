@@ -24,7 +24,9 @@
 #include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/io/File.h>
 #include <runtime/local/io/ReadCsv.h>
+#include <runtime/local/io/DaphneColumnarFile.h>
 #include <runtime/local/io/ReadDaphne.h>
+#include <runtime/local/io/ReadDaphneColumnar.h>
 #include <runtime/local/io/ReadMM.h>
 #include <runtime/local/io/ReadParquet.h>
 #if USE_HDFS
@@ -104,7 +106,9 @@ template <typename VT> struct Read<DenseMatrix<VT>> {
             }
             break;
         case 3:
-            if constexpr (std::is_same<VT, std::string>::value)
+            if (DaphneColumnar::isColumnarFile(filename))
+                readDaphneColumnar(res, filename, {}, ctx);
+            else if constexpr (std::is_same<VT, std::string>::value)
                 throw std::runtime_error("reading string-valued DAPHNE binary format files is not supported (yet)");
             else
                 readDaphne(res, filename);
@@ -186,10 +190,16 @@ template <> struct Read<Frame> {
         else
             labels = fmd.labels.data();
 
-        if (res == nullptr)
-            res = DataObjectFactory::create<Frame>(fmd.numRows, fmd.numCols, schema, labels, false);
-
-        readCsv(res, filename, fmd.numRows, fmd.numCols, ',', schema);
+        if (extValue(filename) == 3) {
+            if (DaphneColumnar::isColumnarFile(filename))
+                readDaphneColumnar(res, filename, {}, ctx);
+            else
+                readDaphne(res, filename);
+        } else {
+            if (res == nullptr)
+                res = DataObjectFactory::create<Frame>(fmd.numRows, fmd.numCols, schema, labels, false);
+            readCsv(res, filename, fmd.numRows, fmd.numCols, ',', schema);
+        }
 
         if (fmd.isSingleValueType)
             delete[] schema;
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/context/IOContext.h>
+#include <runtime/local/io/Future.h>
+#include <runtime/local/kernels/Read.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+/**
+ * @brief Starts reading a data object from a file on the I/O threads of the
+ * `IOContext` and returns a future for it.
+ *
+ * The actual reading is done by the `read` kernel, so all file formats
+ * supported by it are supported here, too. Errors are reported when the
+ * future is awaited.
+ */
+template <class DTRes> struct ReadAsync {
+    static void apply(Future<DTRes> *&res, const char *filename, DCTX(ctx)) {
+        IOContext *ioCtx = IOContext::get(ctx);
+        if (ioCtx == nullptr)
+            throw std::runtime_error("ReadAsync: the DaphneContext has no IOContext");
+        // The file name might be freed before the read starts.
+        std::string fn(filename);
+        res = ioCtx->track(std::make_unique<Future<DTRes>>(ioCtx->submit([fn, ctx]() {
+            DTRes *obj = nullptr;
+            read(obj, fn.c_str(), ctx);
+            return obj;
+        })));
+    }
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTRes> void readAsync(Future<DTRes> *&res, const char *filename, DCTX(ctx)) {
+    ReadAsync<DTRes>::apply(res, filename, ctx);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/io/ArrowCData.h>
+#include <runtime/local/io/ArrowCDataInterface.h>
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <cstddef>
+#include <cstdint>
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Imports a frame from another library (e.g., pyarrow via DaphneLib)
+ * through the Arrow C data interface.
+ *
+ * The given array and schema are taken over; numeric columns without nulls
+ * share their memory with the producer.
+ *
+ * @param res The imported frame.
+ * @param arrayAddress The address of the `ArrowArray` of a struct array.
+ * @param schemaAddress The address of the `ArrowSchema` of the struct array.
+ * @param labels The column labels.
+ * @param numLabels The number of column labels, zero or the number of columns.
+ * @param schema The column types the script was compiled for. If the imported
+ * frame has other column types, an exception is thrown.
+ * @param numCols The number of columns the script was compiled for.
+ */
+inline void receiveFromArrow(Frame *&res, uint64_t arrayAddress, uint64_t schemaAddress, const char **labels,
+                             size_t numLabels, const ValueTypeCode *schema, size_t numCols, DCTX(ctx)) {
+    Frame *frame = nullptr;
+    ArrowCData::importFrame(frame, reinterpret_cast<ArrowArray *>(arrayAddress),
+                            reinterpret_cast<ArrowSchema *>(schemaAddress), labels, numLabels);
+
+    if (frame->getNumCols() != numCols || !std::equal(schema, schema + numCols, frame->getSchema())) {
+        auto printSchema = [](std::ostream &os, const ValueTypeCode *vtcs, size_t n) {
+            os << '[';
+            for (size_t c = 0; c < n; c++)
+                os << (c ? ", " : "") << ValueTypeUtils::cppNameForCode(vtcs[c]);
+            os << ']';
+        };
+        std::stringstream errMsg;
+        errMsg << "receiveFromArrow: the received frame has the column types ";
+        printSchema(errMsg, frame->getSchema(), frame->getNumCols());
+        errMsg << ", but the script was compiled for ";
+        printSchema(errMsg, schema, numCols);
+        DataObjectFactory::destroy(frame);
+        throw std::runtime_error(errMsg.str());
+    }
+    res = frame;
+}
@@ -19,6 +19,7 @@
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/DictionaryEncoding.h>
 #include <runtime/local/datastructures/Matrix.h>
 
 #include <algorithm>
@@ -60,90 +61,32 @@ template <typename VTVal, typename VTCode> struct Recode<DenseMatrix<VTCode>, De
         if (arg->getNumCols() != 1)
             throw std::runtime_error("recode: the argument must have exactly one column");
 
-        if (orderPreserving) {
-            // Determine the distinct values in the input.
-            std::set<VTVal> distinct;
-            const size_t numRowsArg = arg->getNumRows();
-            const VTVal *valuesArg = arg->getValues();
-            const size_t rowSkipArg = arg->getRowSkip();
-            for (size_t r = 0; r < numRowsArg; r++) {
-                distinct.insert(*valuesArg);
-                valuesArg += rowSkipArg;
-            }
-
-            // Allocate output for the decoding dictionary.
-            if (dict == nullptr)
-                dict = DataObjectFactory::create<DenseMatrix<VTVal>>(distinct.size(), 1, false);
-
-            // Create recoding dictionary and store decoding dictionary.
-            std::unordered_map<VTVal, VTCode> recodeDict;
-            VTVal *valuesDict = dict->getValues();
-            const size_t rowSkipDict = dict->getRowSkip();
-            VTCode nextCode = 0;
-            for (auto it = distinct.begin(); it != distinct.end(); it++) {
-                recodeDict.emplace(*it, nextCode++);
-                *valuesDict = *it;
-                valuesDict += rowSkipDict;
-            }
-
-            // Allocate output for recoded data.
-            if (res == nullptr)
-                res = DataObjectFactory::create<DenseMatrix<VTCode>>(numRowsArg, 1, false);
-
-            // Recode the data.
-            valuesArg = arg->getValues(); // rewind
-            VTCode *valuesRes = res->getValues();
-            const size_t rowSkipRes = res->getRowSkip();
-            for (size_t r = 0; r < numRowsArg; r++) {
-                *valuesRes = recodeDict[*valuesArg];
-                valuesArg += rowSkipArg;
-                valuesRes += rowSkipRes;
-            }
-        } else {
-            const size_t numRowsArg = arg->getNumRows();
-
-            // Allocate output for recoded data.
-            if (res == nullptr)
-                res = DataObjectFactory::create<DenseMatrix<VTCode>>(numRowsArg, 1, false);
-
-            // Internal data structure.
-            VTCode nextCode = 0;
-            std::unordered_map<VTVal, VTCode> recodeDict;
+        // Hash each value only once and, if requested, sort only the distinct
+        // values instead of all rows.
+        DictionaryEncoding<VTVal> enc(arg, 0, orderPreserving);
+        const size_t numRowsArg = arg->getNumRows();
+        const size_t numDistinct = enc.getNumDistinct();
 
-            // Recode the data.
-            const VTVal *valuesArg = arg->getValues();
-            const size_t rowSkipArg = arg->getRowSkip();
-            VTCode *valuesRes = res->getValues();
-            const size_t rowSkipRes = res->getRowSkip();
-            for (size_t r = 0; r < numRowsArg; r++) {
-                const VTVal v = *valuesArg;
-
-                auto it = recodeDict.find(v);
-                if (it != recodeDict.end())
-                    *valuesRes = it->second;
-                else {
-                    recodeDict[v] = nextCode;
-                    *valuesRes = nextCode;
-                    nextCode++;
-                }
+        // Allocate output for the decoding dictionary.
+        if (dict == nullptr)
+            dict = DataObjectFactory::create<DenseMatrix<VTVal>>(numDistinct, 1, false);
 
-                valuesArg += rowSkipArg;
-                valuesRes += rowSkipRes;
-            }
+        // Store decoding dictionary.
+        VTVal *valuesDict = dict->getValues();
+        const size_t rowSkipDict = dict->getRowSkip();
+        for (size_t c = 0; c < numDistinct; c++)
+            valuesDict[c * rowSkipDict] = VTVal(enc.getValue(c));
 
-            // Allocate output for the decoding dictionary.
-            if (dict == nullptr)
-                dict = DataObjectFactory::create<DenseMatrix<VTVal>>(recodeDict.size(), 1, false);
+        // Allocate output for recoded data.
+        if (res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VTCode>>(numRowsArg, 1, false);
 
-            // Store decoding dictionary.
-            VTVal *valuesDict = dict->getValues();
-            const size_t rowSkipDict = dict->getRowSkip();
-            for (auto it = recodeDict.begin(); it != recodeDict.end(); it++) {
-                const VTVal v = it->first;
-                const VTCode c = it->second;
-                valuesDict[c * rowSkipDict] = v;
-            }
-        }
+        // Store the recoded data.
+        const auto *codes = enc.getCodes();
+        VTCode *valuesRes = res->getValues();
+        const size_t rowSkipRes = res->getRowSkip();
+        for (size_t r = 0; r < numRowsArg; r++)
+            valuesRes[r * rowSkipRes] = static_cast<VTCode>(codes[r]);
     }
 };
 
@@ -20,6 +20,7 @@
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/io/ArrowCData.h>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -70,33 +71,21 @@ template <typename VT> struct SaveDaphneLibResult<DenseMatrix<VT>> {
 
 template <> struct SaveDaphneLibResult<Frame> {
     static void apply(const Frame *arg, DCTX(ctx)) {
-        // Increase the reference counter of the data object to be transferred
-        // to python, such that the data is not garbage collected by DAPHNE.
-        // TODO But who will free the memory in the end?
-        arg->increaseRefCounter();
-
         DaphneLibResult *daphneLibRes = ctx->getUserConfig().result_struct;
 
         if (!daphneLibRes)
             throw std::runtime_error("saveDaphneLibRes(): daphneLibRes is nullptr");
 
-        const size_t numCols = arg->getNumCols();
-
-        // Create fresh arrays for vtcs, labels and columns.
-        int64_t *vtcs = new int64_t[numCols];
-        char **labels = new char *[numCols];
-        void **columns = new void *[numCols];
-        for (size_t i = 0; i < numCols; i++) {
-            vtcs[i] = static_cast<int64_t>(arg->getSchema()[i]);
-            labels[i] = const_cast<char *>(arg->getLabels()[i].c_str());
-            columns[i] = const_cast<void *>(reinterpret_cast<const void *>(arg->getColumnRaw(i)));
-        }
+        // Release a previous result that was not taken over by Python.
+        if (daphneLibRes->frameArray.release)
+            daphneLibRes->frameArray.release(&daphneLibRes->frameArray);
+        if (daphneLibRes->frameSchema.release)
+            daphneLibRes->frameSchema.release(&daphneLibRes->frameSchema);
 
-        daphneLibRes->cols = numCols;
+        // The exported array keeps the frame alive until Python releases it.
+        ArrowCData::exportFrame(arg, &daphneLibRes->frameArray, &daphneLibRes->frameSchema);
+        daphneLibRes->cols = arg->getNumCols();
         daphneLibRes->rows = arg->getNumRows();
-        daphneLibRes->vtcs = vtcs;
-        daphneLibRes->labels = labels;
-        daphneLibRes->columns = columns;
     }
 };
 
@@ -21,10 +21,75 @@
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
+#include <cstddef>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+template <class DTArg> struct Sparsity {
+    static double apply(const DTArg *arg, DCTX(ctx)) = delete;
+};
+
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
-template <class DTArg> double sparsity(const DTArg *arg, DCTX(ctx)) { return -1.0; }
+/**
+ * @brief Returns the actual sparsity of the given matrix, i.e., the fraction
+ * of its cells that are non-zero.
+ *
+ * This allows the generated code to decide on the representation of a matrix
+ * whose sparsity was unknown at compile-time (e.g., after reading it from a
+ * file).
+ *
+ * @param arg The matrix.
+ * @return The number of non-zeros divided by the number of cells, or zero for
+ * a matrix without any cells.
+ */
+template <class DTArg> double sparsity(const DTArg *arg, DCTX(ctx)) { return Sparsity<DTArg>::apply(arg, ctx); }
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// double <- DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct Sparsity<DenseMatrix<VT>> {
+    static double apply(const DenseMatrix<VT> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+        if (numRows == 0 || numCols == 0)
+            return 0.0;
+
+        const VT *values = arg->getValues();
+        const size_t rowSkip = arg->getRowSkip();
+        size_t numNonZeros = 0;
+        for (size_t r = 0; r < numRows; r++) {
+            for (size_t c = 0; c < numCols; c++)
+                numNonZeros += values[c] != VT(0);
+            values += rowSkip;
+        }
+        return static_cast<double>(numNonZeros) / (numRows * numCols);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// double <- CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct Sparsity<CSRMatrix<VT>> {
+    static double apply(const CSRMatrix<VT> *arg, DCTX(ctx)) {
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+        if (numRows == 0 || numCols == 0)
+            return 0.0;
+        // Explicitly stored zeros are counted as non-zeros, which is fine for
+        // choosing the representation.
+        return static_cast<double>(arg->getNumNonZeros()) / (numRows * numCols);
+    }
+};
 
 #endif // SRC_RUNTIME_LOCAL_KERNELS_SPARSITY_H
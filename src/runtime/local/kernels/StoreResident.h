@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/context/ResidentObjectStore.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+
+#include <stdexcept>
+#include <string>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+template <class DTArg> struct StoreResident {
+    static ResidentObject describe(const DTArg *arg) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Keeps the given data object under the given name in the resident
+ * object store of the current DaphneLib session, such that scripts run later
+ * in the session can refer to it by `loadResident()`.
+ */
+template <class DTArg> void storeResident(const DTArg *arg, const char *name, DCTX(ctx)) {
+    ResidentObjectStore *store = ctx->getUserConfig().resident_objects;
+    if (!store)
+        throw std::runtime_error("storeResident(): resident objects are only available in a DaphneLib session");
+    store->put(name, StoreResident<DTArg>::describe(arg));
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct StoreResident<DenseMatrix<VT>> {
+    static ResidentObject describe(const DenseMatrix<VT> *arg) {
+        return {const_cast<DenseMatrix<VT> *>(arg), ResidentObject::Kind::DENSE_MATRIX, ValueTypeUtils::codeFor<VT>,
+                {}, {}};
+    }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT> struct StoreResident<CSRMatrix<VT>> {
+    static ResidentObject describe(const CSRMatrix<VT> *arg) {
+        return {const_cast<CSRMatrix<VT> *>(arg), ResidentObject::Kind::CSR_MATRIX, ValueTypeUtils::codeFor<VT>,
+                {}, {}};
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+template <> struct StoreResident<Frame> {
+    static ResidentObject describe(const Frame *arg) {
+        const size_t numCols = arg->getNumCols();
+        return {const_cast<Frame *>(arg), ResidentObject::Kind::FRAME, ValueTypeCode::INVALID,
+                std::vector<ValueTypeCode>(arg->getSchema(), arg->getSchema() + numCols),
+                std::vector<std::string>(arg->getLabels(), arg->getLabels() + numCols)};
+    }
+};
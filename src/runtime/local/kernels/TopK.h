@@ -0,0 +1,150 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/kernels/ExtractRow.h>
+#include <runtime/local/kernels/NormalizedKeySort.h>
+#include <runtime/local/kernels/Order.h>
+#include <util/DeduceType.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <cstddef>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+/**
+ * @brief Returns the first `k` rows of `arg` ordered like by the `order`
+ * kernel (or their indexes, if `returnIdx` is `true`), i.e., the same result
+ * as `order` followed by `sliceRow(0, k)`, but without ordering all rows.
+ */
+template <class DTRes, class DTArg> struct TopK {
+    static void apply(DTRes *&res, const DTArg *arg, size_t k, size_t *colIdxs, size_t numColIdxs, bool *ascending,
+                      size_t numAscending, bool returnIdx, DCTX(ctx)) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTRes, class DTArg>
+void topK(DTRes *&res, const DTArg *arg, size_t k, size_t *colIdxs, size_t numColIdxs, bool *ascending,
+          size_t numAscending, bool returnIdx, DCTX(ctx)) {
+    TopK<DTRes, DTArg>::apply(res, arg, k, colIdxs, numColIdxs, ascending, numAscending, returnIdx, ctx);
+}
+
+// ****************************************************************************
+// Functions called by multiple template specializations
+// ****************************************************************************
+
+inline void validateArgsTopK(size_t k, size_t numRowsArg) {
+    if (k > numRowsArg) {
+        std::ostringstream errMsg;
+        errMsg << "invalid argument '" << k << "' passed to TopK: k must not be greater than the #rows of arg '"
+               << numRowsArg << "'";
+        throw std::out_of_range(errMsg.str());
+    }
+}
+
+inline DenseMatrix<size_t> *topKIdxsFrame(const Frame *arg, size_t k, size_t *colIdxs, size_t numColIdxs,
+                                          bool *ascending, DCTX(ctx)) {
+    NormalizedKeySort sorter(arg->getNumRows());
+    for (size_t i = 0; i < numColIdxs; i++) {
+        const ValueTypeCode vtc = arg->getSchema()[colIdxs[i]];
+        if (vtc == ValueTypeCode::STR)
+            AddNormalizedKey<std::string>::apply(sorter, arg, colIdxs[i], ascending[i]);
+        else
+            DeduceValueTypeAndExecute<AddNormalizedKey>::apply(vtc, sorter, arg, colIdxs[i], ascending[i]);
+    }
+    auto idx = DataObjectFactory::create<DenseMatrix<size_t>>(k, 1, false);
+    sorter.topK(k, idx->getValues(), ctx);
+    return idx;
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// Frame <- Frame
+// ----------------------------------------------------------------------------
+
+template <> struct TopK<Frame, Frame> {
+    static void apply(Frame *&res, const Frame *arg, size_t k, size_t *colIdxs, size_t numColIdxs, bool *ascending,
+                      size_t numAscending, bool returnIdx, DCTX(ctx)) {
+        if (arg == nullptr || colIdxs == nullptr || numColIdxs == 0 || ascending == nullptr || returnIdx)
+            throw std::runtime_error("topK-kernel called with invalid arguments");
+        validateArgsTopK(k, arg->getNumRows());
+        DenseMatrix<size_t> *idx = topKIdxsFrame(arg, k, colIdxs, numColIdxs, ascending, ctx);
+        extractRow(res, arg, idx, ctx);
+        DataObjectFactory::destroy(idx);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// DenseMatrix <- Frame
+// ----------------------------------------------------------------------------
+
+template <typename VTRes> struct TopK<DenseMatrix<VTRes>, Frame> {
+    static void apply(DenseMatrix<VTRes> *&res, const Frame *arg, size_t k, size_t *colIdxs, size_t numColIdxs,
+                      bool *ascending, size_t numAscending, bool returnIdx, DCTX(ctx)) {
+        if (arg == nullptr || colIdxs == nullptr || numColIdxs == 0 || ascending == nullptr || !returnIdx ||
+            !std::is_same<VTRes, size_t>::value)
+            throw std::runtime_error("topK-kernel called with invalid arguments");
+        validateArgsTopK(k, arg->getNumRows());
+        res = (DenseMatrix<VTRes> *)topKIdxsFrame(arg, k, colIdxs, numColIdxs, ascending, ctx);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// DenseMatrix <- DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VTRes, typename VTArg> struct TopK<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
+    static void apply(DenseMatrix<VTRes> *&res, const DenseMatrix<VTArg> *arg, size_t k, size_t *colIdxs,
+                      size_t numColIdxs, bool *ascending, size_t numAscending, bool returnIdx, DCTX(ctx)) {
+        if (arg == nullptr || colIdxs == nullptr || numColIdxs == 0 || ascending == nullptr ||
+            (returnIdx == false && !std::is_same<VTRes, VTArg>::value) ||
+            (returnIdx == true && !std::is_same<VTRes, size_t>::value))
+            throw std::runtime_error("topK-kernel called with invalid arguments");
+        validateArgsTopK(k, arg->getNumRows());
+
+        NormalizedKeySort sorter(arg->getNumRows());
+        for (size_t i = 0; i < numColIdxs; i++)
+            sorter.addKey(arg->getValues() + colIdxs[i], arg->getRowSkip(), ascending[i]);
+        auto idx = DataObjectFactory::create<DenseMatrix<size_t>>(k, 1, false);
+        sorter.topK(k, idx->getValues(), ctx);
+
+        if (returnIdx)
+            res = (DenseMatrix<VTRes> *)idx;
+        else {
+            if constexpr (std::is_same<VTArg, VTRes>::value)
+                extractRow(res, arg, idx, ctx);
+            DataObjectFactory::destroy(idx);
+        }
+    }
+};
@@ -22,24 +22,252 @@
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Matrix.h>
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include <cstddef>
 
+#include "ParallelFor.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
 
 template <class DTRes, class DTArg> struct Transpose {
-    static void apply(DTRes *&res, const DTArg *arg, DCTX(ctx)) = delete;
+    static void apply(DTRes *&res, const DTArg *arg, bool mayReuseArg, DCTX(ctx)) = delete;
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
-template <class DTRes, class DTArg> void transpose(DTRes *&res, const DTArg *arg, DCTX(ctx)) {
-    Transpose<DTRes, DTArg>::apply(res, arg, ctx);
+/**
+ * @brief Transposes `arg` into `res`.
+ *
+ * If `mayReuseArg` is `true`, the caller guarantees that `arg` is not used
+ * after this call. Then, the kernel may transpose `arg` in place and return it
+ * as `res` (with an increased reference counter), provided that nothing else
+ * refers to `arg` or its values.
+ */
+template <class DTRes, class DTArg> void transpose(DTRes *&res, const DTArg *arg, bool mayReuseArg, DCTX(ctx)) {
+    Transpose<DTRes, DTArg>::apply(res, arg, mayReuseArg, ctx);
 }
 
+// ****************************************************************************
+// Functions called by multiple template specializations
+// ****************************************************************************
+
+namespace TransposeDense {
+
+/**
+ * @brief Edge length of the leaf tiles of the cache-oblivious recursion.
+ *
+ * A source and a destination tile of this size fit into the L1 cache for all
+ * numeric value types, and the size is a multiple of all SIMD block sizes.
+ */
+constexpr size_t LEAF_SIZE = 32;
+
+/**
+ * @brief Transposes a block of `numRows x numCols` cells from `src` to `dst`
+ * cell by cell.
+ */
+template <typename VT>
+inline void transposeScalar(const VT *src, size_t rowSkipSrc, VT *dst, size_t rowSkipDst, size_t numRows,
+                            size_t numCols) {
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t c = 0; c < numCols; c++)
+            dst[c * rowSkipDst + r] = src[r * rowSkipSrc + c];
+}
+
+/**
+ * @brief The edge length of the square blocks the SIMD micro-kernel for value
+ * type `VT` transposes in registers, or 0 if there is none.
+ *
+ * 32-bit and 64-bit numeric types are handled by the single and double
+ * precision micro-kernels, respectively, since the transpose only moves bits.
+ */
+template <typename VT> constexpr size_t simdBlockSize() {
+    if constexpr (!std::is_arithmetic_v<VT>)
+        return 0;
+#if defined(__AVX__)
+    else if constexpr (sizeof(VT) == 4)
+        return 8;
+    else if constexpr (sizeof(VT) == 8)
+        return 4;
+#elif defined(__SSE2__)
+    else if constexpr (sizeof(VT) == 4)
+        return 4;
+    else if constexpr (sizeof(VT) == 8)
+        return 2;
+#endif
+    else
+        return 0;
+}
+
+/**
+ * @brief Transposes one square block of `simdBlockSize<VT>()` cells in SIMD
+ * registers.
+ */
+template <typename VT> inline void transposeMicroKernel(const VT *src, size_t rowSkipSrc, VT *dst, size_t rowSkipDst) {
+#if defined(__AVX__)
+    if constexpr (sizeof(VT) == 4) {
+        const float *s = reinterpret_cast<const float *>(src);
+        float *d = reinterpret_cast<float *>(dst);
+        __m256 r0 = _mm256_loadu_ps(s + 0 * rowSkipSrc);
+        __m256 r1 = _mm256_loadu_ps(s + 1 * rowSkipSrc);
+        __m256 r2 = _mm256_loadu_ps(s + 2 * rowSkipSrc);
+        __m256 r3 = _mm256_loadu_ps(s + 3 * rowSkipSrc);
+        __m256 r4 = _mm256_loadu_ps(s + 4 * rowSkipSrc);
+        __m256 r5 = _mm256_loadu_ps(s + 5 * rowSkipSrc);
+        __m256 r6 = _mm256_loadu_ps(s + 6 * rowSkipSrc);
+        __m256 r7 = _mm256_loadu_ps(s + 7 * rowSkipSrc);
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+        __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+        __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+        __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+        __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+        __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        _mm256_storeu_ps(d + 0 * rowSkipDst, _mm256_permute2f128_ps(u0, u4, 0x20));
+        _mm256_storeu_ps(d + 1 * rowSkipDst, _mm256_permute2f128_ps(u1, u5, 0x20));
+        _mm256_storeu_ps(d + 2 * rowSkipDst, _mm256_permute2f128_ps(u2, u6, 0x20));
+        _mm256_storeu_ps(d + 3 * rowSkipDst, _mm256_permute2f128_ps(u3, u7, 0x20));
+        _mm256_storeu_ps(d + 4 * rowSkipDst, _mm256_permute2f128_ps(u0, u4, 0x31));
+        _mm256_storeu_ps(d + 5 * rowSkipDst, _mm256_permute2f128_ps(u1, u5, 0x31));
+        _mm256_storeu_ps(d + 6 * rowSkipDst, _mm256_permute2f128_ps(u2, u6, 0x31));
+        _mm256_storeu_ps(d + 7 * rowSkipDst, _mm256_permute2f128_ps(u3, u7, 0x31));
+    } else if constexpr (sizeof(VT) == 8) {
+        const double *s = reinterpret_cast<const double *>(src);
+        double *d = reinterpret_cast<double *>(dst);
+        __m256d r0 = _mm256_loadu_pd(s + 0 * rowSkipSrc);
+        __m256d r1 = _mm256_loadu_pd(s + 1 * rowSkipSrc);
+        __m256d r2 = _mm256_loadu_pd(s + 2 * rowSkipSrc);
+        __m256d r3 = _mm256_loadu_pd(s + 3 * rowSkipSrc);
+        __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+        __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+        __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+        __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+        _mm256_storeu_pd(d + 0 * rowSkipDst, _mm256_permute2f128_pd(t0, t2, 0x20));
+        _mm256_storeu_pd(d + 1 * rowSkipDst, _mm256_permute2f128_pd(t1, t3, 0x20));
+        _mm256_storeu_pd(d + 2 * rowSkipDst, _mm256_permute2f128_pd(t0, t2, 0x31));
+        _mm256_storeu_pd(d + 3 * rowSkipDst, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+#elif defined(__SSE2__)
+    if constexpr (sizeof(VT) == 4) {
+        const float *s = reinterpret_cast<const float *>(src);
+        float *d = reinterpret_cast<float *>(dst);
+        __m128 r0 = _mm_loadu_ps(s + 0 * rowSkipSrc);
+        __m128 r1 = _mm_loadu_ps(s + 1 * rowSkipSrc);
+        __m128 r2 = _mm_loadu_ps(s + 2 * rowSkipSrc);
+        __m128 r3 = _mm_loadu_ps(s + 3 * rowSkipSrc);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(d + 0 * rowSkipDst, r0);
+        _mm_storeu_ps(d + 1 * rowSkipDst, r1);
+        _mm_storeu_ps(d + 2 * rowSkipDst, r2);
+        _mm_storeu_ps(d + 3 * rowSkipDst, r3);
+    } else if constexpr (sizeof(VT) == 8) {
+        const double *s = reinterpret_cast<const double *>(src);
+        double *d = reinterpret_cast<double *>(dst);
+        __m128d r0 = _mm_loadu_pd(s);
+        __m128d r1 = _mm_loadu_pd(s + rowSkipSrc);
+        _mm_storeu_pd(d, _mm_unpacklo_pd(r0, r1));
+        _mm_storeu_pd(d + rowSkipDst, _mm_unpackhi_pd(r0, r1));
+    }
+#endif
+}
+
+/**
+ * @brief Transposes a leaf tile of at most `LEAF_SIZE x LEAF_SIZE` cells,
+ * using the SIMD micro-kernel for all full blocks and scalar code for the
+ * remaining border.
+ */
+template <typename VT>
+inline void transposeLeaf(const VT *src, size_t rowSkipSrc, VT *dst, size_t rowSkipDst, size_t numRows,
+                          size_t numCols) {
+    constexpr size_t bs = simdBlockSize<VT>();
+    if constexpr (bs == 0)
+        transposeScalar(src, rowSkipSrc, dst, rowSkipDst, numRows, numCols);
+    else {
+        const size_t numRowsSimd = numRows - numRows % bs;
+        const size_t numColsSimd = numCols - numCols % bs;
+        for (size_t r = 0; r < numRowsSimd; r += bs)
+            for (size_t c = 0; c < numColsSimd; c += bs)
+                transposeMicroKernel(src + r * rowSkipSrc + c, rowSkipSrc, dst + c * rowSkipDst + r, rowSkipDst);
+        // Right border (all rows), then bottom border (SIMD columns only).
+        transposeScalar(src + numColsSimd, rowSkipSrc, dst + numColsSimd * rowSkipDst, rowSkipDst, numRows,
+                        numCols - numColsSimd);
+        transposeScalar(src + numRowsSimd * rowSkipSrc, rowSkipSrc, dst + numRowsSimd, rowSkipDst,
+                        numRows - numRowsSimd, numColsSimd);
+    }
+}
+
+/**
+ * @brief Cache-obliviously transposes a `numRows x numCols` block by
+ * recursively halving its larger dimension until it fits a leaf tile.
+ */
+template <typename VT>
+void transposeRec(const VT *src, size_t rowSkipSrc, VT *dst, size_t rowSkipDst, size_t numRows, size_t numCols) {
+    if (numRows <= LEAF_SIZE && numCols <= LEAF_SIZE)
+        transposeLeaf(src, rowSkipSrc, dst, rowSkipDst, numRows, numCols);
+    else if (numRows >= numCols) {
+        // Split at a multiple of the leaf size to keep the SIMD blocks aligned
+        // to the leaves.
+        const size_t half = (numRows / 2 + LEAF_SIZE - 1) / LEAF_SIZE * LEAF_SIZE;
+        transposeRec(src, rowSkipSrc, dst, rowSkipDst, half, numCols);
+        transposeRec(src + half * rowSkipSrc, rowSkipSrc, dst + half, rowSkipDst, numRows - half, numCols);
+    } else {
+        const size_t half = (numCols / 2 + LEAF_SIZE - 1) / LEAF_SIZE * LEAF_SIZE;
+        transposeRec(src, rowSkipSrc, dst, rowSkipDst, numRows, half);
+        transposeRec(src + half, rowSkipSrc, dst + half * rowSkipDst, rowSkipDst, numRows, numCols - half);
+    }
+}
+
+/**
+ * @brief Swaps the tile starting at (`r`, `c`) with the transpose of the tile
+ * starting at (`c`, `r`) of a square matrix, or transposes the tile in place
+ * if it lies on the diagonal.
+ *
+ * The tiles are transposed by `transposeLeaf()` through the buffer `tmp` of
+ * `LEAF_SIZE x LEAF_SIZE` cells.
+ */
+template <typename VT>
+inline void swapTransposeTiles(VT *values, size_t rowSkip, size_t n, size_t r, size_t c, VT *tmp) {
+    const size_t numRows = std::min(LEAF_SIZE, n - r);
+    const size_t numCols = std::min(LEAF_SIZE, n - c);
+    VT *upper = values + r * rowSkip + c;
+    VT *lower = values + c * rowSkip + r;
+    transposeLeaf(upper, rowSkip, tmp, numRows, numRows, numCols);
+    if (r != c)
+        transposeLeaf(lower, rowSkip, upper, rowSkip, numCols, numRows);
+    for (size_t i = 0; i < numCols; i++)
+        std::copy(tmp + i * numRows, tmp + (i + 1) * numRows, lower + i * rowSkip);
+}
+
+/**
+ * @brief Whether the given dense matrix can be transposed in place, i.e., it
+ * is square, is not a view, and neither the matrix nor its values array is
+ * shared with another data object.
+ */
+template <typename VT> bool canTransposeInPlace(const DenseMatrix<VT> *arg) {
+    return arg->getNumRows() == arg->getNumCols() && arg->isExclusivelyOwned();
+}
+
+} // namespace TransposeDense
+
 // ****************************************************************************
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
@@ -49,10 +277,27 @@ template <class DTRes, class DTArg> void transpose(DTRes *&res, const DTArg *arg
 // ----------------------------------------------------------------------------
 
 template <typename VT> struct Transpose<DenseMatrix<VT>, DenseMatrix<VT>> {
-    static void apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, DCTX(ctx)) {
+    /**
+     * @brief Transposes a dense matrix.
+     *
+     * If `mayReuseArg` is set, a square matrix is transposed in place if it
+     * is no view and neither the matrix nor its values are shared (see
+     * `TransposeDense::canTransposeInPlace()`); otherwise, a new result
+     * matrix is allocated.
+     */
+    static void apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *arg, bool mayReuseArg, DCTX(ctx)) {
+        using namespace TransposeDense;
+
         const size_t numRows = arg->getNumRows();
         const size_t numCols = arg->getNumCols();
 
+        if (res == nullptr && mayReuseArg && canTransposeInPlace(arg)) {
+            res = const_cast<DenseMatrix<VT> *>(arg);
+            res->increaseRefCounter();
+            applyInPlace(res, ctx);
+            return;
+        }
+
         // skip data movement for vectors
         if ((numRows == 1 || numCols == 1) && !arg->isView()) {
             res = DataObjectFactory::create<DenseMatrix<VT>>(numCols, numRows, arg);
@@ -61,18 +306,43 @@ template <typename VT> struct Transpose<DenseMatrix<VT>, DenseMatrix<VT>> {
                 res = DataObjectFactory::create<DenseMatrix<VT>>(numCols, numRows, false);
 
             const VT *valuesArg = arg->getValues();
+            VT *valuesRes = res->getValues();
             const size_t rowSkipArg = arg->getRowSkip();
             const size_t rowSkipRes = res->getRowSkip();
-            for (size_t r = 0; r < numRows; r++) {
-                VT *valuesRes = res->getValues() + r;
-                for (size_t c = 0; c < numCols; c++) {
-                    *valuesRes = valuesArg[c];
-                    valuesRes += rowSkipRes;
-                }
-                valuesArg += rowSkipArg;
-            }
+
+            // Each thread transposes a horizontal stripe of the argument,
+            // which becomes a vertical stripe of the result.
+            const size_t numTileRows = (numRows + LEAF_SIZE - 1) / LEAF_SIZE;
+            const size_t numThreads = getNumKernelThreads(numTileRows, numRows * numCols, ctx);
+            parallelFor(numTileRows, numThreads, [&](size_t begin, size_t end, size_t) {
+                const size_t rBegin = begin * LEAF_SIZE;
+                const size_t rEnd = std::min(end * LEAF_SIZE, numRows);
+                if (rBegin < rEnd)
+                    transposeRec(valuesArg + rBegin * rowSkipArg, rowSkipArg, valuesRes + rBegin, rowSkipRes,
+                                 rEnd - rBegin, numCols);
+            });
         }
     }
+
+    static void applyInPlace(DenseMatrix<VT> *mat, DCTX(ctx)) {
+        using namespace TransposeDense;
+
+        const size_t n = mat->getNumRows();
+        const size_t rowSkip = mat->getRowSkip();
+        VT *values = mat->getValues();
+
+        // Each tile pair above the diagonal is handled by the thread owning
+        // its tile row. Tile rows are assigned round-robin, since the number
+        // of pairs decreases towards the bottom.
+        const size_t numTileRows = (n + LEAF_SIZE - 1) / LEAF_SIZE;
+        const size_t numThreads = getNumKernelThreads(numTileRows, n * n, ctx);
+        parallelFor(numThreads, numThreads, [&](size_t, size_t, size_t t) {
+            std::vector<VT> tmp(LEAF_SIZE * LEAF_SIZE);
+            for (size_t tr = t; tr < numTileRows; tr += numThreads)
+                for (size_t tc = tr; tc < numTileRows; tc++)
+                    swapTransposeTiles(values, rowSkip, n, tr * LEAF_SIZE, tc * LEAF_SIZE, tmp.data());
+        });
+    }
 };
 
 // ----------------------------------------------------------------------------
@@ -80,7 +350,7 @@ template <typename VT> struct Transpose<DenseMatrix<VT>, DenseMatrix<VT>> {
 // ----------------------------------------------------------------------------
 
 template <typename VT> struct Transpose<CSRMatrix<VT>, CSRMatrix<VT>> {
-    static void apply(CSRMatrix<VT> *&res, const CSRMatrix<VT> *arg, DCTX(ctx)) {
+    static void apply(CSRMatrix<VT> *&res, const CSRMatrix<VT> *arg, bool mayReuseArg, DCTX(ctx)) {
         // Implementation inspired by SciPy
         // https://github.com/scipy/scipy/blob/8a64c938ddf1ae4c02a08d2c5e38daeb8d061d38/scipy/sparse/sparsetools/csr.h#L608
         const size_t numRows = arg->getNumRows();
@@ -135,7 +405,7 @@ template <typename VT> struct Transpose<CSRMatrix<VT>, CSRMatrix<VT>> {
 // ----------------------------------------------------------------------------
 
 template <typename VT> struct Transpose<Matrix<VT>, Matrix<VT>> {
-    static void apply(Matrix<VT> *&res, const Matrix<VT> *arg, DCTX(ctx)) {
+    static void apply(Matrix<VT> *&res, const Matrix<VT> *arg, bool mayReuseArg, DCTX(ctx)) {
         const size_t numRowsRes = arg->getNumCols();
         const size_t numColsRes = arg->getNumRows();
 
@@ -26,6 +26,7 @@
 #include <runtime/local/io/FileMetaData.h>
 #include <runtime/local/io/WriteCsv.h>
 #include <runtime/local/io/WriteDaphne.h>
+#include <runtime/local/io/WriteDaphneColumnar.h>
 #if USE_HDFS
 #include <runtime/local/io/HDFS/WriteHDFS.h>
 #endif
@@ -46,6 +47,16 @@ template <class DTArg> void write(const DTArg *arg, const char *filename, DCTX(c
     Write<DTArg>::apply(arg, filename, ctx);
 }
 
+// ****************************************************************************
+// Functions called by multiple template specializations
+// ****************************************************************************
+
+inline DaphneColumnarWriteOptions getColumnarWriteOptions(DCTX(ctx)) {
+    DaphneColumnarWriteOptions opts;
+    opts.codec = ctx->config.dbdf_compression;
+    return opts;
+}
+
 // ****************************************************************************
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
@@ -68,7 +79,10 @@ template <typename VT> struct Write<DenseMatrix<VT>> {
         } else if (ext == "dbdf") {
             FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
             MetaDataParser::writeMetaData(filename, metaData);
-            writeDaphne(arg, filename);
+            if (ctx->config.dbdf_version == 1)
+                writeDaphne(arg, filename);
+            else
+                writeDaphneColumnar(arg, filename, getColumnarWriteOptions(ctx), ctx);
 #if USE_HDFS
         } else if (ext == "hdfs") {
             HDFSMetaData hdfs = {true, filename};
@@ -92,7 +106,6 @@ template <typename VT> struct Write<DenseMatrix<VT>> {
 
 template <> struct Write<Frame> {
     static void apply(const Frame *arg, const char *filename, DCTX(ctx)) {
-        File *file = openFileForWrite(filename);
         std::vector<ValueTypeCode> vtcs;
         std::vector<std::string> labels;
         for (size_t i = 0; i < arg->getNumCols(); i++) {
@@ -101,6 +114,16 @@ template <> struct Write<Frame> {
         }
         FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), false, vtcs, labels);
         MetaDataParser::writeMetaData(filename, metaData);
+
+        std::string fn(filename);
+        if (fn.substr(fn.find_last_of('.') + 1) == "dbdf") {
+            if (ctx->config.dbdf_version == 1)
+                writeDaphne(arg, filename);
+            else
+                writeDaphneColumnar(arg, filename, getColumnarWriteOptions(ctx), ctx);
+            return;
+        }
+        File *file = openFileForWrite(filename);
         writeCsv(arg, file);
         closeFile(file);
     }
@@ -233,7 +233,7 @@ def generateKernelInstantiation(kernelTemplateInfo, templateValues, opCodes, out
         argTypesTmp = []
         for t in argTypes:
             # TODO Don't hardcode these exceptions.
-            if t in ["void", "mlir::daphne::GroupEnum", "CompareOperation"]:
+            if t in ["void", "mlir::daphne::GroupEnum", "CompareOperation", "ValueTypeCode"]:
                 break
             argTypesTmp.append(t)
         argTypes = argTypesTmp
@@ -258,3 +258,46 @@ template <typename VT> class MTWrapper<CSRMatrix<VT>> : public MTWrapperBase<CSR
     void combineOutputs(CSRMatrix<VT> ***&res, CSRMatrix<VT> ***&res_cuda, [[maybe_unused]] size_t numOutputs,
                         [[maybe_unused]] mlir::daphne::VectorCombine *combines, DCTX(ctx)) override {}
 };
+
+/**
+ * @brief Executes pipelines whose outputs are frames on row ranges (morsels)
+ * of their inputs.
+ *
+ * The results of the morsels are concatenated in the order of the morsels
+ * (see `VectorizedDataSink<Frame>`), so the number of rows of a result need
+ * not be known in advance. Frames are only processed on the CPU.
+ */
+template <> class MTWrapper<Frame> : public MTWrapperBase<Frame> {
+  public:
+    using PipelineFunc = void(Frame ***, Structure **, DCTX(ctx));
+
+    explicit MTWrapper(uint32_t numFunctions, PipelineHWlocInfo topology, DCTX(ctx))
+        : MTWrapperBase<Frame>(numFunctions, topology, ctx) {}
+
+    [[maybe_unused]] void executeSingleQueue(std::vector<std::function<PipelineFunc>> funcs, Frame ***res,
+                                             const bool *isScalar, Structure **inputs, size_t numInputs,
+                                             size_t numOutputs, int64_t *outRows, int64_t *outCols, VectorSplit *splits,
+                                             VectorCombine *combines, DCTX(ctx), bool verbose) {
+        executeCpuQueues(funcs, res, isScalar, inputs, numInputs, numOutputs, outRows, outCols, splits, combines, ctx,
+                         verbose);
+    }
+
+    [[maybe_unused]] void executeCpuQueues(std::vector<std::function<PipelineFunc>> funcs, Frame ***res,
+                                           const bool *isScalar, Structure **inputs, size_t numInputs,
+                                           size_t numOutputs, int64_t *outRows, int64_t *outCols, VectorSplit *splits,
+                                           VectorCombine *combines, DCTX(ctx), bool verbose);
+
+    [[maybe_unused]] void executeQueuePerDeviceType(std::vector<std::function<PipelineFunc>> funcs, Frame ***res,
+                                                    const bool *isScalar, Structure **inputs, size_t numInputs,
+                                                    size_t numOutputs, int64_t *outRows, int64_t *outCols,
+                                                    VectorSplit *splits, VectorCombine *combines, DCTX(ctx),
+                                                    bool verbose) {
+        // There are no frame kernels for devices, so only the first function
+        // is used.
+        executeCpuQueues({funcs[0]}, res, isScalar, inputs, numInputs, numOutputs, outRows, outCols, splits, combines,
+                         ctx, verbose);
+    }
+
+    void combineOutputs(Frame ***&res, Frame ***&res_cuda, [[maybe_unused]] size_t numOutputs,
+                        [[maybe_unused]] mlir::daphne::VectorCombine *combines, DCTX(ctx)) override {}
+};
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MTWrapper.h"
+#include <runtime/local/vectorized/Tasks.h>
+
+[[maybe_unused]] void MTWrapper<Frame>::executeCpuQueues(std::vector<std::function<PipelineFunc>> funcs, Frame ***res,
+                                                         const bool *isScalar, Structure **inputs, size_t numInputs,
+                                                         size_t numOutputs, int64_t *outRows, int64_t *outCols,
+                                                         VectorSplit *splits, VectorCombine *combines, DCTX(ctx),
+                                                         bool verbose) {
+    // The size of the row-wise split inputs determines the number of rows to
+    // process. Frame columns have individual value types, so the memory per
+    // row is only estimated.
+    size_t len = 0;
+    size_t mem_required = 0;
+    for (size_t i = 0; i < numInputs; i++)
+        if (splits[i] == VectorSplit::ROWS) {
+            len = std::max(len, inputs[i]->getNumRows());
+            mem_required += inputs[i]->getNumItems() * sizeof(int64_t);
+        }
+    auto row_mem = std::max(1ul, mem_required / std::max(1ul, len));
+
+    std::vector<std::unique_ptr<TaskQueue>> q;
+    std::vector<TaskQueue *> qvector;
+    for (int i = 0; i < this->_numQueues; i++) {
+        if (ctx->getUserConfig().pinWorkers) {
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(i, &cpuset);
+            sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+        }
+        q.push_back(std::make_unique<BlockingTaskQueue>(len));
+        qvector.push_back(q[i].get());
+    }
+
+    auto batchSize8M = std::max(100ul, static_cast<size_t>(std::ceil(8388608 / row_mem)));
+    this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
+                         ctx->getUserConfig().pinWorkers);
+
+    for (size_t i = 0; i < numOutputs; i++)
+        if (*(res[i]) != nullptr)
+            throw std::runtime_error("MTWrapper<Frame>: the outputs must not be allocated in advance");
+
+    std::vector<VectorizedDataSink<Frame> *> dataSinks(numOutputs);
+    for (size_t i = 0; i < numOutputs; i++)
+        dataSinks[i] = new VectorizedDataSink<Frame>(combines[i]);
+
+    // create tasks and close input
+    auto enqueue = [&](uint64_t startChunk, uint64_t endChunk, uint64_t target) {
+        auto task = new CompiledPipelineTask<Frame>(
+            CompiledPipelineTaskData<Frame>{funcs, isScalar, inputs, numInputs, numOutputs, outRows, outCols, splits,
+                                            combines, startChunk, endChunk, outRows, outCols, 0, ctx},
+            dataSinks);
+        if (ctx->getUserConfig().pinWorkers)
+            qvector[target]->enqueueTask(task, this->_topology.uniqueThreads[target]);
+        else
+            qvector[target]->enqueueTask(task);
+    };
+    if (len == 0)
+        // A single empty morsel yields the (empty) results.
+        enqueue(0, 0, 0);
+    else {
+        SelfSchedulingScheme schedulingScheme = ctx->config.taskPartitioningScheme;
+        int chunkParam = ctx->config.minimumTaskSize;
+        if (chunkParam <= 0)
+            chunkParam = 1;
+        LoadPartitioning lp(schedulingScheme, len, chunkParam, this->_numThreads,
+                            schedulingScheme == SelfSchedulingScheme::AUTO);
+        uint64_t startChunk = 0;
+        uint64_t endChunk = 0;
+        uint64_t currentItr = 0;
+        while (lp.hasNextChunk()) {
+            endChunk += lp.getNextChunk();
+            enqueue(startChunk, endChunk, currentItr % this->_numQueues);
+            startChunk = endChunk;
+            currentItr++;
+        }
+    }
+    for (int i = 0; i < this->_numQueues; i++)
+        qvector[i]->closeInput();
+
+    this->joinAll();
+    for (size_t i = 0; i < numOutputs; i++) {
+        *(res[i]) = dataSinks[i]->consume();
+        delete dataSinks[i];
+    }
+}
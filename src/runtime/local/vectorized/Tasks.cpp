@@ -178,6 +178,36 @@ template <typename VT> void CompiledPipelineTask<CSRMatrix<VT>>::execute(uint32_
 
 template <typename VT> uint64_t CompiledPipelineTask<CSRMatrix<VT>>::getTaskSize() { return _data._ru - _data._rl; }
 
+void CompiledPipelineTask<Frame>::execute(uint32_t fid, uint32_t batchSize) {
+    std::vector<Frame *> lres(_data._numOutputs, nullptr);
+    std::vector<Frame **> outputs;
+    for (auto &r : lres)
+        outputs.push_back(&r);
+    // Even an empty input yields one (empty) result, such that the schema of
+    // the combined result is known.
+    uint64_t r = _data._rl;
+    do {
+        // create zero-copy views of inputs
+        uint64_t r2 = std::min(r + batchSize, _data._ru);
+
+        auto linputs = this->createFuncInputs(r, r2);
+
+        // execute function on given data binding (batch size)
+        _data._funcs[fid](outputs.data(), linputs.data(), _data._ctx);
+        for (size_t i = 0; i < _data._numOutputs; i++) {
+            _resultSinks[i]->add(lres[i], r);
+            lres[i] = nullptr;
+        }
+
+        // Note that a pipeline manages the reference counters of its inputs
+        // internally. Thus, we do not need to care about freeing the inputs
+        // here.
+        r = r2;
+    } while (r < _data._ru);
+}
+
+uint64_t CompiledPipelineTask<Frame>::getTaskSize() { return _data._ru - _data._rl; }
+
 template class CompiledPipelineTask<DenseMatrix<double>>;
 template class CompiledPipelineTask<DenseMatrix<float>>;
 template class CompiledPipelineTask<DenseMatrix<int64_t>>;
@@ -141,3 +141,14 @@ template <typename VT> class CompiledPipelineTask<CSRMatrix<VT>> : public Compil
     void execute(uint32_t fid, uint32_t batchSize) override;
     uint64_t getTaskSize() override;
 };
+
+template <> class CompiledPipelineTask<Frame> : public CompiledPipelineTaskBase<Frame> {
+    std::vector<VectorizedDataSink<Frame> *> &_resultSinks;
+
+  public:
+    CompiledPipelineTask(CompiledPipelineTaskData<Frame> data, std::vector<VectorizedDataSink<Frame> *> &resultSinks)
+        : CompiledPipelineTaskBase<Frame>(data), _resultSinks(resultSinks) {}
+
+    void execute(uint32_t fid, uint32_t batchSize) override;
+    uint64_t getTaskSize() override;
+};
@@ -17,11 +17,17 @@
 #pragma once
 
 #include <ir/daphneir/Daphne.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
 #include <runtime/local/kernels/Transpose.h>
 #include <util/preprocessor_defs.h>
 
+#include <algorithm>
+#include <map>
 #include <mutex>
 #include <queue>
+#include <string>
 
 using mlir::daphne::VectorCombine;
 
@@ -137,3 +143,71 @@ template <typename VT> class VectorizedDataSink<CSRMatrix<VT>> {
         return res;
     }
 };
+
+/**
+ * @brief Concatenates the results a pipeline produces on the individual row
+ * ranges (morsels) of its inputs in the order of these ranges.
+ *
+ * In contrast to matrices, the number of rows of a frame result is generally
+ * not known in advance (e.g., for `FilterRow`), so the results of all morsels
+ * are kept until the pipeline has finished.
+ */
+template <> class VectorizedDataSink<Frame> {
+    std::map<uint64_t, Frame *> _results;
+    std::mutex _mtx;
+    uint64_t _numRows = 0;
+
+  public:
+    explicit VectorizedDataSink(VectorCombine combine) {
+        if (combine != VectorCombine::ROWS)
+            throw std::runtime_error("Vectorization of frames only implemented for row-wise combines");
+    }
+
+    ~VectorizedDataSink() {
+        for (auto &[startRow, frame] : _results)
+            DataObjectFactory::destroy(frame);
+    }
+
+    /**
+     * @brief Adds the result of the morsel starting at the given row of the
+     * inputs and takes its ownership.
+     */
+    void add(Frame *frame, uint64_t startRow) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _results.emplace(startRow, frame);
+        _numRows += frame->getNumRows();
+    }
+
+    Frame *consume() {
+        if (_results.empty())
+            throw std::runtime_error("Vectorized Frame without any iterations");
+        // A single morsel needs no copying.
+        if (_results.size() == 1) {
+            Frame *res = _results.begin()->second;
+            _results.clear();
+            return res;
+        }
+
+        const Frame *first = _results.begin()->second;
+        const size_t numCols = first->getNumCols();
+        const ValueTypeCode *schema = first->getSchema();
+        auto *res = DataObjectFactory::create<Frame>(_numRows, numCols, schema, first->getLabels(), false);
+        size_t row = 0;
+        for (auto &[startRow, frame] : _results) {
+            const size_t numRows = frame->getNumRows();
+            for (size_t c = 0; c < numCols; c++) {
+                if (schema[c] == ValueTypeCode::STR) {
+                    auto col = static_cast<const std::string *>(frame->getColumnRaw(c));
+                    std::copy(col, col + numRows, static_cast<std::string *>(res->getColumnRaw(c)) + row);
+                } else {
+                    const size_t elemSize = ValueTypeUtils::sizeOf(schema[c]);
+                    auto col = static_cast<const uint8_t *>(frame->getColumnRaw(c));
+                    auto resCol = static_cast<uint8_t *>(res->getColumnRaw(c));
+                    std::copy(col, col + numRows * elemSize, resCol + row * elemSize);
+                }
+            }
+            row += numRows;
+        }
+        return res;
+    }
+};
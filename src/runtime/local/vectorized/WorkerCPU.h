@@ -17,6 +17,7 @@
 #pragma once
 
 #include "Worker.h"
+#include <runtime/local/kernels/ParallelFor.h>
 #include <runtime/local/vectorized/TaskQueues.h>
 #include <spdlog/spdlog.h>
 #include <utility>
@@ -52,6 +53,9 @@ class WorkerCPU : public Worker {
     ~WorkerCPU() override = default;
 
     void run() override {
+        // Kernels in the pipeline must not spawn threads of their own.
+        insideVectorizedPipeline = true;
+
         if (_pinWorkers) {
             // pin worker to CPU core
             cpu_set_t cpuset;
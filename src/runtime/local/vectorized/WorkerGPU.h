@@ -17,6 +17,7 @@
 #pragma once
 
 #include "Worker.h"
+#include <runtime/local/kernels/ParallelFor.h>
 #include <runtime/local/vectorized/TaskQueues.h>
 
 class WorkerGPU : public Worker {
@@ -36,6 +37,8 @@ class WorkerGPU : public Worker {
     ~WorkerGPU() override = default;
 
     void run() override {
+        // Kernels in the pipeline must not spawn threads of their own.
+        insideVectorizedPipeline = true;
         Task *t = _q->dequeueTask();
 
         while (!isEOF(t)) {
@@ -99,6 +99,11 @@ if python3 -c "import torch" 2> /dev/null; then
 else
     export DAPHNE_DEP_AVAIL_PYTORCH=0
 fi
+if python3 -c "import pyarrow" 2> /dev/null; then
+    export DAPHNE_DEP_AVAIL_PYARROW=1
+else
+    export DAPHNE_DEP_AVAIL_PYARROW=0
+fi
 
 # Run tests.
 # shellcheck disable=SC2086
@@ -39,3 +39,10 @@ TEST_CASE("ewloopfusion", TAG_CODEGEN) {
     compareDaphneToStr(result, dirPath + "fusion.daphne");
     compareDaphneToStr(result, dirPath + "fusion.daphne", "--mlir-codegen");
 }
+
+TEST_CASE("ewloopfusion into aggregation", TAG_CODEGEN) {
+    std::string result = "31\n";
+
+    compareDaphneToStr(result, dirPath + "fusion_agg.daphne");
+    compareDaphneToStr(result, dirPath + "fusion_agg.daphne", "--mlir-codegen");
+}
@@ -58,6 +58,15 @@ TEST_CASE("matmul tiled and vectorized", TAG_CODEGEN TAG_MATMUL) {
     compareDaphneToStr(result, dirPath + "matmul.daphne", "--mlir-codegen", "--matmul-vec-size-bits=64",
                        "--matmul-fixed-tile-sizes=2,2,2");
 }
+TEST_CASE("matmul tuned", TAG_CODEGEN TAG_MATMUL) {
+    std::string result = "DenseMatrix(3x3, double)\n"
+                         "45 45 45\n"
+                         "45 45 45\n"
+                         "45 45 45\n";
+
+    const std::string profileArg = "--matmul-tuning-profile=" + dirPath + "matmul_tuning_profile.json";
+    compareDaphneToStr(result, dirPath + "matmul.daphne", "--mlir-codegen", profileArg.c_str());
+}
 TEST_CASE("matmul single", TAG_CODEGEN TAG_MATMUL) {
     std::string result = "DenseMatrix(3x3, float)\n"
                          "45 45 45\n"
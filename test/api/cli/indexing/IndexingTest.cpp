@@ -47,5 +47,5 @@ MAKE_FAILURE_TEST_CASE("right_indexing", 10)
 
 // TODO Add a test case for multi-assignments (`X[...], Y[...] = ...`).
 MAKE_SUCCESS_TEST_CASE("left_indexing", 3)
-MAKE_SUCCESS_TEST_CASE("left_indexing_cow", 8)
+MAKE_SUCCESS_TEST_CASE("left_indexing_cow", 11)
 MAKE_FAILURE_TEST_CASE("left_indexing", 7)
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include <catch.hpp>
 
 #include <filesystem>
+#include <sstream>
 #include <string>
 
 const std::string dirPath = "test/api/cli/io/";
@@ -69,6 +70,39 @@ MAKE_READ_TEST_CASE_2("frame_dynamic-path-1")
 // MAKE_READ_TEST_CASE_2("frame_dynamic-path-2")
 // MAKE_READ_TEST_CASE_2("frame_dynamic-path-3")
 
+// These test cases check if asynchronous reads (--async-read) produce the same data as the regular reads. They use the
+// same scripts and reference files as the read test cases above.
+#define MAKE_ASYNC_READ_TEST_CASE(dt, name, nanSafe)                                                                   \
+    TEST_CASE("read_async_" dt "_" name, TAG_IO) {                                                                     \
+        const std::string scriptPath = dirPath + "read/read_" + dt + "_" + name + ".daphne";                           \
+        const std::string inPath = dirPath + "ref/" + dt + "_" + name + "_ref.csv";                                    \
+        compareDaphneToStr("0\n", scriptPath.c_str(), "--async-read", "--args",                                        \
+                           ("inPath=\"" + inPath + "\",nanSafe=" + nanSafe).c_str());                                  \
+    }
+
+MAKE_ASYNC_READ_TEST_CASE("matrix", "si64", "false")
+MAKE_ASYNC_READ_TEST_CASE("matrix", "f64", "true")
+MAKE_ASYNC_READ_TEST_CASE("matrix", "str", "false")
+MAKE_ASYNC_READ_TEST_CASE("frame", "mixed-no-str", "false")
+MAKE_ASYNC_READ_TEST_CASE("frame", "mixed-str", "false")
+
+TEST_CASE("read_async_read-in-udf", TAG_IO) {
+    compareDaphneToStr("0\n", dirPath + "read/read_matrix_read-in-udf.daphne", "--async-read");
+    compareDaphneToStr("0\n", dirPath + "read/read_frame_read-in-udf.daphne", "--async-read");
+}
+
+// The script stops while the read is still pending, such that its result is never awaited.
+TEST_CASE("read_async_not-awaited", TAG_IO) {
+    std::stringstream out;
+    std::stringstream err;
+    const std::string scriptPath = dirPath + "read/read_async_not-awaited.daphne";
+    const std::string inPath = dirPath + "ref/matrix_f64_ref.csv";
+    int status = runDaphne(out, err, "--async-read", "--args", ("inPath=\"" + inPath + "\"").c_str(),
+                           scriptPath.c_str());
+    CHECK(status == StatusCode::EXECUTION_ERROR);
+    CHECK_THAT(out.str(), Catch::Contains("system stopped: before the read result is used"));
+}
+
 // ********************************************************************************
 // Write test cases
 // ********************************************************************************
@@ -108,4 +142,26 @@ MAKE_WRITE_TEST_CASE("matrix", "f64", "true")
 MAKE_WRITE_TEST_CASE("matrix", "str", "false")
 MAKE_WRITE_TEST_CASE("matrix", "view", "false")
 MAKE_WRITE_TEST_CASE("frame", "mixed-no-str", "false")
-MAKE_WRITE_TEST_CASE("frame", "mixed-str", "false")
\ No newline at end of file
+MAKE_WRITE_TEST_CASE("frame", "mixed-str", "false")
+
+// These test cases check if matrices/frames written in the DAPHNE binary format can be read again. They use the same
+// scripts and reference files as the CSV write test cases above.
+#define MAKE_WRITE_DBDF_TEST_CASE(dt, name, nanSafe)                                                                   \
+    TEST_CASE("write_dbdf_" dt "_" name, TAG_IO) {                                                                     \
+        const std::string scriptPathWrt = dirPath + "write/write_" + dt + "_" + name + ".daphne";                      \
+        const std::string scriptPathCmp = dirPath + "do_check_" + dt + ".daphne";                                      \
+        const std::string outPath = dirPath + "out/" + dt + "_" + name + ".dbdf";                                      \
+        const std::string refPath = dirPath + "ref/" + dt + "_" + name + "_ref.csv";                                   \
+        std::filesystem::remove(outPath); /* remove old output file if it still exists */                              \
+        checkDaphneStatusCode(StatusCode::SUCCESS, scriptPathWrt.c_str(), "--args",                                    \
+                              ("outPath=\"" + outPath + "\"").c_str());                                                \
+        compareDaphneToStr("0\n", scriptPathCmp.c_str(), "--args",                                                     \
+                           ("chkPath=\"" + outPath + "\",refPath=\"" + refPath + "\",nanSafe=" + nanSafe).c_str());    \
+    }
+
+MAKE_WRITE_DBDF_TEST_CASE("matrix", "si64", "false")
+MAKE_WRITE_DBDF_TEST_CASE("matrix", "f64", "true")
+MAKE_WRITE_DBDF_TEST_CASE("matrix", "str", "false")
+MAKE_WRITE_DBDF_TEST_CASE("matrix", "view", "false")
+MAKE_WRITE_DBDF_TEST_CASE("frame", "mixed-no-str", "false")
+MAKE_WRITE_DBDF_TEST_CASE("frame", "mixed-str", "false")
@@ -43,3 +43,13 @@ TEST_CASE("binary_operator_casts_constant_folding", TAG_CODEGEN TAG_OPERATIONS)
     const std::string testName = "binary_op_casts_constant_folding";
     compareDaphneParsingSimplifiedToRef(dirPath + testName + ".txt", dirPath + testName + ".daphne");
 }
+
+TEST_CASE("order_slice_to_topk_canonicalization", TAG_CODEGEN TAG_OPERATIONS) {
+    // Only checks that the rewrite happens, the output is checked by the order_2 test.
+    std::stringstream out;
+    std::stringstream err;
+    int status = runDaphne(out, err, "--explain=parsing_simplified", (dirPath + "order_2.daphne").c_str());
+    CHECK(status == StatusCode::SUCCESS);
+    CHECK(err.str().find("\"daphne.topK\"") != std::string::npos);
+    CHECK(err.str().find("\"daphne.order\"") == std::string::npos);
+}
@@ -56,7 +56,7 @@ MAKE_TEST_CASE("operator_minus", 4)
 MAKE_TEST_CASE("operator_plus", 2)
 MAKE_TEST_CASE("operator_slash", 1)
 MAKE_TEST_CASE("operator_times", 1)
-MAKE_TEST_CASE("order", 1)
+MAKE_TEST_CASE("order", 2)
 MAKE_TEST_CASE("rbind", 1)
 MAKE_TEST_CASE("recode", 4)
 MAKE_TEST_CASE("replace", 1)
@@ -67,5 +67,12 @@ MAKE_TEST_CASE("solve", 1)
 MAKE_TEST_CASE("sqrt", 1)
 MAKE_TEST_CASE("sum", 1)
 MAKE_TEST_CASE("syrk", 1)
-MAKE_TEST_CASE("transpose", 1)
-MAKE_TEST_CASE("upper", 1)
\ No newline at end of file
+MAKE_TEST_CASE("transpose", 2)
+MAKE_TEST_CASE("upper", 1)
+
+TEST_CASE("matMulAdaptive", TAG_OPERATIONS) {
+    // The representation of the lhs is chosen at run-time, and must not change
+    // the result.
+    compareDaphneToRefSimple(dirPath, "matMulAdaptive", 1, "--select-matrix-repr");
+    compareDaphneToRefSimple(dirPath, "matMulAdaptive", 1, "--select-matrix-repr", "--no-adaptive-matrix-repr");
+}
@@ -107,4 +107,6 @@ MAKE_TEST_CASE("distinct", 4)
 MAKE_TEST_CASE("strings", 6)
 
 MAKE_TEST_CASE("between", 4)
+
+MAKE_TEST_CASE("commaJoin", 3)
 // TODO Use the scripts testing failure cases.
@@ -63,4 +63,23 @@ void compareDaphneToDaphneOtherArgs(const std::string &scriptFilePath) {
         }                                                                                                              \
     }
 
-MAKE_TEST_CASE("pipeline", 9)
+MAKE_TEST_CASE("pipeline", 12)
+
+TEST_CASE("pipeline with several morsels", TAG_VECTORIZED) {
+    // With a fixed number of threads, the frame is split into several morsels
+    // independently of the number of cores of the machine running the test.
+    const std::string scriptFilePath = dirPath + GENERATE("pipeline_11.daphne", "pipeline_12.daphne");
+
+    std::stringstream outN;
+    std::stringstream errN;
+    int statusN = runDaphne(outN, errN, scriptFilePath.c_str());
+
+    std::stringstream outV;
+    std::stringstream errV;
+    int statusV = runDaphne(outV, errV, "--vec", "--num-threads=4", scriptFilePath.c_str());
+
+    CHECK(statusN == StatusCode::SUCCESS);
+    CHECK(statusV == StatusCode::SUCCESS);
+    CHECK(generalizeDataTypes(outN.str()) == generalizeDataTypes(outV.str()));
+    CHECK(errN.str() == errV.str());
+}
@@ -74,6 +74,8 @@ MAKE_TEST_CASE("data_transfer_pandas_2")
 MAKE_TEST_CASE("data_transfer_pandas_3_series")
 MAKE_TEST_CASE("data_transfer_pandas_4_sparse_dataframe")
 MAKE_TEST_CASE("data_transfer_pandas_5_categorical_dataframe")
+MAKE_TEST_CASE_ENVVAR("data_transfer_pandas_6_arrow", "DAPHNE_DEP_AVAIL_PYARROW")
+MAKE_TEST_CASE("data_transfer_pandas_7_categorical_codes")
 MAKE_TEST_CASE_ENVVAR("data_transfer_pytorch_1", "DAPHNE_DEP_AVAIL_PYTORCH")
 MAKE_TEST_CASE_ENVVAR("data_transfer_tensorflow_1", "DAPHNE_DEP_AVAIL_TENSFORFLOW")
 MAKE_TEST_CASE("frame_innerJoin")
@@ -110,6 +112,7 @@ MAKE_TEST_CASE_STR("matrix_indexing_3", "90\n")
 MAKE_TEST_CASE_SCALAR("numpy_matrix_ops")
 MAKE_TEST_CASE_SCALAR("numpy_matrix_ops_extended")
 MAKE_TEST_CASE("numpy_matrix_ops_replace")
+MAKE_TEST_CASE("session_resident_objects")
 
 // Tests for DaphneLib complex control flow.
 MAKE_TEST_CASE_PARAMETRIZED("if_else_simple", "param=3.8")
@@ -26,4 +26,4 @@ cdf = df.astype("category")
 
 dctx = DaphneContext()
 
-dctx.from_pandas(df, shared_memory=True).print().compute(type="shared memory")
\ No newline at end of file
+dctx.from_pandas(cdf, shared_memory=True).print().compute(type="shared memory")
\ No newline at end of file
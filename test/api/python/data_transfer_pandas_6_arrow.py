@@ -0,0 +1,35 @@
+#!/usr/bin/python
+
+# Copyright 2024 The DAPHNE Consortium
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Data transfer from pandas to DAPHNE and back, via the Arrow C data interface.
+# pd.DataFrame with strings, categorical data, missing values, and narrow types
+
+import numpy as np
+import pandas as pd
+from daphne.context.daphne_context import DaphneContext
+
+df = pd.DataFrame({
+    "a": [1.5, 2.5, 3.5],
+    "b": pd.array([1, None, 3], dtype="Int64"),
+    "c": ["x", "yy", "zzz"],
+    "d": pd.Categorical(["lo", "hi", "lo"]),
+    "e": np.array([1, 2, 3], dtype=np.int16),
+    "f": [True, False, True],
+})
+
+dctx = DaphneContext()
+
+dctx.from_pandas(df, shared_memory=True).print().compute(type="shared memory")
@@ -0,0 +1,31 @@
+# Copyright 2024 The DAPHNE Consortium
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from daphne.context.daphne_context import DaphneContext
+
+dctx = DaphneContext(session=True)
+
+dctx.seq(1, 6, 1).storeResident("X").compute()
+(dctx.loadResidentMatrix("X") * 2).storeResident("Y").compute()
+# The second run reuses the compiled script.
+numCacheHits = dctx.sessionCacheHits()
+for i in range(2):
+    dctx.loadResidentMatrix("Y").sum().print().compute()
+assert dctx.sessionCacheHits() == numCacheHits + 1
+
+dctx.createFrame([dctx.seq(1, 3, 1), dctx.fill(1.23, 3, 1)], ["a", "b"]).storeResident("F").compute()
+dctx.loadResidentFrame("F").print().compute()
+
+dctx.dropResident("X")
+dctx.close()
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+
+#include <nlohmannjson/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief The timings of one benchmark for one combination of parameters.
+ */
+struct BenchResult {
+    std::string name;
+    nlohmann::json params;
+    std::vector<double> timesNs;
+
+    nlohmann::json toJson() const {
+        std::vector<double> sorted = timesNs;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0;
+        for (double t : sorted)
+            sum += t;
+        return {{"name", name},
+                {"params", params},
+                {"repetitions", sorted.size()},
+                {"min_ns", sorted.front()},
+                {"median_ns", sorted[sorted.size() / 2]},
+                {"mean_ns", sum / sorted.size()}};
+    }
+};
+
+/**
+ * @brief Runs the measurements of a benchmark case and collects the results.
+ *
+ * A benchmark case sets up its inputs for each combination of parameters and
+ * then calls `measure()` with the code to time, which must leave the inputs
+ * unchanged. Allocations of results should be part of the timed code, since
+ * kernels usually allocate their results themselves.
+ */
+class BenchRunner {
+    DaphneContext *ctx;
+    size_t repetitions;
+    std::string filter;
+    std::vector<BenchResult> &results;
+    bool verbose;
+
+  public:
+    BenchRunner(DaphneContext *ctx, size_t repetitions, std::string filter, std::vector<BenchResult> &results,
+                bool verbose)
+        : ctx(ctx), repetitions(repetitions), filter(std::move(filter)), results(results), verbose(verbose) {}
+
+    DaphneContext *getContext() const { return ctx; }
+
+    /**
+     * @brief Returns if the benchmark with the given name is selected by the
+     * filter; cases can use this to skip expensive setups.
+     */
+    bool isSelected(const std::string &name) const { return name.find(filter) != std::string::npos; }
+
+    /**
+     * @brief Times `f` after one warm-up run, unless the benchmark is not
+     * selected by the filter.
+     */
+    void measure(const std::string &name, const nlohmann::json &params, const std::function<void()> &f) {
+        if (!isSelected(name))
+            return;
+        using clock = std::chrono::steady_clock;
+        f();
+        BenchResult res{name, params, {}};
+        for (size_t i = 0; i < repetitions; i++) {
+            auto start = clock::now();
+            f();
+            auto end = clock::now();
+            res.timesNs.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        if (verbose)
+            std::cerr << name << " " << params.dump() << ": " << res.toJson()["median_ns"] << " ns" << std::endl;
+        results.push_back(std::move(res));
+    }
+};
+
+using BenchCase = void (*)(BenchRunner &);
+
+inline std::vector<std::pair<std::string, BenchCase>> &benchCases() {
+    static std::vector<std::pair<std::string, BenchCase>> cases;
+    return cases;
+}
+
+struct BenchRegistrar {
+    BenchRegistrar(const char *name, BenchCase f) { benchCases().emplace_back(name, f); }
+};
+
+/**
+ * @brief Defines a benchmark case, which is registered with `daphne_bench`.
+ */
+#define BENCH_CASE(name)                                                                                               \
+    static void name(BenchRunner &bench);                                                                              \
+    static BenchRegistrar name##Registrar(#name, name);                                                                \
+    static void name(BenchRunner &bench)
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/BatchNorm2DTestForward.h>
+#include <runtime/local/kernels/Conv2DForward.h>
+#include <runtime/local/kernels/MaxPoolForward.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <vector>
+
+#include <cstddef>
+
+namespace {
+/**
+ * @brief The shape of a batch of images, like in the layers of a small CNN.
+ */
+struct ImageShape {
+    size_t batchSize;
+    size_t numChannels;
+    size_t imgH;
+    size_t imgW;
+};
+
+const std::vector<ImageShape> imageShapes = {{1, 3, 224, 224}, {32, 3, 32, 32}, {32, 64, 16, 16}};
+
+nlohmann::json params(const ImageShape &s) {
+    return {{"batch_size", s.batchSize}, {"num_channels", s.numChannels}, {"img_h", s.imgH}, {"img_w", s.imgW}};
+}
+
+DenseMatrix<float> *createImages(const ImageShape &s, DaphneContext *ctx) {
+    DenseMatrix<float> *res = nullptr;
+    randMatrix<DenseMatrix<float>, float>(res, s.batchSize, s.numChannels * s.imgH * s.imgW, -1.0f, 1.0f, 1.0, 1,
+                                          ctx);
+    return res;
+}
+} // namespace
+
+BENCH_CASE(Conv2DForwardBench) {
+    if (!bench.isSelected("Conv2DForward/3x3"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    const size_t numFilters = 32;
+    for (const auto &s : imageShapes) {
+        auto data = createImages(s, ctx);
+        DenseMatrix<float> *filter = nullptr, *bias = nullptr;
+        randMatrix<DenseMatrix<float>, float>(filter, numFilters, s.numChannels * 3 * 3, -1.0f, 1.0f, 1.0, 2, ctx);
+        randMatrix<DenseMatrix<float>, float>(bias, numFilters, 1, -1.0f, 1.0f, 1.0, 3, ctx);
+        bench.measure("Conv2DForward/3x3", params(s), [&]() {
+            DenseMatrix<float> *res = nullptr;
+            size_t resH, resW;
+            conv2DForward(res, resH, resW, data, filter, bias, s.batchSize, s.numChannels, s.imgH, s.imgW, 3, 3, 1, 1,
+                          1, 1, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        DataObjectFactory::destroy(data, filter, bias);
+    }
+}
+
+BENCH_CASE(PoolingAndBatchNormBench) {
+    if (!bench.isSelected("MaxPoolForward/2x2") && !bench.isSelected("BatchNorm2DTestForward"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (const auto &s : imageShapes) {
+        auto data = createImages(s, ctx);
+        bench.measure("MaxPoolForward/2x2", params(s), [&]() {
+            DenseMatrix<float> *res = nullptr;
+            size_t resH, resW;
+            maxPoolForward(res, resH, resW, data, s.batchSize, s.numChannels, s.imgH, s.imgW, 2, 2, 2, 2, 0, 0, ctx);
+            DataObjectFactory::destroy(res);
+        });
+
+        DenseMatrix<float> *gamma = nullptr, *beta = nullptr, *emaMean = nullptr, *emaVar = nullptr;
+        randMatrix<DenseMatrix<float>, float>(gamma, s.numChannels, 1, 0.5f, 1.5f, 1.0, 2, ctx);
+        randMatrix<DenseMatrix<float>, float>(beta, s.numChannels, 1, -1.0f, 1.0f, 1.0, 3, ctx);
+        randMatrix<DenseMatrix<float>, float>(emaMean, s.numChannels, 1, -1.0f, 1.0f, 1.0, 4, ctx);
+        randMatrix<DenseMatrix<float>, float>(emaVar, s.numChannels, 1, 0.5f, 1.5f, 1.0, 5, ctx);
+        bench.measure("BatchNorm2DTestForward", params(s), [&]() {
+            DenseMatrix<float> *res = nullptr;
+            batchNorm2DTestForward(res, data, gamma, beta, emaMean, emaVar, 1e-5f, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        DataObjectFactory::destroy(data, gamma, beta, emaMean, emaVar);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <runtime/local/datastructures/AllocationDescriptorHost.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Range.h>
+
+#include <string>
+
+#include <cstddef>
+
+namespace {
+/**
+ * @brief Sums up a column of a matrix cell by cell through `get()`, which
+ * calls `getValues()` for every cell, like many kernels do in their inner
+ * loops.
+ */
+double sumColViaGet(const DenseMatrix<double> *arg) {
+    double sum = 0;
+    for (size_t r = 0; r < arg->getNumRows(); r++)
+        sum += arg->get(r, 0);
+    return sum;
+}
+
+void benchGetValues(BenchRunner &bench, const std::string &variant, bool hostOnly) {
+    const std::string nameGetValues = "DenseMatrix/getValues/" + variant;
+    const std::string nameGet = "DenseMatrix/get/" + variant;
+    if (!bench.isSelected(nameGetValues) && !bench.isSelected(nameGet))
+        return;
+    const size_t numRows = 1000000;
+    auto m = DataObjectFactory::create<DenseMatrix<double>>(numRows, 1, true);
+    if (!hostOnly) {
+        // An additional placement forces getValues() through the data
+        // placement bookkeeping, as for matrices with non-host copies.
+        AllocationDescriptorHost hostAlloc;
+        Range range{0, 0, 1, 1};
+        m->getMetaDataObject()->addDataPlacement(&hostAlloc, &range);
+    }
+    const DenseMatrix<double> *cm = m;
+    nlohmann::json params = {{"num_calls", numRows}};
+    bench.measure(nameGetValues, params, [&]() {
+        const double *volatile sink = nullptr;
+        for (size_t i = 0; i < numRows; i++)
+            sink = cm->getValues();
+        (void)sink;
+    });
+    bench.measure(nameGet, params, [&]() {
+        volatile double sink = sumColViaGet(cm);
+        (void)sink;
+    });
+    DataObjectFactory::destroy(m);
+}
+} // namespace
+
+BENCH_CASE(DenseMatrixGetValuesBench) {
+    benchGetValues(bench, "host_only", true);
+    benchGetValues(bench, "with_placements", false);
+}
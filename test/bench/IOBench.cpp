@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/File.h>
+#include <runtime/local/io/ReadCsv.h>
+#include <runtime/local/io/ReadDaphne.h>
+#include <runtime/local/io/WriteCsv.h>
+#include <runtime/local/io/WriteDaphne.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace {
+const std::vector<std::pair<size_t, size_t>> shapes = {{100000, 10}, {10000, 100}};
+
+nlohmann::json params(size_t numRows, size_t numCols) {
+    return {{"value_type", "double"}, {"num_rows", numRows}, {"num_cols", numCols}};
+}
+
+std::string tempPath(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("daphne_bench_" + name)).string();
+}
+} // namespace
+
+BENCH_CASE(ReadBench) {
+    if (!bench.isSelected("ReadCsv/dense") && !bench.isSelected("ReadDaphne/dense"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (auto [numRows, numCols] : shapes) {
+        DenseMatrix<double> *arg = nullptr;
+        randMatrix<DenseMatrix<double>, double>(arg, numRows, numCols, 0.0, 1.0, 1.0, 1, ctx);
+
+        if (bench.isSelected("ReadCsv/dense")) {
+            const std::string path = tempPath("read.csv");
+            File *file = openFileForWrite(path.c_str());
+            writeCsv(arg, file);
+            closeFile(file);
+            bench.measure("ReadCsv/dense", params(numRows, numCols), [&]() {
+                DenseMatrix<double> *res = nullptr;
+                readCsv(res, path.c_str(), numRows, numCols, ',');
+                DataObjectFactory::destroy(res);
+            });
+            std::filesystem::remove(path);
+        }
+
+        if (bench.isSelected("ReadDaphne/dense")) {
+            const std::string path = tempPath("read.dbdf");
+            writeDaphne(arg, path.c_str());
+            bench.measure("ReadDaphne/dense", params(numRows, numCols), [&]() {
+                DenseMatrix<double> *res = nullptr;
+                readDaphne(res, path.c_str());
+                DataObjectFactory::destroy(res);
+            });
+            std::filesystem::remove(path);
+        }
+
+        DataObjectFactory::destroy(arg);
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/kernels/AggCol.h>
+#include <runtime/local/kernels/AggOpCode.h>
+#include <runtime/local/kernels/AggRow.h>
+#include <runtime/local/kernels/BinaryOpCode.h>
+#include <runtime/local/kernels/EwBinaryMat.h>
+#include <runtime/local/kernels/MatMul.h>
+#include <runtime/local/kernels/RandMatrix.h>
+#include <runtime/local/kernels/Transpose.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+const std::vector<std::pair<size_t, size_t>> shapes = {{1000, 1000}, {100000, 10}, {10, 100000}};
+
+template <typename VT> nlohmann::json params(size_t numRows, size_t numCols, double sparsity = 1.0) {
+    return {{"value_type", ValueTypeUtils::cppNameFor<VT>},
+            {"num_rows", numRows},
+            {"num_cols", numCols},
+            {"sparsity", sparsity}};
+}
+
+template <typename VT> void benchMatMulDense(BenchRunner &bench) {
+    if (!bench.isSelected("MatMul/dense"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (size_t n : {64, 256, 1024}) {
+        DenseMatrix<VT> *lhs = nullptr, *rhs = nullptr;
+        randMatrix<DenseMatrix<VT>, VT>(lhs, n, n, VT(0), VT(1), 1.0, 1, ctx);
+        randMatrix<DenseMatrix<VT>, VT>(rhs, n, n, VT(0), VT(1), 1.0, 2, ctx);
+        bench.measure("MatMul/dense", params<VT>(n, n), [&]() {
+            DenseMatrix<VT> *res = nullptr;
+            matMul(res, lhs, rhs, false, false, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        DataObjectFactory::destroy(lhs, rhs);
+    }
+}
+
+template <typename VT> void benchMatMulSparse(BenchRunner &bench) {
+    if (!bench.isSelected("MatMul/sparse"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    const size_t n = 4096;
+    for (double sparsity : {0.001, 0.01, 0.1}) {
+        CSRMatrix<VT> *lhs = nullptr;
+        DenseMatrix<VT> *rhs = nullptr;
+        randMatrix<CSRMatrix<VT>, VT>(lhs, n, n, VT(1), VT(2), sparsity, 1, ctx);
+        randMatrix<DenseMatrix<VT>, VT>(rhs, n, 16, VT(0), VT(1), 1.0, 2, ctx);
+        bench.measure("MatMul/sparse", params<VT>(n, n, sparsity), [&]() {
+            DenseMatrix<VT> *res = nullptr;
+            matMul(res, lhs, rhs, false, false, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        DataObjectFactory::destroy(lhs, rhs);
+    }
+}
+
+template <typename VT> void benchElementwiseAndAgg(BenchRunner &bench) {
+    if (!bench.isSelected("EwBinaryMat/add") && !bench.isSelected("AggCol/sum") && !bench.isSelected("AggRow/sum") &&
+        !bench.isSelected("Transpose/dense"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (auto [numRows, numCols] : shapes) {
+        DenseMatrix<VT> *lhs = nullptr, *rhs = nullptr;
+        randMatrix<DenseMatrix<VT>, VT>(lhs, numRows, numCols, VT(1), VT(100), 1.0, 1, ctx);
+        randMatrix<DenseMatrix<VT>, VT>(rhs, numRows, numCols, VT(1), VT(100), 1.0, 2, ctx);
+        bench.measure("EwBinaryMat/add", params<VT>(numRows, numCols), [&]() {
+            DenseMatrix<VT> *res = nullptr;
+            ewBinaryMat(BinaryOpCode::ADD, res, lhs, rhs, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        bench.measure("AggCol/sum", params<VT>(numRows, numCols), [&]() {
+            DenseMatrix<VT> *res = nullptr;
+            aggCol(AggOpCode::SUM, res, lhs, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        bench.measure("AggRow/sum", params<VT>(numRows, numCols), [&]() {
+            DenseMatrix<VT> *res = nullptr;
+            aggRow(AggOpCode::SUM, res, lhs, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        bench.measure("Transpose/dense", params<VT>(numRows, numCols), [&]() {
+            DenseMatrix<VT> *res = nullptr;
+            transpose(res, lhs, false, ctx);
+            DataObjectFactory::destroy(res);
+        });
+        DataObjectFactory::destroy(lhs, rhs);
+    }
+}
+} // namespace
+
+BENCH_CASE(MatMulBench) {
+    benchMatMulDense<double>(bench);
+    benchMatMulDense<float>(bench);
+    benchMatMulSparse<double>(bench);
+}
+
+BENCH_CASE(ElementwiseAndAggregationBench) {
+    benchElementwiseAndAgg<double>(bench);
+    benchElementwiseAndAgg<float>(bench);
+    benchElementwiseAndAgg<int64_t>(bench);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <ir/daphneir/Daphne.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/kernels/Group.h>
+#include <runtime/local/kernels/InnerJoin.h>
+#include <runtime/local/kernels/Order.h>
+#include <runtime/local/kernels/RandMatrix.h>
+#include <runtime/local/kernels/TopK.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+const std::vector<size_t> numRowsList = {100000, 1000000};
+const std::vector<int64_t> numDistinctList = {10, 10000};
+
+/**
+ * @brief Creates a frame with an integer key column "k" with the given number
+ * of distinct values and a double column "v".
+ */
+Frame *createKeyValueFrame(size_t numRows, int64_t numDistinct, int64_t seed, DaphneContext *ctx) {
+    DenseMatrix<int64_t> *keys = nullptr;
+    DenseMatrix<double> *values = nullptr;
+    randMatrix<DenseMatrix<int64_t>, int64_t>(keys, numRows, 1, 0, numDistinct - 1, 1.0, seed, ctx);
+    randMatrix<DenseMatrix<double>, double>(values, numRows, 1, 0.0, 1.0, 1.0, seed + 1, ctx);
+    std::vector<Structure *> cols = {keys, values};
+    std::string labels[] = {"k", "v"};
+    Frame *res = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(keys, values);
+    return res;
+}
+
+nlohmann::json params(size_t numRows, int64_t numDistinct) {
+    return {{"num_rows", numRows}, {"num_distinct", numDistinct}};
+}
+} // namespace
+
+BENCH_CASE(GroupBench) {
+    if (!bench.isSelected("Group/sum"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (size_t numRows : numRowsList)
+        for (int64_t numDistinct : numDistinctList) {
+            Frame *arg = createKeyValueFrame(numRows, numDistinct, 1, ctx);
+            const char *keyCols[] = {"k"};
+            const char *aggCols[] = {"v"};
+            mlir::daphne::GroupEnum aggFuncs[] = {mlir::daphne::GroupEnum::SUM};
+            bench.measure("Group/sum", params(numRows, numDistinct), [&]() {
+                Frame *res = nullptr;
+                group(res, arg, keyCols, 1, aggCols, 1, aggFuncs, 1, ctx);
+                DataObjectFactory::destroy(res);
+            });
+            DataObjectFactory::destroy(arg);
+        }
+}
+
+BENCH_CASE(InnerJoinBench) {
+    if (!bench.isSelected("InnerJoin/fk"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (size_t numRows : numRowsList)
+        for (int64_t numDistinct : numDistinctList) {
+            // A primary key side with unique keys in random order and a
+            // foreign key side, such that each row of the latter has exactly
+            // one join partner.
+            std::vector<int64_t> pks(numDistinct);
+            std::iota(pks.begin(), pks.end(), 0);
+            std::shuffle(pks.begin(), pks.end(), std::mt19937(42));
+            auto pkCol = DataObjectFactory::create<DenseMatrix<int64_t>>(numDistinct, 1, false);
+            std::copy(pks.begin(), pks.end(), pkCol->getValues());
+            DenseMatrix<double> *pkValues = nullptr;
+            randMatrix<DenseMatrix<double>, double>(pkValues, numDistinct, 1, 0.0, 1.0, 1.0, 3, ctx);
+            std::vector<Structure *> pkCols = {pkCol, pkValues};
+            std::string pkLabels[] = {"pk", "pv"};
+            Frame *lhs = DataObjectFactory::create<Frame>(pkCols, pkLabels);
+            DataObjectFactory::destroy(pkCol, pkValues);
+            Frame *rhs = createKeyValueFrame(numRows, numDistinct, 1, ctx);
+
+            bench.measure("InnerJoin/fk", params(numRows, numDistinct), [&]() {
+                Frame *res = nullptr;
+                innerJoin(res, lhs, rhs, "pk", "k", numRows, ctx);
+                DataObjectFactory::destroy(res);
+            });
+            DataObjectFactory::destroy(lhs, rhs);
+        }
+}
+
+BENCH_CASE(OrderBench) {
+    if (!bench.isSelected("Order/"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (size_t numRows : numRowsList)
+        for (int64_t numDistinct : numDistinctList) {
+            Frame *arg = createKeyValueFrame(numRows, numDistinct, 1, ctx);
+            size_t colIdxs[] = {0, 1};
+            bool ascending[] = {true, false};
+            bench.measure("Order/frame", params(numRows, numDistinct), [&]() {
+                Frame *res = nullptr;
+                order(res, arg, colIdxs, 2, ascending, 2, false, ctx);
+                DataObjectFactory::destroy(res);
+            });
+            const DenseMatrix<int64_t> *keys = arg->getColumn<int64_t>(0);
+            bench.measure("Order/matrix_idx", params(numRows, numDistinct), [&]() {
+                DenseMatrix<size_t> *res = nullptr;
+                order(res, keys, colIdxs, 1, ascending, 1, true, ctx);
+                DataObjectFactory::destroy(res);
+            });
+            DataObjectFactory::destroy(keys, arg);
+        }
+}
+
+BENCH_CASE(TopKBench) {
+    if (!bench.isSelected("TopK/"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    for (size_t numRows : numRowsList)
+        for (int64_t numDistinct : numDistinctList) {
+            Frame *arg = createKeyValueFrame(numRows, numDistinct, 1, ctx);
+            size_t colIdxs[] = {0, 1};
+            bool ascending[] = {true, false};
+            for (size_t k : {10, 1000}) {
+                nlohmann::json p = params(numRows, numDistinct);
+                p["k"] = k;
+                bench.measure("TopK/frame", p, [&]() {
+                    Frame *res = nullptr;
+                    topK(res, arg, k, colIdxs, 2, ascending, 2, false, ctx);
+                    DataObjectFactory::destroy(res);
+                });
+            }
+            DataObjectFactory::destroy(arg);
+        }
+}
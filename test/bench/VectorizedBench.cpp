@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/BinaryOpCode.h>
+#include <runtime/local/kernels/EwBinaryMat.h>
+#include <runtime/local/kernels/RandMatrix.h>
+#include <runtime/local/vectorized/MTWrapper.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+using DT = DenseMatrix<double>;
+
+// A pipeline of two element-wise operations, like the code generated for
+// `(X + Y) * Y` inside a vectorized pipeline.
+void pipelineAddMul(DT ***outputs, Structure **inputs, DCTX(ctx)) {
+    auto x = reinterpret_cast<DT *>(inputs[0]);
+    auto y = reinterpret_cast<DT *>(inputs[1]);
+    DT *tmp = nullptr;
+    ewBinaryMat(BinaryOpCode::ADD, tmp, x, y, ctx);
+    ewBinaryMat(BinaryOpCode::MUL, *outputs[0], tmp, y, ctx);
+    // Like the generated code, the pipeline owns the views on its morsels.
+    DataObjectFactory::destroy(tmp, x, y);
+}
+} // namespace
+
+BENCH_CASE(VectorizedPipelineBench) {
+    if (!bench.isSelected("VectorizedPipeline/ew"))
+        return;
+    DaphneContext *ctx = bench.getContext();
+    const int oldNumThreads = ctx->config.numberOfThreads;
+    const size_t numRows = 1000000;
+    const size_t numCols = 10;
+
+    DT *x = nullptr, *y = nullptr;
+    randMatrix<DT, double>(x, numRows, numCols, 0.0, 1.0, 1.0, 1, ctx);
+    randMatrix<DT, double>(y, numRows, numCols, 0.0, 1.0, 1.0, 2, ctx);
+
+    static PipelineHWlocInfo topology{ctx->config.queueSetupScheme};
+    const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int numThreads : {1, 2, 4, 8, 16}) {
+        if (numThreads > maxThreads)
+            break;
+        ctx->config.numberOfThreads = numThreads;
+        bench.measure("VectorizedPipeline/ew", {{"num_rows", numRows}, {"num_cols", numCols}, {"threads", numThreads}},
+                      [&]() {
+                          auto wrapper = std::make_unique<MTWrapper<DT>>(1, topology, ctx);
+                          DT *res = nullptr;
+                          DT **outputs[] = {&res};
+                          bool isScalar[] = {false, false};
+                          Structure *inputs[] = {x, y};
+                          int64_t outRows[] = {static_cast<int64_t>(numRows)};
+                          int64_t outCols[] = {static_cast<int64_t>(numCols)};
+                          VectorSplit splits[] = {VectorSplit::ROWS, VectorSplit::ROWS};
+                          VectorCombine combines[] = {VectorCombine::ROWS};
+                          std::vector<std::function<void(DT ***, Structure **, DCTX(ctx))>> funcs = {&pipelineAddMul};
+                          wrapper->executeCpuQueues(funcs, outputs, isScalar, inputs, 2, 1, outRows, outCols, splits,
+                                                    combines, ctx, false);
+                          DataObjectFactory::destroy(res);
+                      });
+    }
+    ctx->config.numberOfThreads = oldNumThreads;
+    DataObjectFactory::destroy(x, y);
+}
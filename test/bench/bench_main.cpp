@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <api/cli/DaphneUserConfig.h>
+#include <runtime/local/kernels/CreateDaphneContext.h>
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+// Runs the kernel micro-benchmarks and writes their timings as JSON, which
+// can be compared against a baseline by test/bench/compare-bench.py.
+//
+// Usage: daphne_bench [--filter <substring>] [--repetitions <n>] [--out <file>]
+//                     [--verbose]
+
+static DaphneUserConfig user_config{};
+
+int main(int argc, char **argv) {
+    std::string filter;
+    std::string outPath;
+    size_t repetitions = 10;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::runtime_error("daphne_bench: missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--filter")
+            filter = next();
+        else if (arg == "--repetitions")
+            repetitions = std::stoul(next());
+        else if (arg == "--out")
+            outPath = next();
+        else if (arg == "--verbose")
+            verbose = true;
+        else {
+            std::cerr << "usage: daphne_bench [--filter <substring>] [--repetitions <n>] [--out <file>] [--verbose]"
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (repetitions == 0)
+        repetitions = 1;
+
+    auto logger = std::make_unique<DaphneLogger>(user_config);
+    user_config.log_ptr->registerLoggers();
+    DaphneContext *ctx = nullptr;
+    createDaphneContext(ctx, reinterpret_cast<uint64_t>(&user_config),
+                        reinterpret_cast<uint64_t>(&KernelDispatchMapping::instance()),
+                        reinterpret_cast<uint64_t>(&Statistics::instance()),
+                        reinterpret_cast<uint64_t>(&StringRefCounter::instance()));
+    std::unique_ptr<DaphneContext> ctxGuard(ctx);
+
+    std::vector<BenchResult> results;
+    BenchRunner runner(ctx, repetitions, filter, results, verbose);
+    for (const auto &c : benchCases())
+        c.second(runner);
+
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    nlohmann::json benchmarks = nlohmann::json::array();
+    for (const auto &r : results)
+        benchmarks.push_back(r.toJson());
+    nlohmann::json out = {
+        {"context", {{"date", date}, {"host", host}, {"num_cpus", std::thread::hardware_concurrency()}}},
+        {"benchmarks", benchmarks}};
+
+    if (outPath.empty())
+        std::cout << out.dump(4) << std::endl;
+    else {
+        std::ofstream ofs(outPath);
+        if (!ofs.good()) {
+            std::cerr << "daphne_bench: could not write " << outPath << std::endl;
+            return 1;
+        }
+        ofs << out.dump(4) << std::endl;
+    }
+    return 0;
+}
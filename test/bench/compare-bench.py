@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The DAPHNE Consortium
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Compares the results of `daphne_bench` against a stored baseline.
+
+A benchmark is flagged as a regression if its median runtime exceeds the one
+of the baseline by more than the given threshold. The exit code is 1 if there
+is at least one regression, and 0 otherwise.
+
+Example:
+    bin/daphne_bench --out current.json
+    test/bench/compare-bench.py baseline.json current.json --threshold 0.1
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {(b["name"], json.dumps(b["params"], sort_keys=True)): b for b in json.load(f)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="JSON output of daphne_bench to compare against")
+    parser.add_argument("current", help="JSON output of daphne_bench to check")
+    parser.add_argument("--threshold", type=float, default=0.1, help="relative slowdown tolerated (default: 0.1)")
+    parser.add_argument("--metric", default="median_ns", choices=["min_ns", "median_ns", "mean_ns"])
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    for key in sorted(current.keys()):
+        name, params = key
+        if key not in baseline:
+            print(f"NEW        {name} {params}")
+            continue
+        old = baseline[key][args.metric]
+        new = current[key][args.metric]
+        change = (new - old) / old if old > 0 else 0.0
+        if change > args.threshold:
+            status = "REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            status = "IMPROVED"
+        else:
+            status = "OK"
+        print(f"{status:<10} {name} {params}: {old:.0f} ns -> {new:.0f} ns ({change:+.1%})")
+    for key in sorted(baseline.keys() - current.keys()):
+        print(f"MISSING    {key[0]} {key[1]}")
+
+    print(f"{regressions} regression(s) with a threshold of {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -13,19 +13,19 @@ module {
     %5 = "daphne.matrixConstant"(%4) : (ui64) -> !daphne.Matrix<6x1xf64>
     %6 = "daphne.reshape"(%5, %0, %1) : (!daphne.Matrix<6x1xf64>, index, index) -> !daphne.Matrix<2x3xf64>
     // CHECK-NOT: daphne.sumAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.addf
     %7 = "daphne.sumAll"(%6) : (!daphne.Matrix<2x3xf64>) -> f64
     "daphne.print"(%7, %3, %2) : (f64, i1, i1) -> ()
     %8 = "daphne.cast"(%6) : (!daphne.Matrix<2x3xf64>) -> !daphne.Matrix<2x3xsi64>
     // CHECK-NOT: daphne.sumAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.addi
     %9 = "daphne.sumAll"(%8) : (!daphne.Matrix<2x3xsi64>) -> si64
     "daphne.print"(%9, %3, %2) : (si64, i1, i1) -> ()
     %10 = "daphne.cast"(%6) : (!daphne.Matrix<2x3xf64>) -> !daphne.Matrix<2x3xui64>
     // CHECK-NOT: daphne.sumAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.addi
     %11 = "daphne.sumAll"(%10) : (!daphne.Matrix<2x3xui64>) -> ui64
     "daphne.print"(%11, %3, %2) : (ui64, i1, i1) -> ()
@@ -43,19 +43,19 @@ module {
     %5 = "daphne.matrixConstant"(%4) : (ui64) -> !daphne.Matrix<6x1xf64>
     %6 = "daphne.reshape"(%5, %0, %1) : (!daphne.Matrix<6x1xf64>, index, index) -> !daphne.Matrix<2x3xf64>
     // CHECK-NOT: daphne.minAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.minf
     %7 = "daphne.minAll"(%6) : (!daphne.Matrix<2x3xf64>) -> f64
     "daphne.print"(%7, %3, %2) : (f64, i1, i1) -> ()
     %8 = "daphne.cast"(%6) : (!daphne.Matrix<2x3xf64>) -> !daphne.Matrix<2x3xsi64>
     // CHECK-NOT: daphne.minAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.minsi
     %9 = "daphne.minAll"(%8) : (!daphne.Matrix<2x3xsi64>) -> si64
     "daphne.print"(%9, %3, %2) : (si64, i1, i1) -> ()
     %10 = "daphne.cast"(%6) : (!daphne.Matrix<2x3xf64>) -> !daphne.Matrix<2x3xui64>
     // CHECK-NOT: daphne.minAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.minui
     %11 = "daphne.minAll"(%10) : (!daphne.Matrix<2x3xui64>) -> ui64
     "daphne.print"(%11, %3, %2) : (ui64, i1, i1) -> ()
@@ -73,19 +73,19 @@ module {
     %5 = "daphne.matrixConstant"(%4) : (ui64) -> !daphne.Matrix<6x1xf64>
     %6 = "daphne.reshape"(%5, %0, %1) : (!daphne.Matrix<6x1xf64>, index, index) -> !daphne.Matrix<2x3xf64>
     // CHECK-NOT: daphne.maxAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.maxf
     %7 = "daphne.maxAll"(%6) : (!daphne.Matrix<2x3xf64>) -> f64
     "daphne.print"(%7, %3, %2) : (f64, i1, i1) -> ()
     %8 = "daphne.cast"(%6) : (!daphne.Matrix<2x3xf64>) -> !daphne.Matrix<2x3xsi64>
     // CHECK-NOT: daphne.maxAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.maxsi
     %9 = "daphne.maxAll"(%8) : (!daphne.Matrix<2x3xsi64>) -> si64
     "daphne.print"(%9, %3, %2) : (si64, i1, i1) -> ()
     %10 = "daphne.cast"(%6) : (!daphne.Matrix<2x3xf64>) -> !daphne.Matrix<2x3xui64>
     // CHECK-NOT: daphne.maxAll
-    // CHECK: linalg.generic
+    // CHECK: affine.for
     // CHECK: arith.maxui
     %11 = "daphne.maxAll"(%10) : (!daphne.Matrix<2x3xui64>) -> ui64
     "daphne.print"(%11, %3, %2) : (ui64, i1, i1) -> ()
@@ -0,0 +1,39 @@
+// RUN: daphne-opt -pass-pipeline="builtin.module(lower-ew, lower-agg, canonicalize, func.func(linalg-generalize-named-ops), func.func(convert-linalg-to-affine-loops), func.func(affine-loop-fusion), func.func(affine-scalrep))" %s | FileCheck %s
+
+// COM: Check whether a chain of element-wise operations and a full aggregation is fused into a single loop nest, in
+// COM: which the intermediate results are forwarded as scalars instead of being stored to memrefs.
+
+module {
+  func.func @main() {
+    %0 = "daphne.constant"() {value = 3 : index} : () -> index
+    %1 = "daphne.constant"() {value = 2 : index} : () -> index
+    %2 = "daphne.constant"() {value = false} : () -> i1
+    %3 = "daphne.constant"() {value = true} : () -> i1
+    %4 = "daphne.constant"() {value = 1.000000e+00 : f64} : () -> f64
+    %5 = "daphne.constant"() {value = 6.000000e+00 : f64} : () -> f64
+    %6 = "daphne.constant"() {value = 2.000000e+00 : f64} : () -> f64
+    %7 = "daphne.seq"(%4, %5, %4) : (f64, f64, f64) -> !daphne.Matrix<6x1xf64:sp[1.000000e+00]>
+    %8 = "daphne.reshape"(%7, %1, %0) : (!daphne.Matrix<6x1xf64:sp[1.000000e+00]>, index, index) -> !daphne.Matrix<2x3xf64:sp[1.000000e+00]>
+    // CHECK-NOT: daphne.ewSub
+    // CHECK-NOT: daphne.ewMul
+    // CHECK-NOT: daphne.sumAll
+    // CHECK-NOT: memref.alloc
+    // CHECK: affine.for
+    // CHECK-NOT: memref.alloc
+    // CHECK-NOT: affine.store
+    // CHECK: affine.for
+    // CHECK-NOT: affine.store
+    // CHECK: arith.subf
+    // CHECK-NOT: affine.store
+    // CHECK: arith.mulf
+    // CHECK-NOT: affine.store
+    // CHECK: arith.addf
+    // CHECK-NOT: affine.store
+    // CHECK-NOT: affine.for
+    %9 = "daphne.ewSub"(%8, %6) : (!daphne.Matrix<2x3xf64:sp[1.000000e+00]>, f64) -> !daphne.Matrix<2x3xf64>
+    %10 = "daphne.ewMul"(%9, %9) : (!daphne.Matrix<2x3xf64>, !daphne.Matrix<2x3xf64>) -> !daphne.Matrix<2x3xf64>
+    %11 = "daphne.sumAll"(%10) : (!daphne.Matrix<2x3xf64>) -> f64
+    "daphne.print"(%11, %3, %2) : (f64, i1, i1) -> ()
+    "daphne.return"() : () -> ()
+  }
+}
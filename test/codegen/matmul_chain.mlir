@@ -0,0 +1,24 @@
+// RUN: daphne-opt --opt-matmul-chain %s | FileCheck %s
+
+// A (1000x10) @ B (10x1000) @ v (1000x1) is computed as A @ (B @ v), which
+// avoids materializing the 1000x1000 intermediate result.
+module {
+  func.func @main() {
+    %0 = "daphne.constant"() {value = false} : () -> i1
+    %1 = "daphne.constant"() {value = 1 : index} : () -> index
+    %2 = "daphne.constant"() {value = 10 : index} : () -> index
+    %3 = "daphne.constant"() {value = 1000 : index} : () -> index
+    %4 = "daphne.constant"() {value = 1.000000e+00 : f64} : () -> f64
+    %5 = "daphne.fill"(%4, %3, %2) : (f64, index, index) -> !daphne.Matrix<1000x10xf64:sp[1.000000e+00]>
+    %6 = "daphne.fill"(%4, %2, %3) : (f64, index, index) -> !daphne.Matrix<10x1000xf64:sp[1.000000e+00]>
+    %7 = "daphne.fill"(%4, %3, %1) : (f64, index, index) -> !daphne.Matrix<1000x1xf64:sp[1.000000e+00]>
+    // CHECK: [[BV:%.*]] = "daphne.matMul"(%{{.*}}, %{{.*}}, %{{.*}}, %{{.*}}) : (!daphne.Matrix<10x1000xf64:sp[1.000000e+00]>, !daphne.Matrix<1000x1xf64:sp[1.000000e+00]>, i1, i1) -> !daphne.Matrix<10x1xf64
+    // CHECK-NEXT: "daphne.matMul"(%{{.*}}, [[BV]], %{{.*}}, %{{.*}}) : (!daphne.Matrix<1000x10xf64:sp[1.000000e+00]>, !daphne.Matrix<10x1xf64
+    // CHECK-SAME: -> !daphne.Matrix<1000x1xf64:sp[1.000000e+00]>
+    // CHECK-NOT: daphne.matMul
+    %8 = "daphne.matMul"(%5, %6, %0, %0) : (!daphne.Matrix<1000x10xf64:sp[1.000000e+00]>, !daphne.Matrix<10x1000xf64:sp[1.000000e+00]>, i1, i1) -> !daphne.Matrix<1000x1000xf64:sp[1.000000e+00]>
+    %9 = "daphne.matMul"(%8, %7, %0, %0) : (!daphne.Matrix<1000x1000xf64:sp[1.000000e+00]>, !daphne.Matrix<1000x1xf64:sp[1.000000e+00]>, i1, i1) -> !daphne.Matrix<1000x1xf64:sp[1.000000e+00]>
+    "daphne.print"(%9, %0, %0) : (!daphne.Matrix<1000x1xf64:sp[1.000000e+00]>, i1, i1) -> ()
+    "daphne.return"() : () -> ()
+  }
+}
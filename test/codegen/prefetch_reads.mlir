@@ -0,0 +1,40 @@
+// RUN: daphne-opt --opt-prefetch-reads %s | FileCheck %s
+
+// The reads of a.csv and b.csv are started right after the definitions of
+// their file names and awaited right before their first use. The read of
+// c.csv must not be started before the write, which might create the file.
+module {
+  func.func @main() {
+    // CHECK: [[FALSE:%.*]] = "daphne.constant"() {value = false}
+    // CHECK-NEXT: [[A:%.*]] = "daphne.constant"() {value = "a.csv"}
+    // CHECK-NEXT: [[FA:%.*]] = "daphne.readAsync"([[A]]) : (!daphne.String) -> !daphne.Future<!daphne.Matrix<?x?xf64>>
+    // CHECK-NEXT: [[B:%.*]] = "daphne.constant"() {value = "b.csv"}
+    // CHECK-NEXT: [[FB:%.*]] = "daphne.readAsync"([[B]]) : (!daphne.String) -> !daphne.Future<!daphne.Matrix<?x?xf64>>
+    // CHECK-NEXT: [[C:%.*]] = "daphne.constant"() {value = "c.csv"}
+    // CHECK-NEXT: "daphne.constant"
+    // CHECK-NEXT: "daphne.constant"
+    // CHECK-NEXT: [[M:%.*]] = "daphne.fill"
+    // CHECK-NEXT: "daphne.print"([[M]]
+    // CHECK-NEXT: [[RA:%.*]] = "daphne.await"([[FA]]) : (!daphne.Future<!daphne.Matrix<?x?xf64>>) -> !daphne.Matrix<?x?xf64>
+    // CHECK-NEXT: [[RB:%.*]] = "daphne.await"([[FB]]) : (!daphne.Future<!daphne.Matrix<?x?xf64>>) -> !daphne.Matrix<?x?xf64>
+    // CHECK-NEXT: [[S:%.*]] = "daphne.ewAdd"([[RA]], [[RB]])
+    // CHECK-NEXT: "daphne.write"([[S]], [[C]])
+    // CHECK-NEXT: "daphne.read"([[C]])
+    // CHECK-NOT: daphne.readAsync
+    %0 = "daphne.constant"() {value = false} : () -> i1
+    %1 = "daphne.constant"() {value = "a.csv"} : () -> !daphne.String
+    %2 = "daphne.constant"() {value = "b.csv"} : () -> !daphne.String
+    %3 = "daphne.constant"() {value = "c.csv"} : () -> !daphne.String
+    %4 = "daphne.constant"() {value = 10 : index} : () -> index
+    %5 = "daphne.constant"() {value = 1.000000e+00 : f64} : () -> f64
+    %6 = "daphne.fill"(%5, %4, %4) : (f64, index, index) -> !daphne.Matrix<10x10xf64>
+    "daphne.print"(%6, %0, %0) : (!daphne.Matrix<10x10xf64>, i1, i1) -> ()
+    %7 = "daphne.read"(%1) : (!daphne.String) -> !daphne.Matrix<?x?xf64>
+    %8 = "daphne.read"(%2) : (!daphne.String) -> !daphne.Matrix<?x?xf64>
+    %9 = "daphne.ewAdd"(%7, %8) : (!daphne.Matrix<?x?xf64>, !daphne.Matrix<?x?xf64>) -> !daphne.Matrix<?x?xf64>
+    "daphne.write"(%9, %3) : (!daphne.Matrix<?x?xf64>, !daphne.String) -> ()
+    %10 = "daphne.read"(%3) : (!daphne.String) -> !daphne.Matrix<?x?xf64>
+    "daphne.print"(%10, %0, %0) : (!daphne.Matrix<?x?xf64>, i1, i1) -> ()
+    "daphne.return"() : () -> ()
+  }
+}
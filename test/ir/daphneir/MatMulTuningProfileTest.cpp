@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <compiler/lowering/MatMulTuningProfile.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("MatMulTuningProfile looks up the closest shape class", TAG_CODEGEN) {
+    MatMulTuningProfile profile;
+    profile.add("f64", 64, 64, 64, {{4, 4, 64, 32, 64}, 256, 1, 4});
+    profile.add("f64", 1024, 1024, 1024, {{8, 8, 256, 128, 1024}, 256, 4, 2});
+    profile.add("f32", 64, 64, 64, {{}, 0, 1, 4});
+
+    // Same shape class.
+    auto c = profile.lookup("f64", 50, 60, 33);
+    REQUIRE(c != nullptr);
+    CHECK(c->tileSizes[0] == 4);
+
+    // Closest shape class.
+    c = profile.lookup("f64", 1024, 512, 1024);
+    REQUIRE(c != nullptr);
+    CHECK(c->tileSizes[0] == 8);
+    CHECK(c->unrollFactor == 4);
+
+    // Other value type.
+    c = profile.lookup("f32", 64, 64, 64);
+    REQUIRE(c != nullptr);
+    CHECK(c->tileSizes.empty());
+    CHECK(profile.lookup("si64", 64, 64, 64) == nullptr);
+
+    // Too far away from any tuned shape class.
+    CHECK(profile.lookup("f64", 8, 8, 8) == nullptr);
+    CHECK(profile.lookupIndex("f64", 8, 8, 8) == -1);
+    CHECK(profile.lookupIndex("f64", 1024, 512, 1024) == 1);
+
+    // Replacing the configuration of a shape class.
+    profile.add("f64", 60, 60, 60, {{2, 2}, 0, 1, 4});
+    CHECK(profile.size() == 3);
+    CHECK(profile.lookup("f64", 64, 64, 64)->tileSizes.size() == 2);
+}
+
+TEST_CASE("MatMulTuningProfile file round trip", TAG_CODEGEN) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "daphne_MatMulTuningProfileTest.json").string();
+
+    MatMulTuningProfile profile;
+    profile.add("f64", 256, 128, 256, {{4, 8, 128, 64, 256}, 512, 2, 4});
+    profile.save(path);
+
+    MatMulTuningProfile loaded = MatMulTuningProfile::load(path);
+    std::remove(path.c_str());
+    REQUIRE(loaded.size() == 1);
+    auto c = loaded.lookup("f64", 256, 128, 256);
+    REQUIRE(c != nullptr);
+    CHECK(c->tileSizes == std::vector<unsigned>{4, 8, 128, 64, 256});
+    CHECK(c->vecSizeBits == 512);
+    CHECK(c->unrollFactor == 2);
+    CHECK(c->unrollJamFactor == 4);
+
+    CHECK_THROWS_AS(MatMulTuningProfile::load("test/ir/daphneir/nonexistent.json"), std::runtime_error);
+    {
+        std::ofstream ofs(path);
+        ofs << R"({"entries": [{"value_type": "f64", "m": 4, "k": 4, "n": 4, "tile_sizes": [1, 4]}]})";
+    }
+    CHECK_THROWS_AS(MatMulTuningProfile::load(path), std::runtime_error);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <compiler/inference/SparsitySketch.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cmath>
+
+TEST_CASE("SparsitySketch of dense products", TAG_INFERENCE) {
+    auto a = SparsitySketch::uniform(100, 50, 1.0);
+    auto b = SparsitySketch::uniform(50, 20, 1.0);
+    auto c = SparsitySketch::matMul(a, b);
+
+    CHECK(c.numRows == 100);
+    CHECK(c.numCols == 20);
+    CHECK(c.sparsity() == Approx(1.0));
+    CHECK(c.nonEmptyRows == Approx(100));
+    CHECK(c.nonEmptyCols == Approx(20));
+}
+
+TEST_CASE("SparsitySketch of uniformly sparse products", TAG_INFERENCE) {
+    const double sa = 0.01;
+    const double sb = 0.02;
+    const double k = 1000;
+    auto a = SparsitySketch::uniform(500, k, sa);
+    auto b = SparsitySketch::uniform(k, 400, sb);
+    auto c = SparsitySketch::matMul(a, b);
+
+    // Without any structure, the estimate is close to the independence
+    // assumption.
+    const double independent = 1.0 - std::pow(1.0 - sa * sb, k);
+    CHECK(c.sparsity() == Approx(independent).epsilon(0.05));
+    CHECK(c.sparsity() <= 1.0);
+}
+
+TEST_CASE("SparsitySketch exploits at most one non-zero per row", TAG_INFERENCE) {
+    // A diagonal matrix only scales the rows of the other argument.
+    auto d = SparsitySketch::diagonal(1000, 1000);
+    auto x = SparsitySketch::uniform(1000, 300, 0.05);
+
+    auto dx = SparsitySketch::matMul(d, x);
+    CHECK(dx.sparsity() == Approx(x.sparsity()));
+    CHECK(dx.maxNnzPerRow == Approx(x.maxNnzPerRow));
+
+    auto xtd = SparsitySketch::matMul(SparsitySketch::uniform(300, 1000, 0.05), d);
+    CHECK(xtd.sparsity() == Approx(0.05));
+
+    // A diagonal matrix with half of its entries being zero empties half of
+    // the rows.
+    auto dHalf = SparsitySketch::diagonal(1000, 500);
+    auto dHalfX = SparsitySketch::matMul(dHalf, x);
+    CHECK(dHalfX.sparsity() == Approx(x.sparsity() / 2));
+    CHECK(dHalfX.nonEmptyRows == Approx(500).epsilon(0.01));
+}
+
+TEST_CASE("SparsitySketch of empty and transposed matrices", TAG_INFERENCE) {
+    auto z = SparsitySketch::uniform(10, 20, 0.0);
+    auto x = SparsitySketch::uniform(20, 30, 0.5);
+    CHECK(SparsitySketch::matMul(z, x).nnz == 0);
+    CHECK(SparsitySketch::matMul(x.transposed(), z.transposed()).nnz == 0);
+
+    auto d = SparsitySketch::diagonal(20, 20);
+    auto t = SparsitySketch::uniform(20, 5, 0.3).transposed();
+    CHECK(t.numRows == 5);
+    CHECK(t.numCols == 20);
+    CHECK(SparsitySketch::matMul(t, d).sparsity() == Approx(0.3));
+}
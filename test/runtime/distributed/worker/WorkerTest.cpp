@@ -16,6 +16,7 @@
 
 #include "run_tests.h"
 #include "runtime/distributed/worker/WorkerImpl.h"
+#include "runtime/distributed/worker/WorkerImplGRPCSync.h"
 #include "runtime/local/kernels/CheckEq.h"
 #include "runtime/local/kernels/EwBinaryMat.h"
 
@@ -24,8 +25,13 @@
 #include <catch.hpp>
 
 #include <api/cli/Utils.h>
+#include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/io/File.h>
 #include <runtime/local/io/ReadCsv.h>
+#include <runtime/local/io/WriteDaphneColumnar.h>
+#include <runtime/local/kernels/SliceRow.h>
+
+#include <filesystem>
 #include <thread>
 
 const std::string dirPath = "test/runtime/distributed/worker/";
@@ -141,3 +147,44 @@ TEMPLATE_PRODUCT_TEST_CASE("Simple distributed worker functionality test", TAG_D
         }
     }
 }
+
+TEST_CASE("Distributed worker reads a row range of a columnar file", TAG_DISTRIBUTED) {
+    auto dctx = setupContextAndLogger();
+    user_config.resolveLibDir();
+    // The server is not used, the service methods are called directly.
+    WorkerImplGRPCSync workerImpl("localhost:0", user_config);
+
+    const std::string filename = (std::filesystem::temp_directory_path() / "daphne_WorkerTest.dbdf").string();
+    auto mat = genGivenVals<DenseMatrix<double>>(4, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    writeDaphneColumnar(mat, filename.c_str(), DaphneColumnarWriteOptions(), dctx.get());
+
+    distributed::ColumnarFileRange request;
+    request.set_filename(filename);
+    request.set_start_row(1);
+    request.set_num_rows(2);
+    distributed::StoredData response;
+
+    SECTION("with the value type of the file") {
+        request.set_value_type(static_cast<uint32_t>(ValueTypeCode::F64));
+        auto status = workerImpl.ReadColumnar(nullptr, &request, &response);
+        REQUIRE(status.ok());
+        CHECK(response.num_rows() == 2);
+        CHECK(response.num_cols() == 3);
+
+        auto res = dynamic_cast<DenseMatrix<double> *>(
+            workerImpl.Transfer(WorkerImpl::StoredInfo({response.identifier(), 2, 3})));
+        REQUIRE(res != nullptr);
+        DenseMatrix<double> *exp = nullptr;
+        sliceRow(exp, mat, 1, 3, nullptr);
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(exp);
+    }
+    SECTION("with another value type") {
+        request.set_value_type(static_cast<uint32_t>(ValueTypeCode::F32));
+        auto status = workerImpl.ReadColumnar(nullptr, &request, &response);
+        CHECK(status.error_code() == grpc::StatusCode::ABORTED);
+    }
+
+    DataObjectFactory::destroy(mat);
+    std::filesystem::remove(filename);
+}
@@ -15,6 +15,7 @@
  */
 
 #include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/AllocationDescriptorHost.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
@@ -193,6 +194,32 @@ TEST_CASE("DenseMatrix sub-matrix works properly", TAG_DATASTRUCTURES) {
     }
 }
 
+TEST_CASE("DenseMatrix host-only fast path of getValues", TAG_DATASTRUCTURES) {
+    using ValueType = double;
+
+    DenseMatrix<ValueType> *mOrig = DataObjectFactory::create<DenseMatrix<ValueType>>(4, 3, true);
+    DenseMatrix<ValueType> *mSub = DataObjectFactory::create<DenseMatrix<ValueType>>(mOrig, 1, 3, 1, 3);
+    CHECK(mOrig->getMetaDataObject()->isHostOnly());
+    CHECK(mSub->getMetaDataObject()->isHostOnly());
+
+    // The fast path must return the same pointers as the data placement
+    // bookkeeping, which is used once there is a placement with a range.
+    ValueType *valuesOrigFast = mOrig->getValues();
+    const ValueType *valuesSubFast = static_cast<const DenseMatrix<ValueType> *>(mSub)->getValues();
+    CHECK(valuesSubFast == valuesOrigFast + 1 * 3 + 1);
+
+    AllocationDescriptorHost hostAlloc;
+    Range range{0, 0, 2, 3};
+    mOrig->getMetaDataObject()->addDataPlacement(&hostAlloc, &range);
+    mSub->getMetaDataObject()->addDataPlacement(&hostAlloc, &range);
+    CHECK_FALSE(mOrig->getMetaDataObject()->isHostOnly());
+    CHECK_FALSE(mSub->getMetaDataObject()->isHostOnly());
+    CHECK(mOrig->getValues() == valuesOrigFast);
+    CHECK(static_cast<const DenseMatrix<ValueType> *>(mSub)->getValues() == valuesSubFast);
+
+    DataObjectFactory::destroy(mSub, mOrig);
+}
+
 TEMPLATE_TEST_CASE("DenseMatrix with string value type", TAG_DATASTRUCTURES, ALL_STRING_VALUE_TYPES) {
     using ValueType = TestType;
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/DictionaryEncoding.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+TEMPLATE_TEST_CASE("DictionaryEncoding", TAG_DATASTRUCTURES, std::string, int64_t) {
+    using VT = TestType;
+    using CodeType = typename DictionaryEncoding<VT>::CodeType;
+
+    std::vector<VT> vals;
+    if constexpr (std::is_same_v<VT, std::string>)
+        vals = {"b", "a", "c", "a", "b", "b"};
+    else
+        vals = {20, 10, 30, 10, 20, 20};
+    auto m = genGivenVals<DenseMatrix<VT>>(6, vals);
+
+    SECTION("first occurrence") {
+        DictionaryEncoding<VT> enc(m);
+        REQUIRE(enc.getNumRows() == 6);
+        REQUIRE(enc.getNumDistinct() == 3);
+        const std::vector<CodeType> exp = {0, 1, 2, 1, 0, 0};
+        CHECK(std::vector<CodeType>(enc.getCodes(), enc.getCodes() + 6) == exp);
+        CHECK(enc.getValue(0) == vals[0]);
+        CHECK(enc.getValue(1) == vals[1]);
+        CHECK(enc.getValue(2) == vals[2]);
+    }
+    SECTION("order-preserving") {
+        DictionaryEncoding<VT> enc(m, 0, true);
+        REQUIRE(enc.getNumDistinct() == 3);
+        const std::vector<CodeType> exp = {1, 0, 2, 0, 1, 1};
+        CHECK(std::vector<CodeType>(enc.getCodes(), enc.getCodes() + 6) == exp);
+        CHECK(enc.getValue(0) == vals[1]);
+        CHECK(enc.getValue(1) == vals[0]);
+        CHECK(enc.getValue(2) == vals[2]);
+        CHECK(enc.find(vals[2]) == std::make_pair(true, CodeType(2)));
+    }
+    SECTION("lookup of absent values") {
+        DictionaryEncoding<VT> enc(m);
+        VT absent;
+        if constexpr (std::is_same_v<VT, std::string>)
+            absent = "d";
+        else
+            absent = 40;
+        CHECK_FALSE(enc.find(absent).first);
+    }
+    SECTION("codes as matrix") {
+        DictionaryEncoding<VT> enc(m, 0, true);
+        auto codes = enc.createCodesMatrix();
+        auto exp = genGivenVals<DenseMatrix<CodeType>>(6, {1, 0, 2, 0, 1, 1});
+        CHECK(*codes == *exp);
+        DataObjectFactory::destroy(codes, exp);
+    }
+
+    DataObjectFactory::destroy(m);
+}
+
+TEST_CASE("DictionaryEncoding of a column in a view", TAG_DATASTRUCTURES) {
+    auto m = genGivenVals<DenseMatrix<int64_t>>(3, {1, 7, 2, 8, 1, 7});
+    DictionaryEncoding<int64_t> enc(m, 1);
+    CHECK(enc.getNumDistinct() == 2);
+    const std::vector<uint32_t> exp = {0, 1, 0};
+    CHECK(std::vector<uint32_t>(enc.getCodes(), enc.getCodes() + 3) == exp);
+    DataObjectFactory::destroy(m);
+}
@@ -0,0 +1,285 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/io/ArrowCData.h>
+#include <runtime/local/kernels/ReceiveFromArrow.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+TEST_CASE("ArrowCData round trip of a frame", TAG_IO) {
+    auto c0 = genGivenVals<DenseMatrix<double>>(3, {1.5, 2.5, 3.5});
+    auto c1 = genGivenVals<DenseMatrix<int64_t>>(3, {-1, 0, 1});
+    auto c2 = genGivenVals<DenseMatrix<uint8_t>>(3, {7, 8, 9});
+    auto c3 = DataObjectFactory::create<DenseMatrix<std::string>>(3, 1, false);
+    c3->set(0, 0, "a");
+    c3->set(1, 0, "");
+    c3->set(2, 0, "hello world");
+    std::vector<Structure *> cols = {c0, c1, c2, c3};
+    const std::string labels[] = {"a", "b", "c", "d"};
+    auto exp = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(c0, c1, c2, c3);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowCData::exportFrame(exp, &array, &schema);
+    CHECK(std::string(schema.format) == "+s");
+    CHECK(schema.n_children == 4);
+    CHECK(std::string(schema.children[0]->format) == "g");
+    CHECK(std::string(schema.children[3]->format) == "U");
+    CHECK(std::string(schema.children[1]->name) == "b");
+    CHECK(array.length == 3);
+
+    Frame *res = nullptr;
+    ArrowCData::importFrame(res, &array, &schema);
+    CHECK(array.release == nullptr);
+    CHECK(schema.release == nullptr);
+    CHECK(*res == *exp);
+    // Numeric columns are shared in both directions, strings are copied.
+    CHECK(res->getColumnRaw(0) == exp->getColumnRaw(0));
+    CHECK(res->getColumnRaw(3) != exp->getColumnRaw(3));
+
+    // The imported frame keeps the exported one alive.
+    const double *values = static_cast<const double *>(exp->getColumnRaw(0));
+    DataObjectFactory::destroy(exp);
+    CHECK(values[2] == 3.5);
+    DataObjectFactory::destroy(res);
+}
+
+TEST_CASE("ArrowCData releases an exported frame that is not consumed", TAG_IO) {
+    auto c0 = genGivenVals<DenseMatrix<int32_t>>(2, {1, 2});
+    std::vector<Structure *> cols = {c0};
+    auto frame = DataObjectFactory::create<Frame>(cols, nullptr);
+    DataObjectFactory::destroy(c0);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowCData::exportFrame(frame, &array, &schema);
+    CHECK(frame->getRefCounter() == 2);
+    array.release(&array);
+    schema.release(&schema);
+    CHECK(frame->getRefCounter() == 1);
+    DataObjectFactory::destroy(frame);
+
+    auto strs = DataObjectFactory::create<Frame>(1, 1, std::vector<ValueTypeCode>{ValueTypeCode::FIXEDSTR16}.data(),
+                                                 nullptr, true);
+    CHECK_THROWS_AS(ArrowCData::exportFrame(strs, &array, &schema), std::runtime_error);
+    CHECK(strs->getRefCounter() == 1);
+    DataObjectFactory::destroy(strs);
+}
+
+// A struct array as produced by other libraries, with nulls, offsets,
+// dictionaries, and types DAPHNE does not have.
+struct ForeignBatch {
+    static inline int numReleased = 0;
+
+    // int64 with a null in the second row
+    std::vector<uint8_t> validity = {0b11111101};
+    std::vector<int64_t> ints = {100, 10, 0, 20, 30};
+    // int16 without nulls
+    std::vector<int16_t> shorts = {-1, -2, -3, -4, -5};
+    // utf8 with a null in the third row
+    std::vector<uint8_t> strValidity = {0b11111011};
+    std::vector<int32_t> strOffsets = {0, 1, 3, 3, 6, 6};
+    std::string strChars = "xabdef";
+    // dictionary-encoded utf8
+    std::vector<int8_t> indices = {0, 1, 1, 0, 1};
+    std::vector<int32_t> dictOffsets = {0, 3, 7};
+    std::string dictChars = "lowhigh";
+    // booleans
+    std::vector<uint8_t> bools = {0b00010110};
+
+    std::vector<std::vector<const void *>> buffers = {
+        {nullptr},
+        {validity.data(), ints.data()},
+        {nullptr, shorts.data()},
+        {strValidity.data(), strOffsets.data(), strChars.data()},
+        {nullptr, indices.data()},
+        {nullptr, dictOffsets.data(), dictChars.data()},
+        {nullptr, bools.data()}};
+    ArrowArray children[6];
+    ArrowArray *childPtrs[5];
+    ArrowSchema childSchemas[6];
+    ArrowSchema *childSchemaPtrs[5];
+
+    static void releaseArray(ArrowArray *a) {
+        numReleased++;
+        a->release = nullptr;
+    }
+    static void releaseSchema(ArrowSchema *s) { s->release = nullptr; }
+
+    ForeignBatch(ArrowArray *array, ArrowSchema *schema) {
+        const char *formats[] = {"l", "s", "u", "c", "u", "b"};
+        const char *names[] = {"ints", "shorts", "strs", "cats", "", "bools"};
+        const int64_t nullCounts[] = {-1, 0, 1, 0, 0, 0};
+        for (size_t i = 0; i < 6; i++) {
+            // All children are longer than the batch, which starts at row 1.
+            children[i] = {5, nullCounts[i], 0, i == 2 || i == 4 ? 3 : 2, 0, buffers[i + 1].data(),
+                           nullptr, nullptr, nullptr, nullptr};
+            childSchemas[i] = {formats[i], names[i], nullptr, 0, 0, nullptr, nullptr, &releaseSchema, nullptr};
+        }
+        children[4].length = 2;
+        children[3].dictionary = &children[4];
+        childSchemas[3].dictionary = &childSchemas[4];
+        const size_t order[] = {0, 1, 2, 3, 5};
+        for (size_t i = 0; i < 5; i++) {
+            childPtrs[i] = &children[order[i]];
+            childSchemaPtrs[i] = &childSchemas[order[i]];
+        }
+        *array = {3, 0, 1, 1, 5, buffers[0].data(), childPtrs, nullptr, &releaseArray, nullptr};
+        *schema = {"+s", "", nullptr, 0, 5, childSchemaPtrs, nullptr, &releaseSchema, nullptr};
+    }
+};
+
+TEST_CASE("ArrowCData imports nulls, dictionaries, and narrow types", TAG_IO) {
+    ArrowArray array;
+    ArrowSchema schema;
+    ForeignBatch batch(&array, &schema);
+    ForeignBatch::numReleased = 0;
+
+    Frame *res = nullptr;
+    const char *labels[] = {"i", "s", "t", "c", "b"};
+    ArrowCData::importFrame(res, &array, &schema, labels, 5);
+    CHECK(res->getNumRows() == 3);
+    CHECK(res->getLabels()[3] == "c");
+
+    CHECK(res->getColumnType(0) == ValueTypeCode::F64);
+    const auto *ints = static_cast<const double *>(res->getColumnRaw(0));
+    CHECK(std::isnan(ints[0]));
+    CHECK(ints[1] == 0);
+    CHECK(ints[2] == 20);
+
+    CHECK(res->getColumnType(1) == ValueTypeCode::SI32);
+    const auto *shorts = static_cast<const int32_t *>(res->getColumnRaw(1));
+    CHECK(shorts[0] == -2);
+    CHECK(shorts[2] == -4);
+
+    CHECK(res->getColumnType(2) == ValueTypeCode::STR);
+    const auto *strs = static_cast<const std::string *>(res->getColumnRaw(2));
+    CHECK(strs[0] == "ab");
+    CHECK(strs[1] == "");
+    CHECK(strs[2] == "def");
+
+    CHECK(res->getColumnType(3) == ValueTypeCode::STR);
+    const auto *cats = static_cast<const std::string *>(res->getColumnRaw(3));
+    CHECK(cats[0] == "high");
+    CHECK(cats[1] == "high");
+    CHECK(cats[2] == "low");
+
+    CHECK(res->getColumnType(4) == ValueTypeCode::UI8);
+    const auto *bools = static_cast<const uint8_t *>(res->getColumnRaw(4));
+    CHECK(bools[0] == 1);
+    CHECK(bools[1] == 1);
+    CHECK(bools[2] == 0);
+
+    // The shorts were converted, so nothing refers to the batch anymore.
+    CHECK(ForeignBatch::numReleased == 1);
+    DataObjectFactory::destroy(res);
+}
+
+TEST_CASE("ArrowCData keeps an imported array until its columns are gone", TAG_IO) {
+    ArrowArray array;
+    ArrowSchema schema;
+    ForeignBatch batch(&array, &schema);
+    ForeignBatch::numReleased = 0;
+    // Only keep the int64 column and mark it as free of nulls, such that it
+    // is used as is.
+    batch.children[0].null_count = 0;
+    array.n_children = 1;
+    schema.n_children = 1;
+
+    Frame *res = nullptr;
+    ArrowCData::importFrame(res, &array, &schema);
+    CHECK(res->getColumnType(0) == ValueTypeCode::SI64);
+    CHECK(res->getLabels()[0] == "ints");
+    CHECK(res->getColumnRaw(0) == batch.ints.data() + 1);
+    CHECK(ForeignBatch::numReleased == 0);
+    DataObjectFactory::destroy(res);
+    CHECK(ForeignBatch::numReleased == 1);
+}
+
+TEST_CASE("ArrowCData rejects unsupported arrays", TAG_IO) {
+    ArrowArray array;
+    ArrowSchema schema;
+    ForeignBatch batch(&array, &schema);
+    ForeignBatch::numReleased = 0;
+    Frame *res = nullptr;
+
+    SECTION("unsupported format") { batch.childSchemas[1].format = "tss:"; }
+    SECTION("wrong number of labels") {
+        const char *labels[] = {"a"};
+        CHECK_THROWS_AS(ArrowCData::importFrame(res, &array, &schema, labels, 1), std::runtime_error);
+        CHECK(ForeignBatch::numReleased == 1);
+        return;
+    }
+    SECTION("not a struct") { schema.format = "l"; }
+    SECTION("dictionary index too large") { batch.indices[2] = 2; }
+    SECTION("negative dictionary index") { batch.indices[3] = -1; }
+    CHECK_THROWS_AS(ArrowCData::importFrame(res, &array, &schema), std::runtime_error);
+    // The arrays are released even if the import fails.
+    CHECK(ForeignBatch::numReleased == 1);
+    CHECK(array.release == nullptr);
+}
+
+TEST_CASE("receiveFromArrow checks the column types", TAG_IO) {
+    auto c0 = genGivenVals<DenseMatrix<double>>(2, {1.5, 2.5});
+    auto c1 = genGivenVals<DenseMatrix<int64_t>>(2, {1, 2});
+    std::vector<Structure *> cols = {c0, c1};
+    auto exp = DataObjectFactory::create<Frame>(cols, nullptr);
+    DataObjectFactory::destroy(c0, c1);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    ArrowCData::exportFrame(exp, &array, &schema);
+    const auto arrayAddress = reinterpret_cast<uint64_t>(&array);
+    const auto schemaAddress = reinterpret_cast<uint64_t>(&schema);
+    Frame *res = nullptr;
+
+    SECTION("expected column types") {
+        const ValueTypeCode vtcs[] = {ValueTypeCode::F64, ValueTypeCode::SI64};
+        receiveFromArrow(res, arrayAddress, schemaAddress, nullptr, 0, vtcs, 2, nullptr);
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(res);
+    }
+    SECTION("other column types") {
+        const ValueTypeCode vtcs[] = {ValueTypeCode::F64, ValueTypeCode::F64};
+        CHECK_THROWS_AS(receiveFromArrow(res, arrayAddress, schemaAddress, nullptr, 0, vtcs, 2, nullptr),
+                        std::runtime_error);
+        // The received frame was destroyed, which released the exported one.
+        CHECK(exp->getRefCounter() == 1);
+    }
+    SECTION("other number of columns") {
+        const ValueTypeCode vtcs[] = {ValueTypeCode::F64};
+        CHECK_THROWS_AS(receiveFromArrow(res, arrayAddress, schemaAddress, nullptr, 0, vtcs, 1, nullptr),
+                        std::runtime_error);
+        // The received frame was destroyed, which released the exported one.
+        CHECK(exp->getRefCounter() == 1);
+    }
+    CHECK(array.release == nullptr);
+    DataObjectFactory::destroy(exp);
+}
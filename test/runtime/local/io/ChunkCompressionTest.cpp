@@ -0,0 +1,127 @@
+/*
+ * Copyright 2021 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/ChunkCompression.h>
+#include <runtime/local/io/DaphneSerializer.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#define DATA_TYPES DenseMatrix, CSRMatrix
+#define VALUE_TYPES int64_t, double
+
+TEST_CASE("ChunkCompression pack/unpack words", TAG_IO) {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> words;
+    // Increasing, decreasing, constant and arbitrary words.
+    for (uint64_t i = 0; i < 300; i++)
+        words.push_back(i * 3);
+    for (uint64_t i = 0; i < 50; i++)
+        words.push_back(1000 - i * 7);
+    for (uint64_t i = 0; i < 200; i++)
+        words.push_back(5);
+    for (uint64_t i = 0; i < 100; i++)
+        words.push_back(rng());
+    words.push_back(0);
+    words.push_back(UINT64_MAX);
+
+    std::vector<char> packed(words.size() * 9);
+    const size_t packedLength = ChunkCompression::packWords(reinterpret_cast<const char *>(words.data()), words.size(),
+                                                            packed.data());
+    std::vector<uint64_t> res(words.size());
+    const size_t readLength =
+        ChunkCompression::unpackWords(packed.data(), packedLength, words.size(), reinterpret_cast<char *>(res.data()));
+
+    CHECK(readLength == packedLength);
+    CHECK(res == words);
+    CHECK_THROWS(ChunkCompression::unpackWords(packed.data(), packedLength - 1, words.size(),
+                                               reinterpret_cast<char *>(res.data())));
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ChunkCompression compress/decompress chunks", TAG_IO, (DATA_TYPES), (VALUE_TYPES)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    const double sparsity = std::is_same<DT, CSRMatrix<VT>>::value ? 0.05 : 1.0;
+    DT *mat = nullptr;
+    randMatrix<DT, VT>(mat, 500, 300, 0, 3, sparsity, 7, nullptr);
+
+    const auto codec = GENERATE(CompressionCodec::NONE, CompressionCodec::LZ4, CompressionCodec::ZSTD);
+    const size_t chunkSize = GENERATE(1000, 4099, 1048576);
+
+    ChunkCompression::ChunkCompressor compressor(codec, ChunkCompression::packableRange(mat));
+    std::vector<std::vector<char>> frames;
+    size_t rawLength = 0;
+    size_t framedLength = 0;
+    auto ser = DaphneSerializerChunks<DT>(mat, chunkSize);
+    for (auto it = ser.begin(); it != ser.end(); ++it) {
+        std::vector<char> frame;
+        const size_t len = compressor.compress(it->second->data(), it->first, rawLength, frame);
+        REQUIRE(len <= ChunkCompression::maxFrameLength(it->first));
+        frame.resize(len);
+        frames.push_back(frame);
+        rawLength += it->first;
+        framedLength += len;
+    }
+    // Small integers compress well, and so do the indices of a CSRMatrix.
+    if (codec != CompressionCodec::NONE && std::is_integral<VT>::value)
+        CHECK(framedLength < rawLength / 2);
+    if (std::is_same<DT, CSRMatrix<VT>>::value)
+        CHECK(framedLength < rawLength);
+
+    DT *res = nullptr;
+    size_t i = 0;
+    std::vector<char> chunk;
+    auto deser = DaphneDeserializerChunks<DT>(&res, chunkSize);
+    for (auto it = deser.begin(); it != deser.end(); ++it) {
+        const size_t len = ChunkCompression::decompress(frames[i].data(), frames[i].size(), chunk);
+        std::copy(chunk.begin(), chunk.begin() + len, it->second->begin());
+        it->first = len;
+        i++;
+    }
+    CHECK(i == frames.size());
+    CHECK(*res == *mat);
+
+    DataObjectFactory::destroy(mat, res);
+}
+
+TEST_CASE("ChunkCompression incompressible chunks", TAG_IO) {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> data(4096);
+    for (auto &word : data)
+        word = rng();
+    const char *bytes = reinterpret_cast<const char *>(data.data());
+    const size_t length = data.size() * sizeof(uint64_t);
+
+    ChunkCompression::ChunkCompressor compressor(CompressionCodec::LZ4, {0, length});
+    std::vector<char> frame;
+    const size_t len = compressor.compress(bytes, length, 0, frame);
+
+    // Neither stage pays off, so the chunk is stored as is.
+    CHECK(len == ChunkCompression::maxFrameLength(length));
+
+    std::vector<char> res;
+    REQUIRE(ChunkCompression::decompress(frame.data(), len, res) == length);
+    CHECK(std::equal(res.begin(), res.end(), bytes));
+}
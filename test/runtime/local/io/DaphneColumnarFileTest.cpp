@@ -0,0 +1,341 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "run_tests.h"
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/io/DaphneColumnarFile.h>
+#include <runtime/local/io/ReadDaphne.h>
+#include <runtime/local/io/ReadDaphneColumnar.h>
+#include <runtime/local/io/WriteDaphne.h>
+#include <runtime/local/io/WriteDaphneColumnar.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+static DaphneColumnarFooter readFooterOf(const char *filename) {
+    const int fd = open(filename, O_RDONLY);
+    DaphneColumnarFooter footer = DaphneColumnar::readFooter(fd, filename);
+    close(fd);
+    return footer;
+}
+
+static Frame *createTestFrame(size_t numRows) {
+    std::mt19937 gen(numRows);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    auto c0 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRows, 1, false);
+    auto c1 = DataObjectFactory::create<DenseMatrix<double>>(numRows, 1, false);
+    auto c2 = DataObjectFactory::create<DenseMatrix<std::string>>(numRows, 1, false);
+    auto c3 = DataObjectFactory::create<DenseMatrix<float>>(numRows, 1, false);
+    auto c4 = DataObjectFactory::create<DenseMatrix<uint8_t>>(numRows, 1, false);
+    for (size_t r = 0; r < numRows; r++) {
+        // Sorted, low-cardinality, low-cardinality, arbitrary, and small values.
+        c0->getValues()[r] = static_cast<int64_t>(r) * 3 - 100;
+        c1->getValues()[r] = (r % 7) * 0.5;
+        c2->getValues()[r] = "val" + std::to_string(r % 5);
+        c3->getValues()[r] = dist(gen) * 0.001f;
+        c4->getValues()[r] = static_cast<uint8_t>(r % 3);
+    }
+    std::vector<Structure *> cols = {c0, c1, c2, c3, c4};
+    std::string labels[] = {"id", "cat", "str", "val", "small"};
+    auto frame = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(c0, c1, c2, c3, c4);
+    return frame;
+}
+
+TEST_CASE("DaphneColumnarFile round trip of frames", TAG_IO) {
+    auto dctx = setupContextAndLogger();
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+
+    const size_t numRows = GENERATE(0, 1, 100, 1000);
+    DaphneColumnarWriteOptions wopts;
+    wopts.rowGroupSize = 64;
+    wopts.codec = GENERATE(CompressionCodec::NONE, CompressionCodec::LZ4);
+
+    Frame *arg = createTestFrame(numRows);
+    writeDaphneColumnar(arg, filename, wopts, dctx.get());
+    CHECK(DaphneColumnar::isColumnarFile(filename));
+
+    Frame *res = nullptr;
+    readDaphneColumnar(res, filename, {}, dctx.get());
+    CHECK(*res == *arg);
+
+    DataObjectFactory::destroy(arg, res);
+    std::remove(filename);
+}
+
+TEST_CASE("DaphneColumnarFile chunk encodings and statistics", TAG_IO) {
+    auto dctx = setupContextAndLogger();
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+
+    Frame *arg = createTestFrame(1000);
+    DaphneColumnarWriteOptions wopts;
+    wopts.rowGroupSize = 300;
+    writeDaphneColumnar(arg, filename, wopts, dctx.get());
+
+    DaphneColumnarFooter footer = readFooterOf(filename);
+    CHECK(footer.dt == DF_data_t::Frame_t);
+    CHECK(footer.numRows == 1000);
+    CHECK(footer.numCols == 5);
+    CHECK(footer.labels == std::vector<std::string>{"id", "cat", "str", "val", "small"});
+    CHECK(footer.rowGroupStarts == std::vector<uint64_t>{0, 300, 600, 900, 1000});
+
+    const DCF_chunk &id = footer.getChunk(1, 0);
+    CHECK(id.encoding == static_cast<uint8_t>(DCF_encoding_t::BITPACKED));
+    CHECK(id.hasMinMax);
+    CHECK(DaphneColumnar::statValue(id.min, ValueTypeCode::SI64) == 800);
+    CHECK(DaphneColumnar::statValue(id.max, ValueTypeCode::SI64) == 1697);
+    CHECK(footer.getChunk(1, 1).encoding == static_cast<uint8_t>(DCF_encoding_t::DICTIONARY));
+    CHECK(footer.getChunk(1, 2).encoding == static_cast<uint8_t>(DCF_encoding_t::DICTIONARY));
+    CHECK(footer.getChunk(1, 2).hasMinMax == 0);
+    CHECK(footer.getChunk(1, 3).encoding == static_cast<uint8_t>(DCF_encoding_t::PLAIN));
+
+    DataObjectFactory::destroy(arg);
+    std::remove(filename);
+}
+
+TEST_CASE("DaphneColumnarFile projection, predicates, and row ranges", TAG_IO) {
+    auto dctx = setupContextAndLogger();
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+
+    auto arg = genGivenVals<DenseMatrix<int64_t>>(8, {
+                                                         0, 10, 100, //
+                                                         1, 11, 101, //
+                                                         2, 12, 102, //
+                                                         3, 13, 103, //
+                                                         4, 14, 104, //
+                                                         5, 15, 105, //
+                                                         6, 16, 106, //
+                                                         7, 17, 107, //
+                                                     });
+    DaphneColumnarWriteOptions wopts;
+    wopts.rowGroupSize = 3;
+    writeDaphneColumnar(arg, filename, wopts, dctx.get());
+
+    SECTION("projection") {
+        DaphneColumnarReadOptions ropts;
+        ropts.colIdxs = {2, 0};
+        DenseMatrix<int64_t> *res = nullptr;
+        readDaphneColumnar(res, filename, ropts, dctx.get());
+        auto exp = genGivenVals<DenseMatrix<int64_t>>(
+            8, {100, 0, 101, 1, 102, 2, 103, 3, 104, 4, 105, 5, 106, 6, 107, 7});
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(res, exp);
+    }
+    SECTION("predicates skip row groups") {
+        DaphneColumnarReadOptions ropts;
+        ropts.colIdxs = {1};
+        ropts.predicates = {{1, 13.5, 14}};
+        DenseMatrix<int64_t> *res = nullptr;
+        readDaphneColumnar(res, filename, ropts, dctx.get());
+        // Only the second row group [3, 6) may contain values in the range.
+        auto exp = genGivenVals<DenseMatrix<int64_t>>(3, {13, 14, 15});
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(res, exp);
+    }
+    SECTION("predicates on multiple columns") {
+        DaphneColumnarReadOptions ropts;
+        ropts.colIdxs = {0};
+        ropts.predicates = {{0, 0, 6}, {2, 106, 200}};
+        DenseMatrix<int64_t> *res = nullptr;
+        readDaphneColumnar(res, filename, ropts, dctx.get());
+        auto exp = genGivenVals<DenseMatrix<int64_t>>(2, {6, 7});
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(res, exp);
+    }
+    SECTION("row range") {
+        DaphneColumnarReadOptions ropts;
+        ropts.startRow = 2;
+        ropts.numRows = 5;
+        DenseMatrix<int64_t> *res = nullptr;
+        readDaphneColumnar(res, filename, ropts, dctx.get());
+        auto exp = genGivenVals<DenseMatrix<int64_t>>(
+            5, {2, 12, 102, 3, 13, 103, 4, 14, 104, 5, 15, 105, 6, 16, 106});
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(res, exp);
+    }
+    SECTION("invalid arguments") {
+        DaphneColumnarReadOptions ropts;
+        ropts.colIdxs = {3};
+        DenseMatrix<int64_t> *res = nullptr;
+        CHECK_THROWS(readDaphneColumnar(res, filename, ropts, dctx.get()));
+        DenseMatrix<double> *resF64 = nullptr;
+        CHECK_THROWS(readDaphneColumnar(resF64, filename, {}, dctx.get()));
+    }
+
+    DataObjectFactory::destroy(arg);
+    std::remove(filename);
+}
+
+TEST_CASE("DaphneColumnarFile NaN statistics", TAG_IO) {
+    auto dctx = setupContextAndLogger();
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    auto arg = genGivenVals<DenseMatrix<double>>(4, {nan, -1.5, nan, 2.5});
+    DaphneColumnarWriteOptions wopts;
+    wopts.rowGroupSize = 2;
+    writeDaphneColumnar(arg, filename, wopts, dctx.get());
+
+    DaphneColumnarFooter footer = readFooterOf(filename);
+    CHECK(footer.getChunk(0, 0).numNulls == 1);
+    CHECK(DaphneColumnar::statValue(footer.getChunk(0, 0).min, ValueTypeCode::F64) == -1.5);
+    CHECK(footer.getChunk(1, 0).numNulls == 1);
+    CHECK(DaphneColumnar::statValue(footer.getChunk(1, 0).max, ValueTypeCode::F64) == 2.5);
+
+    DenseMatrix<double> *res = nullptr;
+    readDaphneColumnar(res, filename, {}, dctx.get());
+    CHECK(std::isnan(res->get(0, 0)));
+    CHECK(res->get(1, 0) == -1.5);
+    CHECK(std::isnan(res->get(2, 0)));
+    CHECK(res->get(3, 0) == 2.5);
+
+    DataObjectFactory::destroy(arg, res);
+    std::remove(filename);
+}
+
+TEST_CASE("DaphneColumnarFile parallel encode and decode", TAG_IO) {
+    auto dctx = setupContextAndLogger();
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+    // The size exceeds the threshold for using multiple threads.
+    const int oldNumThreads = dctx->config.numberOfThreads;
+    dctx->config.numberOfThreads = 4;
+
+    Frame *arg = createTestFrame(300000);
+    writeDaphneColumnar(arg, filename, {}, dctx.get());
+    Frame *res = nullptr;
+    readDaphneColumnar(res, filename, {}, dctx.get());
+    CHECK(*res == *arg);
+
+    dctx->config.numberOfThreads = oldNumThreads;
+    DataObjectFactory::destroy(arg, res);
+    std::remove(filename);
+}
+
+TEST_CASE("DaphneColumnarFile rejects other files", TAG_IO) {
+    auto dctx = setupContextAndLogger();
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f << "this is not a columnar file at all";
+    }
+    CHECK_FALSE(DaphneColumnar::isColumnarFile(filename));
+    Frame *res = nullptr;
+    CHECK_THROWS(readDaphneColumnar(res, filename, {}, dctx.get()));
+
+    CHECK_FALSE(DaphneColumnar::isColumnarFile("./test/runtime/local/io/cig.dbdf"));
+    std::remove(filename);
+}
+
+TEMPLATE_TEST_CASE("DaphneColumnarFile rejects corrupt chunks", TAG_IO, int64_t, double, std::string) {
+    using VT = TestType;
+
+    // Few distinct values, such that non-string chunks are not stored plainly.
+    const size_t numRows = GENERATE(5, 300);
+    std::vector<VT> values(numRows);
+    for (size_t r = 0; r < numRows; r++) {
+        if constexpr (std::is_same_v<VT, std::string>)
+            values[r] = "val" + std::to_string(r % 5);
+        else
+            values[r] = static_cast<VT>(r % 5);
+    }
+    DCF_chunk chunk{};
+    std::vector<char> encoded;
+    DaphneColumnar::encodeChunk(values.data(), 1, numRows, CompressionCodec::NONE, chunk, encoded);
+
+    std::vector<VT> res(numRows);
+    DaphneColumnar::decodeChunk(encoded.data(), chunk, numRows, 0, numRows, res.data(), 1);
+    CHECK(res == values);
+
+    // Every truncation of the chunk must be detected instead of reading past
+    // its end.
+    for (size_t length = 0; length < encoded.size(); length++) {
+        DCF_chunk truncated = chunk;
+        truncated.length = truncated.encodedLength = length;
+        std::vector<char> data(encoded.begin(), encoded.begin() + length);
+        CHECK_THROWS(DaphneColumnar::decodeChunk(data.data(), truncated, numRows, 0, numRows, res.data(), 1));
+    }
+}
+
+TEST_CASE("DaphneColumnarFile rejects too long labels", TAG_IO) {
+    auto dctx = setupContextAndLogger();
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+    std::remove(filename);
+
+    auto c0 = genGivenVals<DenseMatrix<int64_t>>(2, {1, 2});
+    std::vector<Structure *> cols = {c0};
+    std::string labels[] = {std::string(size_t(std::numeric_limits<uint16_t>::max()) + 1, 'a')};
+    auto arg = DataObjectFactory::create<Frame>(cols, labels);
+
+    CHECK_THROWS(writeDaphneColumnar(arg, filename, {}, dctx.get()));
+    CHECK_FALSE(std::filesystem::exists(filename));
+    CHECK_THROWS(writeDaphne(arg, filename));
+    CHECK_FALSE(std::filesystem::exists(filename));
+
+    DataObjectFactory::destroy(c0, arg);
+}
+
+TEST_CASE("DaphneColumnarFile leaves version 1 files to the previous reader", TAG_IO) {
+    const char *filename = "./test/runtime/local/io/DaphneColumnarFileTest.dbdf";
+
+    SECTION("dense matrix") {
+        auto arg = genGivenVals<DenseMatrix<double>>(3, {1.5, 2, 3, 4, 5, 6.5});
+        writeDaphne(arg, filename);
+        CHECK_FALSE(DaphneColumnar::isColumnarFile(filename));
+
+        DenseMatrix<double> *res = nullptr;
+        readDaphne(res, filename);
+        CHECK(*res == *arg);
+
+        DataObjectFactory::destroy(arg, res);
+    }
+    SECTION("frame") {
+        auto c0 = genGivenVals<DenseMatrix<int64_t>>(3, {1, -2, 3});
+        auto c1 = genGivenVals<DenseMatrix<double>>(3, {0.5, 1.5, 2.5});
+        std::vector<Structure *> cols = {c0, c1};
+        std::string labels[] = {"id", "value"};
+        auto arg = DataObjectFactory::create<Frame>(cols, labels);
+        writeDaphne(arg, filename);
+        CHECK_FALSE(DaphneColumnar::isColumnarFile(filename));
+
+        Frame *res = nullptr;
+        readDaphne(res, filename);
+        CHECK(*res == *arg);
+
+        DataObjectFactory::destroy(c0, c1, arg, res);
+    }
+    std::remove(filename);
+}
@@ -17,6 +17,7 @@
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/io/DaphneSerializer.h>
 #include <runtime/local/kernels/CheckEq.h>
 #include <runtime/local/kernels/RandMatrix.h>
@@ -28,6 +29,7 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <string>
 #include <vector>
 
 #define DATA_TYPES DenseMatrix, CSRMatrix
@@ -274,3 +276,117 @@ TEMPLATE_PRODUCT_TEST_CASE("DaphneSerializer serialize/deserialize in order "
     if (newMat != nullptr) // suppress warning
         DataObjectFactory::destroy(newMat);
 }
+
+// ----------------------------------------------------------------------------
+// Frames
+// ----------------------------------------------------------------------------
+
+namespace {
+Frame *genFrame(size_t numRows) {
+    auto c0 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRows, 1, false);
+    auto c1 = DataObjectFactory::create<DenseMatrix<double>>(numRows, 1, false);
+    auto c2 = DataObjectFactory::create<DenseMatrix<std::string>>(numRows, 1, false);
+    auto c3 = DataObjectFactory::create<DenseMatrix<uint8_t>>(numRows, 1, false);
+    for (size_t r = 0; r < numRows; r++) {
+        c0->set(r, 0, static_cast<int64_t>(r) - 17);
+        c1->set(r, 0, r * 0.5);
+        // Includes empty strings and strings longer than a chunk.
+        c2->set(r, 0, std::string(r % 7 == 0 ? 0 : (r * 13) % 150, static_cast<char>('a' + r % 26)));
+        c3->set(r, 0, r % 256);
+    }
+    std::vector<Structure *> cols{c0, c1, c2, c3};
+    std::string labels[] = {"id", "value", "name", "flag"};
+    auto frame = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(c0, c1, c2, c3);
+    return frame;
+}
+} // namespace
+
+TEST_CASE("DaphneSerializer serialize/deserialize Frame", TAG_IO) {
+    const size_t numRows = GENERATE(0, 1, 100);
+    Frame *frame = genFrame(numRows);
+
+    std::vector<char> buffer;
+    const size_t len = DaphneSerializer<Frame>::serialize(frame, buffer);
+    CHECK(len == DaphneSerializer<Frame>::length(frame));
+    CHECK(DaphneSerializer<Frame>::serializedLength(buffer.data()) == len);
+
+    auto newFrame = dynamic_cast<Frame *>(DF_deserialize(buffer));
+    REQUIRE(newFrame != nullptr);
+    CHECK(*newFrame == *frame);
+
+    DataObjectFactory::destroy(frame, newFrame);
+}
+
+TEMPLATE_TEST_CASE("DaphneSerializer serialize/deserialize Frame in order using iterator", TAG_IO, Frame, Structure) {
+    using DT = TestType;
+    const size_t chunkSize = GENERATE(60, 101, 1000, 1048576);
+    Frame *frame = genFrame(100);
+
+    auto tempBuff = std::vector<char>(DaphneSerializer<Frame>::length(frame));
+    auto ser = DaphneSerializerChunks<DT>(frame, chunkSize);
+    size_t idx = 0;
+    for (auto it = ser.begin(); it != ser.end(); ++it) {
+        std::copy(it->second->begin(), it->second->begin() + it->first, tempBuff.begin() + idx);
+        idx += it->first;
+    }
+    REQUIRE(idx == tempBuff.size());
+
+    DT *newFrame = nullptr;
+    idx = 0;
+    auto deser = DaphneDeserializerChunks<DT>(&newFrame, chunkSize);
+    for (auto it = deser.begin(); it != deser.end(); ++it) {
+        size_t chnck = std::min(chunkSize, tempBuff.size() - idx);
+        std::copy(tempBuff.begin() + idx, tempBuff.begin() + idx + chnck, it->second->begin());
+        it->first = chnck;
+        idx += chnck;
+    }
+    CHECK(idx == tempBuff.size());
+    REQUIRE(dynamic_cast<Frame *>(newFrame) != nullptr);
+    CHECK(*dynamic_cast<Frame *>(newFrame) == *frame);
+
+    DataObjectFactory::destroy(frame);
+    if (newFrame != nullptr) // suppress warning
+        DataObjectFactory::destroy(newFrame);
+}
+
+TEST_CASE("DaphneSerializer serialize/deserialize Frame in chunks in order", TAG_IO) {
+    // Each chunk holds the header, so the first one must fit it twice.
+    const size_t chunkSize = GENERATE(150, 1000);
+    Frame *frame = genFrame(100);
+
+    std::vector<char> buffer;
+    DaphneSerializer<Frame>::serialize(frame, buffer);
+
+    // The chunks together must be the same as the Frame serialized at once.
+    std::vector<char> chunks;
+    DaphneSerializerOutOfOrderChunks<Frame> serializer(frame, chunkSize);
+    DaphneDeserializerOutOfOrderChunks<Frame> deserializer;
+    while (serializer.HasNextChunk()) {
+        std::vector<char> bufferTmp;
+        const size_t len = serializer.SerializeNextChunk(bufferTmp);
+        bufferTmp.resize(len);
+        const size_t headerLen = DaphneSerializer<Frame>::headerSize(frame) + sizeof(size_t);
+        chunks.insert(chunks.end(), bufferTmp.begin() + headerLen, bufferTmp.end());
+        deserializer.DeserializeNextChunk(bufferTmp);
+    }
+    CHECK(chunks == buffer);
+    CHECK_FALSE(deserializer.HasNextChunk());
+    REQUIRE(deserializer.obj != nullptr);
+    CHECK(*deserializer.obj == *frame);
+
+    DataObjectFactory::destroy(frame, deserializer.obj);
+}
+
+TEST_CASE("DaphneSerializer Frame with too long label", TAG_IO) {
+    auto c0 = DataObjectFactory::create<DenseMatrix<int64_t>>(3, 1, true);
+    std::vector<Structure *> cols{c0};
+    std::string labels[] = {std::string(70000, 'a')};
+    auto frame = DataObjectFactory::create<Frame>(cols, labels);
+
+    std::vector<char> buffer;
+    CHECK_THROWS(DaphneSerializer<Frame>::serialize(frame, buffer));
+    CHECK_THROWS(DaphneSerializer<Frame>::length(frame));
+
+    DataObjectFactory::destroy(c0, frame);
+}
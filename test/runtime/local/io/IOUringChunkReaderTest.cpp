@@ -0,0 +1,140 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef USE_IO_URING
+
+#include <runtime/local/datastructures/ChunkedTensor.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/io/io_uring/IOUringChunkReader.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <cstdint>
+#include <cstdio>
+
+// Writes all chunks of the tensor one after the other, optionally with the
+// opposite byte order.
+template <typename VT> void writeChunks(const ChunkedTensor<VT> *tensor, const char *filename, bool reverseBytes) {
+    std::vector<VT> values(tensor->data.get(), tensor->data.get() + tensor->total_size_in_elements);
+    if (reverseBytes)
+        ReverseArray(values.data(), values.size());
+    std::ofstream f(filename, std::ios::binary);
+    f.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(VT));
+}
+
+TEMPLATE_TEST_CASE("IOUringChunkReader reads all chunks", TAG_IO, double, int32_t) {
+    using VT = TestType;
+    const char *filename = "./test/runtime/local/io/IOUringChunkReaderTest.bin";
+
+    // Chunks of 4 KiB (for double) can be read with O_DIRECT, the others not.
+    const std::vector<size_t> chunkShape = GENERATE(std::vector<size_t>{32, 16}, std::vector<size_t>{3, 5});
+    const unsigned queueDepth = GENERATE(2, 64);
+    const bool reverseBytes = GENERATE(false, true);
+
+    auto exp = DataObjectFactory::create<ChunkedTensor<VT>>(std::vector<size_t>{100, 40}, chunkShape, InitCode::IOTA);
+    writeChunks(exp, filename, reverseBytes);
+
+    auto res = DataObjectFactory::create<ChunkedTensor<VT>>(std::vector<size_t>{100, 40}, chunkShape, InitCode::NONE);
+    {
+        IOUringChunkReader<VT> reader(filename, res, queueDepth, reverseBytes);
+        reader.submit(getConsecutiveChunkReadRequests(res));
+        CHECK(reader.getNumInFlight() <= queueDepth);
+        reader.waitAll();
+        CHECK(reader.getNumPending() == 0);
+    }
+    for (size_t i = 0; i < res->total_chunk_count; i++) {
+        CHECK(res->chunk_io_futures[i].status == IO_STATUS::SUCCESS);
+        CHECK(res->PollChunkMaterializationAndIOStatus(i));
+    }
+    CHECK(*res == *exp);
+
+    DataObjectFactory::destroy(exp, res);
+    std::remove(filename);
+}
+
+TEST_CASE("IOUringChunkReader processes chunks as they arrive", TAG_IO) {
+    const char *filename = "./test/runtime/local/io/IOUringChunkReaderTest.bin";
+    const std::vector<size_t> shape = {20, 20};
+    const std::vector<size_t> chunkShape = {4, 4};
+
+    auto exp = DataObjectFactory::create<ChunkedTensor<int64_t>>(shape, chunkShape, InitCode::IOTA);
+    writeChunks(exp, filename, false);
+    auto res = DataObjectFactory::create<ChunkedTensor<int64_t>>(shape, chunkShape, InitCode::NONE);
+
+    IOUringChunkReader<int64_t> reader(filename, res, 4);
+    // Only read the even chunks, in reverse order.
+    std::vector<ChunkReadRequest> requests;
+    std::vector<size_t> ids;
+    for (size_t i = res->total_chunk_count; i > 0; i--)
+        if ((i - 1) % 2 == 0) {
+            requests.push_back({i - 1, (i - 1) * res->chunk_element_count * sizeof(int64_t)});
+            ids.push_back(i - 1);
+        }
+    reader.submit(requests);
+
+    std::vector<size_t> visited;
+    forEachMaterializedChunk(res, reader, ids, [&](size_t id) {
+        CHECK(std::equal(res->getPtrToChunk(id), res->getPtrToChunk(id) + res->chunk_element_count,
+                         exp->getPtrToChunk(id)));
+        visited.push_back(id);
+    });
+    std::sort(visited.begin(), visited.end());
+    std::sort(ids.begin(), ids.end());
+    CHECK(visited == ids);
+    CHECK_FALSE(res->chunk_materialization_flags[1]);
+    CHECK_THROWS_AS(forEachMaterializedChunk(res, reader, {1}, [](size_t) {}), std::runtime_error);
+
+    DataObjectFactory::destroy(exp, res);
+    std::remove(filename);
+}
+
+TEST_CASE("IOUringChunkReader reports failed reads", TAG_IO) {
+    const char *filename = "./test/runtime/local/io/IOUringChunkReaderTest.bin";
+    const std::vector<size_t> shape = {10};
+    const std::vector<size_t> chunkShape = {4};
+
+    auto res = DataObjectFactory::create<ChunkedTensor<double>>(shape, chunkShape, InitCode::NONE);
+    {
+        // The file only contains the first chunk and half of the second one.
+        std::vector<double> values(6, 1.0);
+        std::ofstream f(filename, std::ios::binary);
+        f.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(double));
+    }
+
+    IOUringChunkReader<double> reader(filename, res);
+    reader.submit(getConsecutiveChunkReadRequests(res));
+    reader.waitAll();
+    CHECK(res->PollChunkMaterializationAndIOStatus(0));
+    CHECK(res->chunk_io_futures[1].status == IO_STATUS::IO_ERROR);
+    CHECK(res->chunk_io_futures[2].status == IO_STATUS::IO_ERROR);
+    CHECK_FALSE(res->PollChunkMaterializationAndIOStatus(1));
+    CHECK_THROWS_AS(forEachMaterializedChunk(res, reader, {0, 1, 2}, [](size_t) {}), std::runtime_error);
+    CHECK_THROWS_AS(reader.submit({{3, 0}}), std::out_of_range);
+
+    CHECK_THROWS(IOUringChunkReader<double>("./test/runtime/local/io/does_not_exist.bin", res));
+
+    DataObjectFactory::destroy(res);
+    std::remove(filename);
+}
+
+#endif // USE_IO_URING
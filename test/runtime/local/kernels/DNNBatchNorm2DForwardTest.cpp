@@ -85,4 +85,25 @@ TEMPLATE_PRODUCT_TEST_CASE("batch_norm_train_fwd", TAG_DNN, (DenseMatrix), (floa
 
     DataObjectFactory::destroy(input);
     DataObjectFactory::destroy(result);
-}
\ No newline at end of file
+}
+TEMPLATE_PRODUCT_TEST_CASE("batch_norm_test_fwd per channel", TAG_DNN, (DenseMatrix),
+                           (float, double)) { // NOLINT(cert-err58-cpp)
+    auto dctx = setupContextAndLogger();
+    using DT = TestType;
+
+    // two images with two channels of 2x2 pixels each
+    auto input = genGivenVals<DT>(2, {1, 2, 3, 4, 1, 2, 3, 4, 5, 6, 7, 8, 5, 6, 7, 8});
+    auto gamma = genGivenVals<DT>(2, {1, 2});
+    auto beta = genGivenVals<DT>(2, {0, 1});
+    auto ema_mean = genGivenVals<DT>(2, {1, 4});
+    auto ema_var = genGivenVals<DT>(2, {4, 16});
+
+    // channel 0: (x - 1) / 2, channel 1: 2 * (x - 4) / 4 + 1
+    auto exp = genGivenVals<DT>(2, {0, 0.5, 1, 1.5, -0.5, 0, 0.5, 1, 2, 2.5, 3, 3.5, 1.5, 2, 2.5, 3});
+
+    DT *res = nullptr;
+    BatchNorm2DTestForward<DT, DT>::apply(res, input, gamma, beta, ema_mean, ema_var, 0, dctx.get());
+    CHECK(*res == *exp);
+
+    DataObjectFactory::destroy(input, gamma, beta, ema_mean, ema_var, exp, res);
+}
@@ -19,6 +19,10 @@
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/kernels/Conv2DForward.h>
 
+#include <tuple>
+
+#include <cstdint>
+
 template <class DT> void checkConv2DForward(const DT *in, const DT *filter, const DT *exp, DaphneContext *dctx) {
     DT *res = nullptr;
     size_t out_h;
@@ -63,3 +67,81 @@ TEMPLATE_PRODUCT_TEST_CASE("conv_fwd_cpu", TAG_DNN, (DenseMatrix), (float, doubl
     DataObjectFactory::destroy(input);
     DataObjectFactory::destroy(result);
 }
+
+/**
+ * @brief Computes the convolution cell by cell as a reference.
+ */
+template <class DT>
+DT *referenceConv2DForward(const DT *in, const DT *filter, const DT *bias, size_t num_channels, size_t img_h,
+                           size_t img_w, size_t filter_h, size_t filter_w, size_t stride_h, size_t stride_w,
+                           size_t pad_h, size_t pad_w) {
+    using VT = typename DT::VT;
+    const size_t P = (img_h + 2 * pad_h - filter_h) / stride_h + 1;
+    const size_t Q = (img_w + 2 * pad_w - filter_w) / stride_w + 1;
+    const size_t C_new = filter->getNumRows();
+    auto res = DataObjectFactory::create<DT>(in->getNumRows(), C_new * P * Q, false);
+    for (size_t i = 0; i < in->getNumRows(); i++)
+        for (size_t f = 0; f < C_new; f++)
+            for (size_t p = 0; p < P; p++)
+                for (size_t q = 0; q < Q; q++) {
+                    VT sum = bias->get(f, 0);
+                    for (size_t c = 0; c < num_channels; c++)
+                        for (size_t h = 0; h < filter_h; h++)
+                            for (size_t w = 0; w < filter_w; w++) {
+                                const int64_t y = int64_t(p * stride_h + h) - int64_t(pad_h);
+                                const int64_t x = int64_t(q * stride_w + w) - int64_t(pad_w);
+                                if (y >= 0 && y < int64_t(img_h) && x >= 0 && x < int64_t(img_w))
+                                    sum += in->get(i, (c * img_h + y) * img_w + x) *
+                                           filter->get(f, (c * filter_h + h) * filter_w + w);
+                            }
+                    res->set(i, (f * P + p) * Q + q, sum);
+                }
+    return res;
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("conv_fwd_cpu matches reference", TAG_DNN, (DenseMatrix),
+                           (float, double)) { // NOLINT(cert-err58-cpp)
+    auto dctx = setupContextAndLogger();
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    // Shapes with several images, channels, and filters, non-square filters,
+    // strides, and paddings, 1x1 filters without padding, as well as shapes
+    // large enough to be processed in parallel and in several groups of
+    // unfolded images.
+    auto [batch_size, num_channels, img_h, img_w, num_filters, filter_h, filter_w, stride_h, stride_w, pad_h, pad_w] =
+        GENERATE(std::make_tuple(5, 3, 7, 6, 4, 3, 2, 2, 1, 1, 2), std::make_tuple(2, 3, 7, 6, 4, 3, 3, 1, 1, 1, 1),
+                 std::make_tuple(1, 3, 7, 6, 4, 2, 3, 1, 2, 0, 1), std::make_tuple(3, 3, 7, 6, 4, 1, 1, 1, 1, 0, 0),
+                 std::make_tuple(3, 3, 7, 6, 4, 7, 6, 1, 1, 0, 0), std::make_tuple(8, 8, 32, 32, 16, 3, 3, 1, 1, 1, 1),
+                 std::make_tuple(1, 8, 32, 32, 16, 3, 3, 1, 1, 1, 1), std::make_tuple(3, 64, 64, 64, 2, 3, 3, 1, 1, 1, 1));
+
+    // Use multiple threads for the large shapes, independent of the number of
+    // cores.
+    const int oldNumThreads = dctx->config.numberOfThreads;
+    dctx->config.numberOfThreads = 4;
+
+    auto in = DataObjectFactory::create<DT>(batch_size, num_channels * img_h * img_w, false);
+    for (size_t i = 0; i < in->getNumRows() * in->getNumCols(); i++)
+        in->getValues()[i] = static_cast<VT>(static_cast<int>(i * 7 % 11) - 5);
+    auto filter = DataObjectFactory::create<DT>(num_filters, num_channels * filter_h * filter_w, false);
+    for (size_t i = 0; i < filter->getNumRows() * filter->getNumCols(); i++)
+        filter->getValues()[i] = static_cast<VT>(static_cast<int>(i * 5 % 7) - 3);
+    auto bias = DataObjectFactory::create<DT>(num_filters, 1, false);
+    for (size_t i = 0; i < bias->getNumRows(); i++)
+        bias->getValues()[i] = static_cast<VT>(static_cast<int>(i % 5) - 2);
+
+    auto exp = referenceConv2DForward(in, filter, bias, num_channels, img_h, img_w, filter_h, filter_w, stride_h,
+                                      stride_w, pad_h, pad_w);
+    DT *res = nullptr;
+    size_t out_h;
+    size_t out_w;
+    Conv2DForward<DT, DT>::apply(res, out_h, out_w, in, filter, bias, batch_size, num_channels, img_h, img_w, filter_h,
+                                 filter_w, stride_h, stride_w, pad_h, pad_w, dctx.get());
+    CHECK(out_h == (img_h + 2 * pad_h - filter_h) / stride_h + 1);
+    CHECK(out_w == (img_w + 2 * pad_w - filter_w) / stride_w + 1);
+    // All values are small integers, so the results are exact.
+    CHECK(*res == *exp);
+
+    dctx->config.numberOfThreads = oldNumThreads;
+    DataObjectFactory::destroy(in, filter, bias, exp, res);
+}
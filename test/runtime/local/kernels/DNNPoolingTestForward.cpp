@@ -19,6 +19,12 @@
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/kernels/Pooling.h>
 
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+#include <cstdint>
+
 template <typename DT> DT *genInput() {
     return genGivenVals<DT>(2, {1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,  15,  16,  17,
                                 18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,  34,
@@ -121,3 +127,91 @@ TEMPLATE_PRODUCT_TEST_CASE("NN::Pooling::MAX::Forward", TAG_DNN, (DenseMatrix),
     DataObjectFactory::destroy(out_f2x2_s1x1_p1x1);
     DataObjectFactory::destroy(out_f2x2_s2x2_p1x1);
 }
+
+/**
+ * @brief Computes the pooling cell by cell as a reference; cells in the
+ * padding count as zeros.
+ */
+template <template <typename> class OP, class DT>
+DT *referencePoolingForward(const DT *in, size_t num_channels, size_t img_h, size_t img_w, size_t pool_h,
+                            size_t pool_w, size_t stride_h, size_t stride_w, size_t pad_h, size_t pad_w) {
+    using VT = typename DT::VT;
+    const size_t P = (img_h + 2 * pad_h - pool_h) / stride_h + 1;
+    const size_t Q = (img_w + 2 * pad_w - pool_w) / stride_w + 1;
+    auto res = DataObjectFactory::create<DT>(in->getNumRows(), num_channels * P * Q, false);
+    for (size_t i = 0; i < in->getNumRows(); i++)
+        for (size_t c = 0; c < num_channels; c++)
+            for (size_t p = 0; p < P; p++)
+                for (size_t q = 0; q < Q; q++) {
+                    VT acc = OP<VT>::isMAX() ? std::numeric_limits<VT>::lowest() : 0;
+                    for (size_t h = 0; h < pool_h; h++)
+                        for (size_t w = 0; w < pool_w; w++) {
+                            const int64_t y = int64_t(p * stride_h + h) - int64_t(pad_h);
+                            const int64_t x = int64_t(q * stride_w + w) - int64_t(pad_w);
+                            VT v = 0;
+                            if (y >= 0 && y < int64_t(img_h) && x >= 0 && x < int64_t(img_w))
+                                v = in->get(i, (c * img_h + y) * img_w + x);
+                            acc = OP<VT>::isMAX() ? std::max(acc, v) : acc + v;
+                        }
+                    if (!OP<VT>::isMAX())
+                        acc /= static_cast<VT>(pool_h * pool_w);
+                    res->set(i, (c * P + p) * Q + q, acc);
+                }
+    return res;
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("NN::Pooling::Forward matches reference", TAG_DNN, (DenseMatrix),
+                           (float, double)) { // NOLINT(cert-err58-cpp)
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    auto dctx = setupContextAndLogger();
+
+    // Non-square pools, strides, and paddings, as well as a shape large enough
+    // to be processed in parallel.
+    auto [batch_size, num_channels, img_h, img_w, pool_h, pool_w, stride_h, stride_w, pad_h, pad_w] =
+        GENERATE(std::make_tuple(3, 2, 7, 6, 3, 2, 2, 1, 1, 0), std::make_tuple(2, 3, 5, 8, 2, 3, 1, 3, 0, 1),
+                 std::make_tuple(1, 1, 4, 4, 4, 4, 1, 1, 0, 0), std::make_tuple(16, 16, 32, 32, 3, 3, 1, 1, 1, 1));
+
+    // Use multiple threads for the large shapes, independent of the number of
+    // cores.
+    const int oldNumThreads = dctx->config.numberOfThreads;
+    dctx->config.numberOfThreads = 4;
+
+    // Negative values check that the maximum is not clamped at zero.
+    auto in = DataObjectFactory::create<DT>(batch_size, num_channels * img_h * img_w, false);
+    for (size_t i = 0; i < in->getNumRows() * in->getNumCols(); i++)
+        in->getValues()[i] = static_cast<VT>(static_cast<int>(i * 7 % 13) - 9);
+
+    // The averages are not exact, so all cells are compared approximately.
+    auto check = [&](DT *exp, DT *res, size_t out_h, size_t out_w) {
+        CHECK(out_h == (img_h + 2 * pad_h - pool_h) / stride_h + 1);
+        CHECK(out_w == (img_w + 2 * pad_w - pool_w) / stride_w + 1);
+        REQUIRE(res->getNumCols() == exp->getNumCols());
+        size_t numMismatches = 0;
+        for (size_t i = 0; i < exp->getNumRows(); i++)
+            for (size_t j = 0; j < exp->getNumCols(); j++)
+                numMismatches += res->get(i, j) != Approx(exp->get(i, j));
+        CHECK(numMismatches == 0);
+        DataObjectFactory::destroy(exp, res);
+    };
+    size_t out_h;
+    size_t out_w;
+    DT *resMax = nullptr;
+    NN::Pooling::Forward<NN::Pooling::MAX, DT, DT>::apply(resMax, out_h, out_w, in, batch_size, num_channels, img_h,
+                                                          img_w, pool_h, pool_w, stride_h, stride_w, pad_h, pad_w,
+                                                          dctx.get());
+    check(referencePoolingForward<NN::Pooling::MAX>(in, num_channels, img_h, img_w, pool_h, pool_w, stride_h, stride_w,
+                                                    pad_h, pad_w),
+          resMax, out_h, out_w);
+    DT *resAvg = nullptr;
+    NN::Pooling::Forward<NN::Pooling::AVG, DT, DT>::apply(resAvg, out_h, out_w, in, batch_size, num_channels, img_h,
+                                                          img_w, pool_h, pool_w, stride_h, stride_w, pad_h, pad_w,
+                                                          dctx.get());
+    check(referencePoolingForward<NN::Pooling::AVG>(in, num_channels, img_h, img_w, pool_h, pool_w, stride_h, stride_w,
+                                                    pad_h, pad_w),
+          resAvg, out_h, out_w);
+
+    dctx->config.numberOfThreads = oldNumThreads;
+    DataObjectFactory::destroy(in);
+}
@@ -233,4 +233,29 @@ TEMPLATE_TEST_CASE("FilterRow (large input) - Frame", TAG_KERNELS, double, int64
     DataObjectFactory::destroy(c2);
     DataObjectFactory::destroy(arg);
     DataObjectFactory::destroy(res);
-}
\ No newline at end of file
+}
+
+TEST_CASE("FilterRow - Frame with string column", TAG_KERNELS) {
+    using VTSel = int64_t;
+
+    auto c0 = genGivenVals<DenseMatrix<int64_t>>(4, {1, 2, 3, 4});
+    auto c1 = genGivenVals<DenseMatrix<std::string>>(4, {"a", "bb", "ccc", "dddd"});
+    auto c2 = genGivenVals<DenseMatrix<float>>(4, {0.5f, 1.5f, 2.5f, 3.5f});
+    std::vector<Structure *> colMats = {c0, c1, c2};
+    auto arg = DataObjectFactory::create<Frame>(colMats, nullptr);
+
+    auto sel = genGivenVals<DenseMatrix<VTSel>>(4, {1, 0, 0, 1});
+    auto c0Exp = genGivenVals<DenseMatrix<int64_t>>(2, {1, 4});
+    auto c1Exp = genGivenVals<DenseMatrix<std::string>>(2, {"a", "dddd"});
+    auto c2Exp = genGivenVals<DenseMatrix<float>>(2, {0.5f, 3.5f});
+
+    Frame *res = nullptr;
+    filterRow<Frame, Frame, VTSel>(res, arg, sel, nullptr);
+
+    CHECK(res->getNumRows() == 2);
+    CHECK(*(res->getColumn<int64_t>(0)) == *c0Exp);
+    CHECK(*(res->getColumn<std::string>(1)) == *c1Exp);
+    CHECK(*(res->getColumn<float>(2)) == *c2Exp);
+
+    DataObjectFactory::destroy(c0, c1, c2, arg, sel, c0Exp, c1Exp, c2Exp, res);
+}
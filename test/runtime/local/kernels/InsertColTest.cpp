@@ -22,6 +22,8 @@
 #include <catch.hpp>
 #include <tags.h>
 
+#include <memory>
+
 #include <cstdint>
 
 #define DATA_TYPES DenseMatrix, Matrix
@@ -31,7 +33,7 @@ template <typename DTArg, typename VTSel>
 void checkInsertCol(const DTArg *arg, const DTArg *ins, const VTSel lowerIncl, const VTSel upperExcl,
                     const DTArg *exp) {
     DTArg *res = nullptr;
-    insertCol<DTArg, DTArg, VTSel>(res, arg, ins, lowerIncl, upperExcl, nullptr);
+    insertCol<DTArg, DTArg, VTSel>(res, arg, ins, lowerIncl, upperExcl, false, nullptr);
     CHECK(*res == *exp);
     DataObjectFactory::destroy(res, exp);
 }
@@ -39,7 +41,7 @@ void checkInsertCol(const DTArg *arg, const DTArg *ins, const VTSel lowerIncl, c
 template <typename DTArg, typename VTSel>
 void checkInsertColThrow(const DTArg *arg, const DTArg *ins, const VTSel lowerIncl, const VTSel upperExcl) {
     DTArg *res = nullptr;
-    REQUIRE_THROWS_AS((insertCol<DTArg, DTArg, VTSel>(res, arg, ins, lowerIncl, upperExcl, nullptr)),
+    REQUIRE_THROWS_AS((insertCol<DTArg, DTArg, VTSel>(res, arg, ins, lowerIncl, upperExcl, false, nullptr)),
                       std::out_of_range);
 }
 
@@ -254,4 +256,54 @@ TEMPLATE_PRODUCT_TEST_CASE("InsertCol - FP specific", TAG_KERNELS, (DATA_TYPES),
     }
 
     DataObjectFactory::destroy(arg, ins);
-}
\ No newline at end of file
+}
+
+TEMPLATE_TEST_CASE("InsertCol - in-place", TAG_KERNELS, int32_t, double) {
+    using VT = TestType;
+    using DT = DenseMatrix<VT>;
+
+    auto arg = genGivenVals<DT>(2, {1, 2, 3, 4, 5, 6});
+    auto ins = genGivenVals<DT>(2, {7, 8});
+    auto exp = genGivenVals<DT>(2, {1, 7, 3, 4, 8, 6});
+    DT *res = nullptr;
+
+    SECTION("exclusively owned argument") {
+        insertCol<DT, DT, int64_t>(res, arg, ins, 1, 2, true, nullptr);
+        CHECK(res == arg);
+        CHECK(res->getRefCounter() == 2);
+        DataObjectFactory::destroy(arg);
+    }
+
+    SECTION("reuse not allowed by the caller") {
+        insertCol<DT, DT, int64_t>(res, arg, ins, 1, 2, false, nullptr);
+        CHECK(res != arg);
+        DataObjectFactory::destroy(arg);
+    }
+
+    SECTION("argument referenced elsewhere") {
+        arg->increaseRefCounter();
+        insertCol<DT, DT, int64_t>(res, arg, ins, 1, 2, true, nullptr);
+        CHECK(res != arg);
+        DataObjectFactory::destroy(arg, arg);
+    }
+
+    SECTION("values referenced by a view") {
+        auto view = DataObjectFactory::create<DT>(arg, 0, 1);
+        insertCol<DT, DT, int64_t>(res, arg, ins, 1, 2, true, nullptr);
+        CHECK(res != arg);
+        CHECK(arg->get(0, 1) == 2);
+        DataObjectFactory::destroy(view, arg);
+    }
+
+    SECTION("external values") {
+        std::shared_ptr<VT[]> values(new VT[6]{1, 2, 3, 4, 5, 6});
+        auto ext = DataObjectFactory::create<DT>(2, 3, values);
+        values.reset();
+        insertCol<DT, DT, int64_t>(res, ext, ins, 1, 2, true, nullptr);
+        CHECK(res != ext);
+        DataObjectFactory::destroy(ext, arg);
+    }
+
+    CHECK(*res == *exp);
+    DataObjectFactory::destroy(res, ins, exp);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "run_tests.h"
+
+#include <runtime/local/kernels/NormalizedKeySort.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+TEST_CASE("NormalizedKeySort single columns", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+
+    SECTION("signed integers") {
+        const int64_t vals[] = {3, -1, std::numeric_limits<int64_t>::min(), 0, -1, std::numeric_limits<int64_t>::max()};
+        NormalizedKeySort sorter(6);
+        sorter.addKey(vals, 1, true);
+        std::vector<size_t> perm(6);
+        std::vector<std::pair<size_t, size_t>> groups;
+        sorter.sort(perm.data(), &groups, dctx.get());
+        CHECK(perm == std::vector<size_t>{2, 1, 4, 3, 0, 5});
+        CHECK(groups == std::vector<std::pair<size_t, size_t>>{{1, 3}});
+    }
+    SECTION("floating-point values, descending") {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double vals[] = {-0.0, 1.5, nan, -2.5, 0.0, -std::numeric_limits<double>::infinity(), 1.5};
+        NormalizedKeySort sorter(7);
+        sorter.addKey(vals, 1, false);
+        std::vector<size_t> perm(7);
+        std::vector<std::pair<size_t, size_t>> groups;
+        sorter.sort(perm.data(), &groups, dctx.get());
+        CHECK(perm == std::vector<size_t>{2, 1, 6, 0, 4, 3, 5});
+        CHECK(groups == std::vector<std::pair<size_t, size_t>>{{1, 3}, {3, 5}});
+    }
+    SECTION("every other value of a strided column") {
+        const float vals[] = {2, 100, 1, 100, 2, 100, 0, 100};
+        NormalizedKeySort sorter(4);
+        sorter.addKey(vals, 2, true);
+        std::vector<size_t> perm(4);
+        sorter.sort(perm.data(), nullptr, dctx.get());
+        CHECK(perm == std::vector<size_t>{3, 1, 0, 2});
+    }
+    SECTION("constant column") {
+        const uint32_t vals[] = {7, 7, 7};
+        NormalizedKeySort sorter(3);
+        sorter.addKey(vals, 1, true);
+        std::vector<size_t> perm(3);
+        std::vector<std::pair<size_t, size_t>> groups;
+        sorter.sort(perm.data(), &groups, dctx.get());
+        CHECK(perm == std::vector<size_t>{0, 1, 2});
+        CHECK(groups == std::vector<std::pair<size_t, size_t>>{{0, 3}});
+    }
+}
+
+TEST_CASE("NormalizedKeySort matches a stable comparison sort", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+
+    // The large size exceeds the threshold for sorting in parallel; the key
+    // columns need more than 64 bits in total, such that they are packed into
+    // multiple words.
+    const size_t numRows = GENERATE(1, 1000, 300000);
+    const int oldNumThreads = dctx->config.numberOfThreads;
+    dctx->config.numberOfThreads = 4;
+
+    std::mt19937 gen(numRows);
+    std::uniform_int_distribution<int64_t> distA(-20, 20);
+    std::uniform_int_distribution<int64_t> distB(std::numeric_limits<int64_t>::min(),
+                                                 std::numeric_limits<int64_t>::max());
+    std::uniform_int_distribution<int> distC(0, 50);
+    std::vector<int64_t> a(numRows);
+    std::vector<int64_t> b(numRows);
+    std::vector<double> c(numRows);
+    for (size_t r = 0; r < numRows; r++) {
+        a[r] = distA(gen);
+        // Mostly duplicates to produce groups, but many distinct bits.
+        b[r] = distC(gen) < 40 ? 0 : distB(gen);
+        c[r] = distC(gen) * 0.5 - 10;
+    }
+
+    NormalizedKeySort sorter(numRows);
+    sorter.addKey(a.data(), 1, true);
+    sorter.addKey(b.data(), 1, false);
+    sorter.addKey(c.data(), 1, true);
+    std::vector<size_t> perm(numRows);
+    std::vector<std::pair<size_t, size_t>> groups;
+    sorter.sort(perm.data(), &groups, dctx.get());
+
+    auto key = [&](size_t r) { return std::make_tuple(a[r], -static_cast<__int128>(b[r]), c[r]); };
+    std::vector<size_t> exp(numRows);
+    std::iota(exp.begin(), exp.end(), 0);
+    std::stable_sort(exp.begin(), exp.end(), [&](size_t i, size_t j) { return key(i) < key(j); });
+    std::vector<std::pair<size_t, size_t>> expGroups;
+    for (size_t i = 0; i < numRows;) {
+        size_t j = i + 1;
+        while (j < numRows && key(exp[j]) == key(exp[i]))
+            j++;
+        if (j - i > 1)
+            expGroups.emplace_back(i, j);
+        i = j;
+    }
+
+    CHECK(perm == exp);
+    CHECK(groups == expGroups);
+
+    dctx->config.numberOfThreads = oldNumThreads;
+}
@@ -180,4 +180,47 @@ TEMPLATE_PRODUCT_TEST_CASE("Order", TAG_KERNELS, (DenseMatrix, Matrix), (double,
     CHECK(*resIdxs == *expIdxs);
 
     DataObjectFactory::destroy(argMatrix, resMatrix, expMatrix, resIdxs, expIdxs);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Order on string columns", TAG_KERNELS) {
+    using VTIdx = size_t;
+
+    auto c0 = genGivenVals<DenseMatrix<std::string>>(6, {"b", "a", "c", "a", "b", "a"});
+    auto c1 = genGivenVals<DenseMatrix<int64_t>>(6, {0, 1, 2, 3, 4, 5});
+    std::vector<Structure *> colsArg = {c0, c1};
+    auto arg = DataObjectFactory::create<Frame>(colsArg, nullptr);
+    DataObjectFactory::destroy(c0, c1);
+
+    DenseMatrix<VTIdx> *resIdxs = nullptr;
+    DenseMatrix<VTIdx> *expIdxs = nullptr;
+    size_t numKeyCols;
+    size_t colIdxs[2];
+    bool ascending[2];
+
+    SECTION("single string key, ascending") {
+        numKeyCols = 1;
+        colIdxs[0] = 0;
+        ascending[0] = true;
+        // The sort is stable.
+        expIdxs = genGivenVals<DenseMatrix<VTIdx>>(6, {1, 3, 5, 0, 4, 2});
+    }
+    SECTION("single string key, descending") {
+        numKeyCols = 1;
+        colIdxs[0] = 0;
+        ascending[0] = false;
+        expIdxs = genGivenVals<DenseMatrix<VTIdx>>(6, {2, 0, 4, 1, 3, 5});
+    }
+    SECTION("string key, tie-broken by a numeric key") {
+        numKeyCols = 2;
+        colIdxs[0] = 0;
+        ascending[0] = true;
+        colIdxs[1] = 1;
+        ascending[1] = false;
+        expIdxs = genGivenVals<DenseMatrix<VTIdx>>(6, {5, 3, 1, 4, 0, 2});
+    }
+
+    order(resIdxs, arg, colIdxs, numKeyCols, ascending, numKeyCols, true, nullptr);
+    CHECK(*resIdxs == *expIdxs);
+
+    DataObjectFactory::destroy(arg, resIdxs, expIdxs);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/CheckEq.h>
+#include <runtime/local/kernels/PositionList.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+TEMPLATE_TEST_CASE("PositionList", TAG_KERNELS, double, int64_t) {
+    using VTSel = TestType;
+    using DTSel = DenseMatrix<VTSel>;
+    using DTRes = DenseMatrix<size_t>;
+
+    DTSel *sel = nullptr;
+    DTRes *exp = nullptr;
+    SECTION("nothing selected") {
+        sel = genGivenVals<DTSel>(4, {0, 0, 0, 0});
+        exp = DataObjectFactory::create<DTRes>(0, 1, false);
+    }
+    SECTION("some selected") {
+        sel = genGivenVals<DTSel>(6, {0, 1, 1, 0, 0, 1});
+        exp = genGivenVals<DTRes>(3, {1, 2, 5});
+    }
+    SECTION("everything selected") {
+        sel = genGivenVals<DTSel>(3, {1, 1, 1});
+        exp = genGivenVals<DTRes>(3, {0, 1, 2});
+    }
+
+    DTRes *res = nullptr;
+    positionList(res, sel, nullptr);
+    CHECK(*res == *exp);
+
+    DataObjectFactory::destroy(sel, exp, res);
+}
+
+TEST_CASE("PositionList - view", TAG_KERNELS) {
+    // The bit vector is a column of a larger matrix.
+    auto arg = genGivenVals<DenseMatrix<int64_t>>(4, {
+                                                         1, 0, //
+                                                         0, 1, //
+                                                         1, 1, //
+                                                         0, 0, //
+                                                     });
+    auto sel = DataObjectFactory::create<DenseMatrix<int64_t>>(arg, 0, 4, 1, 2);
+    auto exp = genGivenVals<DenseMatrix<size_t>>(2, {1, 2});
+
+    DenseMatrix<size_t> *res = nullptr;
+    positionList(res, sel, nullptr);
+    CHECK(*res == *exp);
+
+    DataObjectFactory::destroy(arg, sel, exp, res);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "run_tests.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/kernels/Await.h>
+#include <runtime/local/kernels/CreateIOContext.h>
+#include <runtime/local/kernels/Read.h>
+#include <runtime/local/kernels/ReadAsync.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <future>
+#include <string>
+
+TEST_CASE("ReadAsync and Await", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+    createIOContext(dctx.get());
+
+    // Several reads in flight at the same time.
+    std::string fnMat = "./test/runtime/local/io/ReadCsv1.csv";
+    Future<DenseMatrix<double>> *futMat = nullptr;
+    readAsync(futMat, fnMat.c_str(), dctx.get());
+    // The kernel must not depend on the file name after it returned.
+    fnMat.assign(fnMat.size(), 'x');
+    Future<Frame> *futFrame = nullptr;
+    readAsync(futFrame, "./test/runtime/local/io/ReadCsv4.csv", dctx.get());
+
+    DenseMatrix<double> *resMat = nullptr;
+    await(resMat, futMat, dctx.get());
+    Frame *resFrame = nullptr;
+    await(resFrame, futFrame, dctx.get());
+
+    DenseMatrix<double> *expMat = nullptr;
+    read(expMat, "./test/runtime/local/io/ReadCsv1.csv", dctx.get());
+    Frame *expFrame = nullptr;
+    read(expFrame, "./test/runtime/local/io/ReadCsv4.csv", dctx.get());
+    CHECK(*resMat == *expMat);
+    CHECK(*resFrame == *expFrame);
+
+    DataObjectFactory::destroy(resMat, expMat, resFrame, expFrame);
+}
+
+TEST_CASE("ReadAsync and Await - errors", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+    Future<DenseMatrix<double>> *fut = nullptr;
+
+    SECTION("no IOContext") {
+        CHECK_THROWS(readAsync(fut, "./test/runtime/local/io/ReadCsv1.csv", dctx.get()));
+    }
+    SECTION("failed read is reported by await") {
+        createIOContext(dctx.get());
+        readAsync(fut, "./test/runtime/local/io/does_not_exist.csv", dctx.get());
+        DenseMatrix<double> *res = nullptr;
+        CHECK_THROWS(await(res, fut, dctx.get()));
+    }
+    SECTION("unknown future") {
+        createIOContext(dctx.get());
+        Future<DenseMatrix<double>> other(std::async(std::launch::deferred, [] {
+            return static_cast<DenseMatrix<double> *>(nullptr);
+        }));
+        DenseMatrix<double> *res = nullptr;
+        CHECK_THROWS(await(res, &other, dctx.get()));
+    }
+}
+
+TEST_CASE("ReadAsync without Await", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+    createIOContext(dctx.get());
+
+    // The results are destroyed together with the IOContext.
+    Future<DenseMatrix<double>> *futMat = nullptr;
+    readAsync(futMat, "./test/runtime/local/io/ReadCsv1.csv", dctx.get());
+    Future<DenseMatrix<double>> *futFailed = nullptr;
+    readAsync(futFailed, "./test/runtime/local/io/does_not_exist.csv", dctx.get());
+    CHECK_NOTHROW(dctx->getIOContext()->destroy());
+}
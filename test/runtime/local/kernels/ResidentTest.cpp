@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "run_tests.h"
+
+#include <runtime/local/context/ResidentObjectStore.h>
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/kernels/LoadResident.h>
+#include <runtime/local/kernels/StoreResident.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("StoreResident and LoadResident", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+    auto m = genGivenVals<DenseMatrix<double>>(2, {1, 2, 3, 4});
+
+    // Outside of a DaphneLib session, there is no store.
+    CHECK_THROWS_AS(storeResident(m, "m", dctx.get()), std::runtime_error);
+
+    ResidentObjectStore store;
+    dctx->getUserConfig().resident_objects = &store;
+
+    storeResident(m, "m", dctx.get());
+    CHECK(m->getRefCounter() == 2);
+    ResidentObject res = store.get("m");
+    CHECK(res.kind == ResidentObject::Kind::DENSE_MATRIX);
+    CHECK(res.valueType == ValueTypeCode::F64);
+
+    DenseMatrix<double> *loaded = nullptr;
+    loadResident(loaded, "m", nullptr, 0, nullptr, 0, dctx.get());
+    CHECK(loaded == m);
+    CHECK(m->getRefCounter() == 3);
+    DataObjectFactory::destroy(loaded);
+
+    // A resident object of an unexpected type or name.
+    DenseMatrix<int64_t> *wrongVt = nullptr;
+    CHECK_THROWS_AS(loadResident(wrongVt, "m", nullptr, 0, nullptr, 0, dctx.get()), std::runtime_error);
+    CHECK(m->getRefCounter() == 2);
+    CHECK_THROWS_AS(loadResident(loaded, "n", nullptr, 0, nullptr, 0, dctx.get()), std::runtime_error);
+
+    // Replacing a resident object releases the previous one.
+    auto c0 = genGivenVals<DenseMatrix<double>>(2, {1, 2});
+    auto c1 = DataObjectFactory::create<DenseMatrix<std::string>>(2, 1, false);
+    std::vector<Structure *> cols = {c0, c1};
+    const std::string labels[] = {"a", "b"};
+    auto f = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(c0, c1);
+    const std::string sigMatrix = store.signature();
+    storeResident(f, "m", dctx.get());
+    CHECK(m->getRefCounter() == 1);
+    CHECK(store.signature() != sigMatrix);
+    res = store.get("m");
+    CHECK(res.kind == ResidentObject::Kind::FRAME);
+    CHECK(res.schema == std::vector<ValueTypeCode>{ValueTypeCode::F64, ValueTypeCode::STR});
+    CHECK(res.labels == std::vector<std::string>{"a", "b"});
+
+    // A resident frame must have the column types and labels the script was
+    // compiled for.
+    Frame *loadedFrame = nullptr;
+    const ValueTypeCode schema[] = {ValueTypeCode::F64, ValueTypeCode::STR};
+    const char *expLabels[] = {"a", "b"};
+    loadResident(loadedFrame, "m", schema, 2, expLabels, 2, dctx.get());
+    CHECK(loadedFrame == f);
+    DataObjectFactory::destroy(loadedFrame);
+    loadedFrame = nullptr;
+    // Unknown labels are not checked.
+    loadResident(loadedFrame, "m", schema, 2, nullptr, 0, dctx.get());
+    CHECK(loadedFrame == f);
+    DataObjectFactory::destroy(loadedFrame);
+    loadedFrame = nullptr;
+    const ValueTypeCode wrongSchema[] = {ValueTypeCode::F64, ValueTypeCode::SI64};
+    CHECK_THROWS_AS(loadResident(loadedFrame, "m", wrongSchema, 2, expLabels, 2, dctx.get()), std::runtime_error);
+    CHECK_THROWS_AS(loadResident(loadedFrame, "m", schema, 1, expLabels, 1, dctx.get()), std::runtime_error);
+    const char *wrongLabels[] = {"a", "c"};
+    CHECK_THROWS_AS(loadResident(loadedFrame, "m", schema, 2, wrongLabels, 2, dctx.get()), std::runtime_error);
+    CHECK(f->getRefCounter() == 2);
+
+    auto csr = DataObjectFactory::create<CSRMatrix<float>>(2, 2, 1, true);
+    storeResident(csr, "s", dctx.get());
+    CHECK(store.get("s").kind == ResidentObject::Kind::CSR_MATRIX);
+    CHECK(store.get("s").valueType == ValueTypeCode::F32);
+
+    CHECK(store.drop("s"));
+    CHECK_FALSE(store.drop("s"));
+    CHECK(csr->getRefCounter() == 1);
+    store.clear();
+    CHECK(f->getRefCounter() == 1);
+
+    dctx->getUserConfig().resident_objects = nullptr;
+    DataObjectFactory::destroy(m, f, csr);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/Sparsity.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstdint>
+
+#define DATA_TYPES DenseMatrix, CSRMatrix
+#define VALUE_TYPES double, int64_t
+
+TEMPLATE_PRODUCT_TEST_CASE("Sparsity", TAG_KERNELS, (DATA_TYPES), (VALUE_TYPES)) {
+    using DT = TestType;
+
+    SECTION("partially sparse") {
+        auto m = genGivenVals<DT>(3, {
+                                         0, 1, 0, 0,
+                                         0, 0, 0, 0,
+                                         2, 0, 3, 0,
+                                     });
+        CHECK(sparsity(m, nullptr) == Approx(0.25));
+        DataObjectFactory::destroy(m);
+    }
+    SECTION("all zero") {
+        auto m = genGivenVals<DT>(2, {0, 0, 0, 0});
+        CHECK(sparsity(m, nullptr) == 0.0);
+        DataObjectFactory::destroy(m);
+    }
+    SECTION("dense") {
+        auto m = genGivenVals<DT>(2, {1, 2, 3, 4});
+        CHECK(sparsity(m, nullptr) == 1.0);
+        DataObjectFactory::destroy(m);
+    }
+}
+
+TEMPLATE_TEST_CASE("Sparsity of a dense view", TAG_KERNELS, double, int64_t) {
+    using VT = TestType;
+
+    auto m = genGivenVals<DenseMatrix<VT>>(2, {
+                                                  1, 0, 0, 0,
+                                                  0, 0, 5, 6,
+                                              });
+    // The view covers the last two columns, skipping the other values.
+    auto view = DataObjectFactory::create<DenseMatrix<VT>>(m, 0, 2, 2, 4);
+    CHECK(sparsity(view, nullptr) == Approx(0.5));
+    DataObjectFactory::destroy(view, m);
+}
@@ -31,7 +31,7 @@
 template <class DT> void checkSyrk(const DT *arg, DCTX(dctx)) {
     DT *resExp = nullptr;
     DT *argT = nullptr;
-    transpose(argT, arg, dctx);
+    transpose(argT, arg, false, dctx);
     matMul(resExp, argT, arg, false, false, dctx);
 
     DT *resAct = nullptr;
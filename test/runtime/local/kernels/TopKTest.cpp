@@ -0,0 +1,145 @@
+/*
+ * Copyright 2024 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "run_tests.h"
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/kernels/CheckEq.h>
+#include <runtime/local/kernels/Order.h>
+#include <runtime/local/kernels/SliceRow.h>
+#include <runtime/local/kernels/TopK.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+TEMPLATE_TEST_CASE("TopK", TAG_KERNELS, double, int64_t) {
+    using VT = TestType;
+    auto dctx = setupContextAndLogger();
+
+    auto arg = genGivenVals<DenseMatrix<VT>>(8, {
+                                                    3, 1, //
+                                                    1, 2, //
+                                                    4, 3, //
+                                                    1, 4, //
+                                                    5, 5, //
+                                                    9, 6, //
+                                                    2, 7, //
+                                                    6, 8, //
+                                                });
+    size_t colIdxs[] = {0};
+
+    SECTION("ascending, data") {
+        bool ascending[] = {true};
+        DenseMatrix<VT> *res = nullptr;
+        topK(res, arg, 3, colIdxs, 1, ascending, 1, false, dctx.get());
+        auto exp = genGivenVals<DenseMatrix<VT>>(3, {1, 2, 1, 4, 2, 7});
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(res, exp);
+    }
+    SECTION("descending, indexes") {
+        bool ascending[] = {false};
+        DenseMatrix<size_t> *res = nullptr;
+        topK(res, arg, 2, colIdxs, 1, ascending, 1, true, dctx.get());
+        auto exp = genGivenVals<DenseMatrix<size_t>>(2, {5, 7});
+        CHECK(*res == *exp);
+        DataObjectFactory::destroy(res, exp);
+    }
+    SECTION("k = 0") {
+        bool ascending[] = {true};
+        DenseMatrix<VT> *res = nullptr;
+        topK(res, arg, 0, colIdxs, 1, ascending, 1, false, dctx.get());
+        CHECK(res->getNumRows() == 0);
+        CHECK(res->getNumCols() == 2);
+        DataObjectFactory::destroy(res);
+    }
+    SECTION("k greater than #rows") {
+        bool ascending[] = {true};
+        DenseMatrix<VT> *res = nullptr;
+        CHECK_THROWS_AS(topK(res, arg, 9, colIdxs, 1, ascending, 1, false, dctx.get()), std::out_of_range);
+    }
+
+    DataObjectFactory::destroy(arg);
+}
+
+TEST_CASE("TopK on frames", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+
+    auto c0 = genGivenVals<DenseMatrix<std::string>>(6, {"b", "a", "c", "a", "b", "a"});
+    auto c1 = genGivenVals<DenseMatrix<double>>(6, {0.5, 1.5, 2.5, 3.5, 4.5, 5.5});
+    std::vector<Structure *> cols = {c0, c1};
+    std::string labels[] = {"s", "d"};
+    auto arg = DataObjectFactory::create<Frame>(cols, labels);
+    size_t colIdxs[] = {0, 1};
+    bool ascending[] = {true, false};
+
+    Frame *res = nullptr;
+    topK(res, arg, 4, colIdxs, 2, ascending, 2, false, dctx.get());
+    auto e0 = genGivenVals<DenseMatrix<std::string>>(4, {"a", "a", "a", "b"});
+    auto e1 = genGivenVals<DenseMatrix<double>>(4, {5.5, 3.5, 1.5, 4.5});
+    std::vector<Structure *> expCols = {e0, e1};
+    auto exp = DataObjectFactory::create<Frame>(expCols, labels);
+    CHECK(*res == *exp);
+
+    DenseMatrix<size_t> *resIdxs = nullptr;
+    topK(resIdxs, arg, 2, colIdxs, 2, ascending, 2, true, dctx.get());
+    auto expIdxs = genGivenVals<DenseMatrix<size_t>>(2, {5, 3});
+    CHECK(*resIdxs == *expIdxs);
+
+    DataObjectFactory::destroy(c0, c1, arg, res, e0, e1, exp, resIdxs, expIdxs);
+}
+
+TEST_CASE("TopK matches order and sliceRow", TAG_KERNELS) {
+    auto dctx = setupContextAndLogger();
+
+    // The large size exceeds the threshold for using multiple threads, which
+    // keep separate heaps.
+    const size_t numRows = GENERATE(10, 1000, 2000000);
+    const size_t k = GENERATE(1, 10);
+    const int oldNumThreads = dctx->config.numberOfThreads;
+    dctx->config.numberOfThreads = 4;
+
+    auto arg = DataObjectFactory::create<DenseMatrix<double>>(numRows, 2, false);
+    std::mt19937 gen(numRows);
+    std::uniform_int_distribution<int> dist(0, 100);
+    double *values = arg->getValues();
+    for (size_t i = 0; i < numRows * 2; i++)
+        values[i] = dist(gen) * 0.25;
+    size_t colIdxs[] = {1, 0};
+    bool ascending[] = {false, true};
+
+    DenseMatrix<size_t> *res = nullptr;
+    topK(res, arg, k, colIdxs, 2, ascending, 2, true, dctx.get());
+    DenseMatrix<size_t> *ordered = nullptr;
+    order(ordered, arg, colIdxs, 2, ascending, 2, true, dctx.get());
+    DenseMatrix<size_t> *exp = nullptr;
+    sliceRow(exp, ordered, int64_t(0), static_cast<int64_t>(k), dctx.get());
+    CHECK(*res == *exp);
+
+    dctx->config.numberOfThreads = oldNumThreads;
+    DataObjectFactory::destroy(arg, res, ordered, exp);
+}
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include "run_tests.h"
+
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
@@ -25,13 +27,14 @@
 #include <catch.hpp>
 
 #include <cstdint>
+#include <tuple>
 
 #define DATA_TYPES DenseMatrix, CSRMatrix, Matrix
 #define VALUE_TYPES double, uint32_t
 
 template <class DT> void checkTranspose(const DT *arg, const DT *exp) {
     DT *res = nullptr;
-    transpose<DT, DT>(res, arg, nullptr);
+    transpose<DT, DT>(res, arg, false, nullptr);
     CHECK(*res == *exp);
 }
 
@@ -159,3 +162,99 @@ TEMPLATE_PRODUCT_TEST_CASE("Transpose", TAG_KERNELS, (DenseMatrix), (ALL_STRING_
     DataObjectFactory::destroy(m);
     DataObjectFactory::destroy(mt);
 }
+
+template <typename VT> DenseMatrix<VT> *genSequence(size_t numRows, size_t numCols) {
+    auto m = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+    VT *values = m->getValues();
+    for (size_t i = 0; i < numRows * numCols; i++)
+        values[i] = static_cast<VT>(i % 1000);
+    return m;
+}
+
+template <typename VT> bool isTransposeOf(const DenseMatrix<VT> *res, const DenseMatrix<VT> *arg) {
+    if (res->getNumRows() != arg->getNumCols() || res->getNumCols() != arg->getNumRows())
+        return false;
+    for (size_t r = 0; r < arg->getNumRows(); r++)
+        for (size_t c = 0; c < arg->getNumCols(); c++)
+            if (res->get(c, r) != arg->get(r, c))
+                return false;
+    return true;
+}
+
+TEMPLATE_TEST_CASE("Transpose blocked", TAG_KERNELS, float, double, int32_t, int64_t) {
+    using VT = TestType;
+
+    auto dctx = setupContextAndLogger();
+
+    // Shapes that are not multiples of the leaf and SIMD block sizes, and
+    // one large enough to be split across threads.
+    auto [numRows, numCols] = GENERATE(std::make_tuple(7, 5), std::make_tuple(33, 65), std::make_tuple(100, 3),
+                                       std::make_tuple(1031, 1027));
+
+    auto arg = genSequence<VT>(numRows, numCols);
+    DenseMatrix<VT> *res = nullptr;
+    transpose<DenseMatrix<VT>, DenseMatrix<VT>>(res, arg, false, dctx.get());
+    CHECK(isTransposeOf(res, arg));
+
+    // A view into the middle of the matrix.
+    auto view = DataObjectFactory::create<DenseMatrix<VT>>(arg, 1, numRows - 1, 1, numCols - 1);
+    DenseMatrix<VT> *resView = nullptr;
+    transpose<DenseMatrix<VT>, DenseMatrix<VT>>(resView, view, false, dctx.get());
+    CHECK(isTransposeOf(resView, view));
+
+    DataObjectFactory::destroy(arg, res, view, resView);
+}
+
+TEMPLATE_TEST_CASE("Transpose in place", TAG_KERNELS, float, double, int64_t) {
+    using VT = TestType;
+
+    auto dctx = setupContextAndLogger();
+
+    const size_t n = GENERATE(1, 9, 70, 1030);
+
+    auto exp = genSequence<VT>(n, n);
+    auto arg = genSequence<VT>(n, n);
+    const VT *valuesBefore = arg->getValues();
+
+    DenseMatrix<VT> *res = nullptr;
+    transpose<DenseMatrix<VT>, DenseMatrix<VT>>(res, arg, true, dctx.get());
+    CHECK(res == arg);
+    CHECK(res->getRefCounter() == 2);
+    CHECK(res->getValues() == valuesBefore);
+    CHECK(isTransposeOf(res, exp));
+
+    DataObjectFactory::destroy(exp, arg, res);
+}
+
+TEMPLATE_TEST_CASE("Transpose in place falls back", TAG_KERNELS, double) {
+    using VT = TestType;
+    using DT = DenseMatrix<VT>;
+
+    auto arg = genSequence<VT>(4, 4);
+    auto exp = genSequence<VT>(4, 4);
+    DT *res = nullptr;
+
+    SECTION("reuse not allowed by the caller") {
+        transpose<DT, DT>(res, arg, false, nullptr);
+        CHECK(res != arg);
+        DataObjectFactory::destroy(arg);
+    }
+
+    SECTION("argument referenced elsewhere") {
+        arg->increaseRefCounter();
+        transpose<DT, DT>(res, arg, true, nullptr);
+        CHECK(res != arg);
+        DataObjectFactory::destroy(arg, arg);
+    }
+
+    SECTION("values referenced by a view") {
+        auto view = DataObjectFactory::create<DT>(arg, 0, 4);
+        transpose<DT, DT>(res, arg, true, nullptr);
+        CHECK(res != arg);
+        CHECK(*arg == *exp);
+        DataObjectFactory::destroy(view, arg);
+    }
+
+    CHECK(isTransposeOf(res, exp));
+    DataObjectFactory::destroy(res, exp);
+}